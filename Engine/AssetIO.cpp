@@ -0,0 +1,246 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+#include "File_system.h"
+#include "AssetIO.h"
+
+bool AssetIO::Less(const shared_ptr<Request> &A, const shared_ptr<Request> &B)
+{
+	if (A->Level != B->Level)
+		return A->Level < B->Level;
+	return A->Order > B->Order;
+}
+
+AssetIO::Ticket AssetIO::Load(string File, Priority Level, Callback Done)
+{
+	Ticket It;
+	if (File.empty())
+		return It;
+
+	It.Key = path(File).generic_string();
+	to_lower(It.Key);
+
+	unique_lock<mutex> Guard(Lock);
+	if (Stopping)
+	{
+		// Nothing Will Read It: The Result Is Ready Right Now
+		promise<Data> Empty;
+		Empty.set_value(nullptr);
+		It.Result = Empty.get_future().share();
+		Guard.unlock();
+
+		if (Done)
+			Done(nullptr);
+		return It;
+	}
+	It.ID = ++Counter;
+
+	auto Found = ByKey.find(It.Key);
+	if (Found != ByKey.end())
+	{
+		// The Same File Is Read Once
+		auto Req = Found->second;
+		Req->Waiters.push_back(make_pair(It.ID, Done));
+		It.Result = Req->Result;
+		if (!Req->Started && Level > Req->Level)
+		{
+			Req->Level = Level;
+			make_heap(Queue.begin(), Queue.end(), Less);
+		}
+		return It;
+	}
+
+	auto Req = make_shared<Request>();
+	Req->Key = It.Key;
+	Req->File = File;
+	Req->Level = Level;
+	Req->Order = It.ID;
+	Req->Result = Req->Promise.get_future().share();
+	Req->Waiters.push_back(make_pair(It.ID, Done));
+	It.Result = Req->Result;
+
+	ByKey.emplace(It.Key, Req);
+	Queue.push_back(Req);
+	push_heap(Queue.begin(), Queue.end(), Less);
+
+	Schedule();
+	return It;
+}
+
+bool AssetIO::Cancel(const Ticket &It)
+{
+	if (!It.IsValid())
+		return false;
+
+	lock_guard<mutex> Guard(Lock);
+	auto Found = ByKey.find(It.Key);
+	if (Found == ByKey.end())
+		return false;
+
+	auto Req = Found->second;
+	auto &W = Req->Waiters;
+	W.erase(remove_if(W.begin(), W.end(), [&It](const pair<uint64_t, Callback> &A) { return A.first == It.ID; }),
+		W.end());
+
+	// Nobody Waits For The File: Don't Read It At All
+	if (W.empty() && !Req->Started)
+	{
+		Queue.erase(find(Queue.begin(), Queue.end(), Req));
+		make_heap(Queue.begin(), Queue.end(), Less);
+		ByKey.erase(Found);
+		Req->Promise.set_value(nullptr);
+	}
+
+	return true;
+}
+
+void AssetIO::Schedule()
+{
+	if (Stopping || Queue.empty() || Jobs >= MaxJobs)
+		return;
+
+	Jobs++;
+	auto Workers = Application.operator bool() ? Application->getWorkers()
+		: shared_ptr<nbsdx::concurrent::ThreadPool<>>();
+	if (Workers.operator bool())
+	{
+		Workers->AddJob([this]() { Run(); });
+		return;
+	}
+
+	// Threads Whose Jobs Are Done Are Joined Here, Others By Stop (They Use This Object)
+	for (auto It = Threads.begin(); It != Threads.end();)
+		if (It->Done->load())
+		{
+			It->Worker.join();
+			It = Threads.erase(It);
+		}
+		else
+			++It;
+
+	OwnThread New;
+	New.Done = make_shared<atomic<bool>>(false);
+	auto Done = New.Done;
+	New.Worker = thread([this, Done]() { Run(); Done->store(true); });
+	Threads.push_back(move(New));
+}
+
+void AssetIO::Run()
+{
+	vector<shared_ptr<Request>> Batch;
+	for (;;)
+	{
+		Batch.clear();
+		{
+			lock_guard<mutex> Guard(Lock);
+			while (!Stopping && !Queue.empty() && Batch.size() < BatchSize)
+			{
+				pop_heap(Queue.begin(), Queue.end(), Less);
+				Batch.push_back(Queue.back());
+				Queue.pop_back();
+				Batch.back()->Started = true;
+			}
+			if (Batch.empty())
+			{
+				Jobs--;
+				Idle.notify_all();
+				return;
+			}
+		}
+
+		// Map Every File Of The Batch, Then Ask The System To Read Them In One Request
+		vector<MappedFile *> Files;
+		for (auto &Req: Batch)
+		{
+			auto File = make_shared<MappedFile>();
+			if (File->Open(Req->File, MappedFile::Sequential))
+			{
+				Req->Mapped = File;
+				Files.push_back(File.get());
+			}
+		}
+		MappedFile::Prefetch(Files);
+
+		lock_guard<mutex> Guard(Lock);
+		for (auto &Req: Batch)
+		{
+			Req->Promise.set_value(Req->Mapped);
+			Completed.push_back(Req);
+		}
+	}
+}
+
+void AssetIO::Update(float BudgetMs)
+{
+	auto Start = chrono::steady_clock::now();
+	for (;;)
+	{
+		shared_ptr<Request> Req;
+		vector<pair<uint64_t, Callback>> Waiters;
+		{
+			lock_guard<mutex> Guard(Lock);
+			if (Completed.empty())
+				return;
+
+			Req = Completed.front();
+			Completed.pop_front();
+			ByKey.erase(Req->Key);
+			Waiters.swap(Req->Waiters);
+		}
+
+		// Callbacks Can Request Other Files, So They're Called Without Lock
+		for (auto &It: Waiters)
+			if (It.second)
+				It.second(Req->Mapped);
+
+		if (chrono::duration<float, milli>(chrono::steady_clock::now() - Start).count() >= BudgetMs)
+			return;
+	}
+}
+
+void AssetIO::Stop()
+{
+	// Everybody Who Waits Gets nullptr, As Load After Stop Gives
+	vector<pair<uint64_t, Callback>> Waiters;
+	auto Take = [&Waiters](Request &Req)
+	{
+		for (auto &It: Req.Waiters)
+			Waiters.push_back(move(It));
+		Req.Waiters.clear();
+	};
+
+	unique_lock<mutex> Guard(Lock);
+	Stopping = true;
+	for (auto &Req: Queue)
+	{
+		Take(*Req);
+		Req->Promise.set_value(nullptr);
+	}
+	Queue.clear();
+
+	Idle.wait(Guard, [this]() { return Jobs == 0; });
+	for (auto &Req: Completed)
+		Take(*Req);
+	Completed.clear();
+	ByKey.clear();
+
+	// Jobs Are Done, Only Their Threads Are Left
+	vector<OwnThread> Own;
+	Own.swap(Threads);
+	Guard.unlock();
+	for (auto &It: Own)
+		if (It.Worker.joinable())
+			It.Worker.join();
+
+	for (auto &It: Waiters)
+		if (It.second)
+			It.second(nullptr);
+}
+
+size_t AssetIO::getPending()
+{
+	lock_guard<mutex> Guard(Lock);
+	return ByKey.size();
+}
@@ -0,0 +1,144 @@
+/**
+ * \file	AssetIO.h.
+ *
+ * \brief	Declares the asynchronous asset I/O queue
+ */
+
+#pragma once
+#if !defined(__ASSETIO_H__)
+#define __ASSETIO_H__
+#include "pch.h"
+
+#include <future>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include "MappedFile.h"
+
+/**
+ * \class	AssetIO
+ *
+ * \brief	Files are mapped and their pages are loaded by jobs of Engine thread pool, so the
+ * 			frame thread only parses them. Requests with higher priority go first, requests
+ * 			of the same file are coalesced into one read, and callbacks are called from
+ * 			Update() on the frame thread (Where It's Safe To Touch Device, Lua And Levels).
+ */
+
+class AssetIO
+{
+public:
+	enum Priority
+	{
+		Low = 0,
+		Normal,
+		High,
+		// e.g. Sound Which Must Be Played Right Now
+		Critical
+	};
+
+	// nullptr If The File Can't Be Read Or The Request Is Cancelled
+	using Data = shared_ptr<MappedFile>;
+	using Callback = function<void(Data)>;
+
+	struct Ticket
+	{
+		string Key;
+		uint64_t ID = 0;
+		shared_future<Data> Result;
+
+		bool IsValid() const { return ID != 0; }
+		bool IsReady() const
+		{
+			return Result.valid() && Result.wait_for(chrono::seconds(0)) == future_status::ready;
+		}
+	};
+
+	AssetIO() {}
+	~AssetIO() { Stop(); }
+
+	/**
+	 * \fn	Ticket AssetIO::Load(string File, Priority Level = Normal, Callback Done = nullptr);
+	 *
+	 * \brief	Request the file
+	 *
+	 * \param 	File 	Full path to the file (Or As If The File Was In Resource Folder).
+	 * \param 	Level	(Optional) The priority (Coalesced Request Gets The Higher One).
+	 * \param 	Done 	(Optional) Called from Update() when the file is read (After Stop() It's
+	 * 					Called At Once With nullptr).
+	 *
+	 * \returns	Ticket to wait for the result or to cancel the request.
+	 */
+
+	Ticket Load(string File, Priority Level = Normal, Callback Done = nullptr);
+
+	/**
+	 * \fn	bool AssetIO::Cancel(const Ticket &It);
+	 *
+	 * \brief	Callback of this ticket won't be called. If nobody else waits for the file
+	 * 			and it isn't read yet, the request is removed from the queue.
+	 *
+	 * \returns	True if callbacks of the file weren't called yet.
+	 */
+
+	bool Cancel(const Ticket &It);
+
+	/**
+	 * \fn	void AssetIO::Update(float BudgetMs = 4.f);
+	 *
+	 * \brief	Call callbacks of read files (Only For BudgetMs, The Rest Wait For The Next Frame)
+	 */
+
+	void Update(float BudgetMs = 4.f);
+
+	// Remove Every Queued Request And Wait For The Jobs. Callbacks Which Weren't Called Yet Get
+	// nullptr (Next Requests Get It At Once)
+	void Stop();
+
+	size_t getPending();
+
+	// Files Which Are Mapped In One Job And Prefetched In One Request
+	static const size_t BatchSize = 8;
+	// Jobs Which Are Run In Thread Pool At Once
+	static const size_t MaxJobs = 2;
+private:
+	struct Request
+	{
+		string Key, File;
+		Priority Level = Normal;
+		uint64_t Order = 0;
+		bool Started = false;
+
+		vector<pair<uint64_t, Callback>> Waiters;
+		promise<Data> Promise;
+		shared_future<Data> Result;
+		Data Mapped;
+	};
+
+	static bool Less(const shared_ptr<Request> &A, const shared_ptr<Request> &B);
+
+	void Run();
+	void Schedule();
+
+	mutex Lock;
+	condition_variable Idle;
+	// Requests Which Callbacks Weren't Called Yet
+	unordered_map<string, shared_ptr<Request>> ByKey;
+	// Heap: The Highest Priority, Then The Oldest Request
+	vector<shared_ptr<Request>> Queue;
+	deque<shared_ptr<Request>> Completed;
+
+	uint64_t Counter = 0;
+	size_t Jobs = 0;
+	bool Stopping = false;
+
+	// Threads Which Run Jobs Without Engine Thread Pool (Joined When They're Done Or By Stop)
+	struct OwnThread
+	{
+		thread Worker;
+		shared_ptr<atomic<bool>> Done;
+	};
+	vector<OwnThread> Threads;
+};
+#endif // !__ASSETIO_H__
@@ -6,6 +6,9 @@ extern shared_ptr<Engine> Application;
 #include "Console.h"
 #include "Camera.h"
 #include "File_system.h"
+#include "MappedFile.h"
+#include "AssetIO.h"
+#include "ResidentCache.h"
 
 #include "Audio.h"
 
@@ -17,7 +20,7 @@ XAUDIO2_VOICE_DETAILS Audio::VOICE_Details = {};
 XAUDIO2_DEVICE_DETAILS Audio::DEVICE_Details = {};
 
 shared_ptr<Audio::Listerner> Audio::Lnr;
-vector<pair<shared_ptr<Audio::Source>, string>> Audio::Src;
+vector<pair<shared_ptr<Audio::Source>, StringID>> Audio::Src;
 
 X3DAUDIO_HANDLE Audio::X3DInstance = {};
 X3DAUDIO_DSP_SETTINGS Audio::DSPSettings = {};
@@ -44,13 +47,28 @@ public:
 */
 HRESULT Audio::AudioFile::loadWAVFile(string filename, XAUDIO2_BUFFER &_Buffer)
 {
-	mmio = mmioOpenA(const_cast<LPSTR>(filename.c_str()), nullptr, MMIO_READ);
-
-	if (!mmio)
+	// XAudio2 Plays Samples Right From Mapped File, So It Lives While The Sound Lives
+	auto Cache = Application->getCache();
+	if (!Mapped.operator bool() && Cache.operator bool())
+	{
+		// Sounds Of The Same File Share One Mapping, It's Kept After Them While It Fits The Budget
+		StringID Key = StringID::Path(filename);
+		Mapped = Cache->Find<MappedFile>(ResidentCache::Sounds, Key);
+		if (!Mapped.operator bool())
+		{
+			auto New = make_shared<MappedFile>();
+			if (New->Open(filename, MappedFile::WillNeed))
+				Mapped = Cache->Add(ResidentCache::Sounds, Key, New, New->size());
+		}
+	}
+	if (!Mapped.operator bool())
+		Mapped = make_shared<MappedFile>();
+	if (!Mapped->IsOpen() && !Mapped->Open(filename, MappedFile::WillNeed))
 		return HRESULT_FROM_WIN32(ERROR_OPEN_FAILED);
 
-	riff.fccType = mmioFOURCC('W', 'A', 'V', 'E');
-	if (mmioDescend(mmio, &riff, nullptr, MMIO_FINDRIFF) != MMSYSERR_NOERROR)
+	auto Data = Mapped->data();
+	size_t Size = Mapped->size();
+	if (Size < 12 || memcmp(Data, "RIFF", 4) != 0 || memcmp(Data + 8, "WAVE", 4) != 0)
 	{
 		Engine::LogError("Audio: " + filename + ": Isn't a WAV File",
 			string(__FILE__) + ": " + to_string(__LINE__),
@@ -58,67 +76,56 @@ HRESULT Audio::AudioFile::loadWAVFile(string filename, XAUDIO2_BUFFER &_Buffer)
 		return HRESULT_FROM_WIN32(E_FAIL);
 	}
 
-	fmt.ckid = mmioFOURCC('f', 'm', 't', ' ');
-
-	if (mmioDescend(mmio, &fmt, &riff, MMIO_FINDCHUNK) != MMSYSERR_NOERROR)
+	const BYTE *Samples = nullptr;
+	DWORD SamplesSize = 0;
+	bool HasFmt = false;
+	for (size_t Pos = 12; Pos + 8 <= Size;)
 	{
-		Engine::LogError("Audio: " + filename + ": Hasn't a FMT",
-			string(__FILE__) + ": " + to_string(__LINE__),
-			"Something is wrong with Audio: " + filename + ": Hasn't a FMT");
-		return HRESULT_FROM_WIN32(E_FAIL);
+		DWORD ChunkSize = *reinterpret_cast<const DWORD *>(Data + Pos + 4);
+		auto Chunk = Data + Pos + 8;
+		if (ChunkSize > Size - Pos - 8)
+			ChunkSize = DWORD(Size - Pos - 8);
+
+		if (memcmp(Data + Pos, "fmt ", 4) == 0)
+		{
+			if (ChunkSize < 16)
+			{
+				Engine::LogError("Audio: " + filename + ": Hasn't a FMT",
+					string(__FILE__) + ": " + to_string(__LINE__),
+					"Something is wrong with Audio: " + filename + ": Has The Wrong FMT Size (" +
+					to_string(ChunkSize) + ")");
+				return HRESULT_FROM_WIN32(E_FAIL);
+			}
+			memcpy(&WaveFormEx, Chunk, min<size_t>(ChunkSize, sizeof(WaveFormEx)));
+			HasFmt = true;
+		}
+		else if (memcmp(Data + Pos, "data", 4) == 0)
+		{
+			Samples = Chunk;
+			SamplesSize = ChunkSize;
+		}
+
+		// Chunks Are Word-Aligned
+		Pos += 8 + size_t(ChunkSize) + (ChunkSize & 1);
 	}
 
-	LONG readSize = mmioRead(mmio, reinterpret_cast<HPSTR>(&WaveFormEx), fmt.cksize);
-	switch (readSize)
-	{
-	case 0:
+	if (!HasFmt)
 	{
 		Engine::LogError("Audio: " + filename + ": Hasn't a FMT",
 			string(__FILE__) + ": " + to_string(__LINE__),
-			"Something is wrong with Audio: " + filename + ": Has The Wrong FMT Size (= 0)");
+			"Something is wrong with Audio: " + filename + ": Hasn't a FMT");
 		return HRESULT_FROM_WIN32(E_FAIL);
 	}
-	break;
-	case -1:
+	if (!Samples)
 	{
-		Engine::LogError("Audio: " + filename + ": Hasn't a FMT",
-			string(__FILE__) + ": " + to_string(__LINE__),
-			"Something is wrong with Audio: " + filename + ": Has The Wrong FMT Size (= -1)");
-		return HRESULT_FROM_WIN32(E_FAIL);
-	}
-	break;
-	default:
-		if ((unsigned)readSize != fmt.cksize)
-		{
-			Engine::LogError("Audio: " + filename + ": Hasn't a FMT",
-				string(__FILE__) + ": " + to_string(__LINE__),
-				"Something is wrong with Audio: " + filename + ": Has The Wrong FMT Size (readSize != fmt.cksize)");
-			return HRESULT_FROM_WIN32(E_FAIL);
-		}
-	}
-
-	mmioAscend(mmio, &fmt, SEEK_SET);
-
-	data.ckid = mmioFOURCC('d', 'a', 't', 'a');
-
-	if (mmioDescend(mmio, &data, &riff, MMIO_FINDCHUNK) != MMSYSERR_NOERROR)
 		Engine::LogError((boost::format("Audio::LoadWAV()-> This File: %s Has a Bad Data.") % filename.c_str()).str(),
 			string(__FILE__) + ": " + to_string(__LINE__),
 			"Sound: Something is wrong with Load WAV File! It Has a Bad Data");
+		return HRESULT_FROM_WIN32(E_FAIL);
+	}
 
-	pDataBuffer.resize(data.cksize);
-
-	if (mmioRead(
-		mmio,
-		reinterpret_cast<HPSTR>(&pDataBuffer[0]), data.cksize) != (signed)data.cksize)
-		Engine::LogError((boost::format("Audio::LoadWAV()-> This File: %s Isn't a WAV File.") % filename).str(),
-			string(__FILE__) + ": " + to_string(__LINE__),
-			"Sound: Something is wrong with Load WAV File! It Isn't a WAV File");
-
-	mmioClose(mmio, MMIO_FHOPEN);
-
-	_Buffer.AudioBytes = pDataBuffer.size();
-	_Buffer.pAudioData = pDataBuffer.data();
+	_Buffer.AudioBytes = SamplesSize;
+	_Buffer.pAudioData = Samples;
 	_Buffer.Flags = XAUDIO2_END_OF_STREAM;
 
 	return S_OK;
@@ -192,30 +199,31 @@ HRESULT Audio::Init()
 void Audio::AddNewFile(string File, bool Repeat)
 {
 	if (File.empty()) return;
+	StringID Name(path(File).filename().string());
 	if (Src.empty())
 	{
-		Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat),
-			path(File).filename().string()));
+		Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat), Name));
 		Src.back().first->Init();
 		return;
 	}
-	for (auto It: Src)
+	for (auto &It: Src)
 	{
-		if (path(File).filename().string() == It.second)
+		if (Name == It.second)
 			return;
 	}
 
-	Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat),
-		path(File).filename().string()));
+	Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat), Name));
 	Src.back().first->Init();
 }
 
 void Audio::Remove(string ID)
 {
 	if (ID.empty()) return;
+	StringID Name = StringID::Find(path(ID).filename().string());
+	if (Name.IsEmpty()) return;
 	for (size_t i = 0; i < Src.size(); i++)
 	{
-		if (Src.at(i).second == path(ID).filename().string())
+		if (Src.at(i).second == Name)
 		{
 			Src.at(i).first->Stop();
 			Src.at(i).first->Destroy();
@@ -229,17 +237,17 @@ void Audio::AddNewFile(vector<string> Files, bool Repeat)
 	for (auto File: Files)
 	{
 		if (File.empty()) continue;
+		StringID Name(path(File).filename().string());
 		if (Src.empty())
 		{
-			Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat),
-				path(File).filename().string()));
+			Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat), Name));
 			Src.back().first->Init();
 			return;
 		}
 		bool IfItBreak = false;
-		for (auto It: Src)
+		for (auto &It: Src)
 		{
-			if (path(File).filename().string() == It.second)
+			if (Name == It.second)
 			{
 				IfItBreak = true;
 				break;
@@ -248,8 +256,7 @@ void Audio::AddNewFile(vector<string> Files, bool Repeat)
 
 		if (!IfItBreak)
 		{
-			Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat),
-				path(File).filename().string()));
+			Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, Repeat), Name));
 			Src.back().first->Init();
 		}
 	}
@@ -289,12 +296,31 @@ HRESULT Audio::doPlay()
 	return S_OK;
 }
 
+vector<shared_ptr<Audio::Source>> Audio::FindSounds(string Index)
+{
+	vector<shared_ptr<Source>> Found;
+
+	// Whole Name Of File: Only IDs Are Compared
+	StringID Key = StringID::Find(Index);
+	if (!Key.IsEmpty())
+		for (auto &It: Src)
+			if (It.second == Key)
+				Found.push_back(It.first);
+
+	// Part Of Name (As It Was Before)
+	if (Found.empty())
+		for (auto &It: Src)
+			if (contains(It.second.original(), Index))
+				Found.push_back(It.first);
+
+	return Found;
+}
+
 HRESULT Audio::doPlay(string Index)
 {
-	for (auto It: Src)
+	for (auto It: FindSounds(Index))
 	{
-		if (contains(It.second, Index))
-			EngineTrace(It.first->Play());
+		EngineTrace(It->Play());
 	}
 
 	return S_OK;
@@ -302,11 +328,9 @@ HRESULT Audio::doPlay(string Index)
 
 shared_ptr<Audio::Source> Audio::GetSound(string Index)
 {
-	for (auto It: Src)
-	{
-		if (contains(It.second, Index))
-			return It.first;
-	}
+	auto Found = FindSounds(Index);
+	if (!Found.empty())
+		return Found.front();
 	return shared_ptr<Source>();
 }
 
@@ -319,6 +343,7 @@ void Audio::AudioFile::Destroy()
 	//}
 	if (source)
 		source->DestroyVoice();
+	Mapped.reset();
 
 	SecureZeroMemory(&buffer, sizeof(XAUDIO2_BUFFER));
 	SecureZeroMemory(&WaveFormEx, sizeof(WAVEFORMATEX));
@@ -419,25 +444,54 @@ HRESULT Audio::PlayFile(string File, bool RepeatIt, bool NeedFind)
 		return E_FAIL;
 	}
 
+	string FullPath = File;
 	if (NeedFind)
 	{
 		auto SoundFile = Application->getFS()->GetFile(File);
-		if (SoundFile.operator bool())
-		{
-			Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, RepeatIt),
-				path(File).filename().string()));
-			Src.back().first->Init();
-			EngineTrace(Src.back().first->Play());
-		}
+		if (!SoundFile.operator bool())
+			return S_OK;
+		FullPath = SoundFile->PathA;
 	}
-	else // If We Have A Full Path To File!!!
+
+	auto Play = [File, FullPath, RepeatIt](shared_ptr<MappedFile> Mapped)
 	{
-		Src.push_back(make_pair(make_shared<Source>(File, VOICE_Details.InputChannels, RepeatIt),
-			path(File).filename().string()));
+		Src.push_back(make_pair(make_shared<Source>(FullPath, VOICE_Details.InputChannels, RepeatIt, Mapped),
+			StringID(path(File).filename().string())));
 		Src.back().first->Init();
-		EngineTrace(Src.back().first->Play());
+		if (FAILED(Src.back().first->Play()))
+			Engine::LogError("Audio::PlayFile() Failed!",
+				string(__FILE__) + ": " + to_string(__LINE__),
+				"Audio: Cannot Play " + FullPath);
+	};
+
+	// The Sound Which Was Played Before Is Still Mapped
+	auto Cache = Application->getCache();
+	StringID Key = StringID::Path(FullPath);
+	if (Cache.operator bool())
+	{
+		auto Resident = Cache->Find<MappedFile>(ResidentCache::Sounds, Key);
+		if (Resident.operator bool())
+		{
+			Play(Resident);
+			return S_OK;
+		}
 	}
 
+	// The File Is Read In Background, The Sound Starts When It's Ready
+	if (Application->getIO().operator bool())
+		Application->getIO()->Load(FullPath, AssetIO::Critical, [Play, FullPath, Key](AssetIO::Data Mapped)
+		{
+			auto Cache = Application->getCache();
+			if (Mapped.operator bool())
+				Play(Cache.operator bool() ? Cache->Add(ResidentCache::Sounds, Key, Mapped, Mapped->size()) : Mapped);
+			else
+				Engine::LogError("Audio::PlayFile() Failed!",
+					string(__FILE__) + ": " + to_string(__LINE__),
+					"Audio: Cannot Read " + FullPath);
+		});
+	else
+		Play(nullptr);
+
 	return S_OK;
 }
 
@@ -453,10 +507,9 @@ HRESULT Audio::doStop()
 
 HRESULT Audio::doStop(string Index)
 {
-	for (auto It: Src)
+	for (auto It: FindSounds(Index))
 	{
-		if (contains(It.second, Index))
-			EngineTrace(It.first->Stop());
+		EngineTrace(It->Stop());
 	}
 	
 	return S_OK;
@@ -484,9 +537,9 @@ void Audio::Listerner::Update(Vector3 CamPos, Vector3 CamAhead, Vector3 CamUp)
 	Listener.Position = X3DAUDIO_VECTOR{ CamPos.x, CamPos.y, CamPos.z };
 }
 
-Audio::Source::Source(string FName, int Channels, bool Repeat)
+Audio::Source::Source(string FName, int Channels, bool Repeat, shared_ptr<MappedFile> Mapped)
 {
-	AUDFile = make_shared<AudioFile>(FName, Channels, Repeat);
+	AUDFile = make_shared<AudioFile>(FName, Channels, Repeat, Mapped);
 	Init();
 }
 
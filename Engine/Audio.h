@@ -5,6 +5,8 @@
 
 #include "DXSDKAudio2.h"
 #include "X3DAudio.h"
+#include "MappedFile.h"
+#include "StringID.h"
 
 class Audio
 {
@@ -18,16 +20,15 @@ private:
 		IXAudio2SubmixVoice *SubMix;
 
 		//	WAV Buffer Data!
-		vector<BYTE> pDataBuffer;
+		shared_ptr<MappedFile> Mapped;
 		WAVEFORMATEX WaveFormEx;
-		HMMIO mmio;
-		MMCKINFO riff, fmt, data;
 
 		bool Repeat = false;
 
 		HRESULT loadWAVFile(string filename, XAUDIO2_BUFFER &_Buffer);
 	public:
-		AudioFile(string FName, int Channels, bool Repeat): Repeat(Repeat)
+		AudioFile(string FName, int Channels, bool Repeat, shared_ptr<MappedFile> Mapped = nullptr):
+			Mapped(Mapped), Repeat(Repeat)
 		{
 			Load(FName, Channels);
 		}
@@ -53,7 +54,8 @@ private:
 	struct Source
 	{
 	public:
-		Source(string FName, int Channels, bool Repeat = true);
+		// Mapped: The File Which Is Already Read (e.g. By AssetIO)
+		Source(string FName, int Channels, bool Repeat = true, shared_ptr<MappedFile> Mapped = nullptr);
 		~Source() {}
 
 		void Init();
@@ -102,8 +104,12 @@ private:
 		X3DAUDIO_LISTENER Listener = { };
 		X3DAUDIO_CONE Listener_DirectionalCone = {};
 	};
-	static vector<pair<shared_ptr<Source>, string>> Src;
+	// Sources And Interned Names Of Their Files
+	static vector<pair<shared_ptr<Source>, StringID>> Src;
 	static shared_ptr<Listerner> Lnr;
+
+	// Sources With This Name Of File (Or With The Part Of Name If There's No Such Name)
+	static vector<shared_ptr<Source>> FindSounds(string Index);
 public:
 	HRESULT Init();
 	
@@ -127,7 +133,7 @@ public:
 	HRESULT changePitch(float Pitch);
 	HRESULT changePan(float Pan);
 
-	vector<pair<shared_ptr<Source>, string>> getAllSources() { return Src; }
+	vector<pair<shared_ptr<Source>, StringID>> getAllSources() { return Src; }
 	shared_ptr<Listerner> getListerner() { return Lnr; }
 
 	bool IsInitSoundSystem() { return InitSoundSystem; }
@@ -84,9 +84,12 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 	string CMD = cmd->CommandStr;
 	to_lower(CMD);
 
+	static const StringID Help("help"), Quit("quit"), Clear("clear"), DoTorque("dotorque"), ReinitLua("reinit_lua"),
+		ChangeSize("changesize");
+
 	if (cmd->type == Command::TypeOfCommand::WithoutParam)
 	{
-		if (contains(CMD, "help"))
+		if (cmd->Key == Help)
 		{
 			string all;
 			for (size_t i = 0; i < ListCommands.size(); i++)
@@ -103,9 +106,9 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 				FindComponentUText("##CText")->AddText(Type::Information,
 					"#list of available commands: " + all);
 		}
-		else if (contains(CMD, "quit"))
+		else if (cmd->Key == Quit)
 			Application->Quit();
-		else if (contains(CMD, "clear"))
+		else if (cmd->Key == Clear)
 		{
 			Console->getComponents()->FindComponentChild("##ConsoleTextBox")->getMassComponents().front()->
 				FindComponentUText("##CText")->ClearText();
@@ -113,7 +116,7 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 			History.push_back(cmd->TypedCmd);
 			return;
 		}
-		else if (contains(CMD, "dotorque"))
+		else if (cmd->Key == DoTorque)
 		{
 			auto ObjPhys = Application->getPhysics()->GetPhysDynamicObject();
 			if (!ObjPhys.empty())
@@ -128,7 +131,7 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 				Console->getComponents()->FindComponentChild("##ConsoleTextBox")->getMassComponents().front()->
 				FindComponentUText("##CText")->AddText(Type::Error, CMD + ": GetPhysDynamicObject() return NULL!!!");
 		}
-		else if (contains(CMD, "reinit_lua"))
+		else if (cmd->Key == ReinitLua)
 			CLua::Reinit();
 	}
 	//if (cmd->type == Command::TypeOfCommand::Lua)
@@ -138,7 +141,7 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 	//}
 	if (cmd->type == Command::TypeOfCommand::WithParam)
 	{
-		if (contains(CMD, "changesize"))
+		if (cmd->Key == ChangeSize)
 			Console->ChangeSize(cmd->One, cmd->Two);
 		//else if (contains(CMD, "addphysbox"))
 		//{
@@ -169,6 +172,24 @@ void Commands::ExecCommand(shared_ptr<dialogs> &Console, shared_ptr<Command> &cm
 
 shared_ptr<Commands::Command> Commands::FindPieceCommand(string Text)
 {
+	// Whole Name Of Command: Only IDs Are Compared
+	StringID Key = StringID::Find(Text.substr(0, Text.find(' ')));
+	for (size_t i = 0; i < commands.size() && !Key.IsEmpty(); i++)
+	{
+		if (commands.at(i)->Key != Key)
+			continue;
+
+		if (Text.find(' ') != string::npos)
+		{
+			string GetParam = Text;
+			deleteWord(GetParam, " ", ModeProcessString::UntilTheBegin, false, false);
+			if (!GetParam.empty())
+				commands.at(i)->CommandUnprocessed = GetParam;
+		}
+		return commands.at(i);
+	}
+
+	// Part Of Name (As It Was Before)
 	for (size_t i = 0; i < commands.size(); i++)
 	{
 		string GetCommand = Text, GetParam = Text, ThisCommand = commands.at(i)->CommandStr;
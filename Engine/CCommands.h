@@ -2,6 +2,7 @@
 #if !defined(__COMMANDS_H__)
 #define __COMMANDS_H__
 #include "pch.h"
+#include "StringID.h"
 
 class dialogs;
 class Commands
@@ -18,6 +19,8 @@ private:
 		string CommandStr = "", CommandParamsProcess = "", CommandUnprocessed = "",
 				S_One = "", S_Two = "", S_Three = "", TypedCmd = "";
 		const string CommandNeededParams = "";
+		// Interned Name Without Spaces (e.g. "changesize")
+		StringID Key;
 		int CountOfParams = 0;
 		float One = 0.f, Two = 0.f, Three = 0.f;
 		bool Checked = false;
@@ -26,7 +29,7 @@ private:
 
 		Command() {}
 		Command(string CommandStr, string CommandNeededParams, TypeOfCommand type): CommandStr(CommandStr),
-			CommandNeededParams(CommandNeededParams), type(type) {}
+			CommandNeededParams(CommandNeededParams), Key(trim_copy(CommandStr)), type(type) {}
 	};
 	vector<shared_ptr<Command>> commands;
 	vector<string> History;
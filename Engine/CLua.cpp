@@ -7,6 +7,7 @@ class Engine;
 extern shared_ptr<Engine> Application;
 #include "Engine.h"
 #include "File_system.h"
+#include "MappedFile.h"
 #include "Console.h"
 #include "Audio.h"
 #include "Camera.h"
@@ -54,9 +55,11 @@ void CLua::Init()
 	LuaState["Engine"].get_or_create<table>().new_usertype<Mouse>("Mouse", "IsLeft", &Engine::IsMouseLeft,
 		"IsRight", &Engine::IsMouseRight, "SetVisible", &ShowCursor);
 
-	const string package_path = LuaState["package"]["path"];
-	LuaState["package"]["path"] = package_path + (!package_path.empty() ? ";" : "")
-		+ Application->getFS()->getPathFromType(_TypeOfFile::SCRIPTS) + "?.lua";
+	// Scripts Of Mounted Folders (Patches And Mods) Are Found Before Scripts Of Resource Folder
+	string package_path = LuaState["package"]["path"];
+	for (auto &Folder: Application->getFS()->getSearchFolders(_TypeOfFile::SCRIPTS))
+		package_path += (!package_path.empty() ? ";" : "") + Folder + "?.lua";
+	LuaState["package"]["path"] = package_path;
 
 	auto Obj = Application->getFS()->GetFile("main.lua");
 	if (Obj && !Obj->PathA.empty())
@@ -72,6 +75,14 @@ void CLua::Reinit()
 	//Application->setCScene(make_shared<CutScene>(LuaState["CutScene_instance"]));
 }
 
+void CLua::ReloadScript(string FileName)
+{
+	if (File.empty()) return;
+
+	LuaState["package"]["loaded"][path(FileName).stem().string()] = sol::lua_nil;
+	callFunction(File, "initEverything", "");
+}
+
 void CLua::Update()
 {
 	try
@@ -101,7 +112,15 @@ void CLua::callFunction(string FileName, string Function, string params)
 			Console::LogError(string("Lua error: File: \"") + FileName + string("\" Doesn't Exist!"));
 			return;
 		}
-		LuaState.safe_script_file(FileName);
+		// Lua Reads Chunk Right From Mapped File (Loose Or In The Archive)
+		MappedFile Mapped(FileName, MappedFile::Sequential);
+		if (!Mapped.IsOpen())
+		{
+			Console::LogError(string("Lua error: File: \"") + FileName + string("\" Doesn't Exist!"));
+			return;
+		}
+		LuaState.safe_script(sol::string_view(reinterpret_cast<const char *>(Mapped.data()), Mapped.size()),
+			FileName);
 		LuaState.get<sol::function>(Function.c_str()).template call<void>(params);
 	}
 	catch (error e)
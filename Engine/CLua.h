@@ -14,6 +14,8 @@ public:
 	void Update();
 	static void callFunction(string FileName, string Function, string params);
 	static void Reinit();
+	// Forget Changed Script (Module) And Run "initEverything" Again
+	static void ReloadScript(string FileName);
 private:
 	static state LuaState;
 };
@@ -156,6 +156,7 @@ public:
 	bool CheckRectangle(float xCenter, float yCenter, float zCenter, float xSize, float ySize, float zSize);
 
 private:
-	Vector3 m_planes[6];
+	// A, B, C, D Of Planes (Vector3 Would Lose Their Distance)
+	Vector4 m_planes[6];
 };
 #endif // !__CAMERA_H__
@@ -0,0 +1,655 @@
+#include "ChunkedGzip.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <zlib.h>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+// gzip Header (RFC 1952)
+static const uint8_t FHCRC = 0x02, FEXTRA = 0x04, FNAME = 0x08, FCOMMENT = 0x10;
+// "DS" Subfield: Size Of The Member, Size Of Raw Data
+static const uint16_t ExtraSize = 4 + 8;
+
+static void Put16(uint8_t *P, uint16_t V) { P[0] = uint8_t(V); P[1] = uint8_t(V >> 8); }
+static void Put32(uint8_t *P, uint32_t V) { Put16(P, uint16_t(V)); Put16(P + 2, uint16_t(V >> 16)); }
+static uint16_t Get16(const uint8_t *P) { return uint16_t(P[0] | (P[1] << 8)); }
+static uint32_t Get32(const uint8_t *P) { return Get16(P) | (uint32_t(Get16(P + 2)) << 16); }
+
+static bool Deflate(const uint8_t *Src, uint32_t Size, int Level, const string &Name, vector<uint8_t> &Member)
+{
+	z_stream Z = {};
+	if (deflateInit2(&Z, Level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return false;
+
+	size_t Head = 12 + ExtraSize + (Name.empty() ? 0 : Name.size() + 1);
+	Member.resize(Head + deflateBound(&Z, Size) + 8);
+
+	uint8_t *P = Member.data();
+	P[0] = 0x1f; P[1] = 0x8b; P[2] = Z_DEFLATED;
+	P[3] = FEXTRA | (Name.empty() ? 0 : FNAME);
+	Put32(P + 4, 0);
+	P[8] = Level >= 9 ? 2 : (Level == 1 ? 4 : 0);
+	P[9] = 11; // NTFS
+	Put16(P + 10, ExtraSize);
+	P[12] = 'D'; P[13] = 'S';
+	Put16(P + 14, 8);
+	Put32(P + 20, Size);
+	if (!Name.empty())
+		memcpy(P + 12 + ExtraSize, Name.c_str(), Name.size() + 1);
+
+	Z.next_in = const_cast<Bytef *>(Src);
+	Z.avail_in = Size;
+	Z.next_out = P + Head;
+	Z.avail_out = uInt(Member.size() - Head - 8);
+	int Res = deflate(&Z, Z_FINISH);
+	size_t Packed = Z.total_out;
+	deflateEnd(&Z);
+	if (Res != Z_STREAM_END)
+		return false;
+
+	Member.resize(Head + Packed + 8);
+	Put32(&Member[Head + Packed], uint32_t(crc32(0L, Src, Size)));
+	Put32(&Member[Head + Packed + 4], Size);
+	Put32(&Member[16], uint32_t(Member.size()));
+
+	return true;
+}
+
+// Usual .gz (One Or Several Members) Can Only Be Read From Start To End
+static bool Gunzip(const uint8_t *Data, uint64_t Size, std::ofstream &Stream, uint64_t &Raw)
+{
+	z_stream Z = {};
+	if (inflateInit2(&Z, 16 + MAX_WBITS) != Z_OK)
+		return false;
+
+	vector<uint8_t> Buf(256 * 1024);
+	uint64_t Pos = 0;
+	int Res = Z_OK;
+	while (true)
+	{
+		if (Z.avail_in == 0 && Pos < Size)
+		{
+			Z.next_in = const_cast<Bytef *>(Data + Pos);
+			Z.avail_in = uInt(min<uint64_t>(Size - Pos, 1u << 30));
+			Pos += Z.avail_in;
+		}
+
+		Z.next_out = Buf.data();
+		Z.avail_out = uInt(Buf.size());
+		Res = inflate(&Z, Z_NO_FLUSH);
+		if (Res != Z_OK && Res != Z_STREAM_END)
+			break;
+
+		size_t Got = Buf.size() - Z.avail_out;
+		Stream.write(reinterpret_cast<const char *>(Buf.data()), Got);
+		Raw += Got;
+
+		if (Res == Z_STREAM_END)
+		{
+			if (Z.avail_in == 0 && Pos == Size)
+				break;
+			inflateReset(&Z);
+		}
+	}
+	inflateEnd(&Z);
+
+	return Res == Z_STREAM_END && Stream.good();
+}
+
+static void Add(ChunkedGzip::Stats &To, const ChunkedGzip::Stats &From)
+{
+	To.Files += From.Files;
+	To.Chunks += From.Chunks;
+	To.Failed += From.Failed;
+	To.Raw += From.Raw;
+	To.Packed += From.Packed;
+}
+
+static string Report(string What, const ChunkedGzip::Stats &Info)
+{
+	char Text[256] = {};
+	snprintf(Text, sizeof(Text), "%s: Files: %zu (Failed: %zu), Chunks: %zu, %.2f MiB -> %.2f MiB, %.2f Sec, %.2f MiB/s",
+		What.c_str(), Info.Files, Info.Failed, Info.Chunks, double(Info.Raw) / (1024. * 1024.),
+		double(Info.Packed) / (1024. * 1024.), Info.Seconds, Info.Throughput());
+	return Text;
+}
+
+namespace
+{
+	// Job Which Runs Once: In The Pool Or By The Caller Which Waits For It. The Caller Doesn't Block On
+	// Jobs Which Are Still In The Queue, So It Can Be a Worker Of The Same Pool (e.g. AssetIO) Without
+	// Taking Every Worker Away While They Wait
+	struct Task
+	{
+		function<void()> Work;
+		atomic<bool> Taken{ false };
+		promise<void> Done;
+		future<void> Finished = Done.get_future();
+
+		void Run()
+		{
+			if (Taken.exchange(true))
+				return;
+			Work();
+			Done.set_value();
+		}
+		void Wait()
+		{
+			Run();
+			Finished.wait();
+		}
+	};
+
+	void Submit(const ChunkedGzip::Runner &Run, shared_ptr<Task> It)
+	{
+		if (Run)
+			Run([It]() { It->Run(); });
+		else
+			It->Run();
+	}
+
+	// Jobs Of One Call (Pool Doesn't Wait For A Part Of Its Jobs)
+	class Jobs
+	{
+	public:
+		explicit Jobs(ChunkedGzip::Runner Run): Run(Run) {}
+		~Jobs() { Wait(); }
+
+		void Add(function<void()> Work)
+		{
+			auto It = make_shared<Task>();
+			It->Work = Work;
+			Waits.push_back(It);
+			Submit(Run, It);
+		}
+		void Wait()
+		{
+			for (auto &It: Waits)
+				It->Wait();
+			Waits.clear();
+		}
+	private:
+		ChunkedGzip::Runner Run;
+		vector<shared_ptr<Task>> Waits;
+	};
+
+	// Chunks Which Are Done Or In Work, Written In Order
+	struct Part: Task
+	{
+		vector<uint8_t> Data;
+		bool Ok = false;
+	};
+
+	size_t Window() { return max<size_t>(4, thread::hardware_concurrency() * 2); }
+}
+
+bool ChunkedGzip::Compress(fs::path In, fs::path Out, Runner Run, Stats &Info, int Level, uint32_t ChunkSize)
+{
+	auto Start = chrono::steady_clock::now();
+	if (ChunkSize == 0)
+		ChunkSize = DefaultChunk;
+
+	boost::system::error_code EC;
+	uint64_t Size = fs::file_size(In, EC);
+	if (EC)
+		return false;
+
+	boost::iostreams::mapped_file_source Src;
+	if (Size > 0)
+	{
+		try
+		{
+			Src.open(In.string());
+		}
+		catch (const std::exception &)
+		{
+			return false;
+		}
+	}
+	auto Data = Size > 0 ? reinterpret_cast<const uint8_t *>(Src.data()) : nullptr;
+
+	std::ofstream Stream(Out.string(), ios::binary | ios::trunc);
+	if (!Stream.is_open())
+		return false;
+
+	// Empty File Is Still One Member
+	string Name = In.filename().string();
+	size_t Count = Size > 0 ? size_t((Size + ChunkSize - 1) / ChunkSize) : 1, Next = 0;
+	deque<shared_ptr<Part>> Pending;
+	bool Ok = true;
+	while (Next < Count || !Pending.empty())
+	{
+		while (Ok && Next < Count && Pending.size() < Window())
+		{
+			auto It = make_shared<Part>();
+			auto From = Data ? Data + uint64_t(Next) * ChunkSize : nullptr;
+			auto Len = uint32_t(Size > 0 ? min<uint64_t>(ChunkSize, Size - uint64_t(Next) * ChunkSize) : 0);
+			// The Part Owns Its Work, So It Keeps Only a Pointer To Itself
+			auto Self = It.get();
+			It->Work = [Self, From, Len, Level, &Name, First = Next == 0]()
+			{
+				Self->Ok = Deflate(From, Len, Level, First ? Name : "", Self->Data);
+			};
+			Submit(Run, It);
+
+			Pending.push_back(It);
+			Next++;
+		}
+		if (Pending.empty())
+			break;
+
+		// Jobs Use Name And Mapped File, So Wait For Every One Of Them Even If Something Failed
+		auto It = Pending.front();
+		Pending.pop_front();
+		It->Wait();
+		if (!Ok || !It->Ok)
+		{
+			Ok = false;
+			continue;
+		}
+
+		Stream.write(reinterpret_cast<const char *>(It->Data.data()), It->Data.size());
+		Info.Packed += It->Data.size();
+		Info.Chunks++;
+	}
+
+	Ok = Ok && Stream.good();
+	Stream.close();
+	if (!Ok)
+	{
+		fs::remove(Out, EC);
+		return false;
+	}
+
+	Info.Files++;
+	Info.Raw += Size;
+	Info.Seconds += chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	return true;
+}
+
+bool ChunkedGzip::Decompress(fs::path In, fs::path Out, Runner Run, Stats &Info)
+{
+	auto Start = chrono::steady_clock::now();
+
+	boost::system::error_code EC;
+	uint64_t Size = fs::file_size(In, EC);
+	if (EC || Size == 0)
+		return false;
+
+	boost::iostreams::mapped_file_source Src;
+	try
+	{
+		Src.open(In.string());
+	}
+	catch (const std::exception &)
+	{
+		return false;
+	}
+	auto Data = reinterpret_cast<const uint8_t *>(Src.data());
+
+	std::ofstream Stream(Out.string(), ios::binary | ios::trunc);
+	if (!Stream.is_open())
+		return false;
+
+	vector<Chunk> Index;
+	string Name;
+	bool Ok = true;
+	uint64_t Raw = 0;
+	if (!ReadIndex(Data, size_t(Size), Index, Name))
+		Ok = Gunzip(Data, Size, Stream, Raw);
+	else
+	{
+		size_t Next = 0;
+		deque<shared_ptr<Part>> Pending;
+		while (Next < Index.size() || !Pending.empty())
+		{
+			while (Ok && Next < Index.size() && Pending.size() < Window())
+			{
+				auto It = make_shared<Part>();
+				const Chunk *From = &Index[Next];
+				auto Self = It.get();
+				It->Work = [Self, Data, From]()
+				{
+					Self->Data.resize(From->RawSize);
+					Self->Ok = Inflate(Data, *From, Self->Data.data());
+				};
+				Submit(Run, It);
+
+				Pending.push_back(It);
+				Next++;
+			}
+			if (Pending.empty())
+				break;
+
+			auto It = Pending.front();
+			Pending.pop_front();
+			It->Wait();
+			if (!Ok || !It->Ok)
+			{
+				Ok = false;
+				continue;
+			}
+
+			Stream.write(reinterpret_cast<const char *>(It->Data.data()), It->Data.size());
+			Raw += It->Data.size();
+			Info.Chunks++;
+		}
+	}
+
+	Ok = Ok && Stream.good();
+	Stream.close();
+	if (!Ok)
+	{
+		fs::remove(Out, EC);
+		return false;
+	}
+
+	Info.Files++;
+	Info.Raw += Raw;
+	Info.Packed += Size;
+	Info.Seconds += chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	return true;
+}
+
+bool ChunkedGzip::CompressFolder(fs::path Folder, fs::path Out, Runner Run, Stats &Info,
+	function<void(string)> Log)
+{
+	if (!Log)
+		Log = [](string) {};
+
+	auto Start = chrono::steady_clock::now();
+	boost::system::error_code EC;
+	if (!fs::is_directory(Folder, EC))
+	{
+		Log("Folder " + Folder.string() + " Doesn't Exist");
+		return false;
+	}
+
+	vector<pair<fs::path, fs::path>> Small, Big;
+	for (fs::recursive_directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (!fs::is_regular_file(It->status()))
+			continue;
+
+		boost::system::error_code SizeEC;
+		fs::path Target = Out / fs::relative(It->path(), Folder, SizeEC);
+		Target += ".gz";
+		fs::create_directories(Target.parent_path(), SizeEC);
+
+		auto Size = fs::file_size(It->path(), SizeEC);
+		(Size <= DefaultChunk ? Small : Big).push_back(make_pair(It->path(), Target));
+	}
+
+	// Small File Is One Job, Big One Is Cut Into Chunks Which Are Jobs
+	Stats Total;
+	mutex Lock;
+	{
+		Jobs Work(Run);
+		for (auto &It: Small)
+			Work.Add([&, It]()
+			{
+				Stats One;
+				bool Ok = Compress(It.first, It.second, nullptr, One);
+				lock_guard<mutex> Guard(Lock);
+				Add(Total, One);
+				if (!Ok)
+				{
+					Total.Failed++;
+					Log("Cannot Compress " + It.first.string());
+				}
+			});
+	}
+	for (auto &It: Big)
+	{
+		Stats One;
+		if (!Compress(It.first, It.second, Run, One))
+		{
+			One.Failed++;
+			Log("Cannot Compress " + It.first.string());
+		}
+		Add(Total, One);
+	}
+
+	Total.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Log(Report("Compressed", Total));
+
+	Add(Info, Total);
+	Info.Seconds += Total.Seconds;
+	return Total.Failed == 0;
+}
+
+bool ChunkedGzip::DecompressFolder(fs::path Folder, fs::path Out, Runner Run, Stats &Info,
+	function<void(string)> Log)
+{
+	if (!Log)
+		Log = [](string) {};
+
+	auto Start = chrono::steady_clock::now();
+	boost::system::error_code EC;
+	if (!fs::is_directory(Folder, EC))
+	{
+		Log("Folder " + Folder.string() + " Doesn't Exist");
+		return false;
+	}
+
+	vector<pair<fs::path, fs::path>> Small, Big;
+	for (fs::recursive_directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (!fs::is_regular_file(It->status()) || It->path().extension() != ".gz")
+			continue;
+
+		boost::system::error_code SizeEC;
+		fs::path Target = Out / fs::relative(It->path(), Folder, SizeEC);
+		Target.replace_extension();
+		fs::create_directories(Target.parent_path(), SizeEC);
+
+		// Only Chunked Files Can Be Decompressed In Parallel
+		auto Size = fs::file_size(It->path(), SizeEC);
+		(Size <= DefaultChunk || !IsChunked(It->path()) ? Small : Big).push_back(make_pair(It->path(), Target));
+	}
+
+	Stats Total;
+	mutex Lock;
+	{
+		Jobs Work(Run);
+		for (auto &It: Small)
+			Work.Add([&, It]()
+			{
+				Stats One;
+				bool Ok = Decompress(It.first, It.second, nullptr, One);
+				lock_guard<mutex> Guard(Lock);
+				Add(Total, One);
+				if (!Ok)
+				{
+					Total.Failed++;
+					Log("Cannot Decompress " + It.first.string());
+				}
+			});
+	}
+	for (auto &It: Big)
+	{
+		Stats One;
+		if (!Decompress(It.first, It.second, Run, One))
+		{
+			One.Failed++;
+			Log("Cannot Decompress " + It.first.string());
+		}
+		Add(Total, One);
+	}
+
+	Total.Seconds = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	Log(Report("Decompressed", Total));
+
+	Add(Info, Total);
+	Info.Seconds += Total.Seconds;
+	return Total.Failed == 0;
+}
+
+bool ChunkedGzip::IsChunked(fs::path File)
+{
+	std::ifstream Stream(File.string(), ios::binary);
+	uint8_t Head[12 + ExtraSize] = {};
+	if (!Stream.read(reinterpret_cast<char *>(Head), sizeof(Head)))
+		return false;
+
+	return Head[0] == 0x1f && Head[1] == 0x8b && (Head[3] & FEXTRA) && Get16(Head + 10) >= ExtraSize &&
+		Head[12] == 'D' && Head[13] == 'S';
+}
+
+bool ChunkedGzip::Open(fs::path File)
+{
+	Close();
+
+	boost::system::error_code EC;
+	if (!fs::exists(File, EC) || fs::file_size(File, EC) == 0)
+		return false;
+
+	try
+	{
+		Map.open(File.string());
+	}
+	catch (const std::exception &)
+	{
+		return false;
+	}
+
+	if (!Map.is_open() || !ReadIndex(reinterpret_cast<const uint8_t *>(Map.data()), Map.size(), Chunks, FileName))
+	{
+		Close();
+		return false;
+	}
+
+	RawSize = Chunks.back().RawOffset + Chunks.back().RawSize;
+	Opened = true;
+	return true;
+}
+
+void ChunkedGzip::Close()
+{
+	Chunks.clear();
+	RawSize = 0;
+	FileName.clear();
+	Opened = false;
+	Cached = SIZE_MAX;
+	Cache.clear();
+
+	if (Map.is_open())
+		Map.close();
+}
+
+size_t ChunkedGzip::Read(uint64_t Offset, void *Data, size_t Size)
+{
+	if (!Opened || Offset >= RawSize)
+		return 0;
+
+	Size = size_t(min<uint64_t>(Size, RawSize - Offset));
+	auto It = upper_bound(Chunks.begin(), Chunks.end(), Offset,
+		[](uint64_t Value, const Chunk &C) { return Value < C.RawOffset; }) - 1;
+
+	size_t Done = 0;
+	auto Out = reinterpret_cast<uint8_t *>(Data);
+	for (; Done < Size && It != Chunks.end(); ++It)
+	{
+		size_t Index = size_t(It - Chunks.begin());
+		if (Cached != Index)
+		{
+			Cache.resize(It->RawSize);
+			Cached = SIZE_MAX;
+			if (!Inflate(reinterpret_cast<const uint8_t *>(Map.data()), *It, Cache.data()))
+				break;
+			Cached = Index;
+		}
+
+		size_t From = size_t(Offset + Done - It->RawOffset), Len = min<size_t>(Size - Done, It->RawSize - From);
+		memcpy(Out + Done, Cache.data() + From, Len);
+		Done += Len;
+	}
+
+	return Done;
+}
+
+bool ChunkedGzip::ReadIndex(const uint8_t *Data, size_t Size, vector<Chunk> &Chunks, string &Name)
+{
+	Chunks.clear();
+	uint64_t Raw = 0;
+	for (size_t Pos = 0; Pos < Size;)
+	{
+		auto P = Data + Pos;
+		if (Size - Pos < 12 + ExtraSize + 8 || P[0] != 0x1f || P[1] != 0x8b || P[2] != Z_DEFLATED ||
+			!(P[3] & FEXTRA))
+			return false;
+
+		size_t Head = 12 + Get16(P + 10);
+		if (Head > Size - Pos)
+			return false;
+
+		uint32_t Member = 0, Len = 0;
+		for (size_t X = 12; X + 4 <= Head;)
+		{
+			uint16_t Sub = Get16(P + X + 2);
+			if (P[X] == 'D' && P[X + 1] == 'S' && Sub == 8 && X + 4 + 8 <= Head)
+			{
+				Member = Get32(P + X + 4);
+				Len = Get32(P + X + 8);
+			}
+			X += 4 + Sub;
+		}
+		if (Member < Head + 8 || Member > Size - Pos)
+			return false;
+
+		for (uint8_t Flag: { FNAME, FCOMMENT })
+			if (P[3] & Flag)
+			{
+				auto End = reinterpret_cast<const uint8_t *>(memchr(P + Head, 0, Member - Head));
+				if (!End)
+					return false;
+				if (Flag == FNAME && Pos == 0)
+					Name.assign(reinterpret_cast<const char *>(P + Head), End - (P + Head));
+				Head = size_t(End - P) + 1;
+			}
+		if (P[3] & FHCRC)
+			Head += 2;
+		if (Head + 8 > Member || Get32(P + Member - 4) != Len)
+			return false;
+
+		Chunk It = {};
+		It.Offset = Pos + Head;
+		It.Size = uint32_t(Member - Head - 8);
+		It.RawOffset = Raw;
+		It.RawSize = Len;
+		It.Crc = Get32(P + Member - 8);
+		Chunks.push_back(It);
+
+		Raw += Len;
+		Pos += Member;
+	}
+
+	return !Chunks.empty();
+}
+
+bool ChunkedGzip::Inflate(const uint8_t *Data, const Chunk &It, uint8_t *Out)
+{
+	z_stream Z = {};
+	if (inflateInit2(&Z, -MAX_WBITS) != Z_OK)
+		return false;
+
+	uint8_t Dummy = 0;
+	Z.next_in = const_cast<Bytef *>(Data + It.Offset);
+	Z.avail_in = It.Size;
+	Z.next_out = It.RawSize ? Out : &Dummy;
+	Z.avail_out = It.RawSize;
+	int Res = inflate(&Z, Z_FINISH);
+	uLong Got = Z.total_out;
+	inflateEnd(&Z);
+
+	return Res == Z_STREAM_END && Got == It.RawSize && crc32(0L, Out, It.RawSize) == It.Crc;
+}
@@ -0,0 +1,162 @@
+/**
+ * \file	ChunkedGzip.h.
+ *
+ * \brief	Declares parallel chunked gzip compressor, decompressor and random access reader
+ */
+
+#pragma once
+#if !defined(__CHUNKEDGZIP_H__)
+#define __CHUNKEDGZIP_H__
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+#include <Boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+/**
+ * \class	ChunkedGzip
+ *
+ * \brief	The file is cut into chunks and every chunk is compressed as its own gzip member,
+ * 			so chunks are compressed (and decompressed) in parallel and the result is still
+ * 			a usual .gz for any gzip tool. The header of each member has "DS" extra field
+ * 			with size of the member and of its raw data: it's the index, so Open() finds
+ * 			any offset of the raw file without decompressing anything.
+ * 			Used by the engine (File_system) and by tools, so it doesn't need pch.h.
+ */
+
+class ChunkedGzip
+{
+public:
+	// Runs the job somewhere (e.g. In Engine Thread Pool), nullptr Runs Everything Right Here
+	using Runner = std::function<void(std::function<void()>)>;
+
+	struct Stats
+	{
+		size_t Files = 0, Chunks = 0, Failed = 0;
+		uint64_t Raw = 0, Packed = 0;
+		double Seconds = 0.;
+
+		// MiB Of Raw Data Per Second (Both Ways)
+		double Throughput() const { return Seconds > 0. ? double(Raw) / (1024. * 1024.) / Seconds : 0.; }
+	};
+
+	static const uint32_t DefaultChunk = 1024 * 1024;
+
+	ChunkedGzip() {}
+	~ChunkedGzip() { Close(); }
+
+	/**
+	 * \fn	static bool ChunkedGzip::Compress(boost::filesystem::path In, boost::filesystem::path Out,
+	 * 		Runner Run, Stats &Info, int Level = 9, uint32_t ChunkSize = DefaultChunk);
+	 *
+	 * \brief	Compress file (Chunks Are Written In Order, Only Some Of Them Are In Memory)
+	 *
+	 * \param 		  	In		 	The file.
+	 * \param 		  	Out		 	The .gz file.
+	 * \param 		  	Run		 	Where to run jobs.
+	 * \param [in,out]	Info	 	Statistic (It's Added).
+	 * \param 		  	Level	 	(Optional) zlib level.
+	 * \param 		  	ChunkSize	(Optional) Size of raw data of each chunk.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Compress(boost::filesystem::path In, boost::filesystem::path Out, Runner Run, Stats &Info,
+		int Level = 9, uint32_t ChunkSize = DefaultChunk);
+
+	/**
+	 * \fn	static bool ChunkedGzip::Decompress(boost::filesystem::path In, boost::filesystem::path Out,
+	 * 		Runner Run, Stats &Info);
+	 *
+	 * \brief	Decompress file made by Compress() in parallel (Usual .gz Is Decompressed Right Here)
+	 *
+	 * \param 		  	In  	The .gz file.
+	 * \param 		  	Out 	The file.
+	 * \param 		  	Run 	Where to run jobs.
+	 * \param [in,out]	Info	Statistic (It's Added).
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Decompress(boost::filesystem::path In, boost::filesystem::path Out, Runner Run, Stats &Info);
+
+	/**
+	 * \fn	static bool ChunkedGzip::CompressFolder(boost::filesystem::path Folder, boost::filesystem::path Out,
+	 * 		Runner Run, Stats &Info, std::function<void(std::string)> Log);
+	 *
+	 * \brief	Compress every file of the folder into the same tree in Out (With .gz)
+	 * 			Small files are compressed each by its own job, big ones are cut into chunks.
+	 *
+	 * \param 		  	Folder	The folder.
+	 * \param 		  	Out   	Output folder.
+	 * \param 		  	Run   	Where to run jobs.
+	 * \param [in,out]	Info  	Statistic (It's Added).
+	 * \param 		  	Log   	Get error text and throughput.
+	 *
+	 * \returns	True if every file is compressed.
+	 */
+
+	static bool CompressFolder(boost::filesystem::path Folder, boost::filesystem::path Out, Runner Run,
+		Stats &Info, std::function<void(std::string)> Log);
+	static bool DecompressFolder(boost::filesystem::path Folder, boost::filesystem::path Out, Runner Run,
+		Stats &Info, std::function<void(std::string)> Log);
+
+	// Has The File The Index (Or It's Usual .gz)
+	static bool IsChunked(boost::filesystem::path File);
+
+	/**
+	 * \fn	bool ChunkedGzip::Open(boost::filesystem::path File);
+	 *
+	 * \brief	Map file and read its index for Read()
+	 *
+	 * \param 	File	The .gz file.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	bool Open(boost::filesystem::path File);
+	void Close();
+	bool IsOpen() const { return Opened; }
+
+	// Size Of Raw File
+	uint64_t size() const { return RawSize; }
+	// Original File Name (From The Header)
+	std::string GetFileName() const { return FileName; }
+
+	/**
+	 * \fn	size_t ChunkedGzip::Read(uint64_t Offset, void *Data, size_t Size);
+	 *
+	 * \brief	Read raw data at any offset (Only Needed Chunks Are Decompressed,
+	 * 			The Last One Is Cached, So Don't Share One Reader Between Threads)
+	 *
+	 * \param 	Offset	Offset in the raw file.
+	 * \param 	Data  	Where to copy.
+	 * \param 	Size  	How much to read.
+	 *
+	 * \returns	Count of read bytes.
+	 */
+
+	size_t Read(uint64_t Offset, void *Data, size_t Size);
+private:
+	struct Chunk
+	{
+		uint64_t Offset, RawOffset; // Of Deflate Data And In Raw File
+		uint32_t Size, RawSize, Crc;
+	};
+
+	static bool ReadIndex(const uint8_t *Data, size_t Size, std::vector<Chunk> &Chunks, std::string &Name);
+	static bool Inflate(const uint8_t *Data, const Chunk &It, uint8_t *Out);
+
+	boost::iostreams::mapped_file_source Map;
+	std::vector<Chunk> Chunks;
+	uint64_t RawSize = 0;
+	std::string FileName;
+	bool Opened = false;
+
+	size_t Cached = SIZE_MAX;
+	std::vector<uint8_t> Cache;
+};
+#endif // !__CHUNKEDGZIP_H__
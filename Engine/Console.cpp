@@ -27,6 +27,7 @@ HRESULT Console::Init()
 
 	ChangeState(Dialog->getVisible() ? Console_STATE::Open : Console_STATE::Close);
 
+	File_system::FlushLog();
 	auto Log = Application->getFS()->getDataFromFileVector(Application->getFS()->getLogFName().string(), true);
 
 	for (size_t i = 0; i < Log.size(); i++)
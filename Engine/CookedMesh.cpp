@@ -0,0 +1,276 @@
+#include "CookedMesh.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+using namespace std;
+
+const uint32_t CookedMesh::ImportFlags = aiProcess_Triangulate | aiProcess_ConvertToLeftHanded
+	| aiProcess_OptimizeMeshes | aiProcess_SortByPType | aiProcess_FindInvalidData
+	| aiProcess_GenUVCoords | aiProcess_TransformUVCoords | aiProcess_OptimizeGraph;
+const char *CookedMesh::Ext = ".mesh";
+
+uint64_t CookedMesh::Hash(string_view Data, uint64_t Seed)
+{
+	uint64_t Result = Seed;
+	for (unsigned char C : Data)
+	{
+		Result ^= C;
+		Result *= 1099511628211ull;
+	}
+	return Result;
+}
+
+void CookedMesh::AddPart(vector<Vertex> PartVertices, vector<uint32_t> PartIndices, vector<string> PartTextures,
+	vector<Lod> PartLods)
+{
+	Part New = {};
+	New.FirstVertex = (uint32_t)Vertices.size();
+	New.VertexCount = (uint32_t)PartVertices.size();
+	New.FirstIndex = (uint32_t)Indices.size();
+	New.IndexCount = (uint32_t)PartIndices.size();
+
+	if (PartLods.empty())
+		PartLods.push_back({ 0, New.IndexCount, 0.f });
+	New.FirstLod = (uint32_t)Lods.size();
+	New.LodCount = (uint32_t)PartLods.size();
+	Lods.insert(Lods.end(), PartLods.begin(), PartLods.end());
+
+	for (int i = 0; i < 3; i++)
+	{
+		New.Min[i] = PartVertices.empty() ? 0.f : PartVertices.front().Pos[i];
+		New.Max[i] = New.Min[i];
+	}
+	for (auto &It: PartVertices)
+		for (int i = 0; i < 3; i++)
+		{
+			New.Min[i] = min(New.Min[i], It.Pos[i]);
+			New.Max[i] = max(New.Max[i], It.Pos[i]);
+		}
+
+	for (int i = 0; i < 3; i++)
+	{
+		Min[i] = Parts.empty() ? New.Min[i] : min(Min[i], New.Min[i]);
+		Max[i] = Parts.empty() ? New.Max[i] : max(Max[i], New.Max[i]);
+	}
+
+	Parts.push_back(New);
+	Vertices.insert(Vertices.end(), PartVertices.begin(), PartVertices.end());
+	Indices.insert(Indices.end(), PartIndices.begin(), PartIndices.end());
+	Textures.push_back(PartTextures);
+}
+
+void CookedMesh::AddNode(const aiNode *Node, const aiScene *Scene)
+{
+	for (unsigned i = 0; i < Node->mNumMeshes; i++)
+	{
+		auto Src = Scene->mMeshes[Node->mMeshes[i]];
+
+		vector<Vertex> PartVertices(Src->mNumVertices);
+		for (unsigned j = 0; j < Src->mNumVertices; j++)
+		{
+			auto &V = PartVertices.at(j);
+			V.Pos[0] = Src->mVertices[j].x;
+			V.Pos[1] = Src->mVertices[j].y;
+			V.Pos[2] = Src->mVertices[j].z;
+			V.Tex[0] = Src->mTextureCoords[0] ? Src->mTextureCoords[0][j].x : 0.f;
+			V.Tex[1] = Src->mTextureCoords[0] ? Src->mTextureCoords[0][j].y : 0.f;
+		}
+
+		vector<uint32_t> PartIndices;
+		PartIndices.reserve(Src->mNumFaces * 3);
+		for (unsigned j = 0; j < Src->mNumFaces; j++)
+			for (unsigned k = 0; k < Src->mFaces[j].mNumIndices; k++)
+				PartIndices.push_back(Src->mFaces[j].mIndices[k]);
+
+		vector<string> PartTextures;
+		if (Src->mMaterialIndex < Scene->mNumMaterials)
+		{
+			auto Material = Scene->mMaterials[Src->mMaterialIndex];
+			for (unsigned j = 0; j < Material->GetTextureCount(aiTextureType_DIFFUSE); j++)
+			{
+				aiString Str;
+				Material->GetTexture(aiTextureType_DIFFUSE, j, &Str);
+				PartTextures.push_back(Str.C_Str());
+			}
+		}
+
+		auto Stats = MeshOptimizer::Optimize(PartVertices, PartIndices);
+		Before += Stats.Before;
+		After += Stats.After;
+
+		// Big Meshes Are Split, So Every Part Can Have 16-Bit Indices
+		for (auto &Chunk: MeshQuantizer::Split(move(PartVertices), move(PartIndices)))
+		{
+			vector<Lod> PartLods;
+			for (auto &It: MeshSimplifier::BuildLods(Chunk.Vertices, Chunk.Indices))
+				PartLods.push_back({ (uint32_t)It.FirstIndex, (uint32_t)It.IndexCount, It.Error });
+
+			AddPart(move(Chunk.Vertices), move(Chunk.Indices), PartTextures, move(PartLods));
+		}
+	}
+
+	for (unsigned i = 0; i < Node->mNumChildren; i++)
+		AddNode(Node->mChildren[i], Scene);
+}
+
+bool CookedMesh::Save(const string &File) const
+{
+	string Strings;
+	vector<Part> Records = Parts;
+	for (size_t i = 0; i < Records.size(); i++)
+	{
+		string List;
+		for (auto &Name: Textures.at(i))
+			List += (List.empty() ? "" : "\n") + Name;
+
+		Records.at(i).Textures = (uint32_t)Strings.size();
+		Records.at(i).TexturesLen = (uint32_t)List.size();
+		Strings += List;
+	}
+
+	Header Head = {};
+	memcpy(Head.Magic, "DSCM", 4);
+	Head.Version = Version;
+	Head.Source = Source;
+	Head.Flags = Flags;
+	Head.Parts = (uint32_t)Records.size();
+	Head.Vertices = (uint32_t)Vertices.size();
+	Head.Indices = (uint32_t)Indices.size();
+	Head.Strings = (uint32_t)Strings.size();
+	Head.Lods = (uint32_t)Lods.size();
+	memcpy(Head.Min, Min, sizeof(Min));
+	memcpy(Head.Max, Max, sizeof(Max));
+
+	string Temp = File + ".tmp";
+	{
+		ofstream Out(Temp, ios::binary | ios::trunc);
+		if (!Out.is_open())
+			return false;
+
+		Out.write(reinterpret_cast<const char *>(&Head), sizeof(Head));
+		Out.write(reinterpret_cast<const char *>(Records.data()), Records.size() * sizeof(Part));
+		Out.write(reinterpret_cast<const char *>(Lods.data()), Lods.size() * sizeof(Lod));
+		Out.write(reinterpret_cast<const char *>(Vertices.data()), Vertices.size() * sizeof(Vertex));
+		Out.write(reinterpret_cast<const char *>(Indices.data()), Indices.size() * sizeof(uint32_t));
+		Out.write(Strings.data(), Strings.size());
+		if (!Out.good())
+		{
+			Out.close();
+			remove(Temp.c_str());
+			return false;
+		}
+	}
+
+	remove(File.c_str());
+	if (rename(Temp.c_str(), File.c_str()) != 0)
+	{
+		remove(Temp.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+bool CookedMesh::Parse(string_view Data, View &Out)
+{
+	auto &Head = Out.Head;
+	if (Data.size() < sizeof(Head))
+		return false;
+	memcpy(&Head, Data.data(), sizeof(Head));
+
+	uint64_t Need = (uint64_t)sizeof(Header) + (uint64_t)Head.Parts * sizeof(Part) +
+		(uint64_t)Head.Lods * sizeof(Lod) + (uint64_t)Head.Vertices * sizeof(Vertex) + (uint64_t)Head.Indices * sizeof(uint32_t) + Head.Strings;
+	if (memcmp(Head.Magic, "DSCM", 4) != 0 || Head.Version != Version || Need != Data.size())
+		return false;
+
+	// Every Record Has Size Which Is a Multiple Of 4, So Blobs Are Aligned In Mapped File
+	const char *Pos = Data.data() + sizeof(Header);
+	Out.Parts = reinterpret_cast<const Part *>(Pos);
+	Pos += Head.Parts * sizeof(Part);
+	Out.Lods = reinterpret_cast<const Lod *>(Pos);
+	Pos += Head.Lods * sizeof(Lod);
+	Out.Vertices = reinterpret_cast<const Vertex *>(Pos);
+	Pos += Head.Vertices * sizeof(Vertex);
+	Out.Indices = reinterpret_cast<const uint32_t *>(Pos);
+	Pos += Head.Indices * sizeof(uint32_t);
+	Out.Strings = string_view(Pos, Head.Strings);
+
+	for (uint32_t i = 0; i < Head.Parts; i++)
+	{
+		auto &It = Out.Parts[i];
+		if ((uint64_t)It.FirstVertex + It.VertexCount > Head.Vertices ||
+			(uint64_t)It.FirstIndex + It.IndexCount > Head.Indices ||
+			(uint64_t)It.Textures + It.TexturesLen > Head.Strings ||
+			(uint64_t)It.FirstLod + It.LodCount > Head.Lods)
+			return false;
+
+		for (uint32_t j = It.FirstLod; j < It.FirstLod + It.LodCount; j++)
+			if ((uint64_t)Out.Lods[j].FirstIndex + Out.Lods[j].IndexCount > It.IndexCount)
+				return false;
+
+		for (uint32_t j = It.FirstIndex; j < It.FirstIndex + It.IndexCount; j++)
+			if (Out.Indices[j] >= It.VertexCount)
+				return false;
+	}
+
+	return true;
+}
+
+vector<string> CookedMesh::View::getTextures(size_t Index) const
+{
+	vector<string> Result;
+	string_view List = Strings.substr(Parts[Index].Textures, Parts[Index].TexturesLen);
+	while (!List.empty())
+	{
+		size_t End = min(List.find('\n'), List.size());
+		Result.push_back(string(List.substr(0, End)));
+		List.remove_prefix(min(End + 1, List.size()));
+	}
+	return Result;
+}
+
+bool CookedMesh::Load(string_view Data)
+{
+	View Parsed;
+	if (!Parse(Data, Parsed))
+		return false;
+
+	auto &Head = Parsed.Head;
+	Parts.assign(Parsed.Parts, Parsed.Parts + Head.Parts);
+	Lods.assign(Parsed.Lods, Parsed.Lods + Head.Lods);
+	Vertices.assign(Parsed.Vertices, Parsed.Vertices + Head.Vertices);
+	Indices.assign(Parsed.Indices, Parsed.Indices + Head.Indices);
+	Textures.clear();
+	for (size_t i = 0; i < Parts.size(); i++)
+		Textures.push_back(Parsed.getTextures(i));
+
+	Source = Head.Source;
+	Flags = Head.Flags;
+	memcpy(Min, Head.Min, sizeof(Min));
+	memcpy(Max, Head.Max, sizeof(Max));
+	return true;
+}
+
+uint64_t CookedMesh::SourceHash(const string &File, string_view Data, ModelDeps::Reader Read)
+{
+	string Salt = to_string(Version) + "/" + to_string(ImportFlags);
+	uint64_t Result = Hash(Data, Hash(Salt));
+
+	// Material Libraries Of .obj Give Names Of Textures
+	ModelDeps::Result Deps;
+	ModelDeps::Scan(File, Data, Deps, [&Result, &Read](const string &Name, string &Text)
+	{
+		if (!(Read ? Read(Name, Text) : ModelDeps::ReadFile(Name, Text)))
+			return false;
+		Result = Hash(Text, Result);
+		return true;
+	});
+
+	return Result;
+}
@@ -0,0 +1,185 @@
+/**
+ * \file	CookedMesh.h.
+ *
+ * \brief	Declares the cooked mesh (Model Which Was Imported Offline)
+ */
+
+#pragma once
+#if !defined(__COOKEDMESH_H__)
+#define __COOKEDMESH_H__
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include "ModelDeps.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "MeshQuantizer.h"
+
+struct aiNode;
+struct aiScene;
+
+/**
+ * \class	CookedMesh
+ *
+ * \brief	Model as Models::processNode makes it (Vertices, Indices, Levels Of Detail And Diffuse
+ * 			Textures Of Every Mesh), so loading it is reading blobs instead of running Assimp.
+ * 			It's written by Tools/Cook next to the model ("models/box/box.obj.mesh") or by the
+ * 			engine when it imports the model first time (Cache Folder, Name Is The Source Hash).
+ * 			File: Header, Part[Parts], Lod[Lods], Vertex[Vertices], uint32_t[Indices], Strings.
+ * 			Used by the engine and by tools, so it doesn't need pch.h.
+ */
+
+class CookedMesh
+{
+public:
+#pragma pack(push, 1)
+	struct Header
+	{
+		char Magic[4];
+		uint32_t Version;
+		// Hash Of The Source (With Its Material Libraries) And Import Flags Which Made It
+		uint64_t Source;
+		uint32_t Flags;
+		uint32_t Parts, Vertices, Indices, Strings, Lods;
+		float Min[3], Max[3];
+	};
+	// The Same Layout As Things (Models.h)
+	struct Vertex
+	{
+		float Pos[3];
+		float Tex[2];
+	};
+	struct Part
+	{
+		uint32_t FirstVertex, VertexCount;
+		// Indices Are Relative To FirstVertex (Every Level Of Detail)
+		uint32_t FirstIndex, IndexCount;
+		// Diffuse Textures (Names Separated By '\n')
+		uint32_t Textures, TexturesLen;
+		float Min[3], Max[3];
+		uint32_t FirstLod, LodCount;
+	};
+	// Level Of Detail Of The Part: Its Indices Use The Same Vertices (The First Level Is The Full Mesh)
+	struct Lod
+	{
+		// Relative To FirstIndex Of The Part
+		uint32_t FirstIndex, IndexCount;
+		// Distance Which Is Lost (In Units Of The Model)
+		float Error;
+	};
+#pragma pack(pop)
+
+	uint64_t Source = 0;
+	uint32_t Flags = 0;
+	std::vector<Part> Parts;
+	std::vector<Vertex> Vertices;
+	std::vector<uint32_t> Indices;
+	std::vector<Lod> Lods;
+	// Diffuse Textures Of Every Part
+	std::vector<std::vector<std::string>> Textures;
+	float Min[3] = {}, Max[3] = {};
+	// Post-Transform Cache Of Meshes Which AddNode Added (Before And After MeshOptimizer), Isn't Saved
+	MeshOptimizer::CacheStats Before, After;
+
+	// Checked File Which Isn't Copied: Pointers Are Into Its Data (e.g. Mapped File)
+	struct View
+	{
+		Header Head = {};
+		const Part *Parts = nullptr;
+		const Lod *Lods = nullptr;
+		const Vertex *Vertices = nullptr;
+		const uint32_t *Indices = nullptr;
+		std::string_view Strings;
+
+		std::vector<std::string> getTextures(size_t Index) const;
+	};
+
+	/**
+	 * \fn	void CookedMesh::AddPart(std::vector<Vertex> PartVertices, std::vector<uint32_t> PartIndices,
+	 * 		std::vector<std::string> PartTextures, std::vector<Lod> PartLods = {});
+	 *
+	 * \brief	Add mesh (Its Bounds And Bounds Of The Whole Model Are Computed)
+	 *
+	 * \param 	PartVertices	Vertices of the mesh.
+	 * \param 	PartIndices 	Indices of every level.
+	 * \param 	PartTextures	Diffuse textures.
+	 * \param 	PartLods		(Optional) Levels of detail (One Level Of Every Index If It's Empty).
+	 */
+
+	void AddPart(std::vector<Vertex> PartVertices, std::vector<uint32_t> PartIndices,
+		std::vector<std::string> PartTextures, std::vector<Lod> PartLods = {});
+
+	/**
+	 * \fn	void CookedMesh::AddNode(const aiNode *Node, const aiScene *Scene);
+	 *
+	 * \brief	Add meshes of the node and its children as Models::processNode makes them
+	 * 			(Embedded Textures Aren't Kept: Such Scene Isn't Cooked), their triangles and
+	 * 			vertices are reordered by MeshOptimizer, meshes with more than 65535 vertices are split
+	 * 			by MeshQuantizer and levels of detail are made by MeshSimplifier
+	 */
+
+	void AddNode(const aiNode *Node, const aiScene *Scene);
+
+	/**
+	 * \fn	bool CookedMesh::Save(const std::string &File) const;
+	 *
+	 * \brief	Write into temp file and then rename it (A Reader Never Sees Half Of The File)
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	bool Save(const std::string &File) const;
+
+	/**
+	 * \fn	bool CookedMesh::Load(std::string_view Data);
+	 *
+	 * \brief	Check and read whole file
+	 *
+	 * \param 	Data	Content of the file (e.g. Mapped File).
+	 *
+	 * \returns	False if it's broken or was made by other version.
+	 */
+
+	bool Load(std::string_view Data);
+
+	/**
+	 * \fn	static bool CookedMesh::Parse(std::string_view Data, View &Out);
+	 *
+	 * \brief	Check the file as Load() does, but only point to its parts
+	 *
+	 * \param 		  	Data	Content of the file (It Must Live While The View Is Used).
+	 * \param [in,out]	Out 	The view.
+	 *
+	 * \returns	False if it's broken or was made by other version.
+	 */
+
+	static bool Parse(std::string_view Data, View &Out);
+
+	/**
+	 * \fn	static uint64_t CookedMesh::SourceHash(const std::string &File, std::string_view Data,
+	 * 		ModelDeps::Reader Read = nullptr);
+	 *
+	 * \brief	Hash of the model with its material libraries (.mtl), the version and import flags.
+	 * 			Cooked mesh with other Header::Source was made from other source or by other code.
+	 *
+	 * \param 	File	The model.
+	 * \param 	Data	Content of the model.
+	 * \param 	Read	(Optional) How material libraries are read (Disk If It's Empty).
+	 *
+	 * \returns	The hash.
+	 */
+
+	static uint64_t SourceHash(const std::string &File, std::string_view Data, ModelDeps::Reader Read = nullptr);
+
+	// FNV-1a (64-Bit)
+	static uint64_t Hash(std::string_view Data, uint64_t Seed = 14695981039346656037ull);
+
+	static const uint32_t Version = 6;
+	// Post-Processing Of Assimp Which Models And The Cooker Use
+	static const uint32_t ImportFlags;
+	// Added To The Name Of The Model
+	static const char *Ext;
+};
+#endif // !__COOKEDMESH_H__
@@ -28,7 +28,7 @@ HRESULT Dialogs::LoadFile(string *FileName)
 		throw exception(string(string("Dialogs->LoadFile()::doc->LoadFile:\n") + string(doc->ErrorStr())).c_str());
 		return E_FAIL;
 	}
-	if (doc->Parse(Application->getFS()->getDataFromFile(FileName, false).c_str()) > 0)
+	if (doc->Parse(Application->getFS()->getDataFromFile(Application->getFS()->GetFile(*FileName)->PathA).c_str()) > 0)
 	{
 		throw exception(string(string("Dialogs->LoadFile()::doc->Parse:\n") + string(doc->ErrorStr())).c_str());
 		return E_FAIL;
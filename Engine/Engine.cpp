@@ -17,6 +17,11 @@
 #include "Multiplayer.h"
 #include "SDKInterface.h"
 #include "File_system.h"
+#include "FileWatcher.h"
+#include "FlightRecorder.h"
+#include "AssetIO.h"
+#include "ResidentCache.h"
+#include "StringID.h"
 
 ID3D11Device *Engine::Device = nullptr;
 ID3D11DeviceContext *Engine::DeviceContext = nullptr;
@@ -69,6 +74,10 @@ bool DrawGrid = true, DrawCamSphere;
 HRESULT Engine::Init(string NameWnd, HINSTANCE hInstance)
 {
 	this->hInstance = hInstance;
+
+	// StringID Doesn't Need The Engine (Tools Use It Too), So Its Errors Are Given From Here
+	StringID::setLog([](string Text) { LogError(Text, string(__FILE__) + ": " + to_string(__LINE__), Text); });
+
 	ZeroMemory(&wnd, sizeof(WNDCLASSEXW));
 	wnd.style = CS_BYTEALIGNCLIENT | CS_BYTEALIGNWINDOW | CS_HREDRAW | CS_VREDRAW;
 	wnd.lpfnWndProc = (WNDPROC)Engine::WndProc;
@@ -367,6 +376,7 @@ void Engine::Render()
 
 		frameTime = float(MainThread->GetElapsedSeconds());
 		fps = float(MainThread->GetFramesPerSecond());
+		FlightRecorder::MarkFrame(MainThread->GetFrameCount(), frameTime);
 
 		if (Pick.operator bool())
 		{
@@ -461,6 +471,15 @@ void Engine::Render()
 		debug->ReportLiveDeviceObjects(D3D11_RLDO_DETAIL);
 #endif
 
+		if (Watcher.operator bool())
+			Watcher->Update();
+
+		if (IO.operator bool())
+			IO->Update();
+
+		if (FS.operator bool())
+			FS->UpdateDependencies();
+
 		if (Level.operator bool())
 			Level->Update();
 
@@ -518,6 +537,15 @@ void Engine::Destroy()
 {
 	auto extFunc = [&]()
 	{
+		if (Watcher.operator bool())
+			Watcher->Stop();
+
+		if (IO.operator bool())
+			IO->Stop();
+
+		if (Workers.operator bool())
+			Workers->JoinAll();
+
 		if (PhysX.operator bool())
 			PhysX->Destroy();
 
@@ -531,6 +559,12 @@ void Engine::Destroy()
 		if (Sound.operator bool())
 			Sound->ReleaseAudio();
 
+		// Unused Textures And Buffers Are Freed While There's The Device (Textures Which Wait For Upload
+		// Are Used By The Queue)
+		Models::ForgetUploads();
+		if (Cache.operator bool())
+			Cache->Clear();
+
 		::ShowWindow(hwnd, SW_HIDE);
 		::DestroyWindow(hwnd);
 		::UnregisterClassW(ClassWND.c_str(), hInstance);
@@ -554,6 +588,10 @@ void Engine::Destroy()
 		::CoUninitialize();
 
 		MainThread = nullptr;
+
+		// The Last Records Must Get Into The File
+		FlightRecorder::Close();
+		File_system::CloseLog();
 	};
 
 	if (cv.wait_for(lckck, chrono::minutes(1000000),
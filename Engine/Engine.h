@@ -27,6 +27,9 @@ class Picking;
 class Levels;
 class CutScene;
 class Multiplayer;
+class FileWatcher;
+class AssetIO;
+class ResidentCache;
 
 /*!
  * \class Engine Contains All The Classes
@@ -113,6 +116,12 @@ private:
 	static shared_ptr<GamePad> gamepad;
 
 	shared_ptr<DebugDraw> dDraw;
+	shared_ptr<FileWatcher> Watcher;
+	shared_ptr<AssetIO> IO;
+	// Loaded Models, Textures And Sounds (Budgets And Eviction)
+	shared_ptr<ResidentCache> Cache;
+	// Background Jobs (e.g. Compression)
+	shared_ptr<nbsdx::concurrent::ThreadPool<>> Workers = make_shared<nbsdx::concurrent::ThreadPool<>>();
 
 #if defined(Never_MainMenu)
 	shared_ptr<MainMenu> Menu = make_unique<MainMenu>();
@@ -166,6 +175,10 @@ public:
 
 	shared_ptr<DebugDraw> getDebugDraw() { return dDraw; }
 	shared_ptr<Multiplayer> getMPL() { return MPL; }
+	shared_ptr<FileWatcher> getWatcher() { return Watcher; }
+	shared_ptr<AssetIO> getIO() { return IO; }
+	shared_ptr<ResidentCache> getCache() { return Cache; }
+	shared_ptr<nbsdx::concurrent::ThreadPool<>> getWorkers() { return Workers; }
 	shared_ptr<Timer> getMainThread() { return MainThread; }
 
 	void setUI(shared_ptr<UI> _UI)
@@ -244,6 +257,21 @@ public:
 		if (!this->MPL.operator bool())
 			this->MPL = _Multiplayer;
 	}
+	void setWatcher(shared_ptr<FileWatcher> _Watcher)
+	{
+		if (!this->Watcher.operator bool())
+			this->Watcher = _Watcher;
+	}
+	void setIO(shared_ptr<AssetIO> _IO)
+	{
+		if (!this->IO.operator bool())
+			this->IO = _IO;
+	}
+	void setCache(shared_ptr<ResidentCache> _Cache)
+	{
+		if (!this->Cache.operator bool())
+			this->Cache = _Cache;
+	}
 	shared_ptr<Mouse> getMouse() { return mouse; }
 	shared_ptr<Keyboard> getKeyboard() { return keyboard; }
 	shared_ptr<GamePad> getGamepad() { return gamepad; }
@@ -0,0 +1,249 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+#include "FileWatcher.h"
+#include "File_system.h"
+#include "Console.h"
+#include "Levels.h"
+#include "UI.h"
+#include "CLua.h"
+#include "ResidentCache.h"
+
+HRESULT FileWatcher::Init(wstring Folder, bool UsePolling)
+{
+	Stop();
+
+	this->Folder = Folder;
+	Polling = UsePolling;
+	Quit = false;
+	StopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (!StopEvent)
+	{
+		Engine::LogError("FileWatcher::Init()->CreateEventW() Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"FileWatcher: Init Failed!");
+		return E_FAIL;
+	}
+
+	if (Polling)
+		TakeSnapshot(Snapshot);
+
+	Worker = thread([this]() { Polling ? PollThread() : WatchThread(); });
+	return S_OK;
+}
+
+void FileWatcher::Stop()
+{
+	Quit = true;
+	if (StopEvent)
+		SetEvent(StopEvent);
+	if (Worker.joinable())
+		Worker.join();
+	if (StopEvent)
+	{
+		CloseHandle(StopEvent);
+		StopEvent = nullptr;
+	}
+}
+
+void FileWatcher::Push(boost::filesystem::path File, bool Created)
+{
+	lock_guard<mutex> Guard(Lock);
+	Pending[File.generic_wstring()] |= Created;
+	LastChange = chrono::steady_clock::now();
+}
+
+void FileWatcher::WatchThread()
+{
+	HANDLE Dir = CreateFileW(Folder.c_str(), FILE_LIST_DIRECTORY,
+		FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+		FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+	OVERLAPPED Ov = {};
+	Ov.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+	if (Dir == INVALID_HANDLE_VALUE || !Ov.hEvent)
+	{
+		if (Dir != INVALID_HANDLE_VALUE) CloseHandle(Dir);
+		if (Ov.hEvent) CloseHandle(Ov.hEvent);
+
+		OutputDebugStringA("FileWatcher: Change Notifications Aren't Available. Use Polling!\n");
+		Polling = true;
+		TakeSnapshot(Snapshot);
+		PollThread();
+		return;
+	}
+
+	// DWORD Aligned As ReadDirectoryChangesW Requires
+	vector<DWORD> Buffer(16 * 1024);
+	const DWORD Filter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+		FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+	while (!Quit)
+	{
+		ResetEvent(Ov.hEvent);
+		if (!ReadDirectoryChangesW(Dir, Buffer.data(), DWORD(Buffer.size() * sizeof(DWORD)), TRUE, Filter,
+			nullptr, &Ov, nullptr))
+		{
+			OutputDebugStringA("FileWatcher: ReadDirectoryChangesW Failed. Use Polling!\n");
+			CloseHandle(Ov.hEvent);
+			CloseHandle(Dir);
+			Polling = true;
+			TakeSnapshot(Snapshot);
+			PollThread();
+			return;
+		}
+
+		HANDLE Handles[] = { Ov.hEvent, StopEvent };
+		if (WaitForMultipleObjects(2, Handles, FALSE, INFINITE) != WAIT_OBJECT_0)
+		{
+			CancelIo(Dir);
+			DWORD Bytes = 0;
+			GetOverlappedResult(Dir, &Ov, &Bytes, TRUE);
+			break;
+		}
+
+		DWORD Bytes = 0;
+		if (!GetOverlappedResult(Dir, &Ov, &Bytes, FALSE))
+			continue;
+
+		// Buffer Overflow: Changes Were Lost, So Scan Everything (Manifest Makes It Cheap)
+		if (Bytes == 0)
+		{
+			lock_guard<mutex> Guard(Lock);
+			NeedRescan = true;
+			LastChange = chrono::steady_clock::now();
+			continue;
+		}
+
+		auto Info = reinterpret_cast<FILE_NOTIFY_INFORMATION *>(Buffer.data());
+		while (true)
+		{
+			Push(boost::filesystem::path(Folder) / wstring(Info->FileName, Info->FileNameLength / sizeof(WCHAR)),
+				Info->Action == FILE_ACTION_ADDED || Info->Action == FILE_ACTION_RENAMED_NEW_NAME);
+
+			if (!Info->NextEntryOffset) break;
+			Info = reinterpret_cast<FILE_NOTIFY_INFORMATION *>(reinterpret_cast<BYTE *>(Info) + Info->NextEntryOffset);
+		}
+	}
+
+	CloseHandle(Ov.hEvent);
+	CloseHandle(Dir);
+}
+
+void FileWatcher::TakeSnapshot(unordered_map<string, pair<time_t, uintmax_t>> &To)
+{
+	To.clear();
+
+	boost::system::error_code EC;
+	for (boost::filesystem::recursive_directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (!boost::filesystem::is_regular_file(It->status())) continue;
+
+		boost::system::error_code FileEC;
+		To[It->path().generic_string()] = make_pair(boost::filesystem::last_write_time(It->path(), FileEC),
+			boost::filesystem::file_size(It->path(), FileEC));
+	}
+}
+
+void FileWatcher::PollThread()
+{
+	unordered_map<string, pair<time_t, uintmax_t>> Current;
+	while (!Quit)
+	{
+		if (WaitForSingleObject(StopEvent, (DWORD)PollInterval.count()) == WAIT_OBJECT_0)
+			break;
+
+		TakeSnapshot(Current);
+		for (auto &It: Current)
+		{
+			auto Old = Snapshot.find(It.first);
+			if (Old == Snapshot.end() || Old->second != It.second)
+				Push(It.first);
+		}
+		for (auto &It: Snapshot)
+			if (Current.find(It.first) == Current.end())
+				Push(It.first);
+
+		Snapshot.swap(Current);
+	}
+}
+
+void FileWatcher::Update()
+{
+	vector<pair<wstring, bool>> Changed;
+	bool Rescan = false;
+	{
+		lock_guard<mutex> Guard(Lock);
+		if (Pending.empty() && !NeedRescan) return;
+		if (chrono::steady_clock::now() - LastChange < Delay) return;
+
+		Changed.assign(Pending.begin(), Pending.end());
+		Pending.clear();
+		swap(Rescan, NeedRescan);
+	}
+
+	auto FS = Application->getFS();
+	if (!FS.operator bool()) return;
+
+	if (Rescan)
+		FS->ScanFiles();
+
+	for (auto &It: Changed)
+	{
+		boost::system::error_code EC;
+		if (!boost::filesystem::exists(It.first, EC))
+		{
+			FS->RemoveFile(It.first);
+			continue;
+		}
+
+		// Time Of Folder Is Changed With Each New File In It, Which Is Reported Separately
+		if (boost::filesystem::is_directory(It.first, EC) && !It.second)
+			continue;
+
+		auto Obj = FS->UpdateFile(It.first);
+		if (Obj && !Obj->PathA.empty())
+			Reload(Obj->TypeOfFile, Obj->PathA);
+	}
+}
+
+void FileWatcher::Reload(_TypeOfFile Type, string File)
+{
+	switch (Type)
+	{
+	case MODELS:
+		if (Application->getLevel().operator bool())
+			Application->getLevel()->ReloadModel(File);
+		break;
+	case TEXTURES:
+		if (Application->getLevel().operator bool())
+			Application->getLevel()->ReloadTexture(File);
+		break;
+	case SOUNDS:
+		// Next Sound Of This File Maps It Again
+		if (Application->getCache().operator bool())
+			Application->getCache()->Forget(ResidentCache::Sounds, StringID::Path(File));
+		break;
+	case SCRIPTS:
+		if (Application->getCLua().operator bool())
+			CLua::ReloadScript(File);
+		break;
+	case UIS:
+	{
+		if (!Application->getUI().operator bool()) return;
+
+		string Current = Application->getUI()->getFileUI(), Other = File;
+		to_lower(Current);
+		to_lower(Other);
+		if (Current.empty() || boost::filesystem::path(Current).generic_string() != Other) return;
+
+		Application->getUI()->ReloadXML(File);
+		break;
+	}
+	default:
+		return;
+	}
+
+	Console::LogInfo("Hot Reload: " + File);
+}
@@ -0,0 +1,54 @@
+#pragma once
+#if !defined(__FILEWATCHER_H__)
+#define __FILEWATCHER_H__
+#include "pch.h"
+
+#include <Boost/filesystem.hpp>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+enum _TypeOfFile;
+
+// Watch Resource Folder (ReadDirectoryChangesW Or Polling If It Can't Be Used),
+// Apply Changes To The File System And Reload Changed Assets Without Reload Of The Level
+class FileWatcher
+{
+public:
+	FileWatcher() {}
+	~FileWatcher() { Stop(); }
+
+	HRESULT Init(wstring Folder, bool UsePolling = false);
+	void Stop();
+
+	// Call It From The Main Thread Each Frame
+	void Update();
+
+	bool IsPolling() { return Polling; }
+private:
+	void WatchThread();
+	void PollThread();
+	void Push(boost::filesystem::path File, bool Created = false);
+	void Reload(_TypeOfFile Type, string File);
+
+	// Snapshot Of Files For Polling (Generic Path, Case Kept -> Time And Size)
+	unordered_map<string, pair<time_t, uintmax_t>> Snapshot;
+	void TakeSnapshot(unordered_map<string, pair<time_t, uintmax_t>> &To);
+
+	wstring Folder;
+	// Written By The Worker When Notifications Fail, Read By The Frame Thread
+	atomic<bool> Polling = false;
+	thread Worker;
+	atomic<bool> Quit = false;
+	HANDLE StopEvent = nullptr;
+
+	mutex Lock;
+	// Changed Path -> It Was Created Or Moved Here (Only Such Folders Are Walked)
+	unordered_map<wstring, bool> Pending;
+	bool NeedRescan = false;
+	chrono::steady_clock::time_point LastChange;
+	// Editors Write Files In Several Steps, So Wait Until Folder Is Quiet
+	const chrono::milliseconds Delay = 250ms;
+	const chrono::milliseconds PollInterval = 1000ms;
+};
+#endif // !__FILEWATCHER_H__
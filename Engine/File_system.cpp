@@ -5,10 +5,22 @@ extern shared_ptr<Engine> Application;
 #include "Engine.h"
 #include "Console.h"
 #include "File_system.h"
+#include "MappedFile.h"
+#include "ChunkedGzip.h"
+#include "Logger.h"
+#include "FlightRecorder.h"
+#include "ModelDeps.h"
 
 path File_system::WorkDir = "";
-static shared_ptr<boost::filesystem::ofstream> LogFile;
+string File_system::WorkDirSourcesA;
+static shared_ptr<Logger> Log = make_shared<Logger>();
 path File_system::LogFName = "Engine.log";
+path File_system::ManifestFName = "resource.manifest";
+path File_system::PakFName = "resource.pak";
+shared_ptr<Pak> File_system::Archive = make_shared<Pak>();
+path File_system::AliasFName = "textures.alias";
+path File_system::MountsFName = "resource.mounts";
+shared_ptr<VFS> File_system::Mounts = make_shared<VFS>();
 
 File_system::File_system()
 {
@@ -35,7 +47,9 @@ void File_system::ScanFiles()
 		? L"resource/"
 		: L"/resource/");
 
-	if (!exists(WorkDirSourcesA))
+	bool HasFolder = exists(WorkDirSourcesA),
+		HasArchive = Archive->Open(GetCurrentPath() + PakFName.string());
+	if (!HasFolder && !HasArchive)
 	{
 		MessageBoxA(Engine::GetHWND(), "Engine Cannot Work Without Resource Folder!", "ERROR",
 			MB_OK | MB_ICONERROR);
@@ -45,102 +59,334 @@ void File_system::ScanFiles()
 		exit(-1);
 	}
 
-	auto file = getFilesInFolder(WorkDirSourcesA, true, true);
-	for (size_t i = 0; i < file.size(); i++)
+	for (auto &List: Catalog)
+		List.clear();
+	ByPath.clear();
+	ByName.clear();
+	ByStem.clear();
+
+	// Loose Files Override The Archive, Patches And Mods Of resource.mounts Are Over Both
+	Mounts->Clear();
+	BaseMount = HasFolder ? Mounts->MountDirectory("resource", WorkDirSourcesA, 0) : 0;
+	if (HasArchive)
+		Mounts->MountArchive(PakFName.string(), Archive, -1);
+	LoadMounts();
+
+	if (HasFolder)
 	{
-		string someFile = file.at(i),
-			ext = extension(someFile);
-		auto Fname = path(someFile);
-		auto type = GetTypeFileByExt(someFile);
-		switch (type)
+		Manifest Cache;
+		Cache.Open(GetCurrentPath() + ManifestFName.string(), WorkDirSourcesA);
+
+		vector<Manifest::Folder> Folders;
+		bool Changed = false;
+		ScanFolder(WorkDirSourcesA, -1, Cache, Folders, Changed);
+
 		{
-		case MODELS:
-			Models.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Models.back().first->ExtW = Fname.extension().wstring();
-			Models.back().first->FileW = Fname.filename().wstring();
-			Models.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case TEXTURES:
-			Textures.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Textures.back().first->ExtW = Fname.extension().wstring();
-			Textures.back().first->FileW = Fname.filename().wstring();
-			Textures.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case LEVELS:
-			Levels.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Levels.back().first->ExtW = Fname.extension().wstring();
-			Levels.back().first->FileW = Fname.filename().wstring();
-			Levels.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case DIALOGS:
-			Dialogs.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Dialogs.back().first->ExtW = Fname.extension().wstring();
-			Dialogs.back().first->FileW = Fname.filename().wstring();
-			Dialogs.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case SOUNDS:
-			Sounds.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Sounds.back().first->ExtW = Fname.extension().wstring();
-			Sounds.back().first->FileW = Fname.filename().wstring();
-			Sounds.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case SHADERS:
-			Shaders.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Shaders.back().first->ExtW = Fname.extension().wstring();
-			Shaders.back().first->FileW = Fname.filename().wstring();
-			Shaders.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case UIS:
-			Uis.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Uis.back().first->ExtW = Fname.extension().wstring();
-			Uis.back().first->FileW = Fname.filename().wstring();
-			Uis.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case SCRIPTS:
-			Scripts.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Scripts.back().first->ExtW = Fname.extension().wstring();
-			Scripts.back().first->FileW = Fname.filename().wstring();
-			Scripts.back().first->PathW = Fname.wstring().c_str();
-			break;
-		case FONTS:
-			Fonts.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			Fonts.back().first->ExtW = Fname.extension().wstring();
-			Fonts.back().first->FileW = Fname.filename().wstring();
-			Fonts.back().first->PathW = Fname.wstring().c_str();
-			break;
-		default:
-			if (contains(Fname.filename().string(), "proj")) continue;
-
-			None.push_back(make_pair(make_shared<File_system::File>(someFile, ext,
-				Fname.filename().string(), (size_t)file_size(Fname), type), file.at(i)));
-			None.back().first->ExtW = Fname.extension().wstring();
-			None.back().first->FileW = Fname.filename().wstring();
-			None.back().first->PathW = Fname.wstring().c_str();
-			break;
+			lock_guard<mutex> Lock(DepsLock);
+			Deps.clear();
+			for (auto &It: Cache.GetDependencies())
+				Deps[StringID::Path(It.Path)] = It;
 		}
+
+		Cache.Close();
+		Snapshot = move(Folders);
+		if (Changed)
+			SaveManifest();
 	}
+
+	// Every File Comes To The Catalog Once: From The Mount Which Wins
+	for (auto &Key: Mounts->GetAll())
+		Publish(Key);
+	ReportShadows();
+
+	LoadAliases();
 }
 
-void File_system::RescanFilesByType(_TypeOfFile Type)
+void File_system::LoadMounts()
 {
-	// Get New Files
-	GetFileByType(Type).clear();
-	auto Files = getFilesInFolder(getPathFromType(Type), true, true);
-	for (size_t i = 0; i < Files.size(); i++)
+	MappedFile List(GetCurrentPath() + MountsFName.string(), MappedFile::Sequential);
+	if (!List.IsOpen() || List.size() == 0)
+		return;
+
+	// Each Line: dir|pak <Priority> <Path Relative To Working Folder Or Full Path>
+	vector<string> Lines;
+	split(Lines, string(List.View()), is_any_of("\r\n"), token_compress_on);
+	for (auto &Line: Lines)
+	{
+		trim(Line);
+		if (Line.empty() || Line.front() == '#')
+			continue;
+
+		std::istringstream Stream(Line);
+		string Kind, Where;
+		int Priority = 0;
+		Stream >> Kind >> Priority;
+		getline(Stream >> std::ws, Where);
+		to_lower(Kind);
+
+		path Full = Where;
+		if (!Full.is_absolute())
+			Full = GetCurrentPath() + Where;
+
+		bool Mounted = false;
+		if (Kind == "dir")
+		{
+			auto ID = Mounts->MountDirectory(Where, Full.generic_string(), Priority);
+			Mounted = ID != 0 && is_directory(Full);
+			if (Mounted)
+				Mounts->Scan(ID);
+			else if (ID)
+				Mounts->Unmount(ID);
+		}
+		else if (Kind == "pak")
+		{
+			auto Pack = make_shared<Pak>();
+			Mounted = Pack->Open(Full) && Mounts->MountArchive(Where, Pack, Priority) != 0;
+		}
+
+		if (!Mounted)
+			Engine::LogError("File System::LoadMounts Failed!",
+				string(__FILE__) + ": " + to_string(__LINE__),
+				"File System: Cannot Mount \"" + Line + "\" From " + MountsFName.string());
+	}
+}
+
+shared_ptr<File_system::File> File_system::Publish(StringID Key)
+{
+	string Virtual = WorkDirSourcesA + Key.str();
+	auto Src = Mounts->Resolve(Key);
+	if (!Src.IsFound())
+	{
+		auto It = ByPath.find(StringID(Virtual));
+		if (It != ByPath.end())
+			Forget(It->second);
+		return shared_ptr<File_system::File>();
+	}
+
+	path File = WorkDirSourcesA + Src.File.Path;
+	auto Type = Src.File.Type ? (_TypeOfFile)Src.File.Type : GetTypeFileByExt(File);
+	if (Type == NONE && contains(File.filename().string(), "proj"))
+		return shared_ptr<File_system::File>();
+
+	// Files Of Folders Are Opened Right From Disk, The Rest Is Read Through The Mounts
+	auto Obj = Intern(File, Type, (size_t)Src.File.Size, Src.File.HasTextures);
+	Obj->Packed = Src.Type != VFS::Directory;
+	Obj->PathA = Src.Type == VFS::Directory ? Src.Real : File.generic_string();
+	return Obj;
+}
+
+shared_ptr<File_system::File> File_system::Track(path File, _TypeOfFile T, size_t Size, bool HasTextures)
+{
+	string Relative;
+	auto Mount = Mounts->Locate(File.generic_string(), Relative);
+	if (!Mount)
+		return Intern(File, T, Size, HasTextures);
+
+	VFS::Entry Obj;
+	Obj.Path = Relative;
+	Obj.Size = Size;
+	Obj.Type = T;
+	Obj.HasTextures = HasTextures;
+	Mounts->Add(Mount, Obj);
+
+	return Publish(StringID::Path(Relative));
+}
+
+void File_system::ReportShadows()
+{
+	// Loose Files Over The Archive Are Usual: Only Count Them
+	map<pair<string, string>, vector<string>> ByMounts;
+	for (auto &It: Mounts->GetShadows())
+		ByMounts[make_pair(It.Winner, It.Hidden)].push_back(It.Path);
+
+	for (auto &It: ByMounts)
 	{
-		GetFile(Files.at(i));
+		string Text = (boost::format("VFS: %s Shadows %d Files Of %s") % It.first.first % It.second.size()
+			% It.first.second).str();
+		if (It.first.first != "resource" || It.first.second != PakFName.string())
+			for (size_t i = 0; i < It.second.size() && i < 16; i++)
+				Text += "\n\t" + It.second.at(i);
+		if (It.second.size() > 16)
+			Text += "\n\t...";
+		AddTextToLog(Text + "\n", Type::Information);
 	}
 }
 
+uint32_t File_system::MountFolder(string Folder, int Priority, string Name)
+{
+	boost::system::error_code EC;
+	if (!is_directory(Folder, EC))
+		return 0;
+
+	auto ID = Mounts->MountDirectory(Name.empty() ? Folder : Name, Folder, Priority);
+	if (!ID)
+		return 0;
+
+	Mounts->Scan(ID);
+	for (auto &Key: Mounts->GetAll(ID))
+		Publish(Key);
+	ReportShadows();
+	return ID;
+}
+
+uint32_t File_system::MountPak(string File, int Priority)
+{
+	auto Pack = make_shared<Pak>();
+	if (!Pack->Open(File))
+		return 0;
+
+	auto ID = Mounts->MountArchive(path(File).filename().string(), Pack, Priority);
+	for (auto &Key: Mounts->GetAll(ID))
+		Publish(Key);
+	ReportShadows();
+	return ID;
+}
+
+uint32_t File_system::MountMemory(string Name, int Priority)
+{
+	return Mounts->MountMemory(Name, Priority);
+}
+
+bool File_system::AddMemoryFile(uint32_t Mount, string File, vector<BYTE> Data)
+{
+	// The Same Key As Resolve Looks For
+	File = ToKey(File);
+	if (!Mounts->AddMemoryFile(Mount, File, move(Data)))
+		return false;
+
+	return Publish(StringID::Path(File)).operator bool();
+}
+
+bool File_system::Unmount(uint32_t Mount)
+{
+	if (Mount == BaseMount)
+		return false;
+
+	auto Keys = Mounts->GetAll(Mount);
+	if (!Mounts->Unmount(Mount))
+		return false;
+
+	// Files Of The Mount Go Back To The Mounts Which Were Under It (Or Are Removed)
+	for (auto &Key: Keys)
+		Publish(Key);
+	return true;
+}
+
+string File_system::ToKey(string File)
+{
+	string Key = path(File).generic_string(), Root = WorkDirSourcesA;
+	to_lower(Key);
+	to_lower(Root);
+	if (!Root.empty() && Key.compare(0, Root.size(), Root) == 0)
+		Key.erase(0, Root.size());
+
+	return Key;
+}
+
+VFS::Source File_system::Resolve(string File)
+{
+	return Mounts->Resolve(ToKey(File));
+}
+
+void File_system::ScanFolder(path Folder, int Parent, const Manifest &Cache, vector<Manifest::Folder> &Folders,
+	bool &Changed)
+{
+	string Dir = Folder.generic_string();
+	if (!Dir.empty() && Dir.back() != '/')
+		Dir += "/";
+
+	Manifest::Folder Current;
+	Current.Path = Dir.substr(WorkDirSourcesA.size());
+	if (!Current.Path.empty())
+		Current.Path.pop_back();
+	Current.Parent = Parent;
+
+	boost::system::error_code EC;
+	Current.MTime = (int64_t)last_write_time(Folder, EC);
+	if (EC) return;
+
+	int Index = (int)Folders.size();
+	Folders.push_back(Current);
+
+	// Folder Wasn't Changed: Take Its Files From The Manifest
+	auto Rec = Cache.FindFolder(Current.Path);
+	if (Cache.IsClean(Rec, Current.MTime))
+	{
+		auto Files = Cache.GetFiles(Rec);
+		for (uint32_t i = 0; i < Rec->FileCount; i++)
+		{
+			Manifest::Entry Obj;
+			Obj.Name = Cache.GetName(&Files[i]);
+			Obj.Size = (size_t)Files[i].Size;
+			Obj.Type = Files[i].Type;
+			Obj.HasTextures = Files[i].HasTextures != 0;
+			if (Obj.Type < MODELS || Obj.Type > NONE) continue;
+
+			ListFile(Current.Path, Obj);
+			Folders.at(Index).Files.push_back(Obj);
+		}
+
+		for (auto Child: Cache.GetChildren(Rec))
+			ScanFolder(WorkDirSourcesA + Cache.GetPath(Child), Index, Cache, Folders, Changed);
+		return;
+	}
+
+	Changed = true;
+
+	vector<path> SubFolders;
+	for (directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (is_directory(It->status()))
+		{
+			SubFolders.push_back(It->path());
+			continue;
+		}
+
+		auto Type = GetTypeFileByExt(It->path());
+		if (Type == NONE && contains(It->path().filename().string(), "proj")) continue;
+
+		Manifest::Entry Obj;
+		Obj.Name = It->path().filename().string();
+		boost::system::error_code SizeEC;
+		Obj.Size = (size_t)file_size(It->path(), SizeEC);
+		Obj.Type = Type;
+		ListFile(Current.Path, Obj);
+		Folders.at(Index).Files.push_back(Obj);
+	}
+
+	sort(SubFolders.begin(), SubFolders.end());
+	for (auto &It: SubFolders)
+		ScanFolder(It, Index, Cache, Folders, Changed);
+}
+
+void File_system::ListFile(const string &Folder, const Manifest::Entry &Obj)
+{
+	VFS::Entry File;
+	File.Path = Folder.empty() ? Obj.Name : Folder + "/" + Obj.Name;
+	File.Size = Obj.Size;
+	File.Type = Obj.Type;
+	File.HasTextures = Obj.HasTextures;
+	Mounts->Add(BaseMount, File);
+}
+
+void File_system::RescanFilesByType(_TypeOfFile Type)
+{
+	string Folder = getPathFromType(Type);
+	if (Folder.empty() || !exists(Folder))
+		return;
+
+	// Forget Files Which Were Deleted
+	auto Files = Catalog.at(Type);
+	for (auto It: Files)
+		if (!It.first->Packed && It.first->AliasA.empty() && !exists(It.first->PathA))
+			RemoveFile(It.first->PathA);
+
+	// Get New Files
+	for (auto &File: getFilesInFolder(Folder, true, true))
+		if (GetTypeFileByExt(File) == Type)
+			Track(File, Type, (size_t)file_size(File));
+}
+
 _TypeOfFile File_system::GetTypeFileByExt(path File)
 {
 	string Ext = File.string();
@@ -166,16 +412,10 @@ _TypeOfFile File_system::GetTypeFileByExt(path File)
 		if (!File.has_branch_path() && !File.has_parent_path() && !File.has_root_directory() &&
 			!File.has_root_name() && !File.has_root_path() && File.has_filename())
 		{
-			string WExt = File.string();
-			deleteWord(WExt, File.extension().string());
-			auto Obj = Find(WExt);
-			to_lower(Obj->PathA);
-			if (contains(Obj->PathA, "ui"))
-				return UIS;
-			if (contains(Obj->PathA, "maps"))
-				return LEVELS;
-			if (contains(Obj->PathA, "text"))
-				return DIALOGS;
+			// Only Name Of File: Type Was Already Got From The Folder When It Was Added
+			auto Names = ByName.find(StringID::Find(File.string()));
+			if (Names != ByName.end() && !Names->second.empty())
+				return Names->second.front()->TypeOfFile;
 		}
 		string lower = File.string();
 		to_lower(lower);
@@ -198,53 +438,48 @@ void File_system::CreateLog()
 		MessageBoxA(Engine::GetHWND(), "Engine cannot get path to log file!", "Error!", MB_OK | MB_ICONERROR);
 		return;
 	}
-	else if (!exists(LogFName))
-	{
-		LogFile = make_shared<boost::filesystem::ofstream>(LogFName, std::ofstream::in | std::ofstream::app);
-		if (!LogFile->is_open())
-		{
-			MessageBoxA(Engine::GetHWND(), "Engine cannot create a log file!", "Error!", MB_OK | MB_ICONERROR);
-			return;
-		}
-	}
-	else
-	{
-		LogFile = make_shared<boost::filesystem::ofstream>(LogFName, std::ofstream::in | std::ofstream::app);
-		OpenLog();
-	}
 
-	LogFile->close();
+	// The File Is Opened Once, Records Are Written By The Logger Thread
+	if (!Log->Start(LogFName))
+		MessageBoxA(Engine::GetHWND(), "Engine cannot create a log file!", "Error!", MB_OK | MB_ICONERROR);
+
+	// The Last Records Survive A Crash In Engine.flight (See Tools/FlightDecoder)
+	if (!FlightRecorder::IsOpen() && FlightRecorder::Open(path(LogFName).replace_extension(".flight").string()))
+		FlightRecorder::Write(FlightRecorder::Event, "Started");
 }
 
 void File_system::AddTextToLog(string Text, Type type)
 {
-	OpenLog();
+	FlightRecorder::Write(FlightRecorder::Kind(type), Text);
 
-	ParseText(Text, type);
-	*LogFile << Text;
-
-	LogFile->close();
+	// Records Before CreateLog() Wait In The Queue
+	Log->Push(move(Text), type);
 }
 
 void File_system::OpenLog()
 {
-	if (!exists(LogFName))
+	if (!Log->IsRunning())
 		CreateLog();
+}
 
-	if (!LogFile->is_open())
-	{
-		LogFile = make_shared<boost::filesystem::ofstream>(LogFName, std::ofstream::in | std::ofstream::app);
-		if (!LogFile->is_open())
-		{
-			MessageBoxA(Engine::GetHWND(), "Engine cannot open a log file!", "Error!", MB_OK | MB_ICONERROR);
-			return;
-		}
-	}
+void File_system::FlushLog()
+{
+	Log->Flush();
+}
+
+void File_system::CloseLog()
+{
+	Log->Stop();
 }
 
 void File_system::ClearLogs()
 {
-	boost::filesystem::remove(LogFName);
+	Log->Clear();
+}
+
+shared_ptr<Logger> File_system::getLogger()
+{
+	return Log;
 }
 
 string File_system::getPathFromType(_TypeOfFile T)
@@ -277,516 +512,428 @@ string File_system::getPathFromType(_TypeOfFile T)
 	return New;
 }
 
-shared_ptr<File_system::File> File_system::Find(path File, bool AlsoAddFile)
+vector<string> File_system::getSearchFolders(_TypeOfFile T)
 {
-	if (File.empty())
-		return make_shared<File_system::File>();
-
-	if (!File.has_extension())
-		AlsoAddFile = true;
+	vector<string> Folders;
+	string Sub = getPathFromType(T);
+	if (Sub.size() < WorkDirSourcesA.size())
+		return Folders;
+	Sub.erase(0, WorkDirSourcesA.size());
+
+	for (auto &It: Mounts->GetMounts())
+		if (It.Type == VFS::Directory)
+			Folders.push_back(It.Root + Sub);
+
+	if (Folders.empty())
+		Folders.push_back(getPathFromType(T));
+	return Folders;
+}
 
-	if (AlsoAddFile)
+shared_ptr<File_system::File> File_system::UpdateFile(path File)
+{
+	boost::system::error_code EC;
+	if (is_directory(File, EC))
 	{
-		shared_ptr<File_system::File> NewObj = make_shared<File_system::File>();
-		auto AllFiles = getFilesInFolder(WorkDirSourcesA, true, true);
-		for (size_t i = 0; i < AllFiles.size(); i++)
-		{
-			string Files = AllFiles.at(i);
-			to_lower(Files);
-			// Models
-			if (contains(Files, File.string() + (!File.has_extension() ? ".obj" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::MODELS;
-					NewObj->ExtA = ".obj";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			if (contains(Files, File.string() + (!File.has_extension() ? ".3ds" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::MODELS;
-					NewObj->ExtA = ".3ds";
-					return NewObj;
-				}
-				else
-					return F;
+		// Folder Was Created Or Moved Here: Its Files May Not Be Reported One By One
+		for (recursive_directory_iterator It(File, EC), End; !EC && It != End; It.increment(EC))
+			if (is_regular_file(It->status()))
+				UpdateFile(It->path());
+		return shared_ptr<File_system::File>();
+	}
 
-			}
-			if (contains(Files, File.string() + (!File.has_extension() ? ".fbx" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::MODELS;
-					NewObj->ExtA = ".fbx";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+	if (!is_regular_file(File, EC))
+		return shared_ptr<File_system::File>();
 
-			// Textures
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".dds" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::TEXTURES;
-					NewObj->ExtA = ".dds";
-					return NewObj;
-				}
-				else
-					return F;
+	auto Type = GetTypeFileByExt(File);
+	if (Type == NONE && contains(File.filename().string(), "proj"))
+		return shared_ptr<File_system::File>();
 
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".png" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{	// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::TEXTURES;
-					NewObj->ExtA = ".png";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".bmp" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::TEXTURES;
-					NewObj->ExtA = ".bmp";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".jpg" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::TEXTURES;
-					NewObj->ExtA = ".jpg";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+	auto Size = file_size(File, EC);
+	if (EC)
+		return shared_ptr<File_system::File>();
 
-			// Shaders
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".hlsl" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SHADERS;
-					NewObj->ExtA = ".hlsl";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".fx" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SHADERS;
-					NewObj->ExtA = ".fx";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".vs" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SHADERS;
-					NewObj->ExtA = ".vs";
-					return NewObj;
-				}
-				else
-					return F;
-			}
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".ps" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SHADERS;
-					NewObj->ExtA = ".ps";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+	return Track(File, Type, (size_t)Size);
+}
 
-			// Sounds
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".wav" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SOUNDS;
-					NewObj->ExtA = ".wav";
-					return NewObj;
-				}
-				else 
-					return F;
-			}
+void File_system::RemoveFile(path File)
+{
+	string Key = File.generic_string();
+	to_lower(Key);
+	if (Key.empty()) return;
+
+	// File Of A Mounted Folder: Other Mount (e.g. The Archive) May Still Have It
+	string Relative;
+	auto Mount = Mounts->Locate(File.generic_string(), Relative);
+	if (Mount)
+	{
+		StringID Single = StringID::Find(Relative);
+		if (Mounts->Remove(Mount, Relative))
+		{
+			Publish(Single);
+			return;
+		}
 
-			// Maps, UI and etc
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".xml" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-
-					if (contains(NewObj->FileA, "ui"))
-						NewObj->TypeOfFile = _TypeOfFile::UIS;
-					else if (contains(NewObj->FileA, "maps"))
-						NewObj->TypeOfFile = _TypeOfFile::LEVELS;
-					else if (contains(NewObj->FileA, "text"))
-						NewObj->TypeOfFile = _TypeOfFile::DIALOGS;
-					NewObj->ExtA = ".xml";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+		// It Was A Folder
+		if (!Relative.empty() && Relative.back() != '/')
+			Relative += "/";
+		to_lower(Relative);
 
-			// Scripts
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".lua" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::SCRIPTS;
-					NewObj->ExtA = ".lua";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+		vector<string> Removed;
+		for (auto &Key: Mounts->GetAll(Mount))
+			if (Key.str().compare(0, Relative.size(), Relative) == 0)
+				Removed.push_back(Key.original());
 
-			// Fonts
-			else if (contains(Files, File.string() + (!File.has_extension() ? ".ttf" : "")))
-			{
-				auto F = GetFileByPath(Files);
-				if (!F || F->FileA.empty() || F->FileW.empty())
-				{
-					// If need to add it to engine
-					NewObj->PathA = Files;
-					NewObj->TypeOfFile = _TypeOfFile::FONTS;
-					NewObj->ExtA = ".ttf";
-					return NewObj;
-				}
-				else
-					return F;
-			}
+		for (auto &It: Removed)
+		{
+			Mounts->Remove(Mount, It);
+			Publish(StringID::Path(It));
 		}
+		if (!Removed.empty())
+			return;
 	}
-	else
+
+	auto It = ByPath.find(StringID::Find(Key));
+	if (It != ByPath.end())
 	{
-		switch (GetTypeFileByExt(File))
-		{
-		case MODELS:
-			for (auto elem: Models)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case TEXTURES:
-			for (auto elem: Textures)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(Path).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case LEVELS:
-			for (auto elem: Levels)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case DIALOGS:
-			for (auto elem: Dialogs)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case SOUNDS:
-			for (auto elem: Sounds)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case SHADERS:
-			for (auto elem: Shaders)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case UIS:
-			for (auto elem: Uis)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case SCRIPTS:
-			for (auto elem: Scripts)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-			break;
-		case FONTS:
-			for (auto elem: Fonts)
-			{
-				string Path = elem.second;
-				to_lower(Path);
-				if (contains(path(elem.second).filename().string(), File.filename().string()))
-					return elem.first;
-			}
-		}
+		Forget(It->second);
+		return;
 	}
-	return make_shared<File_system::File>();
+
+	// It Was A Folder
+	if (Key.back() != '/')
+		Key += "/";
+
+	vector<shared_ptr<File_system::File>> Removed;
+	for (auto &Obj: ByPath)
+		if (Obj.first.str().compare(0, Key.size(), Key) == 0)
+			Removed.push_back(Obj.second);
+
+	for (auto &Obj: Removed)
+		Forget(Obj);
 }
 
-vector<pair<shared_ptr<File_system::File>, string>> File_system::GetFileByType(_TypeOfFile T)
+shared_ptr<File_system::File> File_system::Intern(path File, _TypeOfFile T, size_t Size, bool HasTextures)
 {
-	switch (T)
+	path Generic = File.generic_path();
+	StringID Key(Generic.string());
+
+	auto It = ByPath.find(Key);
+	if (It != ByPath.end())
 	{
-	case MODELS:
-		return Models;
-	case TEXTURES:
-		return Textures;
-	case LEVELS:
-		return Levels;
-	case DIALOGS:
-		return Dialogs;
-	case SOUNDS:
-		return Sounds;
-	case SHADERS:
-		return Shaders;
-	case UIS:
-		return Uis;
-	case SCRIPTS:
-		return Scripts;
-	case FONTS:
-		return Fonts;
-	case NONE:
-		return None;
+		It->second->Size = Size;
+		It->second->Hash = 0;
+		It->second->HasTextures = It->second->HasTextures || HasTextures;
+		return It->second;
 	}
 
-	return vector<pair<shared_ptr<File_system::File>, string>>();
+	auto Obj = make_shared<File_system::File>(Generic.string(), Generic.extension().string(),
+		Generic.filename().string(), Size, T, HasTextures);
+	Obj->Key = Key;
+	Obj->Name = StringID(Obj->FileA);
+
+	Catalog.at(T).push_back(make_pair(Obj, Key));
+	ByPath.emplace(Key, Obj);
+	ByName[Obj->Name].push_back(Obj);
+	ByStem[StringID(Generic.stem().string())].push_back(Obj);
+
+	return Obj;
 }
 
-shared_ptr<File_system::File> File_system::GetFileByPath(path File)
+void File_system::Forget(shared_ptr<File> Obj)
 {
-	string lower = File.string();
-	to_lower(lower);
+	if (!Obj) return;
 
-	switch (GetTypeFileByExt(lower))
+	auto Erase = [&Obj](unordered_map<StringID, vector<shared_ptr<File>>> &Index, StringID Key)
 	{
-	case MODELS:
-		for (auto it: Models)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case TEXTURES:
-		for (auto it: Textures)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case LEVELS:
-		for (auto it: Levels)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case DIALOGS:
-		for (auto it: Dialogs)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case SOUNDS:
-		for (auto it: Sounds)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case SHADERS:
-		for (auto it: Shaders)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case UIS:
-		for (auto it: Uis)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case SCRIPTS:
-		for (auto it: Scripts)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
-	case FONTS:
-		for (auto it: Fonts)
-		{
-			to_lower(it.second);
-			if ((contains(it.second, lower)))
-				return it.first;
-		}
-		break;
+		auto It = Index.find(Key);
+		if (It == Index.end()) return;
+
+		It->second.erase(std::remove(It->second.begin(), It->second.end(), Obj), It->second.end());
+		if (It->second.empty())
+			Index.erase(It);
+	};
+
+	string Where = Obj->AliasA.empty() ? Obj->PathA : Obj->AliasA;
+	ByPath.erase(Obj->Key);
+	Erase(ByName, Obj->Name);
+	Erase(ByStem, StringID(path(Where).stem().string()));
+
+	auto &List = Catalog.at(Obj->TypeOfFile);
+	List.erase(std::remove_if(List.begin(), List.end(),
+		[&Obj](const pair<shared_ptr<File>, StringID> &It) { return It.first == Obj; }), List.end());
+
+	// Aliases Can't Live Without The Stored File
+	if (Obj->AliasA.empty())
+	{
+		vector<shared_ptr<File_system::File>> Aliases;
+		for (auto &It: List)
+			if (!It.first->AliasA.empty() && It.first->PathA == Obj->PathA)
+				Aliases.push_back(It.first);
+		for (auto &It: Aliases)
+			Forget(It);
 	}
+}
 
-	return shared_ptr<File_system::File>();
+shared_ptr<File_system::File> File_system::InternAlias(path Alias, shared_ptr<File> Stored)
+{
+	path Generic = Alias.generic_path();
+	StringID Key(Generic.string());
+
+	auto It = ByPath.find(Key);
+	if (It != ByPath.end())
+		return It->second;
+
+	auto Obj = make_shared<File_system::File>(*Stored);
+	Obj->AliasA = Generic.string();
+	Obj->FileA = Generic.filename().string();
+	Obj->Key = Key;
+	Obj->Name = StringID(Obj->FileA);
+
+	Catalog.at(Obj->TypeOfFile).push_back(make_pair(Obj, Key));
+	ByPath.emplace(Key, Obj);
+	ByName[Obj->Name].push_back(Obj);
+	ByStem[StringID(Generic.stem().string())].push_back(Obj);
+
+	return Obj;
 }
 
-shared_ptr<File_system::File> File_system::GetFile(path File)
+// FNV-1a
+static uint64_t HashContent(const MappedFile &File)
 {
-	if (File.empty()) return shared_ptr<File_system::File>();
-	
-	File.swap(File.generic());
-	string Fname = File.generic_string();
-	to_lower(Fname);
+	uint64_t Hash = 14695981039346656037ull;
+	for (size_t i = 0; i < File.size(); i++)
+		Hash = (Hash ^ File.data()[i]) * 1099511628211ull;
 
-	// It means that we have the full-path like this "C:/SommePath/Somme.obj" only with lower cases
-	if (File.has_branch_path() && File.has_parent_path() && File.has_root_directory() &&
-		File.has_root_name() && File.has_root_path() && File.has_extension() && File.has_filename())
+	return Hash ? Hash : 1;
+}
+
+shared_ptr<File_system::File> File_system::FindSameContent(path Source, _TypeOfFile T)
+{
+	MappedFile Src(Source.string(), MappedFile::Sequential);
+	if (!Src.IsOpen() || Src.size() == 0)
+		return shared_ptr<File_system::File>();
+
+	uint64_t Hash = 0;
+	for (auto &It: Catalog.at(T))
 	{
-		auto Obj = GetFileByPath(Fname);
-		if (Obj && Obj->Size > 0)
+		auto Obj = It.first;
+		if (!Obj->AliasA.empty() || Obj->Size != Src.size())
+			continue;
+
+		if (!Hash)
+			Hash = HashContent(Src);
+		if (Obj->Hash && Obj->Hash != Hash)
+			continue;
+
+		MappedFile Other(Obj->PathA, MappedFile::Sequential);
+		if (!Other.IsOpen() || Other.size() != Src.size())
+			continue;
+		if (!Obj->Hash)
+			Obj->Hash = HashContent(Other);
+		if (Obj->Hash == Hash && memcmp(Other.data(), Src.data(), Src.size()) == 0)
 			return Obj;
-		if (File.has_extension())
-			deleteWord(Fname, File.extension().string());
+	}
+
+	return shared_ptr<File_system::File>();
+}
+
+shared_ptr<File_system::File> File_system::ImportTexture(path Source, path Target)
+{
+	auto Relative = [this](string Path)
+	{
+		return Path.compare(0, WorkDirSourcesA.size(), WorkDirSourcesA) == 0 ? Path.substr(WorkDirSourcesA.size())
+			: Path;
+	};
+
+	boost::system::error_code EC;
+	if (!exists(Source, EC))
+		return shared_ptr<File_system::File>();
+
+	string TargetA = Target.generic_string(), Lower = TargetA;
+	to_lower(Lower);
+
+	auto Stored = FindSameContent(Source, TEXTURES);
+	if (Stored)
+	{
+		string StoredA = Stored->PathA;
+		to_lower(StoredA);
+		if (StoredA == Lower)
+			return Stored;
+
+		auto Obj = InternAlias(Target, Stored);
+		Dedup.Aliased++;
+		Dedup.SavedBytes += Stored->Size;
+		Dedup.Aliases.push_back(make_pair(Relative(TargetA), Relative(Stored->PathA)));
+		SaveAliases();
+
+		Console::LogInfo((boost::format("File System: %s Is The Same As %s And Isn't Copied (Saved %d KiB)")
+			% Relative(TargetA) % Relative(Stored->PathA) % (Stored->Size / 1024)).str());
+		return Obj;
+	}
+
+	create_directories(Target.parent_path(), EC);
+	copy_file(Source, Target, EC);
+	if (EC)
+	{
+		Engine::LogError("File System: " + EC.message() + "\n",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"Cannot Copy " + Source.string() + " To " + TargetA + "\n");
+		return shared_ptr<File_system::File>();
+	}
+
+	Dedup.Stored++;
+	return Track(Target, TEXTURES, (size_t)file_size(Target, EC), true);
+}
+
+void File_system::LoadAliases()
+{
+	MappedFile List(WorkDirSourcesA + AliasFName.string(), MappedFile::Sequential);
+	if (!List.IsOpen() || List.size() == 0)
+		return;
 
-		// if it was empty try to add to engine
-		Find(Fname);
+	// Each Line: Alias <Tab> Stored File (Both Relative To Resource Folder)
+	vector<string> Lines;
+	split(Lines, string(List.View()), is_any_of("\r\n"), token_compress_on);
+	for (auto &Line: Lines)
+	{
+		auto Tab = Line.find('\t');
+		if (Tab == string::npos)
+			continue;
+
+		string Stored = WorkDirSourcesA + Line.substr(Tab + 1);
+		to_lower(Stored);
+		auto Obj = Lookup(Stored);
+		if (Obj && Obj->AliasA.empty())
+			InternAlias(WorkDirSourcesA + Line.substr(0, Tab), Obj);
 	}
+}
 
-	// It means that we have the path like this "Somme" or with full-path "C:/SommePath/Somme"
-	else if (File.has_filename())
+void File_system::SaveAliases()
+{
+	string Text;
+	for (auto &It: Catalog.at(TEXTURES))
 	{
-		if (File.has_extension())
-			deleteWord(Fname, File.extension().string());
+		auto Obj = It.first;
+		if (Obj->AliasA.empty() || Obj->AliasA.compare(0, WorkDirSourcesA.size(), WorkDirSourcesA) != 0 ||
+			Obj->PathA.compare(0, WorkDirSourcesA.size(), WorkDirSourcesA) != 0)
+			continue;
+
+		Text += Obj->AliasA.substr(WorkDirSourcesA.size()) + "\t" + Obj->PathA.substr(WorkDirSourcesA.size()) + "\n";
+	}
+
+	std::ofstream Stream(WorkDirSourcesA + AliasFName.string(), ios::binary | ios::trunc);
+	Stream << Text;
+}
 
-		auto Obj = Find(Fname);
-		if (Obj && Obj->Size > 0)
+shared_ptr<File_system::File> File_system::Lookup(string Lower)
+{
+	if (Lower.empty())
+		return shared_ptr<File_system::File>();
+
+	// Nothing Is Interned For A Path Which Was Never Added
+	auto It = ByPath.find(StringID::Find(Lower));
+	if (It != ByPath.end() && !It->first.IsEmpty())
+		return It->second;
+
+	// Relative Path Or Only Name Of File: Check Everything With The Same Name
+	auto Names = ByName.find(StringID::Find(path(Lower).filename().string()));
+	if (Names == ByName.end())
+		return shared_ptr<File_system::File>();
+
+	for (auto &Obj: Names->second)
+	{
+		const string &Key = Obj->Key.str();
+		if (Key.size() >= Lower.size() && Key.compare(Key.size() - Lower.size(), Lower.size(), Lower) == 0)
 			return Obj;
 	}
 
-	return AddFile(File);
+	return shared_ptr<File_system::File>();
 }
 
-#include "Models.h"
-void getListTexturesFromModel(aiNode *node, const aiScene *pScene, vector<string> &ListTextures)
+shared_ptr<File_system::File> File_system::Find(path File, bool AlsoAddFile)
 {
-	for (UINT i = 0; i < node->mNumMeshes; i++)
+	if (File.empty())
+		return make_shared<File_system::File>();
+
+	string Lower = File.generic_string();
+	to_lower(Lower);
+
+	if (!AlsoAddFile && File.has_extension())
 	{
-		auto mesh = pScene->mMeshes[node->mMeshes[i]];
-		if (mesh->mMaterialIndex >= 0)
+		// Only By Name Of File
+		auto Names = ByName.find(StringID::Find(path(Lower).filename().string()));
+		if (Names != ByName.end() && !Names->second.empty())
+			return Names->second.front();
+
+		return make_shared<File_system::File>();
+	}
+
+	if (File.has_extension())
+	{
+		auto Obj = Lookup(Lower);
+		if (Obj)
+			return Obj;
+	}
+	else
+	{
+		// The Same Order Of Extensions As Before: Models, Textures, Shaders, Sounds, XML, Scripts, Fonts
+		static const vector<string> Exts =
+		{
+			".obj", ".3ds", ".fbx",
+			".dds", ".png", ".bmp", ".jpg",
+			".hlsl", ".fx", ".vs", ".ps",
+			".wav",
+			".xml",
+			".lua",
+			".ttf"
+		};
+
+		// It's Only Name Without Extension
+		if (!File.has_parent_path())
 		{
-			aiMaterial *material = pScene->mMaterials[mesh->mMaterialIndex];
-			for (auto type = 0; (aiTextureType)type <= AI_TEXTURE_TYPE_MAX; type++)
+			auto Stems = ByStem.find(StringID::Find(Lower));
+			if (Stems != ByStem.end())
+				for (auto &Ext: Exts)
+					for (auto &Obj: Stems->second)
+						if (iequals(path(Obj->PathA).extension().string(), Ext))
+							return Obj;
+		}
+		else
+			for (auto &Ext: Exts)
 			{
-				for (UINT i = 0; i < material->GetTextureCount((aiTextureType)type); i++)
-				{
-					aiString str = {};
-					material->GetTexture((aiTextureType)type, i, &str);
-					if (str.C_Str() && str.data)
-						ListTextures.push_back(path(str.C_Str()).filename().string());
-				}
+				auto Obj = Lookup(Lower + Ext);
+				if (Obj)
+					return Obj;
 			}
-		}
-
 	}
-	for (UINT i = 0; i < node->mNumChildren; i++)
-		getListTexturesFromModel(node->mChildren[i], pScene, ListTextures);
+
+	return make_shared<File_system::File>();
+}
+
+const File_system::FileList &File_system::GetFileByType(_TypeOfFile T)
+{
+	return Catalog.at(T);
+}
+
+shared_ptr<File_system::File> File_system::GetFileByPath(path File)
+{
+	string lower = File.generic_string();
+	to_lower(lower);
+
+	return Lookup(lower);
+}
+
+shared_ptr<File_system::File> File_system::GetFile(path File)
+{
+	if (File.empty()) return shared_ptr<File_system::File>();
+
+	// It can be the full-path like this "C:/SommePath/Somme.obj" or only the name like this "Somme"
+	auto Obj = Find(File.generic_path());
+	if (Obj && Obj->Size > 0)
+		return Obj;
+
+	// if it was empty try to add to engine
+	return AddFile(File);
 }
 
 shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vector<pair<bool, string>>> &ListTextures)
@@ -858,7 +1005,6 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 			if (_Obj && _Obj->Size == 0 && !_Obj->HasTextures) // Find Our Undoned Files In AllFiles
 			{
 				// Copy Them And Change Them To Set Full-Path And Other
-				bool IsCreated = false;
 
 				//try
 				//{
@@ -871,31 +1017,16 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 					if (_Obj->PathA.empty())
 					{
 						path Path = pathType + delExt + "/" + Fname;
-
-						Textures.push_back(make_pair(make_shared<File_system::File>(Path.string(), ext, Fname,
-							(size_t)file_size(_File), T), Path.string()));
-						Textures.back().first->ExtW = Path.extension().wstring();
-						Textures.back().first->FileW = Path.filename().wstring();
-						Textures.back().first->PathW = Path.wstring();
-
-						IsCreated = true;
-						if (!exists(pathType + delExt))
-							create_directory(pathType + delExt);
-
-						copy(_File, Path);
+						if (!ImportTexture(_File, Path))
+							Intern(Path, _TypeOfFile::TEXTURES, 0);
 					}
 					else
 					{
-						if (!exists(pathType + delExt))
-							create_directory(pathType + delExt);
-
-						copy(_File, path(_Obj->PathA));
-					}
-
-					if (!IsCreated)
-					{
-						_Obj->HasTextures = true;
-						_Obj->Size = (size_t)file_size(_File);
+						// Undone File Becomes The Stored Texture Or An Alias Of The Same One
+						path Target = _Obj->PathA;
+						Forget(_Obj);
+						auto Imported = ImportTexture(_File, Target);
+						_Obj = Imported ? Imported : Intern(Target, _TypeOfFile::TEXTURES, 0);
 					}
 					// Anyway delete last element in list files to not to show it
 					if (ptr._Ptr)
@@ -939,7 +1070,7 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 	// It means that we have the path like this "Somme" or with full-path
 	if (!File.empty() && File.has_filename() && _Obj && _Obj->Size == 0)
 	{
-		if (!exists(_Obj->PathA))
+		if (!exists(File))
 		{
 			Engine::LogError("File System: File Doesn't Exist Or Found!\n",
 				string(__FILE__) + ": " + to_string(__LINE__),
@@ -965,10 +1096,9 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 		// Try To Find Some Textures From File And Add It To Queue Engine To Model
 		if (T == _TypeOfFile::MODELS)
 		{
-			auto importer = new Assimp::Importer;
-
-			auto pScene = importer->ReadFile(File.string(), 0);
-			if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode || !pScene->HasMeshes())
+			// Only References Are Read (Or Taken From The Manifest), The Model Is Imported When It's Loaded
+			vector<string> tmpList;
+			if (!GetDependencies(File, tmpList))
 			{
 				Engine::LogError("File System: Some Trouble With This File!\n",
 					string(__FILE__) + ": " + to_string(__LINE__),
@@ -977,8 +1107,6 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 			}
 			else
 			{
-				vector<string> tmpList;
-				getListTexturesFromModel(pScene->mRootNode, pScene, tmpList);
 				if (!tmpList.empty())
 					ListTextures.first = Fname;
 				else
@@ -988,10 +1116,11 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 
 				for (auto It : tmpList)
 				{
-					PathFile = getPathFromType(GetTypeFileByExt(It));
+					// PathFile Is Still Needed: Textures Are Taken From The Folder Of The Model
+					string TypePath = getPathFromType(GetTypeFileByExt(It));
 					string delExt = Fname; // Replace Ext
 					deleteWord(delExt, ext);
-					if (!exists(path(PathFile + delExt + "/" + It)))
+					if (!exists(path(TypePath + delExt + "/" + It)))
 						ListTextures.second.push_back(make_pair(false, It));
 				}
 			}
@@ -1007,11 +1136,7 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 				create_directory(pathType + delExt);
 
 			copy(File, path(Path));
-			Models.push_back(make_pair(make_shared<File_system::File>(Path.string(), ext, Fname,
-				exists(path(pathType + delExt)) ? (size_t)file_size(Path) : 0, T), Path.string()));
-			Models.back().first->ExtW = Path.extension().wstring();
-			Models.back().first->FileW = Path.filename().wstring();
-			Models.back().first->PathW = Path.wstring();
+			Track(Path, T, exists(path(pathType + delExt)) ? (size_t)file_size(Path) : 0);
 		}
 
 		delExt = Path.filename().string(); // Replace Ext
@@ -1032,15 +1157,9 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 				if (!exists(pathType + delExt))
 					create_directory(pathType + delExt);
 
-				if (exists(path(PathFile + "/" + Fname)))
-					copy(path(PathFile + "/" + Fname), path(Path));
-
-				Textures.push_back(make_pair(make_shared<File_system::File>(Path, ext, Fname,
-					exists(path(PathFile + "/" + Fname)) ? (size_t)file_size(Path) : 0, T,
-					exists(path(PathFile + "/" + Fname))), path(Path).string()));
-				Textures.back().first->ExtW = path(Path).extension().wstring();
-				Textures.back().first->FileW = path(Path).filename().wstring();
-				Textures.back().first->PathW = path(Path).wstring();
+				// Texture Which Is Already Stored (e.g. By Other Model) Becomes An Alias
+				if (!exists(path(PathFile + "/" + Fname)) || !ImportTexture(PathFile + "/" + Fname, Path))
+					Intern(Path, T, 0, false);
 			}
 			catch (boost::filesystem::filesystem_error const &e)
 			{
@@ -1056,81 +1175,9 @@ shared_ptr<File_system::File> File_system::AddFile(path File, pair<string, vecto
 	else if (_Obj && _Obj->Size > 0)
 		return _Obj;
 
-	switch (T)
-	{
-	case MODELS:
-		Models.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Models.back().first->ExtW = path(PathFile).extension().wstring();
-		Models.back().first->FileW = File.filename().wstring();
-		Models.back().first->PathW = path(PathFile).wstring();
-		return Models.back().first;
-		break;
-	case TEXTURES:
-		Textures.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Textures.back().first->ExtW = path(PathFile).extension().wstring();
-		Textures.back().first->FileW = File.filename().wstring();
-		Textures.back().first->PathW = path(PathFile).wstring();
-		return Textures.back().first;
-		break;
-	case LEVELS:
-		Levels.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Levels.back().first->ExtW = path(PathFile).extension().wstring();
-		Levels.back().first->FileW = File.filename().wstring();
-		Levels.back().first->PathW = path(PathFile).wstring();
-		return Levels.back().first;
-		break;
-	case DIALOGS:
-		Dialogs.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Dialogs.back().first->ExtW = path(PathFile).extension().wstring();
-		Dialogs.back().first->FileW = File.filename().wstring();
-		Dialogs.back().first->PathW = path(PathFile).wstring();
-		return Dialogs.back().first;
-		break;
-	case SOUNDS:
-		Sounds.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Sounds.back().first->ExtW = path(PathFile).extension().wstring();
-		Sounds.back().first->FileW = File.filename().wstring();
-		Sounds.back().first->PathW = path(PathFile).wstring();
-		return Sounds.back().first;
-		break;
-	case SHADERS:
-		Shaders.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Shaders.back().first->ExtW = path(PathFile).extension().wstring();
-		Shaders.back().first->FileW = File.filename().wstring();
-		Shaders.back().first->PathW = path(PathFile).wstring();
-		return Shaders.back().first;
-		break;
-	case UIS:
-		Uis.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Uis.back().first->ExtW = path(PathFile).extension().wstring();
-		Uis.back().first->FileW = File.filename().wstring();
-		Uis.back().first->PathW = path(PathFile).wstring();
-		return Uis.back().first;
-		break;
-	case SCRIPTS:
-		Scripts.push_back(make_pair(make_shared<File_system::File>(PathFile, path(PathFile).extension().string(),
-			Fname, (size_t)file_size(PathFile), T), PathFile));
-		Scripts.back().first->ExtW = path(PathFile).extension().wstring();
-		Scripts.back().first->FileW = File.filename().wstring();
-		Scripts.back().first->PathW = path(PathFile).wstring();
-		return Scripts.back().first;
-		break;
-	case FONTS:
-		Fonts.push_back(make_pair(make_shared<File_system::File>(PathFile, File.extension().string(),
-			Fname, (size_t)file_size(File), T), PathFile));
-		Fonts.back().first->ExtW = File.extension().wstring();
-		Fonts.back().first->FileW = File.filename().wstring();
-		Fonts.back().first->PathW = File.wstring().c_str();
-		return Fonts.back().first;
-		break;
-	}
+	T = GetTypeFileByExt(File);
+	if (T != _TypeOfFile::NONE && exists(File))
+		return Track(File, T, (size_t)file_size(File));
 
 	Engine::LogError("File System: ERROR_FILE_NOT_FOUND!\n",
 		string(__FILE__) + ": " + to_string(__LINE__),
@@ -1260,38 +1307,40 @@ string File_system::getDataFromFile(string File, string start, string end)
 	if (File.empty())
 		return "";
 
-	string Returned_val;
-	std::ifstream streamObj = std::ifstream(File.c_str());
-	streamObj >> noskipws;
-	if (streamObj.is_open())
+	TextLoader::Syntax S = TextLoader::Plain();
+	if (!start.empty() && !end.empty())
 	{
-		copy(istream_iterator<char>(streamObj), istream_iterator<char>(), std::back_inserter(Returned_val));
-
-		if (!Returned_val.empty())
-			if (!start.empty() & !end.empty())
-			{
-				deleteWord(Returned_val, start, end);
-				return Returned_val;
-			}
-			else
-				return Returned_val;
-		else
-		{
-			Engine::LogError("File System::getDataFromFile Failed!",
-				string(__FILE__) + ": " + to_string(__LINE__),
-				"File System: Something is wrong with File System Function (getDataFromFile)!");
-			return "";
-		}
+		S.BlockStart = start;
+		S.BlockEnd = end;
 	}
-	else
+
+	// Mapped File (Loose Or In The Archive) Is Copied Once, Comments Are Skipped While Copying
+	MappedFile Mapped(File, MappedFile::Sequential);
+	string Returned_val(Mapped.size(), '\0');
+	if (Mapped.IsOpen() && Mapped.size() > 0)
+		Returned_val.resize(TextLoader::Strip(reinterpret_cast<const char *>(Mapped.data()), Mapped.size(), S,
+			&Returned_val[0]));
+
+	if (Returned_val.empty())
+		Engine::LogError("File System::getDataFromFile Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"File System: Something is wrong with File System Function (getDataFromFile)!");
+
+	return Returned_val;
+}
+
+string_view File_system::getDataFromFile(string File, const TextLoader::Syntax &S, TextLoader::Arena &Into)
+{
+	MappedFile Mapped(File, MappedFile::Sequential);
+	if (!Mapped.IsOpen())
 	{
 		Engine::LogError("File System::getDataFromFile Failed!",
 			string(__FILE__) + ": " + to_string(__LINE__),
 			"File System: Something is wrong with File System Function (getDataFromFile)!");
-		return "";
+		return string_view();
 	}
 
-	return "";
+	return TextLoader::Load(reinterpret_cast<const char *>(Mapped.data()), Mapped.size(), S, Into);
 }
 
 vector<string> File_system::getDataFromFileVector(string File, bool LineByline)
@@ -1317,27 +1366,28 @@ vector<string> File_system::getDataFromFileVector(string File, bool LineByline)
 
 	return vector<string>();
 }
+const Pak::Entry *File_system::FindInArchive(string File)
+{
+	if (!Archive->IsOpen()) return nullptr;
+
+	return Archive->Find(ToKey(File));
+}
+
+bool File_system::ReadFromArchive(string File, vector<BYTE> &Data)
+{
+	auto It = FindInArchive(File);
+	return It && Archive->Read(It, Data);
+}
+
 bool File_system::ReadFileMemory(LPCSTR filename, size_t &FileSize, vector<BYTE> &FilePtr)
 {
-	if (!exists(filename) || file_size(filename) == 0) return false;
-	std::ifstream is(filename, ios::binary);
-	if (is)
-	{
-		is.unsetf(std::ios::skipws);
-		is.seekg(0, is.end);
-		FileSize = static_cast<size_t>(is.tellg());
-		is.seekg(0, is.beg);
-
-		FilePtr.reserve(FileSize+1);
-
-		// read the data:
-		FilePtr.insert(FilePtr.begin(),
-			std::istream_iterator<BYTE>(is),
-			std::istream_iterator<BYTE>());
-		FilePtr.push_back('\0');
-	}
-	else
-		return false;
+	MappedFile File(filename, MappedFile::Sequential);
+	if (!File.IsOpen() || File.size() == 0) return false;
+
+	FileSize = File.size();
+	FilePtr.reserve(FilePtr.size() + FileSize + 1);
+	FilePtr.insert(FilePtr.end(), File.data(), File.data() + FileSize);
+	FilePtr.push_back('\0');
 
 	return true;
 }
@@ -1451,15 +1501,15 @@ boost::property_tree::ptree File_system::LoadSettingsFile()
 {
 	if (!boost::filesystem::exists(GetCurrentPath() + "settings.cfg")) return boost::property_tree::ptree();
 
-	bool IfRead = false;
-	vector<BYTE> File; size_t Size = 0;
 	boost::property_tree::ptree fData;
-	if (IfRead = File_system::ReadFileMemory((GetCurrentPath() + "settings.cfg").c_str(), Size, File))
+	MappedFile File(GetCurrentPath() + "settings.cfg", MappedFile::Sequential);
+	if (File.IsOpen() && File.size() > 0)
 	{
-		string Data = reinterpret_cast<char *>(File.data());
+		// Only One Copy: Settings Are Case-Insensitive
+		string Data(File.View());
 		to_lower(Data);
 
-		std::istringstream ini(Data);
+		boost::iostreams::stream<boost::iostreams::array_source> ini(Data.data(), Data.size());
 		boost::property_tree::ini_parser::read_ini(ini, fData);
 	}
 
@@ -1481,110 +1531,205 @@ void File_system::SaveSettings(vector<pair<string, string>> ToFile)
 	boost::property_tree::ini_parser::write_ini(p.string(), fData);
 }
 
+// Chunks Are Compressed In Engine Thread Pool
+static ChunkedGzip::Runner getWorkers()
+{
+	if (!Application.operator bool() || !Application->getWorkers().operator bool())
+		return nullptr;
+
+	auto Workers = Application->getWorkers();
+	return [Workers](function<void()> Job) { Workers->AddJob(Job); };
+}
+
 bool File_system::compressFile(path data, string where)
 {
+	boost::system::error_code EC;
 	if (!where.empty())
-		boost::filesystem::create_directories(where);
-	try
+		boost::filesystem::create_directories(where, EC);
+
+	auto output = (!where.empty() ? (where + "/") : "") + data.filename().string() + ".gz";
+	OutputDebugStringA(("Writing " + output + "\n").c_str());
+
+	ChunkedGzip::Stats Info;
+	if (!ChunkedGzip::Compress(data, output, getWorkers(), Info))
 	{
-		std::ifstream file(data.string().c_str(), ios::binary | ios::in);
-		if (file)
-		{
-			boost::iostreams::filtering_streambuf<boost::iostreams::input> inbuf;
-			inbuf.push(gz_com(gzip_params(zlib::best_compression, zlib::deflated, zlib::default_window_bits,
-				zlib::default_mem_level, zlib::default_strategy, data.string(), "Comment")));
-			inbuf.push(file);
+		Engine::LogError("File System::compressFile Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"File System: Cannot Compress " + data.string());
+		return false;
+	}
 
-			auto output = (!where.empty() ? (where + "/") : "") + data.filename().string();
+	return true;
+}
 
-			if (gz_com *gz = inbuf.component<0, gz_com>())
-			{
-				OutputDebugStringA(("Writing " + output + "\n").c_str());
-				std::ofstream ofs(output.c_str(), std::ios::binary | ios::out);
-				ofs << '';
-				boost::iostreams::copy(inbuf, ofs);
-				rename(output, output + ".gz");
-			}
-		}
-		else
-			return false;
+bool File_system::decompressFile(path data, string where)
+{
+	boost::system::error_code EC;
+	if (!where.empty())
+		boost::filesystem::create_directories(where, EC);
 
-		return true;
+	// Original Name Is In The Header
+	string Name;
+	{
+		ChunkedGzip Reader;
+		if (Reader.Open(data))
+			Name = path(Reader.GetFileName()).filename().string();
 	}
-	catch (const gzip_error& e)
+	if (Name.empty())
+		Name = data.stem().string();
+
+	auto output = (!where.empty() ? (where + "/") : "") + Name;
+	OutputDebugStringA(("Writing " + output + "\n").c_str());
+
+	ChunkedGzip::Stats Info;
+	if (!ChunkedGzip::Decompress(data, output, getWorkers(), Info))
 	{
-		switch (e.error())
+		Engine::LogError("File System::decompressFile Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"File System: Cannot Decompress " + data.string());
+		return false;
+	}
+
+	return true;
+}
+
+bool File_system::compressFolder(path Folder, string where, bool Decompress)
+{
+	ChunkedGzip::Stats Info;
+	auto Log = [](string Text) { OutputDebugStringA((Text + "\n").c_str()); };
+	bool Result = Decompress ? ChunkedGzip::DecompressFolder(Folder, where, getWorkers(), Info, Log)
+		: ChunkedGzip::CompressFolder(Folder, where, getWorkers(), Info, Log);
+
+	Console::LogInfo((boost::format("File System: %s %d Files (%.2f MiB -> %.2f MiB) In %.2f Sec: %.2f MiB/s")
+		% (Decompress ? "Decompressed" : "Compressed") % Info.Files % (Info.Raw / (1024. * 1024.))
+		% (Info.Packed / (1024. * 1024.)) % Info.Seconds % Info.Throughput()).str());
+	if (!Result)
+		Engine::LogError("File System::compressFolder Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"File System: " + to_string(Info.Failed) + " Files Of " + Folder.string() + " Failed");
+
+	return Result;
+}
+
+static bool getStamp(const path &File, uint64_t &Size, int64_t &MTime)
+{
+	boost::system::error_code EC;
+	Size = (uint64_t)file_size(File, EC);
+	if (EC) return false;
+	MTime = (int64_t)last_write_time(File, EC);
+	return !EC;
+}
+
+bool File_system::GetDependencies(path Model, vector<string> &Textures)
+{
+	string Full = Model.generic_string();
+	if (!ModelDeps::IsSupported(Full))
+		return false;
+
+	Manifest::Dependency Dep;
+	Dep.Path = Full;
+	if (!getStamp(Model, Dep.Size, Dep.MTime))
+		return false;
+
+	StringID Key = StringID::Path(Full);
+	{
+		lock_guard<mutex> Lock(DepsLock);
+		auto It = Deps.find(Key);
+		if (It != Deps.end() && It->second.Size == Dep.Size && It->second.MTime == Dep.MTime)
 		{
-		case gzip::bad_header: // 4
-			throw exception("4");
-			break;
-		case gzip::bad_crc: // 2
-			throw exception("2");
-			break;
-		case gzip::bad_footer: // 5
-			throw exception("5");
-			break;
-		case gzip::bad_length: // 3
-			throw exception("3");
-			break;
-		case gzip::bad_method: // 6
-			throw exception("6");
-			break;
+			Textures = It->second.Files;
+			return true;
 		}
 	}
 
-	return false;
+	MappedFile Data(Full, MappedFile::Sequential);
+	ModelDeps::Result Result;
+	if (!Data.IsOpen() || !ModelDeps::Scan(Full, Data.View(), Result))
+		return false;
+
+	// Textures Are Looked For By Name: Near The Model And Then In The Resource Folder
+	for (auto &It: Result.Textures)
+	{
+		string Name = path(It).filename().string();
+		if (Name.empty()) continue;
+		if (find_if(Dep.Files.begin(), Dep.Files.end(), [&Name](const string &Other) { return iequals(Other, Name); })
+			== Dep.Files.end())
+			Dep.Files.push_back(Name);
+	}
+	Textures = Dep.Files;
+
+	lock_guard<mutex> Lock(DepsLock);
+	Deps[Key] = move(Dep);
+	DepsChanged = true;
+	return true;
 }
 
-bool File_system::decompressFile(path data, string where)
+void File_system::ScanDependencies(vector<path> Models, function<void()> Done)
 {
-	if (!where.empty())
-		boost::filesystem::create_directories(where);
-	try
+	auto Batch = make_shared<DepsBatch>();
+	Batch->Done = Done;
+	Batch->Left = Models.size();
+	DepsBatches.push_back(Batch);
+
+	auto Run = getWorkers();
+	for (auto &It: Models)
 	{
-		std::ifstream file(data.string().c_str(), ios::binary | ios::in);
-		boost::iostreams::filtering_streambuf<boost::iostreams::input> inbuf;
-		inbuf.push(gz_decom());
-		inbuf.push(file);
-		if (gz_decom *gz = inbuf.component<0, gz_decom>())
+		auto Job = [this, Batch, It]()
 		{
-			auto output = (!where.empty() ? (where + "/") : "") + data.filename().string();
-			{
-				OutputDebugStringA(("Writing " + output).c_str());
-				std::ofstream ofs(output.c_str(), std::ios::binary);
-				boost::iostreams::copy(inbuf, ofs);
-			}
-
-			OutputDebugStringA(("Original filename: " + gz->file_name() + "\n").c_str());
-			OutputDebugStringA(("Original mtime: " + to_string(gz->mtime()) + "\n").c_str());
-			OutputDebugStringA(("Zip comment: " + gz->comment() + "\n").c_str());
-			if (!gz->file_name().empty())
-				rename(output, where + "/" + path(gz->file_name()).filename().string());
-		}
+			vector<string> Textures;
+			GetDependencies(It, Textures);
+			Batch->Left--;
+		};
 
-		return true;
+		if (Run)
+			Run(Job);
+		else
+			Job();
 	}
-	catch (const gzip_error& e)
+}
+
+void File_system::UpdateDependencies()
+{
+	// Done May Start New Scans
+	vector<function<void()>> Finished;
+	for (auto It = DepsBatches.begin(); It != DepsBatches.end();)
 	{
-		switch (e.error())
+		if ((*It)->Left.load() == 0)
 		{
-		case gzip::bad_header: // 4
-			throw exception("4");
-			break;
-		case gzip::bad_crc: // 2
-			throw exception("2");
-			break;
-		case gzip::bad_footer: // 5
-			throw exception("5");
-			break;
-		case gzip::bad_length: // 3
-			throw exception("3");
-			break;
-		case gzip::bad_method: // 6
-			throw exception("6");
-			break;
+			Finished.push_back((*It)->Done);
+			It = DepsBatches.erase(It);
 		}
+		else
+			It++;
 	}
 
-	return false;
+	for (auto &Done: Finished)
+		if (Done)
+			Done();
+
+	if (DepsBatches.empty() && DepsChanged.exchange(false))
+		SaveManifest();
+}
+
+void File_system::SaveManifest()
+{
+	if (Snapshot.empty())
+		return;
+
+	vector<Manifest::Dependency> List;
+	{
+		lock_guard<mutex> Lock(DepsLock);
+		List.reserve(Deps.size());
+		for (auto &It: Deps)
+			List.push_back(It.second);
+	}
+
+	// Models Which Were Deleted Aren't Kept
+	List.erase(remove_if(List.begin(), List.end(), [](const Manifest::Dependency &Dep)
+	{
+		boost::system::error_code EC;
+		return !exists(Dep.Path, EC);
+	}), List.end());
+
+	Manifest::Save(GetCurrentPath() + ManifestFName.string(), WorkDirSourcesA, Snapshot, List);
 }
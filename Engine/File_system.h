@@ -12,11 +12,23 @@
 #include <fstream>
 #include <Boost/filesystem.hpp>
 #include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <map>
+#include <mutex>
+#include <atomic>
 #include <boost/iostreams/device/file.hpp>
+#include <boost/iostreams/device/array.hpp>
 #include <boost/iostreams/stream.hpp>
 #include <Boost/iostreams/filtering_streambuf.hpp>
 #include <Boost/iostreams/copy.hpp>
 #include <Boost/iostreams/filter/gzip.hpp>
+#include "Manifest.h"
+#include "Pak.h"
+#include "TextLoader.h"
+#include "StringID.h"
+#include "VFS.h"
+class Logger;
 using gz_com = boost::iostreams::gzip_compressor;
 using gz_decom = boost::iostreams::gzip_decompressor;
 
@@ -57,35 +69,38 @@ private:
 	struct File
 	{
 		File() {}
-		File(wstring PathW, wstring ExtW, wstring FileW, size_t Size, _TypeOfFile TypeOfFile,
-			bool HasTextures = false): PathW(PathW), ExtW(ExtW), FileW(FileW),
-			Size(Size), TypeOfFile(TypeOfFile), HasTextures(HasTextures) {}
-
 		File(string PathA, string ExtA, string FileA, size_t Size, _TypeOfFile TypeOfFile,
 			bool HasTextures = false): PathA(PathA), ExtA(ExtA), FileA(FileA),
 			Size(Size), TypeOfFile(TypeOfFile), HasTextures(HasTextures) {}
 
-		wstring PathW = L"", ExtW = L"", FileW = L"";
+		// Wide Path Is Made Only When Windows API Needs It
+		wstring getPathW() const { return path(PathA).wstring(); }
+
 		// Full Path To Required File
 		string PathA = "", ExtA = "", FileA = "";
+		// Interned Lower Case Path In The Catalog And Name Of File (See StringID.h)
+		StringID Key, Name;
 
 		bool HasTextures = false;
+		// File Is Served From The Archive (There's No Such File On Disk)
+		bool Packed = false;
+		// Path In The Catalog If It's An Alias (PathA Is The Stored File With The Same Content)
+		string AliasA = "";
 
 		size_t Size = 0;
+		// Hash Of The Content (0 If It Wasn't Needed Yet)
+		uint64_t Hash = 0;
 
 		_TypeOfFile TypeOfFile;
 	};
-	vector<pair<shared_ptr<File>, string/*IDPath*/>>
-		Models,
-		Textures,
-		Levels,
-		Dialogs,
-		Sounds,
-		Shaders,
-		Uis,
-		Scripts,
-		Fonts,
-		None;
+	using FileList = vector<pair<shared_ptr<File>, StringID/*Key*/>>;
+
+	/** \brief	Catalog Of Files Split By Type (Index Is _TypeOfFile) */
+	std::array<FileList, NONE + 1> Catalog;
+
+	/** \brief	Case-Insensitive Indexes Of The Catalog (Keys Are Interned Lower Case Strings) */
+	unordered_map<StringID, shared_ptr<File>> ByPath;
+	unordered_map<StringID, vector<shared_ptr<File>>> ByName, ByStem;
 
 	/** \brief	The Project For SDK */
 	shared_ptr<ProjectFile> Project = make_shared<ProjectFile>();
@@ -261,6 +276,28 @@ public:
 
 	void RescanFilesByType(_TypeOfFile T);
 
+	/**
+	 * \fn	shared_ptr<File> File_system::UpdateFile(path File);
+	 *
+	 * \brief	Apply created or modified file (or folder) to the catalog
+	 *
+	 * \param 	File	Full path to the file.
+	 *
+	 * \returns	The catalog entry (nullptr for folders and skipped files).
+	 */
+
+	shared_ptr<File> UpdateFile(path File);
+
+	/**
+	 * \fn	void File_system::RemoveFile(path File);
+	 *
+	 * \brief	Remove deleted file (or every file of deleted folder) from the catalog
+	 *
+	 * \param 	File	Full path to the file.
+	 */
+
+	void RemoveFile(path File);
+
 	/**
 	 * \fn	shared_ptr<AllFile::File> File_system::GetFile(path File);
 	 *
@@ -293,7 +330,7 @@ public:
 		pair<string, vector<pair<bool, string>>> &ListTextures = pair<string, vector<pair<bool, string>>>());
 
 	/**
-	 * \fn	vector<pair<shared_ptr<AllFile::File>, string>> File_system::GetFileByType(_TypeOfFile T);
+	 * \fn	const FileList &File_system::GetFileByType(_TypeOfFile T);
 	 *
 	 * \brief	Get File By Type
 	 *
@@ -302,10 +339,10 @@ public:
 	 *
 	 * \param 	T	A _TypeOfFile to process.
 	 *
-	 * \returns	The file by type.
+	 * \returns	View of the catalog for this type (don't keep it while adding files).
 	 */
 
-	vector<pair<shared_ptr<File>, string>> GetFileByType(_TypeOfFile T);
+	const FileList &GetFileByType(_TypeOfFile T);
 
 	/**
 	 * \fn	vector<wstring> File_system::getFilesInFolderW(wstring Folder);
@@ -390,6 +427,21 @@ public:
 
 	string getDataFromFile(string File, string start = "<!--", string end = "-->");
 
+	/**
+	 * \fn	string_view File_system::getDataFromFile(string File, const TextLoader::Syntax &S,
+	 * 		TextLoader::Arena &Into);
+	 *
+	 * \brief	Get Data From File Into Memory Of The Arena (Many Texts Are Freed At Once)
+	 *
+	 * \param 		  	File	Needed File.
+	 * \param 		  	S   	What Is Comment.
+	 * \param [in,out]	Into	The Arena.
+	 *
+	 * \returns	Text Without Comments (Ends With '\0').
+	 */
+
+	string_view getDataFromFile(string File, const TextLoader::Syntax &S, TextLoader::Arena &Into);
+
 	/**
 	 * \fn	vector<string> File_system::getDataFromFileVector(string File, bool LineByline);
 	 *
@@ -423,6 +475,97 @@ public:
 
 	static bool ReadFileMemory(LPCSTR filename, size_t &FileSize, vector<BYTE> &FilePtr);
 
+	/**
+	 * \fn	static bool File_system::ReadFromArchive(string File, vector<BYTE> &Data);
+	 *
+	 * \brief	Read file from the mounted archive (resource.pak)
+	 *
+	 * \param 		  	File	Full path (As If The File Was In Resource Folder) or relative path.
+	 * \param [in,out]	Data	Data of the file.
+	 *
+	 * \returns	True if the archive has this file.
+	 */
+
+	static bool ReadFromArchive(string File, vector<BYTE> &Data);
+
+	/**
+	 * \fn	static const Pak::Entry *File_system::FindInArchive(string File);
+	 *
+	 * \brief	Find file in the mounted archive
+	 *
+	 * \param 	File	Full path (As If The File Was In Resource Folder) or relative path.
+	 *
+	 * \returns	The entry or nullptr.
+	 */
+
+	static const Pak::Entry *FindInArchive(string File);
+	static shared_ptr<Pak> getArchive() { return Archive; }
+
+	/**
+	 * \fn	static VFS::Source File_system::Resolve(string File);
+	 *
+	 * \brief	Find the mount which gives the resource file (Patch, Mod, Resource Folder Or Archive)
+	 *
+	 * \param 	File	Full path (As If The File Was In Resource Folder) or relative path.
+	 *
+	 * \returns	The source (Not Found If No Mount Has It).
+	 */
+
+	static VFS::Source Resolve(string File);
+	static shared_ptr<VFS> getVFS() { return Mounts; }
+
+	/**
+	 * \fn	uint32_t File_system::MountFolder(string Folder, int Priority, string Name = "");
+	 *
+	 * \brief	Mount folder over (Or Under) the resource folder. Its files come to the catalog
+	 * 			at once, the resource folder isn't scanned again.
+	 *
+	 * \param 	Folder  	Full path to the folder.
+	 * \param 	Priority	Resource folder is 0, the archive is -1. Higher priority wins.
+	 * \param 	Name		(Optional) Name for diagnostics.
+	 *
+	 * \returns	ID of the mount (0 If It Failed).
+	 */
+
+	uint32_t MountFolder(string Folder, int Priority, string Name = "");
+	uint32_t MountPak(string File, int Priority);
+	uint32_t MountMemory(string Name, int Priority);
+	// File Of The Memory Mount (Path Is Relative To Resource Folder)
+	bool AddMemoryFile(uint32_t Mount, string File, vector<BYTE> Data);
+	bool Unmount(uint32_t Mount);
+	// Files Which Are Hidden By Mounts With Higher Priority
+	vector<VFS::Shadow> getShadows() { return Mounts->GetShadows(); }
+
+	/**
+	 * \fn	bool File_system::GetDependencies(path Model, vector<string> &Textures);
+	 *
+	 * \brief	Names of textures which the model refers to. The model isn't imported: references
+	 * 			are read by ModelDeps and kept in the manifest until the size or write time of
+	 * 			the model is changed. Can be called from any thread.
+	 *
+	 * \param 		  	Model   	Full path of the model.
+	 * \param [in,out]	Textures	Names of the textures (Without Folders).
+	 *
+	 * \returns	False if the model can't be read.
+	 */
+
+	bool GetDependencies(path Model, vector<string> &Textures);
+
+	/**
+	 * \fn	void File_system::ScanDependencies(vector<path> Models, function<void()> Done);
+	 *
+	 * \brief	Scan models on worker threads (e.g. Hundreds Of Dropped Models), so AddFile finds
+	 * 			their textures in the cache
+	 *
+	 * \param 	Models	Full paths of the models.
+	 * \param 	Done  	Called on the main thread (By UpdateDependencies) when every model was scanned.
+	 */
+
+	void ScanDependencies(vector<path> Models, function<void()> Done);
+
+	// Main Thread: Finish Scans Which Are Done, Save New Dependencies When Nothing Is Scanned
+	void UpdateDependencies();
+
 	/**
 	 * \fn	_TypeOfFile File_system::GetTypeFileByExt(path File);
 	 *
@@ -456,7 +599,12 @@ public:
 	static void CreateLog();
 	static void AddTextToLog(string Text, Type type);
 	static void OpenLog();
+	// Wait Until Every Record Is In The File
+	static void FlushLog();
+	static void CloseLog();
 	static void ClearLogs();
+	// Drop Counters And So On
+	static shared_ptr<Logger> getLogger();
 	// ********************************
 
 	/**
@@ -503,6 +651,18 @@ public:
 
 	string getPathFromType(_TypeOfFile T);
 
+	/**
+	 * \fn	vector<string> File_system::getSearchFolders(_TypeOfFile T);
+	 *
+	 * \brief	Folders of this type in every mounted folder (The Mount Which Wins Is First)
+	 *
+	 * \param 	T	A _TypeOfFile to process.
+	 *
+	 * \returns	Full paths with '/' at end.
+	 */
+
+	vector<string> getSearchFolders(_TypeOfFile T);
+
 	/**
 	 * \fn	auto File_system::GetProject()
 	 *
@@ -531,21 +691,193 @@ public:
 	boost::property_tree::ptree LoadSettingsFile();
 	void SaveSettings(vector<pair<string, string>> ToFile);
 
+	/**
+	 * \fn	bool File_system::compressFile(path data, string where = "");
+	 *
+	 * \brief	Compress file into data.gz (Chunks Are Compressed In Parallel, See ChunkedGzip)
+	 *
+	 * \param 	data 	The file.
+	 * \param 	where	(Optional) Output folder.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
 	bool compressFile(path data, string where = "");
 	bool decompressFile(path data, string where = "");
 
+	/**
+	 * \fn	bool File_system::compressFolder(path Folder, string where, bool Decompress = false);
+	 *
+	 * \brief	Compress (Or Decompress) every file of the folder into the same tree in where.
+	 * 			Throughput is written to the console.
+	 *
+	 * \param 	Folder	  	The folder.
+	 * \param 	where	  	Output folder.
+	 * \param 	Decompress	(Optional) Decompress .gz files of the folder.
+	 *
+	 * \returns	True if every file is done.
+	 */
+
+	bool compressFolder(path Folder, string where, bool Decompress = false);
+
+	/**
+	 * \struct	DedupReport
+	 *
+	 * \brief	What deduplication of textures saved since the engine was started
+	 */
+
+	struct DedupReport
+	{
+		size_t Stored = 0, Aliased = 0;
+		uint64_t SavedBytes = 0;
+		// Alias -> Stored File (Relative To Resource Folder)
+		vector<pair<string, string>> Aliases;
+	};
+	const DedupReport &getDedupReport() { return Dedup; }
+
 	string getWorkDirSourceA() { return WorkDirSourcesA; }
 	wstring getWorkDirSourceW() { return WorkDirSourcesW; }
 protected:
 	/** \brief	The work dir */
 	static path WorkDir;
-	/** \brief	The work dir resources Ansi */
-	string WorkDirSourcesA;
+	/** \brief	The work dir resources Ansi (Static: Lookups Of The Catalog Are Static Too) */
+	static string WorkDirSourcesA;
 	/** \brief	The work dir resources Wide */
 	wstring WorkDirSourcesW;
 
 	/** \brief	Name of the log file */
 	static path LogFName;
+	/** \brief	Name of the resource manifest (Cache Of Scanned Folders) */
+	static path ManifestFName;
+	/** \brief	Name of the resource archive (Loose Files In Resource Folder Override It) */
+	static path PakFName;
+	/** \brief	The mounted archive */
+	static shared_ptr<Pak> Archive;
+	/** \brief	Name of the list of texture aliases (In Resource Folder, So It Goes To The Archive) */
+	static path AliasFName;
+	/** \brief	Name of the list of mounts (Patches And Mods) Which Are Over The Resource Folder */
+	static path MountsFName;
+	/** \brief	Mounts Of Resource Files */
+	static shared_ptr<VFS> Mounts;
+	/** \brief	The Mount Of The Resource Folder */
+	uint32_t BaseMount = 0;
+
+	/** \brief	Folders Of The Last Scan (The Manifest Is Saved Again With New Dependencies) */
+	vector<Manifest::Folder> Snapshot;
+	/** \brief	Textures Of Models By Full Path */
+	unordered_map<StringID, Manifest::Dependency> Deps;
+	mutex DepsLock;
+	atomic<bool> DepsChanged{ false };
+	struct DepsBatch
+	{
+		atomic<size_t> Left{ 0 };
+		function<void()> Done;
+	};
+	vector<shared_ptr<DepsBatch>> DepsBatches;
+
+	DedupReport Dedup;
+
+	/**
+	 * \fn	shared_ptr<File> File_system::ImportTexture(path Source, path Target);
+	 *
+	 * \brief	Copy texture into resource folder. If there's already a texture with the same
+	 * 			content, nothing is copied and Target becomes its alias.
+	 *
+	 * \param 	Source	The texture.
+	 * \param 	Target	Full path in resource folder.
+	 *
+	 * \returns	The catalog entry (nullptr If It Can't Be Copied).
+	 */
+
+	shared_ptr<File> ImportTexture(path Source, path Target);
+
+	/**
+	 * \fn	shared_ptr<File> File_system::FindSameContent(path Source, _TypeOfFile T);
+	 *
+	 * \brief	Find stored file with the same content (Only Files Of The Same Size Are Hashed)
+	 *
+	 * \returns	The catalog entry or nullptr.
+	 */
+
+	shared_ptr<File> FindSameContent(path Source, _TypeOfFile T);
+
+	/**
+	 * \fn	shared_ptr<File> File_system::InternAlias(path Alias, shared_ptr<File> Stored);
+	 *
+	 * \brief	Add alias of the stored file to the catalog
+	 *
+	 * \param 	Alias 	Full path of the alias.
+	 * \param 	Stored	The stored file.
+	 *
+	 * \returns	The catalog entry of the alias.
+	 */
+
+	shared_ptr<File> InternAlias(path Alias, shared_ptr<File> Stored);
+	void LoadAliases();
+	void SaveAliases();
+
+	/**
+	 * \fn	void File_system::LoadMounts();
+	 *
+	 * \brief	Mount folders and archives of resource.mounts (Each Line: dir|pak Priority Path)
+	 */
+
+	void LoadMounts();
+
+	/**
+	 * \fn	shared_ptr<File> File_system::Publish(StringID Key);
+	 *
+	 * \brief	Put the file into the catalog as the winning mount gives it (Or Remove It If No
+	 * 			Mount Has It)
+	 *
+	 * \param 	Key	Interned path relative to resource folder.
+	 *
+	 * \returns	The catalog entry or nullptr.
+	 */
+
+	shared_ptr<File> Publish(StringID Key);
+
+	/**
+	 * \fn	static string File_system::ToKey(string File);
+	 *
+	 * \brief	Path of the catalog: lowercase, with '/' and relative to the resource folder
+	 *
+	 * \param 	File	Full path (As If The File Was In Resource Folder) or relative path.
+	 *
+	 * \returns	The key.
+	 */
+
+	static string ToKey(string File);
+
+	/**
+	 * \fn	shared_ptr<File> File_system::Track(path File, _TypeOfFile T, size_t Size, bool HasTextures = false);
+	 *
+	 * \brief	Add file of a mounted folder to its mount and to the catalog (Other Files Only To The Catalog)
+	 *
+	 * \returns	The catalog entry.
+	 */
+
+	shared_ptr<File> Track(path File, _TypeOfFile T, size_t Size, bool HasTextures = false);
+	void ListFile(const string &Folder, const Manifest::Entry &Obj);
+	void ReportShadows();
+	void SaveManifest();
+
+	/**
+	 * \fn	void File_system::ScanFolder(path Folder, int Parent, const Manifest &Cache,
+	 * 		vector<Manifest::Folder> &Folders, bool &Changed);
+	 *
+	 * \brief	Add files of the folder and its subfolders to the catalog. Folders which
+	 * 			weren't changed since the manifest was saved are taken from the manifest.
+	 *
+	 * \param 		  	Folder 	The folder.
+	 * \param 		  	Parent 	Index of the parent folder in Folders (-1 For Root).
+	 * \param 		  	Cache  	Manifest from the last run.
+	 * \param [in,out]	Folders	Folders for the new manifest.
+	 * \param [in,out]	Changed	Set to true if something was walked again.
+	 */
+
+	void ScanFolder(path Folder, int Parent, const Manifest &Cache, vector<Manifest::Folder> &Folders,
+		bool &Changed);
 
 	/**
 	 * \fn	shared_ptr<File_system::AllFile::File> File_system::Find(path File);
@@ -561,5 +893,42 @@ protected:
 	 */
 
 	shared_ptr<File_system::File> Find(path File, bool AlsoAddFile = true);
+
+	/**
+	 * \fn	shared_ptr<File> File_system::Intern(path File, _TypeOfFile T, size_t Size, bool HasTextures = false);
+	 *
+	 * \brief	Add file to the catalog and its indexes (or update it if this path is already there)
+	 *
+	 * \param 	File	   	Full path to the file.
+	 * \param 	T		   	Type of the file.
+	 * \param 	Size	   	Size of the file.
+	 * \param 	HasTextures	(Optional) True if textures of the file were found.
+	 *
+	 * \returns	The catalog entry.
+	 */
+
+	shared_ptr<File> Intern(path File, _TypeOfFile T, size_t Size, bool HasTextures = false);
+
+	/**
+	 * \fn	void File_system::Forget(shared_ptr<File> Obj);
+	 *
+	 * \brief	Remove file from the catalog and its indexes
+	 *
+	 * \param 	Obj	The catalog entry.
+	 */
+
+	void Forget(shared_ptr<File> Obj);
+
+	/**
+	 * \fn	shared_ptr<File> File_system::Lookup(string Lower);
+	 *
+	 * \brief	Find catalog entry by full path, path suffix or file name
+	 *
+	 * \param 	Lower	Generic path in lower case.
+	 *
+	 * \returns	The catalog entry or nullptr.
+	 */
+
+	shared_ptr<File> Lookup(string Lower);
 };
 #endif // !__FILE_SYSTEM_H__
@@ -0,0 +1,180 @@
+#include "FlightRecorder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <windows.h>
+
+using namespace std;
+
+FlightRecorder::Header *FlightRecorder::Map = nullptr;
+FlightRecorder::Record *FlightRecorder::Records = nullptr;
+void *FlightRecorder::File = INVALID_HANDLE_VALUE, *FlightRecorder::Mapping = nullptr;
+
+static const char Magic[4] = { 'D', 'S', 'F', 'R' };
+static const uint32_t Version = 1;
+
+bool FlightRecorder::Open(string FileName, uint32_t Capacity)
+{
+	if (Map || Capacity == 0)
+		return Map != nullptr;
+
+	// Keep The Last Run For Post-Mortem
+	string Old = FileName, Ext = ".flight";
+	auto Dot = Old.find_last_of('.');
+	if (Dot != string::npos && Old.find_first_of("/\\", Dot) == string::npos)
+	{
+		Ext = Old.substr(Dot);
+		Old.erase(Dot);
+	}
+	MoveFileExA(FileName.c_str(), (Old + ".1" + Ext).c_str(), MOVEFILE_REPLACE_EXISTING);
+
+	uint64_t Size = uint64_t(HeaderSize) + uint64_t(Capacity) * sizeof(Record);
+	File = CreateFileA(FileName.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (File == INVALID_HANDLE_VALUE)
+		return false;
+
+	Mapping = CreateFileMappingA(File, nullptr, PAGE_READWRITE, DWORD(Size >> 32), DWORD(Size), nullptr);
+	auto View = Mapping ? MapViewOfFile(Mapping, FILE_MAP_WRITE, 0, 0, SIZE_T(Size)) : nullptr;
+	if (!View)
+	{
+		if (Mapping)
+			CloseHandle(Mapping);
+		CloseHandle(File);
+		Mapping = nullptr;
+		File = INVALID_HANDLE_VALUE;
+		return false;
+	}
+
+	// The New File Is Zeroed: Every Slot Is Empty
+	auto Head = static_cast<Header *>(View);
+	memcpy(Head->Magic, Magic, sizeof(Magic));
+	Head->Version = Version;
+	Head->RecordSize = sizeof(Record);
+	Head->Capacity = Capacity;
+
+	LARGE_INTEGER Frequency, Ticks;
+	QueryPerformanceFrequency(&Frequency);
+	QueryPerformanceCounter(&Ticks);
+	Head->Frequency = uint64_t(Frequency.QuadPart);
+	Head->StartTicks = uint64_t(Ticks.QuadPart);
+
+	FILETIME Now;
+	GetSystemTimeAsFileTime(&Now);
+	Head->StartTime = (uint64_t(Now.dwHighDateTime) << 32) | Now.dwLowDateTime;
+	Head->ProcessID = GetCurrentProcessId();
+	Head->Clean = 0;
+	Head->Next.store(0);
+
+	Records = reinterpret_cast<Record *>(static_cast<uint8_t *>(View) + HeaderSize);
+	Map = Head;
+	return true;
+}
+
+void FlightRecorder::Close()
+{
+	if (!Map)
+		return;
+
+	Write(Event, "Closed");
+	Map->Clean = 1;
+
+	// Other Threads May Still Write, So The View Isn't Unmapped
+	FlushViewOfFile(Map, 0);
+}
+
+void FlightRecorder::Write(Kind Type, const char *Text, size_t Length)
+{
+	auto Head = Map;
+	if (!Head)
+		return;
+
+	uint64_t Number = Head->Next.fetch_add(1, memory_order_relaxed);
+	Record &It = Records[Number % Head->Capacity];
+
+	// The Slot Isn't Valid Until It's Finished
+	It.Sequence.store(0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	LARGE_INTEGER Ticks;
+	QueryPerformanceCounter(&Ticks);
+	It.Ticks = uint64_t(Ticks.QuadPart);
+	It.ThreadID = GetCurrentThreadId();
+	It.Type = Type;
+	It.Length = uint16_t(min<size_t>(Length, TextSize));
+	memcpy(It.Text, Text, It.Length);
+
+	It.Sequence.store(Number + 1, memory_order_release);
+}
+
+void FlightRecorder::MarkFrame(uint32_t Number, float Time)
+{
+	if (!Map)
+		return;
+
+	char Text[64];
+	int Length = snprintf(Text, sizeof(Text), "%u %.3f ms", Number, Time * 1000.f);
+	Write(Frame, Text, Length > 0 ? size_t(Length) : 0);
+}
+
+bool FlightRecorder::Decode(const uint8_t *Data, size_t Size, Dump &Out)
+{
+	if (!Data || Size < HeaderSize)
+		return false;
+
+	auto Head = reinterpret_cast<const Header *>(Data);
+	if (memcmp(Head->Magic, Magic, sizeof(Magic)) != 0 || Head->Version != Version ||
+		Head->RecordSize != sizeof(Record) || Head->Capacity == 0 ||
+		Size < uint64_t(HeaderSize) + uint64_t(Head->Capacity) * sizeof(Record))
+		return false;
+
+	Out.Frequency = Head->Frequency;
+	Out.StartTime = Head->StartTime;
+	Out.ProcessID = Head->ProcessID;
+	Out.Capacity = Head->Capacity;
+	Out.Clean = Head->Clean != 0;
+	Out.Entries.clear();
+
+	auto Slots = reinterpret_cast<const Record *>(Data + HeaderSize);
+	for (uint32_t i = 0; i < Head->Capacity; i++)
+	{
+		const Record &It = Slots[i];
+		uint64_t Sequence = It.Sequence.load();
+		if (Sequence == 0 || It.Type > Event)
+			continue;
+
+		Entry E;
+		E.Sequence = Sequence - 1;
+		E.Time = Head->Frequency ? double(int64_t(It.Ticks - Head->StartTicks)) / double(Head->Frequency) : 0.;
+		E.ThreadID = It.ThreadID;
+		E.Type = Kind(It.Type);
+		E.Text.assign(It.Text, min<size_t>(It.Length, TextSize));
+		Out.Entries.push_back(move(E));
+	}
+
+	sort(Out.Entries.begin(), Out.Entries.end(),
+		[](const Entry &A, const Entry &B) { return A.Sequence < B.Sequence; });
+
+	uint64_t Next = Head->Next.load();
+	Out.Lost = Next > Out.Entries.size() ? Next - Out.Entries.size() : 0;
+	return true;
+}
+
+const char *FlightRecorder::GetKindName(Kind Type)
+{
+	switch (Type)
+	{
+	case Normal:
+		return "normal";
+	case Information:
+		return "info";
+	case Error:
+		return "error";
+	case Frame:
+		return "frame";
+	case Event:
+		return "event";
+	}
+
+	return "unknown";
+}
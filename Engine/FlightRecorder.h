@@ -0,0 +1,143 @@
+/**
+ * \file	FlightRecorder.h.
+ *
+ * \brief	Declares the crash-safe ring buffer of the last engine events and its decoder
+ */
+
+#pragma once
+#if !defined(__FLIGHTRECORDER_H__)
+#define __FLIGHTRECORDER_H__
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * \class	FlightRecorder
+ *
+ * \brief	Records of fixed size are written into the ring buffer which is a mapped file,
+ * 			so they are in the file even if the engine crashes (The System Writes The Pages).
+ * 			Any thread writes without locks: it takes the next number of record, fills the
+ * 			slot and stores the number at the end, so the slot which was being written
+ * 			during the crash is skipped by the decoder.
+ * 			Used by the engine and by Tools/FlightDecoder, so it doesn't need pch.h.
+ */
+
+class FlightRecorder
+{
+public:
+	enum Kind: uint16_t
+	{
+		// The Same As Type Of Log
+		Normal = 0,
+		Information,
+		Error,
+		// Start Of Frame (Text Has Number And Time Of Frame)
+		Frame,
+		// Level Is Loaded, Engine Is Closed And So On
+		Event
+	};
+
+	static const uint32_t TextSize = 104;
+
+#pragma pack(push, 1)
+	struct Header
+	{
+		char Magic[4];
+		uint32_t Version, RecordSize, Capacity;
+		// QueryPerformanceCounter: Frequency And Ticks When The File Was Created
+		uint64_t Frequency, StartTicks;
+		// FILETIME (UTC) When The File Was Created
+		uint64_t StartTime;
+		uint32_t ProcessID, Clean;
+		// Number Of The Next Record
+		std::atomic<uint64_t> Next;
+	};
+
+	struct Record
+	{
+		// Number Of The Record + 1 (0: Empty Or Not Finished)
+		std::atomic<uint64_t> Sequence;
+		uint64_t Ticks;
+		uint32_t ThreadID;
+		uint16_t Type, Length;
+		char Text[TextSize];
+	};
+#pragma pack(pop)
+
+	static_assert(sizeof(Record) == 128, "Record Must Be 128 Bytes");
+
+	// Header Takes Whole Page, So Records Don't Share It
+	static const uint32_t HeaderSize = 4096;
+	static const uint32_t DefaultCapacity = 16384;
+
+	/**
+	 * \fn	static bool FlightRecorder::Open(std::string File, uint32_t Capacity = DefaultCapacity);
+	 *
+	 * \brief	Create the file and map it (The File Of The Last Run Is Renamed To *.1.flight)
+	 *
+	 * \param 	File		Full path to the file.
+	 * \param 	Capacity	(Optional) Count of records in the ring.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Open(std::string File, uint32_t Capacity = DefaultCapacity);
+
+	// Mark The File As Closed Without Crash And Write It (The Mapping Lives Until The Process Ends)
+	static void Close();
+
+	/**
+	 * \fn	static void FlightRecorder::Write(Kind Type, const char *Text, size_t Length);
+	 *
+	 * \brief	Record the text (It's Cut To TextSize). Does nothing if the file isn't opened.
+	 */
+
+	static void Write(Kind Type, const char *Text, size_t Length);
+	static void Write(Kind Type, const std::string &Text) { Write(Type, Text.data(), Text.size()); }
+	static void MarkFrame(uint32_t Number, float Time);
+
+	static bool IsOpen() { return Map != nullptr; }
+
+	struct Entry
+	{
+		uint64_t Sequence;
+		// Seconds Since The File Was Created
+		double Time;
+		uint32_t ThreadID;
+		Kind Type;
+		std::string Text;
+	};
+
+	struct Dump
+	{
+		uint64_t Frequency = 0, StartTime = 0;
+		uint32_t ProcessID = 0, Capacity = 0;
+		bool Clean = false;
+		// Records Which Were Overwritten By Newer Ones
+		uint64_t Lost = 0;
+		std::vector<Entry> Entries;
+	};
+
+	/**
+	 * \fn	static bool FlightRecorder::Decode(const uint8_t *Data, size_t Size, Dump &Out);
+	 *
+	 * \brief	Read records of the file in order of writing
+	 *
+	 * \param 		  	Data	Content of the file.
+	 * \param 		  	Size	Size of the file.
+	 * \param [in,out]	Out 	The result.
+	 *
+	 * \returns	False if it isn't the file of FlightRecorder.
+	 */
+
+	static bool Decode(const uint8_t *Data, size_t Size, Dump &Out);
+
+	static const char *GetKindName(Kind Type);
+private:
+	static Header *Map;
+	static Record *Records;
+	static void *File, *Mapping;
+};
+#endif // !__FLIGHTRECORDER_H__
@@ -15,11 +15,13 @@ extern shared_ptr<Engine> Application;
 //}
 
 GameObjects::Object::Object(string ID_TEXT, string ModelNameFile, shared_ptr<SimpleLogic> Logic,
-	TYPE type, Vector3 PosCoords, Vector3 ScaleCoords, Vector3 RotationCoords)
+	TYPE type, Vector3 PosCoords, Vector3 ScaleCoords, Vector3 RotationCoords, shared_ptr<Models> Loaded)
 {
-	// Set Up The Render Model
+	// Set Up The Render Model (It Can Be Loaded Already, e.g. By ModelBatch Of The Level)
 	auto File = Application->getFS()->GetFile(ModelNameFile);
-	if (File)
+	if (Loaded.operator bool())
+		model = Loaded;
+	else if (File)
 		model = make_shared<Models>(File->PathA);
 	if (!File || !model.operator bool() || model->getMeshes().empty())
 	{
@@ -40,7 +40,7 @@ public:
 		Object() {}
 		Object(string ID_TEXT, string ModelNameFile, shared_ptr<SimpleLogic> Logic,
 			TYPE type, Vector3 PosCoords = Vector3::Zero, Vector3 ScaleCoords = Vector3::Zero,
-			Vector3 RotationCoords = Vector3::Zero);
+			Vector3 RotationCoords = Vector3::Zero, shared_ptr<Models> Loaded = nullptr);
 
 		void SetID_TEXT(LPCSTR _ID_TEXT) { ID_TEXT = _ID_TEXT; }
 
@@ -0,0 +1,81 @@
+#include "InstanceQueue.h"
+
+#include <algorithm>
+
+using namespace std;
+
+void InstanceQueue::Add(const void *Mesh, size_t Level, const float *World)
+{
+	if (!Mesh || !World)
+		return;
+
+	auto It = Find.find({ Mesh, Level });
+	if (It == Find.end())
+	{
+		It = Find.insert({ { Mesh, Level }, Groups.size() }).first;
+		Groups.emplace_back();
+		Groups.back().Mesh = Mesh;
+		Groups.back().Level = Level;
+	}
+
+	auto &Worlds = Groups.at(It->second).Worlds;
+	Worlds.insert(Worlds.end(), World, World + 16);
+	Count++;
+}
+
+InstanceQueue::Stats InstanceQueue::Flush(Backend &Device)
+{
+	Stats Result;
+	Result.Instances = Count;
+	Result.Groups = Groups.size();
+
+	// Draws Of The Written Buffer: Group, Its First Instance In The Buffer And Count
+	struct Pending
+	{
+		const Group *From;
+		size_t First, Count;
+	};
+	vector<Pending> Draws;
+	size_t Capacity = max(Device.getCapacity(), (size_t)1);
+	auto Submit = [&] ()
+	{
+		if (Draws.empty())
+			return;
+
+		Device.Write(Staging.data(), Staging.size() / 16);
+		Result.Writes++;
+		for (auto &It: Draws)
+			Device.Draw(It.From->Mesh, It.From->Level, It.First, It.Count);
+		Result.Draws += Draws.size();
+
+		Staging.clear();
+		Draws.clear();
+	};
+
+	Staging.clear();
+	for (auto &It: Groups)
+	{
+		size_t Total = It.Worlds.size() / 16, Done = 0;
+		while (Done < Total)
+		{
+			if (Staging.size() / 16 == Capacity)
+				Submit();
+
+			size_t First = Staging.size() / 16, Take = min(Total - Done, Capacity - First);
+			Staging.insert(Staging.end(), It.Worlds.begin() + Done * 16, It.Worlds.begin() + (Done + Take) * 16);
+			Draws.push_back({ &It, First, Take });
+			Done += Take;
+		}
+	}
+	Submit();
+
+	Clear();
+	return Result;
+}
+
+void InstanceQueue::Clear()
+{
+	Groups.clear();
+	Find.clear();
+	Count = 0;
+}
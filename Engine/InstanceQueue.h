@@ -0,0 +1,84 @@
+/**
+ * \file	InstanceQueue.h.
+ *
+ * \brief	Declares the instance queue (Copies Of Meshes Drawn By One Call)
+ */
+
+#pragma once
+#if !defined(__INSTANCEQUEUE_H__)
+#define __INSTANCEQUEUE_H__
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \class	InstanceQueue
+ *
+ * \brief	Models of the frame add their meshes with world matrices, Flush groups them by the mesh
+ * 			and its level of detail (In The Order Of The First Copy) and draws each group once:
+ * 			matrices of groups are written into the instance buffer one after another. If the
+ * 			buffer is smaller than the frame, it's written again and groups go on from its start.
+ * 			Device calls go through Backend, so tests record them instead of drawing.
+ * 			Used by the engine and by tests, so it doesn't need pch.h.
+ */
+
+class InstanceQueue
+{
+public:
+	// Calls Which Draw Groups: Direct3D 11 In The Engine, Recorded By Tests
+	class Backend
+	{
+	public:
+		virtual ~Backend() {}
+		// Instances Which The Buffer Holds
+		virtual size_t getCapacity() = 0;
+		// Matrices (16 Floats Each, Row Vectors Are Multiplied By Them) Are Written From The Start Of The Buffer
+		virtual void Write(const float *Worlds, size_t Count) = 0;
+		// Draw The Level Of The Mesh For Instances [First, First + Count) Of The Buffer
+		virtual void Draw(const void *Mesh, size_t Level, size_t First, size_t Count) = 0;
+	};
+	struct Stats
+	{
+		size_t Instances = 0, Groups = 0, Draws = 0, Writes = 0;
+	};
+
+	// Mesh Must Live Until Flush (It's Done In The Same Frame)
+	void Add(const void *Mesh, size_t Level, const float *World);
+	// Draw Every Group And Forget Them
+	Stats Flush(Backend &Device);
+	void Clear();
+
+	size_t size() const { return Count; }
+
+private:
+	struct Group
+	{
+		const void *Mesh = nullptr;
+		size_t Level = 0;
+		std::vector<float> Worlds;
+	};
+	struct Key
+	{
+		const void *Mesh;
+		size_t Level;
+
+		bool operator==(const Key &Other) const { return Mesh == Other.Mesh && Level == Other.Level; }
+	};
+	struct KeyHash
+	{
+		size_t operator()(const Key &It) const
+		{
+			return std::hash<const void *>()(It.Mesh) ^ (std::hash<size_t>()(It.Level) << 1);
+		}
+	};
+
+	std::vector<Group> Groups;
+	std::unordered_map<Key, size_t, KeyHash> Find;
+	size_t Count = 0;
+	// Matrices Of The Next Write (Kept, So Frames Don't Allocate It)
+	std::vector<float> Staging;
+};
+#endif // !__INSTANCEQUEUE_H__
@@ -9,13 +9,29 @@ extern shared_ptr<Engine> Application;
 #include "Camera.h"
 #include "Models.h"
 #include "SimpleLogic.h"
+#include "ModelBatch.h"
+#include "FlightRecorder.h"
+
+// A Cluster Mustn't Span The Whole Level: Then Nothing Of It Is Culled
+StaticBatcher::Settings Levels::Batching = { 65535, 100.f };
+
+// Transform Of The Object Is Given To Its Model (Scale And Rotation If It Has Them)
+static void PlaceModel(GameObjects::Object &It)
+{
+	auto Model = It.GetModel();
+	if (It.GetScale())
+		Model->setScale(It.GetScaleCord());
+	if (It.GetRotation())
+		Model->setRotation(It.GetRotCord());
+	Model->setPosition(It.GetPositionCord());
+}
 
 //vector<shared_ptr<GameObjects::Object>> Levels::Obj_other, Levels::Obj_npc;
 //vector<string> Levels::IDModels;
 
 HRESULT Levels::Load(string FileBuff)
 {
-	deleteWord(FileBuff, string("<!--"), string("-->"));
+	TextLoader::Strip(FileBuff, TextLoader::XML());
 
 	if (doc->Parse(FileBuff.c_str()) > 0)
 	{
@@ -41,6 +57,8 @@ HRESULT Levels::Load(string FileBuff)
 		return E_FAIL;
 	}
 	Process();
+	FlightRecorder::Write(FlightRecorder::Event, (boost::format("Level Is Loaded (Objects: %d)")
+		% MainChild->GetNodes().size()).str());
 	return S_OK;
 }
 
@@ -75,8 +93,50 @@ void Levels::Reload_Level(string File)
 	//LoadXML(File);
 }
 
+void Levels::ReloadModel(string File)
+{
+	string Name = path(File).filename().string();
+	to_lower(Name);
+	// The First Model Is Loaded Again, The Others Get Its Meshes
+	Models::ForgetModel(File);
+
+	for (auto &It: MainChild->GetNodes())
+	{
+		if (!It->GM.operator bool() || !It->GM->GetModel().operator bool()) continue;
+
+		string Other = It->GM->GetModelNameFile();
+		to_lower(Other);
+		if (Other == Name)
+			It->GM->GetModel()->Reload(File);
+	}
+	MainChild->ChangeStatic();
+}
+
+void Levels::ReloadTexture(string File)
+{
+	string Name = path(File).filename().string();
+	Models::ForgetTexture(File);
+
+	for (auto &It: MainChild->GetNodes())
+	{
+		if (!It->GM.operator bool() || !It->GM->GetModel().operator bool()) continue;
+
+		auto Obj = Application->getFS()->GetFile(It->GM->GetModelNameFile());
+		if (It->GM->GetModel()->UsesTexture(Name) && Obj && !Obj->PathA.empty())
+			It->GM->GetModel()->Reload(Obj->PathA);
+	}
+	MainChild->ChangeStatic();
+}
+
 void Levels::Process()
 {
+	// Objects Of The Previous Load Are Made First
+	if (Loading.operator bool())
+	{
+		Loading->Wait();
+		FinishLoading();
+	}
+
 	bool IsModels = true, IsSobjs = true; // If do not then abort create new nodes
 
 	XMLNode *scene = doc->FirstChildElement("scene"), // We're now at <scene>
@@ -100,6 +160,8 @@ void Levels::Process()
 		IsModels = false;
 
 	vector<XMLElement *> Models, S_objs;
+	// Files Of Models In The Order Of The Level
+	vector<string> Files;
 	if (IsModels)
 	{
 		for (;;)
@@ -217,20 +279,58 @@ void Levels::Process()
 			}
 		}
 
-		// Check if the model has in resource of engine then add it to level
-		if (exists(Application->getFS()->getPathFromType(_TypeOfFile::MODELS) + ModelFileName))
-			Add(make_shared<GameObjects::Object>(ModelID, ModelFileName, nullptr,
-				type, Pos, Scale, Rotate))->RenderName = NameOfNode.empty() ? ModelID : NameOfNode;
+		// Check if the model has in resource of engine (Or In Any Mount) then add it to level
+		string ModelPath = Application->getFS()->getPathFromType(_TypeOfFile::MODELS) + ModelFileName;
+		if (File_system::Resolve(ModelPath).IsFound() || exists(ModelPath))
+		{
+			string RenderName = NameOfNode.empty() ? ModelID : NameOfNode;
+			auto Create = [this, ModelID, ModelFileName, RenderName, type, Pos, Scale, Rotate]
+				(shared_ptr<::Models> Loaded)
+			{
+				auto Node = Add(make_shared<GameObjects::Object>(ModelID, ModelFileName, nullptr,
+					type, Pos, Scale, Rotate, Loaded));
+				if (Node.operator bool())
+					Node->RenderName = RenderName;
+			};
+
+			auto File = Application->getFS()->GetFile(ModelFileName);
+			Files.push_back(File.operator bool() ? File->PathA : ModelPath);
+			Pending.push_back(Create);
+		}
 		else
 			Engine::LogError((boost::format("Model: %s wasn't find in resources Engine and be skiped") % ModelFileName).str(),
 				string(__FILE__) + ": " + to_string(__LINE__),
 				(boost::format("Model: %s wasn't find in resources Engine and be skiped") % ModelFileName).str());
 		I++;
 	}
+
+	// Models Are Loaded By Workers And Objects Are Made In One Of The Next Frames (Update)
+	if (!Files.empty())
+		Loading = make_shared<ModelBatch>(Files);
+}
+
+void Levels::FinishLoading()
+{
+	// In The Order Of The Level, Whichever Model Was Prepared First
+	for (size_t i = 0; i < Pending.size(); i++)
+		Pending.at(i)(Loading->Make(i));
+	MainChild->MakeStatic();
+
+	Loading->LogTimings("Level");
+	FlightRecorder::Write(FlightRecorder::Event, (boost::format("Models Of The Level Are Made (Objects: %d)")
+		% MainChild->GetNodes().size()).str());
+	Loading.reset();
+	Pending.clear();
 }
 
 void Levels::Update()
 {
+	if (Loading.operator bool() && Loading->Update())
+		FinishLoading();
+
+	// Textures Of Made Models Reach The Device Over Next Frames
+	Models::UploadTextures();
+
 	if (MainChild)
 		MainChild->Update();
 }
@@ -239,7 +339,7 @@ shared_ptr<Levels::Node> Levels::Add(string PathModel)
 {
 	shared_ptr<Node> nd = make_shared<Node>();
 
-	nd->ID = to_string(Objects.size());
+	nd->SetID(to_string(Objects.size()));
 	nd->RenderName = path(PathModel).filename().string();
 	nd->GM = make_shared<GameObjects::Object>(nd->ID, nd->RenderName,
 		nullptr, Model, Vector3::Zero, Vector3::One, Vector3::Zero);
@@ -253,7 +353,7 @@ shared_ptr<Levels::Node> Levels::Add(shared_ptr<GameObjects::Object> GM)
 {
 	shared_ptr<Node> nd = make_shared<Node>();
 
-	nd->ID = GM->GetIdText();
+	nd->SetID(GM->GetIdText());
 	nd->RenderName = GM->GetModelNameFile();
 	nd->GM = GM;
 	if (nd->GM->GetIdText().empty())
@@ -291,12 +391,17 @@ void Levels::Remove(string ID)
 
 void Levels::Destroy()
 {
+	// Models Which Are Still Loaded Aren't Added
+	Loading.reset();
+	Pending.clear();
+
 	for (auto It: MainChild->GetNodes())
 	{
 		MainChild->DeleteNode(It->ID);
 		if (Application->getSound())
 			Application->getSound()->Remove(It->ID);
 	}
+	MainChild->MakeStatic();
 	if (doc)
 		doc->Clear();
 
@@ -518,8 +623,8 @@ shared_ptr<Levels::Node> Levels::Child::AddNewNode(shared_ptr<Node> ND)
 {
 	for (auto It: Nodes)
 	{
-		if (It->ID == ND->ID)
-			ND->ID = "$" + ND->ID;
+		if (It->Key == ND->Key)
+			ND->SetID("$" + ND->ID);
 	}
 	Nodes.push_back(ND);
 	return Nodes.back();
@@ -532,6 +637,7 @@ void Levels::Child::DeleteNode(string ID)
 		if (ID == Nodes.at(i)->ID)
 		{
 			//Nodes.at(i)->GM->Destroy();
+			StaticChanged = StaticChanged || Nodes.at(i)->IsStatic;
 			Nodes.erase(Nodes.begin() + i);
 		}
 	}
@@ -539,9 +645,24 @@ void Levels::Child::DeleteNode(string ID)
 
 void Levels::Child::Update()
 {
+	// Far Models Are Drawn With Less Triangles (Error Of Their Level Is Less Than a Pixel)
+	auto Camera = Application->getCamera();
+	float ScreenHeight = (float)Application->getWorkAreaSize(Application->GetHWND()).y;
+
 	for (size_t i = 0; i < Nodes.size(); i++)
 	{
 		auto it = Nodes.at(i)->GM;
+		if (Nodes.at(i)->IsStatic)
+		{
+			// Objects Which Move, Get Logic Or Are Hidden Leave The Batch
+			PlaceModel(*it);
+			if (!it->GetLogic().operator bool() && it->RenderIt && !Nodes.at(i)->SaveInfo->IsRemoved &&
+				it->GetModel()->getWorld() == Nodes.at(i)->StaticWorld)
+				continue;
+
+			Nodes.at(i)->IsStatic = false;
+			StaticChanged = true;
+		}
 		if (!it->RenderIt || Nodes.at(i)->SaveInfo->IsRemoved)
 			continue;
 
@@ -553,19 +674,56 @@ void Levels::Child::Update()
 
 		it->UpdateLogic(Application->getframeTime());
 		Model->setPosition(it->GetPositionCord());
-		Model->Render(Application->getCamera()->GetViewMatrix(), Application->getCamera()->GetProjMatrix());
+		Model->SelectLod(Camera->GetEyePt(), Camera->GetProjMatrix(), ScreenHeight);
+		Model->Render(Camera->GetViewMatrix(), Camera->GetProjMatrix());
+	}
+
+	if (StaticChanged)
+		BuildStatic();
+	if (Static.operator bool())
+	{
+		Frustum View;
+		View.ConstructFrustum(Camera->GetFarClip(), Camera->GetProjMatrix(), Camera->GetViewMatrix());
+		Static->Cull(View);
+		Static->Render(Camera->GetViewMatrix(), Camera->GetProjMatrix());
 	}
+
+	// Copies Which Models Added Are Drawn Together
+	Models::FlushInstances(Camera->GetViewMatrix(), Camera->GetProjMatrix());
+}
+
+void Levels::Child::MakeStatic()
+{
+	for (auto &It: Nodes)
+		It->IsStatic = It->GM.operator bool() && It->GM->GetType() == GameObjects::TYPE::Model &&
+			It->GM->GetModel().operator bool() && !It->GM->GetModel()->getMeshes().empty() &&
+			!It->GM->GetLogic().operator bool() && It->GM->RenderIt && !It->SaveInfo->IsRemoved;
+	BuildStatic();
+}
+
+void Levels::Child::BuildStatic()
+{
+	StaticChanged = false;
+
+	vector<shared_ptr<Models>> Merged;
+	for (auto &It: Nodes)
+		if (It->IsStatic)
+		{
+			PlaceModel(*It->GM);
+			It->StaticWorld = It->GM->GetModel()->getWorld();
+			Merged.push_back(It->GM->GetModel());
+		}
+
+	Static = Merged.empty() ? nullptr : Models::MakeStatic(Merged, Batching);
 }
 
 shared_ptr<Levels::Node> Levels::Child::getNodeByID(string ID)
 {
-	to_lower(ID);
-	for (auto it: Nodes)
-	{
-		to_lower(it->ID);
-		if (ID == it->ID)
-			return it;
-	}
+	StringID Key = StringID::Find(ID);
+	if (!Key.IsEmpty())
+		for (auto &it: Nodes)
+			if (it->Key == Key)
+				return it;
 
 	return make_shared<Node>();
 }
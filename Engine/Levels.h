@@ -4,10 +4,13 @@
 #include "pch.h"
 
 #include "GameObjects.h"
+#include "StringID.h"
+#include "StaticBatcher.h"
 
 enum _TypeOfFile;
 
 class SimpleLogic;
+class ModelBatch;
 class Levels: public GameObjects
 {
 private:
@@ -28,15 +31,26 @@ private:
 
 		shared_ptr<GameObjects::Object> GM = make_shared<GameObjects::Object>();
 
+		void SetID(string NewID) { ID = NewID; Key = StringID(ID); }
+
 		bool IsItChanged = false; // Needed To Save Action
-		string ID; // Only ID Of Node
+		string ID; // Only ID Of Node (Set It By SetID)
+		StringID Key; // Interned Lower Case ID To Find The Node
 		string RenderName;
 		shared_ptr<NewInfo> SaveInfo = make_shared<NewInfo>();
+		// Drawn By The Static Batch Of The Level: The Transform Which Was Merged
+		bool IsStatic = false;
+		Matrix StaticWorld;
 	};
 	struct Child
 	{
 	private:
 		vector<shared_ptr<Node>> Nodes;
+		// Clusters Of Objects Which Don't Move (A Draw Call Per Texture And Place), Made Again When
+		// Some Of Them Moves, Gets Logic Or Is Removed (It's Drawn By Itself Then)
+		shared_ptr<Models> Static;
+		bool StaticChanged = false;
+		void BuildStatic();
 
 	public:
 		shared_ptr<Node> AddNewNode(shared_ptr<Node> ND);
@@ -44,14 +58,24 @@ private:
 		void Update();
 		auto GetNodes() { return Nodes; }
 		shared_ptr<Node> getNodeByID(string ID);
+		// Objects Which Have Models And No Logic Are Drawn By The Static Batch
+		void MakeStatic();
+		// Models Of Objects Are Loaded Again: Clusters Are Made Again
+		void ChangeStatic() { StaticChanged = true; }
 	};
 	shared_ptr<Child> MainChild = make_shared<Child>(); // It's a Main Scene
 public:
+	// Clusters Of The Static Batch (settings.cfg: [static] max_extent), They're Culled By Their Bounds
+	static StaticBatcher::Settings Batching;
+
 	HRESULT Init();
 
 	HRESULT Load(string FileBuff);
 	void Process();
 	void Reload_Level(string File);
+	// Hot Reload: Load Again Models Which Use This Model Or Texture File
+	void ReloadModel(string File);
+	void ReloadTexture(string File);
 	void Update();
 
 	shared_ptr<Node> Add(string PathModel);
@@ -75,5 +99,10 @@ protected:
 	shared_ptr<tinyxml2::XMLDocument> doc = make_shared<tinyxml2::XMLDocument>();
 	static void Spawn(/*Vector3 pos, GameObjects::TYPE type*/);
 	bool NotSaved = false;
+
+	// Models Of The Level Which Workers Load, Objects Are Made By Update In The Order Of The File
+	shared_ptr<ModelBatch> Loading;
+	vector<function<void(shared_ptr<Models>)>> Pending;
+	void FinishLoading();
 };
 #endif // !__LEVELS__H_
@@ -0,0 +1,230 @@
+#include "pch.h"
+
+#include "Logger.h"
+
+using namespace boost::filesystem;
+
+Logger::Logger()
+{
+	for (auto &It: Dropped)
+		It = 0;
+
+	// Records Can Be Pushed Before Start(): They Wait For The File
+	Tail = new Node;
+	Head = Tail;
+}
+
+Logger::~Logger()
+{
+	Stop();
+
+	while (Node *It = Pop())
+		Queued--;
+	delete Tail;
+}
+
+bool Logger::Start(path File)
+{
+	if (Running)
+		return true;
+
+	FileName = File;
+	if (!OpenFile())
+		return false;
+
+	Running = true;
+	Writer = thread([this]() { Run(); });
+	return true;
+}
+
+void Logger::Stop()
+{
+	if (!Running.exchange(false))
+		return;
+
+	Wake.notify_one();
+	if (Writer.joinable())
+		Writer.join();
+
+	if (File)
+	{
+		fclose(File);
+		File = nullptr;
+	}
+}
+
+bool Logger::Push(string Text, Type type)
+{
+	// Full Queue: The Writer Can't Keep Up, So Don't Make It Worse
+	if (Queued.fetch_add(1) >= Capacity)
+	{
+		Queued--;
+		Dropped.at(type)++;
+		return false;
+	}
+
+	auto It = new Node;
+	It->Text = move(Text);
+	It->type = type;
+
+	Node *Prev = Head.exchange(It, memory_order_acq_rel);
+	Prev->Next.store(It, memory_order_release);
+	Pushed++;
+
+	// Errors Must Be In The File Even If The Engine Crashes Right After
+	if ((type == Error || Queued >= Capacity / 2) && !Urgent.exchange(true))
+		Wake.notify_one();
+
+	return true;
+}
+
+void Logger::Flush()
+{
+	if (!Running)
+		return;
+
+	size_t Target = Pushed;
+	Urgent = true;
+	Wake.notify_one();
+
+	unique_lock<mutex> Guard(Lock);
+	Done.wait(Guard, [this, Target]() { return Written >= Target || !Running; });
+}
+
+void Logger::Clear()
+{
+	if (!Running)
+	{
+		boost::system::error_code EC;
+		boost::filesystem::remove(FileName, EC);
+		return;
+	}
+
+	NeedClear = true;
+	Urgent = true;
+	Wake.notify_one();
+
+	unique_lock<mutex> Guard(Lock);
+	Done.wait(Guard, [this]() { return !NeedClear || !Running; });
+}
+
+Logger::Node *Logger::Pop()
+{
+	Node *Next = Tail->Next.load(memory_order_acquire);
+	if (!Next)
+		return nullptr;
+
+	// Next Has The Record And Becomes The Stub
+	delete Tail;
+	Tail = Next;
+	return Next;
+}
+
+void Logger::Run()
+{
+	for (;;)
+	{
+		{
+			unique_lock<mutex> Guard(Lock);
+			Wake.wait_for(Guard, chrono::milliseconds(FlushMs), [this]() { return !Running || Urgent; });
+		}
+		bool Stopping = !Running;
+		Urgent = false;
+
+		if (NeedClear)
+		{
+			if (File)
+				fclose(File);
+			File = nullptr;
+
+			boost::system::error_code EC;
+			boost::filesystem::remove(FileName, EC);
+			for (int i = 1; i <= Keep; i++)
+				boost::filesystem::remove(FileName.parent_path() / (FileName.stem().string() + "." + to_string(i) +
+					FileName.extension().string()), EC);
+
+			OpenFile();
+			NeedClear = false;
+		}
+
+		while (Node *It = Pop())
+		{
+			// Formatting Is Done Here, Not In The Thread Which Logs
+			string Text = move(It->Text);
+			ParseText(Text, It->type);
+			Write(Text);
+
+			Queued--;
+			Written++;
+		}
+
+		size_t Lost = Dropped.at(Normal) + Dropped.at(Information) + Dropped.at(Error);
+		if (Lost != Reported)
+		{
+			Write((boost::format("\n[INFO] Logger: %d Records Were Dropped (Errors: %d)\n")
+				% (Lost - Reported) % Dropped.at(Error)).str());
+			Reported = Lost;
+		}
+
+		if (File)
+			fflush(File);
+
+		{
+			lock_guard<mutex> Guard(Lock);
+		}
+		Done.notify_all();
+
+		if (Stopping)
+			return;
+	}
+}
+
+void Logger::Write(const string &Text)
+{
+	if (!File || Text.empty())
+		return;
+
+	fwrite(Text.data(), 1, Text.size(), File);
+	FileSize += Text.size();
+	if (FileSize >= MaxSize)
+		Rotate();
+}
+
+void Logger::Rotate()
+{
+	fclose(File);
+	File = nullptr;
+
+	// Engine.log -> Engine.1.log -> Engine.2.log ... (The Oldest One Is Removed)
+	auto Part = [this](int i)
+	{
+		return FileName.parent_path() / (FileName.stem().string() + "." + to_string(i) +
+			FileName.extension().string());
+	};
+
+	boost::system::error_code EC;
+	boost::filesystem::remove(Part(Keep), EC);
+	for (int i = Keep - 1; i >= 1; i--)
+		boost::filesystem::rename(Part(i), Part(i + 1), EC);
+	boost::filesystem::rename(FileName, Part(1), EC);
+
+	OpenFile();
+}
+
+bool Logger::OpenFile()
+{
+	File = _wfopen(FileName.wstring().c_str(), L"a");
+	if (!File)
+		return false;
+
+	// One Big Buffer: The System Is Called Only On Flush
+	Buffer.resize(64 * 1024);
+	setvbuf(File, Buffer.data(), _IOFBF, Buffer.size());
+
+	boost::system::error_code EC;
+	FileSize = file_size(FileName, EC);
+	if (EC)
+		FileSize = 0;
+
+	return true;
+}
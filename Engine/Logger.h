@@ -0,0 +1,109 @@
+/**
+ * \file	Logger.h.
+ *
+ * \brief	Declares the background logger of Engine.log
+ */
+
+#pragma once
+#if !defined(__LOGGER_H__)
+#define __LOGGER_H__
+#include "pch.h"
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <Boost/filesystem.hpp>
+
+/**
+ * \class	Logger
+ *
+ * \brief	Any thread puts records into lock-free queue and goes on, one thread formats them
+ * 			and writes them into the file which is opened once. The file is flushed from time
+ * 			to time (Right Away If There Are Errors) and rotated when it's too big.
+ * 			If the queue is full (e.g. Error Every Frame), new records are dropped and counted.
+ */
+
+class Logger
+{
+public:
+	Logger();
+	~Logger();
+
+	/**
+	 * \fn	bool Logger::Start(boost::filesystem::path File);
+	 *
+	 * \brief	Open the file (For Append) and run the writer thread
+	 *
+	 * \param 	File	Full path to the log.
+	 *
+	 * \returns	True if the file is opened.
+	 */
+
+	bool Start(boost::filesystem::path File);
+
+	// Write Everything What Is In The Queue And Close The File
+	void Stop();
+
+	/**
+	 * \fn	bool Logger::Push(string Text, Type type);
+	 *
+	 * \brief	Put record into the queue (Doesn't Wait For Anything)
+	 *
+	 * \param 	Text	The text.
+	 * \param 	type	The type.
+	 *
+	 * \returns	False if the record is dropped.
+	 */
+
+	bool Push(string Text, Type type);
+
+	// Wait Until Every Pushed Record Is Written
+	void Flush();
+	// Remove The Log And Its Old Parts (Writer Reopens It)
+	void Clear();
+
+	bool IsRunning() const { return Running; }
+	size_t getDropped(Type type) const { return Dropped[type].load(); }
+	size_t getWritten() const { return Written.load(); }
+
+	// Records Which Can Wait In The Queue
+	static const size_t Capacity = 4096;
+	// How Often The File Is Flushed
+	static const int FlushMs = 250;
+	// The File Is Renamed To Engine.1.log (And So On) When It's Bigger
+	static const uintmax_t MaxSize = 8 * 1024 * 1024;
+	static const int Keep = 3;
+private:
+	struct Node
+	{
+		atomic<Node *> Next{ nullptr };
+		string Text;
+		Type type = Normal;
+	};
+
+	void Run();
+	// Called Only By Writer Thread
+	Node *Pop();
+	void Write(const string &Text);
+	void Rotate();
+	bool OpenFile();
+
+	// Producers Swap Head, Writer Owns Tail (It's Always The Stub Node)
+	atomic<Node *> Head{ nullptr };
+	Node *Tail = nullptr;
+	atomic<size_t> Queued{ 0 }, Written{ 0 }, Pushed{ 0 };
+	std::array<atomic<size_t>, 3> Dropped;
+	// Dropped Records Which Are Already Reported In The Log
+	size_t Reported = 0;
+
+	boost::filesystem::path FileName;
+	FILE *File = nullptr;
+	vector<char> Buffer;
+	uintmax_t FileSize = 0;
+
+	thread Writer;
+	mutex Lock;
+	condition_variable Wake, Done;
+	atomic<bool> Running{ false }, Urgent{ false }, NeedClear{ false };
+};
+#endif // !__LOGGER_H__
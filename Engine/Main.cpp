@@ -22,6 +22,9 @@
 #include "UI.h"
 #include "CLua.h"
 #include "SDKInterface.h"
+#include "FileWatcher.h"
+#include "AssetIO.h"
+#include "ResidentCache.h"
 
 #include "Timer.h"
 
@@ -71,6 +74,10 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 
 	//	// FS (File System)!!!
 	Application->setFS(make_shared<File_system>());
+	//	// Background Reading Of Resources
+	Application->setIO(make_shared<AssetIO>());
+	//	// Loaded Models, Textures And Sounds Are Kept While They Fit Into Budgets
+	Application->setCache(make_shared<ResidentCache>());
 
 	if (FAILED(Application->Init("DecisionEngine", hInstance)))
 	{
@@ -173,6 +180,14 @@ int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPWSTR lpCmdLi
 		//	Application->getFS()->GetProject()->OpenFile(Obj->PathA);
 		//}
 	}
+
+	Application->setWatcher(make_shared<FileWatcher>());
+	if (Application->getWatcher().operator bool())
+		if (FAILED(Application->getWatcher()->Init(Application->getFS()->getWorkDirSourceW())))
+			Engine::LogError("wWinMain::getWatcher()->Init() Failed.",
+				string(__FILE__) + ": " + to_string(__LINE__),
+				"FileWatcher: Init Failed! Hot Reload Is Disabled");
+
 	//Application->setMultiplayer(make_shared<Multiplayer>());
 	//EngineTrace(Application->getMPL()->Init());
 	
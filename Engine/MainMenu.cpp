@@ -18,7 +18,7 @@ HRESULT MainMenu::Init(File_system *FS, Audio *sound)
 	this->fs = FS;
 
 	if (!ui->IsInitUI())
-		ui->Init(FS, 3, FS->GetFile(string("Main_texures_UI.dds"))->PathW.c_str());
+		ui->Init(FS, 3, FS->GetFile(string("Main_texures_UI.dds"))->getPathW().c_str());
 
 	MainMenuDlg = *ui->getDialog()->at(0);
 	AudioMenuDlg = *ui->getDialog()->at(1);
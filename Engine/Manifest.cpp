@@ -0,0 +1,246 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+#include "Manifest.h"
+
+#include <ctime>
+
+bool Manifest::Open(boost::filesystem::path File, string Root)
+{
+	Close();
+
+	boost::system::error_code EC;
+	if (!boost::filesystem::exists(File, EC))
+		return false;
+
+	try
+	{
+		Map.open(File.string());
+	}
+	catch (const std::exception &)
+	{
+		return false;
+	}
+
+	if (!Map.is_open() || Map.size() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	Head = reinterpret_cast<const Header *>(Map.data());
+	uint64_t Need = (uint64_t)sizeof(Header) + (uint64_t)Head->Folders * sizeof(FolderRecord) +
+		(uint64_t)Head->Files * sizeof(FileRecord) + (uint64_t)Head->Deps * sizeof(DepRecord) + Head->Strings;
+	if (memcmp(Head->Magic, "DSMF", 4) != 0 || Head->Version != Version || Need != Map.size() ||
+		Head->RootLen > Head->Strings)
+	{
+		Engine::LogError("Manifest::Open Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"Manifest: File " + File.string() + " Is Broken Or Outdated. Full Rescan!");
+		Close();
+		return false;
+	}
+
+	FolderRecs = reinterpret_cast<const FolderRecord *>(Map.data() + sizeof(Header));
+	FileRecs = reinterpret_cast<const FileRecord *>(FolderRecs + Head->Folders);
+	DepRecs = reinterpret_cast<const DepRecord *>(FileRecs + Head->Files);
+	Strings = reinterpret_cast<const char *>(DepRecs + Head->Deps);
+
+	// Resource Folder Was Moved
+	if (GetString(0, Head->RootLen) != Root)
+	{
+		Close();
+		return false;
+	}
+
+	for (uint32_t i = 0; i < Head->Folders; i++)
+	{
+		auto Rec = &FolderRecs[i];
+		if ((uint64_t)Rec->FirstFile + Rec->FileCount > Head->Files ||
+			(uint64_t)Rec->Path + Rec->PathLen > Head->Strings ||
+			Rec->Parent >= (int32_t)i)
+		{
+			Close();
+			return false;
+		}
+
+		ByPath.emplace(GetPath(Rec), Rec);
+		if (Rec->Parent >= 0)
+			Children[&FolderRecs[Rec->Parent]].push_back(Rec);
+	}
+
+	for (uint32_t i = 0; i < Head->Files; i++)
+		if ((uint64_t)FileRecs[i].Name + FileRecs[i].NameLen > Head->Strings)
+		{
+			Close();
+			return false;
+		}
+
+	for (uint32_t i = 0; i < Head->Deps; i++)
+		if ((uint64_t)DepRecs[i].Path + DepRecs[i].PathLen > Head->Strings ||
+			(uint64_t)DepRecs[i].List + DepRecs[i].ListLen > Head->Strings)
+		{
+			Close();
+			return false;
+		}
+
+	return true;
+}
+
+void Manifest::Close()
+{
+	ByPath.clear();
+	Children.clear();
+	Head = nullptr;
+	FolderRecs = nullptr;
+	FileRecs = nullptr;
+	DepRecs = nullptr;
+	Strings = nullptr;
+
+	if (Map.is_open())
+		Map.close();
+}
+
+const Manifest::FolderRecord *Manifest::FindFolder(const string &Path) const
+{
+	auto It = ByPath.find(Path);
+	return It != ByPath.end() ? It->second : nullptr;
+}
+
+bool Manifest::IsClean(const FolderRecord *Rec, int64_t MTime) const
+{
+	// Time Has Precision In Seconds, So Folder Which Was Changed In The Same Second
+	// As Manifest Was Written May Have Files We Didn't See
+	return Rec && Head && Rec->MTime == MTime && MTime < Head->Saved;
+}
+
+const Manifest::FileRecord *Manifest::GetFiles(const FolderRecord *Rec) const
+{
+	return FileRecs + Rec->FirstFile;
+}
+
+const vector<const Manifest::FolderRecord *> &Manifest::GetChildren(const FolderRecord *Rec) const
+{
+	auto It = Children.find(Rec);
+	return It != Children.end() ? It->second : NoChildren;
+}
+
+vector<Manifest::Dependency> Manifest::GetDependencies() const
+{
+	vector<Dependency> Result;
+	if (!Head)
+		return Result;
+
+	Result.reserve(Head->Deps);
+	for (uint32_t i = 0; i < Head->Deps; i++)
+	{
+		Dependency Dep;
+		Dep.Path = GetString(DepRecs[i].Path, DepRecs[i].PathLen);
+		Dep.Size = DepRecs[i].Size;
+		Dep.MTime = DepRecs[i].MTime;
+		if (DepRecs[i].ListLen > 0)
+			split(Dep.Files, GetString(DepRecs[i].List, DepRecs[i].ListLen), is_any_of("\n"));
+		Result.push_back(Dep);
+	}
+
+	return Result;
+}
+
+string Manifest::GetString(uint32_t Offset, uint32_t Len) const
+{
+	return string(Strings + Offset, Len);
+}
+
+bool Manifest::Save(boost::filesystem::path File, string Root, const vector<Folder> &Folders,
+	const vector<Dependency> &Deps)
+{
+	vector<FolderRecord> FolderRecs;
+	vector<FileRecord> FileRecs;
+	vector<DepRecord> DepRecs;
+	string Strings = Root;
+
+	auto AddString = [&Strings](const string &Str, uint32_t &Offset, uint32_t &Len)
+	{
+		Offset = (uint32_t)Strings.size();
+		Len = (uint32_t)Str.size();
+		Strings += Str;
+	};
+
+	for (auto &It: Folders)
+	{
+		FolderRecord Rec = {};
+		AddString(It.Path, Rec.Path, Rec.PathLen);
+		Rec.MTime = It.MTime;
+		Rec.Parent = It.Parent;
+		Rec.FirstFile = (uint32_t)FileRecs.size();
+		Rec.FileCount = (uint32_t)It.Files.size();
+		FolderRecs.push_back(Rec);
+
+		for (auto &Obj: It.Files)
+		{
+			FileRecord FRec = {};
+			AddString(Obj.Name, FRec.Name, FRec.NameLen);
+			FRec.Size = Obj.Size;
+			FRec.Type = (uint8_t)Obj.Type;
+			FRec.HasTextures = Obj.HasTextures ? 1 : 0;
+			FileRecs.push_back(FRec);
+		}
+	}
+
+	for (auto &It: Deps)
+	{
+		DepRecord Rec = {};
+		AddString(It.Path, Rec.Path, Rec.PathLen);
+		Rec.Size = It.Size;
+		Rec.MTime = It.MTime;
+		AddString(join(It.Files, "\n"), Rec.List, Rec.ListLen);
+		DepRecs.push_back(Rec);
+	}
+
+	Header Head = {};
+	memcpy(Head.Magic, "DSMF", 4);
+	Head.Version = Version;
+	Head.Folders = (uint32_t)FolderRecs.size();
+	Head.Files = (uint32_t)FileRecs.size();
+	Head.Strings = (uint32_t)Strings.size();
+	Head.RootLen = (uint32_t)Root.size();
+	Head.Saved = (int64_t)std::time(nullptr);
+	Head.Deps = (uint32_t)DepRecs.size();
+
+	boost::filesystem::path Temp = File;
+	Temp += ".tmp";
+	{
+		std::ofstream Out(Temp.string(), std::ios::binary | std::ios::trunc);
+		if (!Out.is_open())
+		{
+			Engine::LogError("Manifest::Save Failed!",
+				string(__FILE__) + ": " + to_string(__LINE__),
+				"Manifest: Cannot Create File " + Temp.string());
+			return false;
+		}
+
+		Out.write(reinterpret_cast<const char *>(&Head), sizeof(Head));
+		Out.write(reinterpret_cast<const char *>(FolderRecs.data()), FolderRecs.size() * sizeof(FolderRecord));
+		Out.write(reinterpret_cast<const char *>(FileRecs.data()), FileRecs.size() * sizeof(FileRecord));
+		Out.write(reinterpret_cast<const char *>(DepRecs.data()), DepRecs.size() * sizeof(DepRecord));
+		Out.write(Strings.data(), Strings.size());
+		if (!Out.good())
+		{
+			Out.close();
+			boost::filesystem::remove(Temp);
+			return false;
+		}
+	}
+
+	boost::system::error_code EC;
+	boost::filesystem::rename(Temp, File, EC);
+	if (EC)
+	{
+		boost::filesystem::remove(Temp, EC);
+		return false;
+	}
+
+	return true;
+}
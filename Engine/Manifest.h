@@ -0,0 +1,144 @@
+/**
+ * \file	Manifest.h.
+ *
+ * \brief	Declares the manifest class (On-Disk Cache Of The Resource Catalog)
+ */
+
+#pragma once
+#if !defined(__MANIFEST_H__)
+#define __MANIFEST_H__
+#include "pch.h"
+
+#include <Boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <unordered_map>
+
+/**
+ * \class	Manifest
+ *
+ * \brief	Binary snapshot of the resource folder which is memory-mapped on the next start.
+ * 			Every folder keeps its last write time, so only folders which were changed since
+ * 			the last run must be walked again. File content changes don't touch folder time,
+ * 			so sizes of the cached files may be stale until the file is requested.
+ * 			It also keeps textures which models refer to, so a model isn't read again until
+ * 			its size or write time is changed.
+ */
+
+class Manifest
+{
+public:
+#pragma pack(push, 1)
+	struct Header
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t Folders, Files;
+		uint32_t Strings, RootLen;
+		// Time When Manifest Was Saved (Folders Changed In The Same Second Are Always Rescanned)
+		int64_t Saved;
+		uint32_t Deps;
+	};
+	struct FolderRecord
+	{
+		uint32_t Path, PathLen; // Relative To Resource Folder, Without Slash At End
+		int64_t MTime;
+		int32_t Parent;
+		uint32_t FirstFile, FileCount;
+	};
+	struct FileRecord
+	{
+		uint32_t Name, NameLen;
+		uint64_t Size;
+		uint8_t Type, HasTextures;
+	};
+	struct DepRecord
+	{
+		uint32_t Path, PathLen; // Full Generic Path Of The Model
+		uint64_t Size;
+		int64_t MTime;
+		uint32_t List, ListLen; // Textures Separated By '\n'
+	};
+#pragma pack(pop)
+
+	struct Entry
+	{
+		string Name;
+		size_t Size = 0;
+		int Type = 0;
+		bool HasTextures = false;
+	};
+	struct Folder
+	{
+		string Path;
+		int64_t MTime = 0;
+		int Parent = -1;
+		vector<Entry> Files;
+	};
+	struct Dependency
+	{
+		string Path;
+		uint64_t Size = 0;
+		int64_t MTime = 0;
+		vector<string> Files;
+	};
+
+	Manifest() {}
+	~Manifest() { Close(); }
+
+	/**
+	 * \fn	bool Manifest::Open(boost::filesystem::path File, string Root);
+	 *
+	 * \brief	Map manifest file and check that it was made for this resource folder
+	 *
+	 * \param 	File	The manifest file.
+	 * \param 	Root	Resource folder (Generic Path).
+	 *
+	 * \returns	True if manifest can be used.
+	 */
+
+	bool Open(boost::filesystem::path File, string Root);
+	void Close();
+
+	const FolderRecord *FindFolder(const string &Path) const;
+	bool IsClean(const FolderRecord *Rec, int64_t MTime) const;
+
+	string GetPath(const FolderRecord *Rec) const { return GetString(Rec->Path, Rec->PathLen); }
+	const FileRecord *GetFiles(const FolderRecord *Rec) const;
+	string GetName(const FileRecord *Rec) const { return GetString(Rec->Name, Rec->NameLen); }
+	const vector<const FolderRecord *> &GetChildren(const FolderRecord *Rec) const;
+	// Textures Of Models Which Were Scanned Before
+	vector<Dependency> GetDependencies() const;
+
+	/**
+	 * \fn	static bool Manifest::Save(boost::filesystem::path File, string Root, const vector<Folder> &Folders,
+	 * 		const vector<Dependency> &Deps = {});
+	 *
+	 * \brief	Write manifest (Into Temp File And Then Rename It)
+	 *
+	 * \param 	File   	The manifest file.
+	 * \param 	Root   	Resource folder (Generic Path).
+	 * \param 	Folders	Folders with their files, parents must go before children.
+	 * \param 	Deps   	(Optional) Textures of models.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Save(boost::filesystem::path File, string Root, const vector<Folder> &Folders,
+		const vector<Dependency> &Deps = {});
+
+	static const uint32_t Version = 2;
+private:
+	string GetString(uint32_t Offset, uint32_t Len) const;
+
+	boost::iostreams::mapped_file_source Map;
+	const Header *Head = nullptr;
+	const FolderRecord *FolderRecs = nullptr;
+	const FileRecord *FileRecs = nullptr;
+	const DepRecord *DepRecs = nullptr;
+	const char *Strings = nullptr;
+
+	unordered_map<string, const FolderRecord *> ByPath;
+	unordered_map<const FolderRecord *, vector<const FolderRecord *>> Children;
+	vector<const FolderRecord *> NoChildren;
+};
+#endif // !__MANIFEST_H__
@@ -0,0 +1,210 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+#include "File_system.h"
+#include "MappedFile.h"
+
+bool MappedFile::Open(string FileName, Advice Hint)
+{
+	Close();
+
+	if (FileName.empty()) return false;
+
+	// Resource File Is Taken From The Mount Which Wins (Patch, Mod, Resource Folder Or Archive)
+	auto Src = File_system::Resolve(FileName);
+	if (Src.IsFound() && Src.Type == VFS::Directory)
+		FileName = Src.Real;
+	else if (Src.IsFound())
+	{
+		Size = (size_t)Src.File.Size;
+		if (Src.Type == VFS::Memory)
+		{
+			Memory = Src.File.Data;
+			Data = Memory ? Memory->data() : nullptr;
+		}
+		else
+		{
+			// The Archive Is Kept While Its Data Is Used
+			Archive = Src.Archive;
+			Data = Archive->GetData(Src.File.Packed);
+			if (!Data)
+			{
+				if (!Archive->Read(Src.File.Packed, Unpacked)) return false;
+				Data = Unpacked.data();
+			}
+		}
+
+		Opened = true;
+		if (Hint == WillNeed)
+			Prefetch();
+		return true;
+	}
+
+	DWORD Flags = FILE_ATTRIBUTE_NORMAL;
+	if (Hint == Sequential || Hint == WillNeed)
+		Flags |= FILE_FLAG_SEQUENTIAL_SCAN;
+	else if (Hint == Random)
+		Flags |= FILE_FLAG_RANDOM_ACCESS;
+
+	File = CreateFileW(boost::filesystem::path(FileName).wstring().c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, Flags, nullptr);
+	if (File == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER FileSize = {};
+	if (!GetFileSizeEx(File, &FileSize))
+	{
+		Close();
+		return false;
+	}
+
+	Size = (size_t)FileSize.QuadPart;
+	Opened = true;
+
+	// Empty File Can't Be Mapped
+	if (Size == 0)
+		return true;
+
+	Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (Mapping)
+		Data = reinterpret_cast<const BYTE *>(MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0));
+	if (!Data)
+	{
+		Engine::LogError("MappedFile::Open Failed!",
+			string(__FILE__) + ": " + to_string(__LINE__),
+			"MappedFile: Cannot Map File " + FileName);
+		Close();
+		return false;
+	}
+
+	if (Hint == WillNeed)
+		Prefetch();
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (Mapping)
+	{
+		if (Data)
+			UnmapViewOfFile(Data);
+		CloseHandle(Mapping);
+	}
+	if (File != INVALID_HANDLE_VALUE)
+		CloseHandle(File);
+
+	File = INVALID_HANDLE_VALUE;
+	Mapping = nullptr;
+	Data = nullptr;
+	Size = 0;
+	Opened = false;
+	Unpacked.clear();
+	Memory.reset();
+	Archive.reset();
+}
+
+// PrefetchVirtualMemory Is Only Since Windows 8, Engine Still Works On Windows 7
+struct PrefetchRange { PVOID Address; SIZE_T Bytes; };
+using PrefetchFunc = BOOL(WINAPI *)(HANDLE, ULONG_PTR, PrefetchRange *, ULONG);
+static PrefetchFunc getPrefetch()
+{
+	static auto Func = reinterpret_cast<PrefetchFunc>(
+		GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "PrefetchVirtualMemory"));
+	return Func;
+}
+
+void MappedFile::Prefetch(size_t Offset, size_t Length)
+{
+	if (!Data || Offset >= Size) return;
+	Length = min(Length, Size - Offset);
+
+	PrefetchRange Range = { const_cast<BYTE *>(Data + Offset), Length };
+	if (getPrefetch() && getPrefetch()(GetCurrentProcess(), 1, &Range, 0))
+		return;
+
+	// Touch One Byte On Each Page
+	volatile BYTE Sum = 0;
+	for (size_t i = Offset; i < Offset + Length; i += 4096)
+		Sum += Data[i];
+}
+
+void MappedFile::Prefetch(const vector<MappedFile *> &Files)
+{
+	vector<PrefetchRange> Ranges;
+	for (auto It: Files)
+		if (It && It->Data && It->Size)
+			Ranges.push_back({ const_cast<BYTE *>(It->Data), It->Size });
+	if (Ranges.empty()) return;
+
+	// One Request For Every File
+	if (getPrefetch() && getPrefetch()(GetCurrentProcess(), Ranges.size(), Ranges.data(), 0))
+		return;
+
+	for (auto It: Files)
+		if (It)
+			It->Prefetch();
+}
+
+namespace
+{
+	class MappedIOStream: public Assimp::IOStream
+	{
+	public:
+		bool Open(const string &File) { return Mapped.Open(File, MappedFile::Sequential); }
+
+		size_t Read(void *pvBuffer, size_t pSize, size_t pCount) override
+		{
+			if (!pSize || !pCount) return 0;
+
+			size_t Count = min(pCount, (Mapped.size() - Pos) / pSize);
+			memcpy(pvBuffer, Mapped.data() + Pos, Count * pSize);
+			Pos += Count * pSize;
+			return Count;
+		}
+		size_t Write(const void *, size_t, size_t) override { return 0; }
+		aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override
+		{
+			size_t New = pOffset;
+			if (pOrigin == aiOrigin_CUR)
+				New = Pos + pOffset;
+			else if (pOrigin == aiOrigin_END)
+				New = Mapped.size() - pOffset;
+			if (New > Mapped.size())
+				return aiReturn_FAILURE;
+
+			Pos = New;
+			return aiReturn_SUCCESS;
+		}
+		size_t Tell() const override { return Pos; }
+		size_t FileSize() const override { return Mapped.size(); }
+		void Flush() override {}
+	private:
+		MappedFile Mapped;
+		size_t Pos = 0;
+	};
+}
+
+bool MappedIOSystem::Exists(const char *pFile) const
+{
+	boost::system::error_code EC;
+	return File_system::Resolve(pFile).IsFound() || boost::filesystem::exists(pFile, EC);
+}
+
+Assimp::IOStream *MappedIOSystem::Open(const char *pFile, const char *pMode)
+{
+	// Only For Reading
+	if (!pMode || strchr(pMode, 'w') || strchr(pMode, 'a'))
+		return nullptr;
+
+	auto Stream = new MappedIOStream;
+	if (!Stream->Open(pFile))
+	{
+		delete Stream;
+		return nullptr;
+	}
+
+	return Stream;
+}
@@ -0,0 +1,102 @@
+/**
+ * \file	MappedFile.h.
+ *
+ * \brief	Declares read-only memory-mapped file and Assimp IO system on top of it
+ */
+
+#pragma once
+#if !defined(__MAPPEDFILE_H__)
+#define __MAPPEDFILE_H__
+#include "pch.h"
+
+#include <string_view>
+#include "assimp\IOStream.hpp"
+#include "assimp\IOSystem.hpp"
+class Pak;
+
+/**
+ * \class	MappedFile
+ *
+ * \brief	Read-only view of the whole file (Pages Are Loaded By The System When They Are Touched).
+ * 			Stored files of the archive are served right from its mapping, compressed ones
+ * 			are unpacked once. The view lives while the object lives.
+ */
+
+class MappedFile
+{
+public:
+	enum Advice
+	{
+		Normal = 0,
+		// Whole File Will Be Read From Start To End (Parsers)
+		Sequential,
+		// Only Small Parts Will Be Read (e.g. Table Of Contents)
+		Random,
+		// Whole File Is Needed Right Now: Load It In One Request
+		WillNeed
+	};
+
+	MappedFile() {}
+	MappedFile(string File, Advice Hint = Normal) { Open(File, Hint); }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	/**
+	 * \fn	bool MappedFile::Open(string File, Advice Hint = Normal);
+	 *
+	 * \brief	Map file (Or Find It In The Archive If There's No Such File On Disk)
+	 *
+	 * \param 	File	Full path to the file.
+	 * \param 	Hint	(Optional) How the file will be read.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	bool Open(string File, Advice Hint = Normal);
+	void Close();
+
+	/**
+	 * \fn	void MappedFile::Prefetch(size_t Offset = 0, size_t Length = SIZE_MAX);
+	 *
+	 * \brief	Ask the system to load pages of this range before they will be touched
+	 */
+
+	void Prefetch(size_t Offset = 0, size_t Length = SIZE_MAX);
+	// Prefetch Several Files In One Request
+	static void Prefetch(const vector<MappedFile *> &Files);
+
+	bool IsOpen() const { return Opened; }
+	const BYTE *data() const { return Data; }
+	size_t size() const { return Size; }
+	string_view View() const { return string_view(reinterpret_cast<const char *>(Data), Size); }
+private:
+	HANDLE File = INVALID_HANDLE_VALUE, Mapping = nullptr;
+	const BYTE *Data = nullptr;
+	size_t Size = 0;
+	bool Opened = false;
+
+	// Unpacked File From The Archive
+	vector<BYTE> Unpacked;
+	// File Of The Memory Mount Or The Archive Which Has The File (See VFS)
+	shared_ptr<const vector<BYTE>> Memory;
+	shared_ptr<Pak> Archive;
+};
+
+/**
+ * \class	MappedIOSystem
+ *
+ * \brief	Assimp reads models (And Their Materials, e.g. .mtl) through MappedFile,
+ * 			so it works the same for loose files and the archive.
+ */
+
+class MappedIOSystem: public Assimp::IOSystem
+{
+public:
+	bool Exists(const char *pFile) const override;
+	char getOsSeparator() const override { return '/'; }
+	Assimp::IOStream *Open(const char *pFile, const char *pMode = "rb") override;
+	void Close(Assimp::IOStream *pFile) override { delete pFile; }
+};
+#endif // !__MAPPEDFILE_H__
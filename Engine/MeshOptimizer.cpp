@@ -0,0 +1,309 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+MeshOptimizer::CacheStats MeshOptimizer::AnalyzeVertexCache(const vector<uint32_t> &Indices, size_t VertexCount,
+	unsigned Cache)
+{
+	CacheStats Result;
+	Result.Triangles = Indices.size() / 3;
+
+	// Time When The Vertex Entered The FIFO (It's Still There If Less Than Cache Entries Came After It)
+	vector<size_t> Entered(VertexCount, 0);
+	vector<bool> Seen(VertexCount, false);
+	size_t Time = 0;
+	for (size_t i = 0; i < Result.Triangles * 3; i++)
+	{
+		uint32_t V = Indices[i];
+		if (V >= VertexCount)
+			continue;
+
+		if (!Seen[V])
+		{
+			Seen[V] = true;
+			Result.Vertices++;
+		}
+		else if (Time - Entered[V] < Cache)
+			continue;
+
+		Entered[V] = Time++;
+		Result.Misses++;
+	}
+
+	return Result;
+}
+
+namespace
+{
+	// Forsyth's Scores: Vertices Of The Last Triangle, Then Decaying By Place In The Cache,
+	// Plus Boost For Vertices Which Have Few Triangles Left (So They Don't Stay Alone)
+	const int ScoreCache = 32;
+	const int MaxValence = 32;
+	const float CacheDecayPower = 1.5f, LastTriScore = 0.75f, ValenceBoostScale = 2.f, ValenceBoostPower = 0.5f;
+
+	struct ScoreTable
+	{
+		float Cache[ScoreCache] = {}, Valence[MaxValence + 1] = {};
+
+		ScoreTable()
+		{
+			for (int i = 0; i < ScoreCache; i++)
+				Cache[i] = i < 3 ? LastTriScore
+				: pow(1.f - float(i - 3) / float(ScoreCache - 3), CacheDecayPower);
+			for (int i = 1; i <= MaxValence; i++)
+				Valence[i] = ValenceBoostScale * pow(float(i), -ValenceBoostPower);
+		}
+
+		float get(int CachePos, uint32_t Live) const
+		{
+			if (Live == 0)
+				return -1.f;
+			return (CachePos >= 0 ? Cache[CachePos] : 0.f) + Valence[min(Live, (uint32_t)MaxValence)];
+		}
+	};
+}
+
+void MeshOptimizer::OptimizeVertexCache(vector<uint32_t> &Indices, size_t VertexCount)
+{
+	static const ScoreTable Scores;
+	size_t Triangles = Indices.size() / 3;
+	if (Triangles == 0)
+		return;
+	for (size_t i = 0; i < Triangles * 3; i++)
+		if (Indices[i] >= VertexCount)
+			return;
+
+	// Triangles Of Every Vertex (Not Emitted Ones Are At The Front Of Its Range)
+	vector<uint32_t> Live(VertexCount, 0), First(VertexCount + 1, 0);
+	for (size_t i = 0; i < Triangles * 3; i++)
+		Live[Indices[i]]++;
+	for (size_t i = 0; i < VertexCount; i++)
+		First[i + 1] = First[i] + Live[i];
+
+	vector<uint32_t> Adjacent(Triangles * 3), Filled(VertexCount, 0);
+	for (size_t i = 0; i < Triangles * 3; i++)
+	{
+		uint32_t V = Indices[i];
+		Adjacent[First[V] + Filled[V]++] = (uint32_t)(i / 3);
+	}
+
+	vector<int> CachePos(VertexCount, -1);
+	vector<float> VertexScore(VertexCount);
+	for (size_t i = 0; i < VertexCount; i++)
+		VertexScore[i] = Scores.get(-1, Live[i]);
+
+	vector<float> TriScore(Triangles);
+	vector<bool> Emitted(Triangles, false);
+	for (size_t i = 0; i < Triangles; i++)
+		TriScore[i] = VertexScore[Indices[i * 3]] + VertexScore[Indices[i * 3 + 1]] + VertexScore[Indices[i * 3 + 2]];
+
+	vector<uint32_t> Result;
+	Result.reserve(Triangles * 3);
+	vector<uint32_t> Cache, NewCache;
+	Cache.reserve(ScoreCache + 3);
+	NewCache.reserve(ScoreCache + 3);
+
+	size_t Best = size_t(max_element(TriScore.begin(), TriScore.end()) - TriScore.begin());
+	size_t Cursor = 0;
+	for (size_t Done = 0; Done < Triangles; Done++)
+	{
+		// Dead End: Nothing In The Cache Has Triangles Left, Take The Next One In The Input Order
+		if (Best == Triangles)
+		{
+			while (Emitted[Cursor])
+				Cursor++;
+			Best = Cursor;
+		}
+
+		const uint32_t *Tri = &Indices[Best * 3];
+		Result.insert(Result.end(), Tri, Tri + 3);
+		Emitted[Best] = true;
+
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t V = Tri[k];
+			uint32_t *Begin = &Adjacent[First[V]], *End = Begin + Live[V];
+			auto Found = find(Begin, End, (uint32_t)Best);
+			if (Found != End)
+			{
+				swap(*Found, *(End - 1));
+				Live[V]--;
+			}
+		}
+
+		// The Triangle Goes To The Front, Others Are Pushed Back
+		NewCache.assign(Tri, Tri + 3);
+		for (auto V: Cache)
+			if (V != Tri[0] && V != Tri[1] && V != Tri[2])
+				NewCache.push_back(V);
+
+		for (size_t i = ScoreCache; i < NewCache.size(); i++)
+		{
+			// Fell Out Of The Cache
+			uint32_t V = NewCache[i];
+			CachePos[V] = -1;
+			float Score = Scores.get(-1, Live[V]);
+			for (uint32_t t = 0; t < Live[V]; t++)
+				TriScore[Adjacent[First[V] + t]] += Score - VertexScore[V];
+			VertexScore[V] = Score;
+		}
+		if (NewCache.size() > (size_t)ScoreCache)
+			NewCache.resize(ScoreCache);
+
+		for (size_t i = 0; i < NewCache.size(); i++)
+		{
+			uint32_t V = NewCache[i];
+			CachePos[V] = (int)i;
+			float Score = Scores.get((int)i, Live[V]);
+			for (uint32_t t = 0; t < Live[V]; t++)
+				TriScore[Adjacent[First[V] + t]] += Score - VertexScore[V];
+			VertexScore[V] = Score;
+		}
+		Cache.swap(NewCache);
+
+		// The Next Is The Best Triangle Which Uses Cached Vertices
+		Best = Triangles;
+		float BestScore = -1.f;
+		for (auto V: Cache)
+			for (uint32_t t = 0; t < Live[V]; t++)
+			{
+				uint32_t Candidate = Adjacent[First[V] + t];
+				if (TriScore[Candidate] > BestScore)
+				{
+					BestScore = TriScore[Candidate];
+					Best = Candidate;
+				}
+			}
+	}
+
+	copy(Result.begin(), Result.end(), Indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(vector<uint32_t> &Indices, const float *Positions, size_t Stride,
+	size_t VertexCount, float Threshold)
+{
+	size_t Triangles = Indices.size() / 3;
+	if (Triangles < 2 || !Positions)
+		return;
+	for (size_t i = 0; i < Triangles * 3; i++)
+		if (Indices[i] >= VertexCount)
+			return;
+
+	auto Position = [Positions, Stride](uint32_t V)
+	{
+		return reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + V * Stride);
+	};
+
+	// Clusters Start Where Every Vertex Of The Triangle Misses The Cache: Moving Them Costs Nothing
+	vector<size_t> Starts;
+	{
+		vector<size_t> Entered(VertexCount, 0);
+		vector<bool> Seen(VertexCount, false);
+		size_t Time = 0;
+		for (size_t i = 0; i < Triangles; i++)
+		{
+			int Misses = 0;
+			for (int k = 0; k < 3; k++)
+			{
+				uint32_t V = Indices[i * 3 + k];
+				if (Seen[V] && Time - Entered[V] < CacheSize)
+					continue;
+				Seen[V] = true;
+				Entered[V] = Time++;
+				Misses++;
+			}
+			if (i == 0 || Misses == 3)
+				Starts.push_back(i);
+		}
+	}
+	if (Starts.size() < 2)
+		return;
+	Starts.push_back(Triangles);
+
+	// Centre And Normal (Weighted By Area) Of Every Cluster And Of The Mesh
+	struct Cluster
+	{
+		size_t Begin = 0, End = 0;
+		double Centre[3] = {}, Normal[3] = {}, Area = 0.;
+		double Key = 0.;
+	};
+	vector<Cluster> Clusters(Starts.size() - 1);
+	double MeshCentre[3] = {}, MeshArea = 0.;
+	for (size_t c = 0; c < Clusters.size(); c++)
+	{
+		auto &It = Clusters[c];
+		It.Begin = Starts[c];
+		It.End = Starts[c + 1];
+		for (size_t i = It.Begin; i < It.End; i++)
+		{
+			const float *A = Position(Indices[i * 3]), *B = Position(Indices[i * 3 + 1]), *C = Position(Indices[i * 3 + 2]);
+			double E1[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] }, E2[3] = { C[0] - A[0], C[1] - A[1], C[2] - A[2] };
+			double N[3] = { E1[1] * E2[2] - E1[2] * E2[1], E1[2] * E2[0] - E1[0] * E2[2], E1[0] * E2[1] - E1[1] * E2[0] };
+			double Area = sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]) * 0.5;
+
+			for (int k = 0; k < 3; k++)
+			{
+				It.Centre[k] += (A[k] + B[k] + C[k]) / 3. * Area;
+				It.Normal[k] += N[k];
+			}
+			It.Area += Area;
+		}
+
+		for (int k = 0; k < 3; k++)
+			MeshCentre[k] += It.Centre[k];
+		MeshArea += It.Area;
+		if (It.Area > 0.)
+			for (int k = 0; k < 3; k++)
+				It.Centre[k] /= It.Area;
+	}
+	if (MeshArea <= 0.)
+		return;
+	for (int k = 0; k < 3; k++)
+		MeshCentre[k] /= MeshArea;
+
+	// Clusters Which Face Away From The Centre Are Drawn First, They Hide The Others
+	for (auto &It: Clusters)
+	{
+		double Length = sqrt(It.Normal[0] * It.Normal[0] + It.Normal[1] * It.Normal[1] + It.Normal[2] * It.Normal[2]);
+		if (Length <= 0.)
+			continue;
+		for (int k = 0; k < 3; k++)
+			It.Key += (It.Centre[k] - MeshCentre[k]) * It.Normal[k] / Length;
+	}
+	stable_sort(Clusters.begin(), Clusters.end(), [](const Cluster &A, const Cluster &B) { return A.Key > B.Key; });
+
+	vector<uint32_t> Result;
+	Result.reserve(Indices.size());
+	for (auto &It: Clusters)
+		Result.insert(Result.end(), Indices.begin() + It.Begin * 3, Indices.begin() + It.End * 3);
+
+	double Before = AnalyzeVertexCache(Indices, VertexCount).ACMR(), After = AnalyzeVertexCache(Result, VertexCount).ACMR();
+	if (After <= Before * Threshold)
+		copy(Result.begin(), Result.end(), Indices.begin());
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(vector<uint32_t> &Indices, vector<uint32_t> &Remap, size_t VertexCount)
+{
+	// Broken Index: Nothing Is Moved
+	Remap.assign(VertexCount, ~0u);
+	for (auto V: Indices)
+		if (V >= VertexCount)
+		{
+			for (size_t i = 0; i < VertexCount; i++)
+				Remap[i] = (uint32_t)i;
+			return VertexCount;
+		}
+
+	uint32_t Next = 0;
+	for (auto &V: Indices)
+	{
+		if (Remap[V] == ~0u)
+			Remap[V] = Next++;
+		V = Remap[V];
+	}
+
+	return Next;
+}
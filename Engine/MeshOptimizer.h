@@ -0,0 +1,152 @@
+/**
+ * \file	MeshOptimizer.h.
+ *
+ * \brief	Declares the mesh optimizer (Order Of Triangles And Vertices For The GPU Caches)
+ */
+
+#pragma once
+#if !defined(__MESHOPTIMIZER_H__)
+#define __MESHOPTIMIZER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \class	MeshOptimizer
+ *
+ * \brief	Reorders triangles of the mesh so the post-transform cache hits more often (Forsyth's
+ * 			Linear-Speed Vertex Cache Optimisation), optionally moves clusters of triangles which
+ * 			face outwards to the front (Less Overdraw, Sander Et Al. "Fast Triangle Reordering"),
+ * 			then renumbers vertices in the order they're used (Vertex Fetch Is Linear).
+ * 			Geometry isn't changed, only the order. It's done when the model is imported.
+ * 			Used by the engine and by tools, so it doesn't need pch.h.
+ */
+
+class MeshOptimizer
+{
+public:
+	// Result Of Simulated FIFO Cache Of The GPU
+	struct CacheStats
+	{
+		size_t Triangles = 0, Vertices = 0, Misses = 0;
+
+		// Average Cache Miss Ratio: Transformed Vertices Per Triangle (0.5 Is Ideal, 3 Is The Worst)
+		double ACMR() const { return Triangles ? double(Misses) / Triangles : 0.; }
+		// Average Transform To Vertex Ratio: How Many Times Each Vertex Is Transformed (1 Is Ideal)
+		double ATVR() const { return Vertices ? double(Misses) / Vertices : 0.; }
+
+		CacheStats &operator+=(const CacheStats &Other)
+		{
+			Triangles += Other.Triangles;
+			Vertices += Other.Vertices;
+			Misses += Other.Misses;
+			return *this;
+		}
+	};
+	struct Report
+	{
+		CacheStats Before, After;
+	};
+
+	// Post-Transform Cache Of Most GPUs Which Is Simulated By AnalyzeVertexCache
+	static const unsigned CacheSize = 16;
+
+	/**
+	 * \fn	static CacheStats MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t> &Indices,
+	 * 		size_t VertexCount, unsigned Cache = CacheSize);
+	 *
+	 * \brief	Count vertices which the GPU transforms for this list of triangles
+	 *
+	 * \param 	Indices	   	Triangle list.
+	 * \param 	VertexCount	Number of vertices.
+	 * \param 	Cache	   	(Optional) Size of FIFO cache.
+	 *
+	 * \returns	Misses and ratios.
+	 */
+
+	static CacheStats AnalyzeVertexCache(const std::vector<uint32_t> &Indices, size_t VertexCount,
+		unsigned Cache = CacheSize);
+
+	// Forsyth: Triangle Whose Vertices Are In The Cache (And Have Less Triangles Left) Goes Next
+	static void OptimizeVertexCache(std::vector<uint32_t> &Indices, size_t VertexCount);
+
+	/**
+	 * \fn	static void MeshOptimizer::OptimizeOverdraw(std::vector<uint32_t> &Indices, const float *Positions,
+	 * 		size_t Stride, size_t VertexCount, float Threshold = 1.05f);
+	 *
+	 * \brief	Split the list (Already Optimized For The Cache) into clusters where the cache starts
+	 * 			again, and draw clusters which face outwards first. The order is kept only if ACMR
+	 * 			is at most Threshold times ACMR before.
+	 *
+	 * \param 	Indices	   	Triangle list.
+	 * \param 	Positions  	The first vertex position (X, Y, Z).
+	 * \param 	Stride	   	Bytes between positions.
+	 * \param 	VertexCount	Number of vertices.
+	 * \param 	Threshold  	(Optional) How much worse the cache can become.
+	 */
+
+	static void OptimizeOverdraw(std::vector<uint32_t> &Indices, const float *Positions, size_t Stride,
+		size_t VertexCount, float Threshold = 1.05f);
+
+	/**
+	 * \fn	static size_t MeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t> &Indices,
+	 * 		std::vector<uint32_t> &Remap, size_t VertexCount);
+	 *
+	 * \brief	Renumber vertices in the order of the first use (Unused Vertices Are Dropped)
+	 *
+	 * \param [in,out]	Indices	   	Triangle list, it gets new numbers.
+	 * \param [out]   	Remap	   	New number of every old vertex (~0u If It's Unused).
+	 * \param 		  	VertexCount	Number of vertices.
+	 *
+	 * \returns	Number of vertices which are used.
+	 */
+
+	static size_t OptimizeVertexFetch(std::vector<uint32_t> &Indices, std::vector<uint32_t> &Remap,
+		size_t VertexCount);
+
+	// Move Vertices As Remap Says (Vertex Is Any Type)
+	template<class Vertex> static void ApplyRemap(std::vector<Vertex> &Vertices, const std::vector<uint32_t> &Remap,
+		size_t Used)
+	{
+		std::vector<Vertex> Result(Used);
+		for (size_t i = 0; i < Vertices.size() && i < Remap.size(); i++)
+			if (Remap[i] != ~0u)
+				Result[Remap[i]] = Vertices[i];
+		Vertices.swap(Result);
+	}
+
+	/**
+	 * \fn	template<class Vertex> static Report MeshOptimizer::Optimize(std::vector<Vertex> &Vertices,
+	 * 		std::vector<uint32_t> &Indices, bool Overdraw = true);
+	 *
+	 * \brief	Every pass for the mesh whose vertices start with the position (Three Floats)
+	 *
+	 * \returns	The cache before and after.
+	 */
+
+	template<class Vertex> static Report Optimize(std::vector<Vertex> &Vertices, std::vector<uint32_t> &Indices,
+		bool Overdraw = true)
+	{
+		Report Result;
+		Result.Before = AnalyzeVertexCache(Indices, Vertices.size());
+		if (Indices.size() < 3 || Vertices.empty())
+		{
+			Result.After = Result.Before;
+			return Result;
+		}
+
+		OptimizeVertexCache(Indices, Vertices.size());
+		if (Overdraw)
+			OptimizeOverdraw(Indices, reinterpret_cast<const float *>(Vertices.data()), sizeof(Vertex),
+				Vertices.size());
+
+		std::vector<uint32_t> Remap;
+		size_t Used = OptimizeVertexFetch(Indices, Remap, Vertices.size());
+		ApplyRemap(Vertices, Remap, Used);
+
+		Result.After = AnalyzeVertexCache(Indices, Vertices.size());
+		return Result;
+	}
+};
+#endif // !__MESHOPTIMIZER_H__
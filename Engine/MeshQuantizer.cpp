@@ -0,0 +1,131 @@
+#include "MeshQuantizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+using namespace std;
+
+uint16_t MeshQuantizer::ToHalf(float Value)
+{
+	uint32_t Bits = 0;
+	memcpy(&Bits, &Value, sizeof(Bits));
+	uint32_t Sign = (Bits >> 16) & 0x8000, Abs = Bits & 0x7FFFFFFF;
+
+	// Infinity Or NaN (It Stays NaN)
+	if (Abs >= 0x7F800000)
+		return uint16_t(Sign | 0x7C00 | (Abs > 0x7F800000 ? 0x200 : 0));
+	// Rounds To More Than 65504
+	if (Abs >= 0x477FF000)
+		return uint16_t(Sign | 0x7C00);
+
+	// Less Than 2^-14: Subnormal Half Whose Unit Is 2^-24
+	if (Abs < 0x38800000)
+	{
+		if (Abs < 0x33000000)
+			return uint16_t(Sign);
+
+		uint32_t Exponent = Abs >> 23, Mantissa = (Abs & 0x7FFFFF) | 0x800000, Shift = 126 - Exponent;
+		uint32_t Result = Mantissa >> Shift, Rest = Mantissa & ((1u << Shift) - 1), Half = 1u << (Shift - 1);
+		if (Rest > Half || (Rest == Half && (Result & 1)))
+			Result++;
+		return uint16_t(Sign | Result);
+	}
+
+	// Exponent Is Rebiased From 127 To 15, Carry Of Rounding Goes Into It
+	uint32_t Result = (Abs - 0x38000000) >> 13, Rest = Abs & 0x1FFF;
+	if (Rest > 0x1000 || (Rest == 0x1000 && (Result & 1)))
+		Result++;
+	return uint16_t(Sign | Result);
+}
+
+float MeshQuantizer::FromHalf(uint16_t Value)
+{
+	uint32_t Sign = uint32_t(Value & 0x8000) << 16, Exponent = (Value >> 10) & 0x1F, Mantissa = Value & 0x3FF;
+	if (Exponent == 0)
+	{
+		float Result = Mantissa * 5.9604644775390625e-8f;
+		return Sign ? -Result : Result;
+	}
+
+	uint32_t Bits = Sign | (Exponent == 31 ? 0x7F800000 | (Mantissa << 13) : ((Exponent + 112) << 23) | (Mantissa << 13));
+	float Result = 0.f;
+	memcpy(&Result, &Bits, sizeof(Result));
+	return Result;
+}
+
+MeshQuantizer::Decode MeshQuantizer::getDecode(const float *Positions, size_t Stride, size_t Count)
+{
+	Decode Result;
+	if (!Positions || Count == 0)
+		return Result;
+
+	float Min[3], Max[3];
+	for (size_t i = 0; i < Count; i++)
+	{
+		const float *P = reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + i * Stride);
+		for (int k = 0; k < 3; k++)
+		{
+			Min[k] = i ? min(Min[k], P[k]) : P[k];
+			Max[k] = i ? max(Max[k], P[k]) : P[k];
+		}
+	}
+	for (int k = 0; k < 3; k++)
+	{
+		Result.Offset[k] = Min[k];
+		Result.Scale[k] = Max[k] - Min[k];
+	}
+	return Result;
+}
+
+bool MeshQuantizer::FitsHalf(const float *UVs, size_t Stride, size_t Count, float MaxError)
+{
+	if (!UVs)
+		return true;
+
+	for (size_t i = 0; i < Count; i++)
+	{
+		const float *UV = reinterpret_cast<const float *>(reinterpret_cast<const char *>(UVs) + i * Stride);
+		for (int k = 0; k < 2; k++)
+			if (!(fabs(FromHalf(ToHalf(UV[k])) - UV[k]) <= MaxError))
+				return false;
+	}
+	return true;
+}
+
+void MeshQuantizer::Pack(const float *Positions, const float *UVs, size_t Stride, size_t Count, const Decode &Bounds,
+	vector<PackedVertex> &Out)
+{
+	Out.resize(Count);
+	for (size_t i = 0; i < Count; i++)
+	{
+		auto &It = Out[i];
+		const float *P = reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + i * Stride);
+		for (int k = 0; k < 3; k++)
+		{
+			float Normalized = Bounds.Scale[k] > 0.f ? (P[k] - Bounds.Offset[k]) / Bounds.Scale[k] : 0.f;
+			It.Pos[k] = (uint16_t)lround(min(max(Normalized, 0.f), 1.f) * 65535.f);
+		}
+		It.Pos[3] = 65535;
+
+		const float *UV = UVs ? reinterpret_cast<const float *>(reinterpret_cast<const char *>(UVs) + i * Stride) : nullptr;
+		It.Tex[0] = ToHalf(UV ? UV[0] : 0.f);
+		It.Tex[1] = ToHalf(UV ? UV[1] : 0.f);
+	}
+}
+
+void MeshQuantizer::Unpack(const PackedVertex &It, const Decode &Bounds, float Pos[3], float Tex[2])
+{
+	for (int k = 0; k < 3; k++)
+		Pos[k] = Bounds.Offset[k] + Bounds.Scale[k] * (It.Pos[k] / 65535.f);
+	Tex[0] = FromHalf(It.Tex[0]);
+	Tex[1] = FromHalf(It.Tex[1]);
+}
+
+vector<uint16_t> MeshQuantizer::Narrow(const uint32_t *Indices, size_t Count)
+{
+	vector<uint16_t> Result(Count);
+	for (size_t i = 0; i < Count; i++)
+		Result[i] = (uint16_t)Indices[i];
+	return Result;
+}
@@ -0,0 +1,144 @@
+/**
+ * \file	MeshQuantizer.h.
+ *
+ * \brief	Declares the mesh quantizer (Compact Vertices And 16-Bit Indices)
+ */
+
+#pragma once
+#if !defined(__MESHQUANTIZER_H__)
+#define __MESHQUANTIZER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \class	MeshQuantizer
+ *
+ * \brief	Vertices for the device which take 12 bytes instead of 20: positions are normalized
+ * 			16-bit numbers within bounds of the mesh (The Decode Scale And Offset Turn Them Back,
+ * 			The Engine Multiplies The World By Them), UVs are half floats. Meshes which have at
+ * 			most 65535 vertices get 16-bit indices, bigger ones are split when they're imported.
+ * 			Used by the engine and by tools, so it doesn't need pch.h.
+ */
+
+class MeshQuantizer
+{
+public:
+#pragma pack(push, 1)
+	// DXGI_FORMAT_R16G16B16A16_UNORM (W Is 1) And DXGI_FORMAT_R16G16_FLOAT
+	struct PackedVertex
+	{
+		uint16_t Pos[4];
+		uint16_t Tex[2];
+	};
+#pragma pack(pop)
+	// Position = Offset + Scale * Normalized Position
+	struct Decode
+	{
+		float Scale[3] = { 1.f, 1.f, 1.f }, Offset[3] = { 0.f, 0.f, 0.f };
+	};
+	// Part Of The Split Mesh: Its Own Vertices (In The Order Of The First Use) And Indices
+	template<class Vertex> struct Chunk
+	{
+		std::vector<Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+	};
+
+	// The Most Vertices Which 16-Bit Indices Address
+	static const size_t MaxVertices16 = 65535;
+
+	// IEEE Half Float (Rounded To Nearest Even, Too Big Values Become Infinity)
+	static uint16_t ToHalf(float Value);
+	static float FromHalf(uint16_t Value);
+
+	// Bounds Of Positions (Zero Scale For Flat Axes)
+	static Decode getDecode(const float *Positions, size_t Stride, size_t Count);
+
+	/**
+	 * \fn	static bool MeshQuantizer::FitsHalf(const float *UVs, size_t Stride, size_t Count,
+	 * 		float MaxError = 1.f / 2048);
+	 *
+	 * \brief	Whether half floats keep every UV within MaxError (Tiled UVs Lose Precision Far From 0)
+	 */
+
+	static bool FitsHalf(const float *UVs, size_t Stride, size_t Count, float MaxError = 1.f / 2048);
+
+	/**
+	 * \fn	static void MeshQuantizer::Pack(const float *Positions, const float *UVs, size_t Stride,
+	 * 		size_t Count, const Decode &Bounds, std::vector<PackedVertex> &Out);
+	 *
+	 * \brief	Encode vertices
+	 *
+	 * \param 		  	Positions	The first vertex position (X, Y, Z).
+	 * \param 		  	UVs		 	The first texture coordinates (U, V) or nullptr.
+	 * \param 		  	Stride	 	Bytes between vertices.
+	 * \param 		  	Count	 	Number of vertices.
+	 * \param 		  	Bounds	 	Decode of the mesh (getDecode).
+	 * \param [out]   	Out		 	Packed vertices.
+	 */
+
+	static void Pack(const float *Positions, const float *UVs, size_t Stride, size_t Count, const Decode &Bounds,
+		std::vector<PackedVertex> &Out);
+
+	// What The Device Reads From The Packed Vertex
+	static void Unpack(const PackedVertex &It, const Decode &Bounds, float Pos[3], float Tex[2]);
+
+	// Indices Of The Mesh Which Has At Most MaxVertices16 Vertices
+	static std::vector<uint16_t> Narrow(const uint32_t *Indices, size_t Count);
+
+	/**
+	 * \fn	template<class Vertex> static std::vector<Chunk<Vertex>> MeshQuantizer::Split(
+	 * 		std::vector<Vertex> Vertices, std::vector<uint32_t> Indices, size_t MaxVertices = MaxVertices16);
+	 *
+	 * \brief	Split the mesh in the order of its triangles (Optimized Order Is Kept) into parts
+	 * 			which have at most MaxVertices vertices. Small mesh is one part.
+	 *
+	 * \returns	Parts of the mesh.
+	 */
+
+	template<class Vertex> static std::vector<Chunk<Vertex>> Split(std::vector<Vertex> Vertices,
+		std::vector<uint32_t> Indices, size_t MaxVertices = MaxVertices16)
+	{
+		std::vector<Chunk<Vertex>> Result(1);
+		if (Vertices.size() <= MaxVertices || MaxVertices < 3)
+		{
+			Result.back().Vertices.swap(Vertices);
+			Result.back().Indices.swap(Indices);
+			return Result;
+		}
+
+		// Number Of The Vertex In The Current Part
+		std::vector<uint32_t> Local(Vertices.size(), ~0u), Used;
+		for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+		{
+			const uint32_t *Tri = &Indices[i];
+			if (Tri[0] >= Vertices.size() || Tri[1] >= Vertices.size() || Tri[2] >= Vertices.size())
+				continue;
+
+			size_t New = (Local[Tri[0]] == ~0u) + (Local[Tri[1]] == ~0u) + (Local[Tri[2]] == ~0u);
+			if (Result.back().Vertices.size() + New > MaxVertices)
+			{
+				for (auto V: Used)
+					Local[V] = ~0u;
+				Used.clear();
+				Result.emplace_back();
+			}
+
+			auto &Part = Result.back();
+			for (int k = 0; k < 3; k++)
+			{
+				if (Local[Tri[k]] == ~0u)
+				{
+					Local[Tri[k]] = (uint32_t)Part.Vertices.size();
+					Part.Vertices.push_back(Vertices[Tri[k]]);
+					Used.push_back(Tri[k]);
+				}
+				Part.Indices.push_back(Local[Tri[k]]);
+			}
+		}
+
+		return Result;
+	}
+};
+#endif // !__MESHQUANTIZER_H__
@@ -0,0 +1,495 @@
+#include "MeshSimplifier.h"
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace std;
+
+namespace
+{
+	const uint32_t None = ~0u, Many = ~0u - 1;
+	// Planes Along Borders And Seams Weigh More Than Faces, So They Stay In Place
+	const double BorderWeight = 10.;
+	// Triangle Around The Moved Vertex Mustn't Turn More Than By ~75 Degrees
+	const double MinFlipCos = 0.25;
+
+	enum Kind: uint8_t { Manifold, Border, Seam, Locked };
+
+	struct Vec3
+	{
+		double X = 0., Y = 0., Z = 0.;
+	};
+	Vec3 Sub(const Vec3 &A, const Vec3 &B) { return { A.X - B.X, A.Y - B.Y, A.Z - B.Z }; }
+	Vec3 Cross(const Vec3 &A, const Vec3 &B) { return { A.Y * B.Z - A.Z * B.Y, A.Z * B.X - A.X * B.Z, A.X * B.Y - A.Y * B.X }; }
+	double Dot(const Vec3 &A, const Vec3 &B) { return A.X * B.X + A.Y * B.Y + A.Z * B.Z; }
+
+	// Sum Of W * (N * P + D)^2
+	struct Quadric
+	{
+		double A00 = 0., A11 = 0., A22 = 0., A01 = 0., A02 = 0., A12 = 0., B0 = 0., B1 = 0., B2 = 0., C = 0., W = 0.;
+
+		void addPlane(const Vec3 &N, double D, double Weight)
+		{
+			A00 += Weight * N.X * N.X;
+			A11 += Weight * N.Y * N.Y;
+			A22 += Weight * N.Z * N.Z;
+			A01 += Weight * N.X * N.Y;
+			A02 += Weight * N.X * N.Z;
+			A12 += Weight * N.Y * N.Z;
+			B0 += Weight * N.X * D;
+			B1 += Weight * N.Y * D;
+			B2 += Weight * N.Z * D;
+			C += Weight * D * D;
+			W += Weight;
+		}
+		void add(const Quadric &Other)
+		{
+			A00 += Other.A00; A11 += Other.A11; A22 += Other.A22;
+			A01 += Other.A01; A02 += Other.A02; A12 += Other.A12;
+			B0 += Other.B0; B1 += Other.B1; B2 += Other.B2;
+			C += Other.C;
+			W += Other.W;
+		}
+		double eval(const Vec3 &P) const
+		{
+			return A00 * P.X * P.X + A11 * P.Y * P.Y + A22 * P.Z * P.Z +
+				2. * (A01 * P.X * P.Y + A02 * P.X * P.Z + A12 * P.Y * P.Z) +
+				2. * (B0 * P.X + B1 * P.Y + B2 * P.Z) + C;
+		}
+	};
+
+	// Attribute Which Changes Linearly Over Triangles (A(P) = G * P + D): Sum Of W * (G * P + D - A)^2
+	struct AttributeQuadric
+	{
+		Quadric Plane;
+		Vec3 G;
+		double D = 0.;
+
+		void addGradient(const Vec3 &Gradient, double Offset, double Weight)
+		{
+			Plane.addPlane(Gradient, Offset, Weight);
+			G = { G.X + Weight * Gradient.X, G.Y + Weight * Gradient.Y, G.Z + Weight * Gradient.Z };
+			D += Weight * Offset;
+		}
+		void add(const AttributeQuadric &Other)
+		{
+			Plane.add(Other.Plane);
+			G = { G.X + Other.G.X, G.Y + Other.G.Y, G.Z + Other.G.Z };
+			D += Other.D;
+		}
+		double eval(const Vec3 &P, double A) const
+		{
+			return Plane.eval(P) - 2. * A * (Dot(G, P) + D) + A * A * Plane.W;
+		}
+	};
+
+	struct PositionKey
+	{
+		uint32_t X, Y, Z;
+		bool operator==(const PositionKey &Other) const { return X == Other.X && Y == Other.Y && Z == Other.Z; }
+	};
+	struct PositionHash
+	{
+		size_t operator()(const PositionKey &It) const
+		{
+			return size_t(It.X * 73856093u ^ It.Y * 19349663u ^ It.Z * 83492791u);
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t From = None, To = None;
+		// The Other Side Of UV Seam
+		uint32_t From2 = None, To2 = None;
+		double Cost = 0.;
+	};
+
+	// The Only Vertex At The Other End Of Open Edge (None Or Many)
+	void FindOpenEdges(const vector<uint32_t> &Indices, const vector<uint32_t> &Map, size_t VertexCount,
+		vector<uint32_t> &OpenIn, vector<uint32_t> &OpenOut)
+	{
+		unordered_set<uint64_t> Edges;
+		Edges.reserve(Indices.size());
+		for (size_t i = 0; i < Indices.size(); i += 3)
+			for (int k = 0; k < 3; k++)
+				Edges.insert(uint64_t(Map[Indices[i + k]]) << 32 | Map[Indices[i + (k + 1) % 3]]);
+
+		OpenIn.assign(VertexCount, None);
+		OpenOut.assign(VertexCount, None);
+		for (auto Edge: Edges)
+		{
+			uint32_t A = uint32_t(Edge >> 32), B = uint32_t(Edge);
+			if (A == B || Edges.count(uint64_t(B) << 32 | A))
+				continue;
+			OpenOut[A] = OpenOut[A] == None ? B : Many;
+			OpenIn[B] = OpenIn[B] == None ? A : Many;
+		}
+	}
+}
+
+float MeshSimplifier::getScale(const float *Positions, size_t Stride, size_t VertexCount)
+{
+	if (!Positions || VertexCount == 0)
+		return 0.f;
+
+	float Min[3], Max[3];
+	for (size_t i = 0; i < VertexCount; i++)
+	{
+		const float *P = reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + i * Stride);
+		for (int k = 0; k < 3; k++)
+		{
+			Min[k] = i ? min(Min[k], P[k]) : P[k];
+			Max[k] = i ? max(Max[k], P[k]) : P[k];
+		}
+	}
+	return max(Max[0] - Min[0], max(Max[1] - Min[1], Max[2] - Min[2]));
+}
+
+vector<uint32_t> MeshSimplifier::Simplify(const vector<uint32_t> &Indices, const float *Positions, const float *UVs,
+	size_t Stride, size_t VertexCount, size_t TargetIndices, float TargetError, float UVWeight, float *ResultError)
+{
+	if (ResultError)
+		*ResultError = 0.f;
+
+	vector<uint32_t> Result(Indices.begin(), Indices.begin() + Indices.size() / 3 * 3);
+	if (!Positions || Result.size() <= TargetIndices)
+		return Result;
+	for (auto V: Result)
+		if (V >= VertexCount)
+			return Result;
+
+	// Positions In The Unit Box, So Errors Don't Depend On Size Of The Mesh
+	float Scale = getScale(Positions, Stride, VertexCount);
+	double Inverse = Scale > 0.f ? 1. / Scale : 1.;
+	vector<Vec3> P(VertexCount);
+	vector<double> U(UVs ? VertexCount : 0), V(UVs ? VertexCount : 0);
+	for (size_t i = 0; i < VertexCount; i++)
+	{
+		const float *Pos = reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + i * Stride);
+		P[i] = { Pos[0] * Inverse, Pos[1] * Inverse, Pos[2] * Inverse };
+		if (UVs)
+		{
+			const float *UV = reinterpret_cast<const float *>(reinterpret_cast<const char *>(UVs) + i * Stride);
+			U[i] = UV[0] * UVWeight;
+			V[i] = UV[1] * UVWeight;
+		}
+	}
+
+	// Vertices Of One Position (Wedges) Are Linked In a Ring, Remap Is The First Of Them
+	vector<uint32_t> Remap(VertexCount), Wedge(VertexCount);
+	{
+		unordered_map<PositionKey, uint32_t, PositionHash> Known;
+		Known.reserve(VertexCount);
+		for (uint32_t i = 0; i < (uint32_t)VertexCount; i++)
+		{
+			const float *Pos = reinterpret_cast<const float *>(reinterpret_cast<const char *>(Positions) + i * Stride);
+			PositionKey Key;
+			memcpy(&Key, Pos, sizeof(Key));
+			auto First = Known.emplace(Key, i).first->second;
+
+			Remap[i] = First;
+			Wedge[i] = i;
+			if (First != i)
+			{
+				Wedge[i] = Wedge[First];
+				Wedge[First] = i;
+			}
+		}
+	}
+	vector<uint32_t> Identity(VertexCount);
+	for (uint32_t i = 0; i < (uint32_t)VertexCount; i++)
+		Identity[i] = i;
+
+	// Quadrics Of Faces (By Positions) And Of Attributes (By Vertices, They Differ Across Seams)
+	vector<Quadric> Faces(VertexCount);
+	vector<AttributeQuadric> AttrU(UVs ? VertexCount : 0), AttrV(UVs ? VertexCount : 0);
+	unordered_set<uint64_t> Edges;
+	Edges.reserve(Result.size());
+	for (size_t i = 0; i < Result.size(); i += 3)
+		for (int k = 0; k < 3; k++)
+			Edges.insert(uint64_t(Result[i + k]) << 32 | Result[i + (k + 1) % 3]);
+	for (size_t i = 0; i < Result.size(); i += 3)
+	{
+		uint32_t I[3] = { Result[i], Result[i + 1], Result[i + 2] };
+		Vec3 E1 = Sub(P[I[1]], P[I[0]]), E2 = Sub(P[I[2]], P[I[0]]), N = Cross(E1, E2);
+		double Length2 = Dot(N, N), Length = sqrt(Length2);
+		if (Length <= 0.)
+			continue;
+
+		Vec3 Unit = { N.X / Length, N.Y / Length, N.Z / Length };
+		double Area = Length * 0.5;
+		for (int k = 0; k < 3; k++)
+			Faces[Remap[I[k]]].addPlane(Unit, -Dot(Unit, P[I[k]]), Area);
+
+		// Planes Through Open Edges Which Are Perpendicular To The Face
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t A = I[k], B = I[(k + 1) % 3];
+			if (Edges.count(uint64_t(B) << 32 | A))
+				continue;
+
+			Vec3 Edge = Sub(P[B], P[A]), Normal = Cross(Edge, Unit);
+			double EdgeLength = sqrt(Dot(Normal, Normal));
+			if (EdgeLength <= 0.)
+				continue;
+			Normal = { Normal.X / EdgeLength, Normal.Y / EdgeLength, Normal.Z / EdgeLength };
+			double Weight = Dot(Edge, Edge) * BorderWeight;
+			Faces[Remap[A]].addPlane(Normal, -Dot(Normal, P[A]), Weight);
+			Faces[Remap[B]].addPlane(Normal, -Dot(Normal, P[A]), Weight);
+		}
+
+		if (!UVs)
+			continue;
+
+		// Gradient Of The Attribute In The Plane Of The Triangle
+		Vec3 Left = Cross(E2, N), Right = Cross(N, E1);
+		for (int c = 0; c < 2; c++)
+		{
+			auto &A = c ? V : U;
+			double D1 = A[I[1]] - A[I[0]], D2 = A[I[2]] - A[I[0]];
+			Vec3 G = { (D1 * Left.X + D2 * Right.X) / Length2, (D1 * Left.Y + D2 * Right.Y) / Length2,
+				(D1 * Left.Z + D2 * Right.Z) / Length2 };
+			double Offset = A[I[0]] - Dot(G, P[I[0]]);
+			for (int k = 0; k < 3; k++)
+				(c ? AttrV : AttrU)[I[k]].addGradient(G, Offset, Area);
+		}
+	}
+
+	auto Cost = [&](uint32_t From, uint32_t To)
+	{
+		auto &Face = Faces[Remap[From]];
+		double Result = Face.W > 0. ? fabs(Face.eval(P[To])) / Face.W : 0.;
+		if (!AttrU.empty() && AttrU[From].Plane.W > 0.)
+			Result += fabs(AttrU[From].eval(P[To], U[To]) + AttrV[From].eval(P[To], V[To])) / AttrU[From].Plane.W;
+		return Result;
+	};
+
+	Edges.clear();
+
+	double Limit = double(TargetError) * TargetError, MaxCost = 0.;
+	vector<uint32_t> OpenIn, OpenOut, PosOpenIn, PosOpenOut;
+	vector<uint8_t> Kinds(VertexCount), Busy(VertexCount);
+	vector<uint32_t> Move(VertexCount), First(VertexCount + 1), Adjacent;
+	vector<Collapse> Collapses;
+	vector<size_t> Order;
+	while (Result.size() > TargetIndices)
+	{
+		// Open Edges Of Vertices (Borders And Seams) And Of Positions (Only Borders)
+		FindOpenEdges(Result, Identity, VertexCount, OpenIn, OpenOut);
+		FindOpenEdges(Result, Remap, VertexCount, PosOpenIn, PosOpenOut);
+		for (uint32_t i = 0; i < (uint32_t)VertexCount; i++)
+		{
+			uint32_t Other = Wedge[i];
+			bool Single = OpenIn[i] < Many && OpenOut[i] < Many;
+			if (Other == i)
+				Kinds[i] = OpenIn[i] == None && OpenOut[i] == None ? Manifold : Single ? Border : Locked;
+			else if (Wedge[Other] == i && Single && OpenIn[Other] < Many && OpenOut[Other] < Many &&
+				PosOpenIn[Remap[i]] == None && PosOpenOut[Remap[i]] == None)
+				Kinds[i] = Seam;
+			else
+				Kinds[i] = Locked;
+		}
+
+		// Triangles Of Every Position
+		fill(First.begin(), First.end(), 0);
+		for (auto It: Result)
+			First[Remap[It] + 1]++;
+		for (size_t i = 0; i < VertexCount; i++)
+			First[i + 1] += First[i];
+		Adjacent.resize(Result.size());
+		{
+			vector<uint32_t> Filled(First.begin(), First.end() - 1);
+			for (size_t i = 0; i < Result.size(); i++)
+				Adjacent[Filled[Remap[Result[i]]]++] = uint32_t(i / 3);
+		}
+
+		Collapses.clear();
+		for (size_t i = 0; i < Result.size(); i += 3)
+			for (int k = 0; k < 3; k++)
+				for (int Side = 0; Side < 2; Side++)
+				{
+					uint32_t From = Result[i + (Side ? (k + 1) % 3 : k)], To = Result[i + (Side ? k : (k + 1) % 3)];
+					if (Remap[From] == Remap[To])
+						continue;
+
+					Collapse It;
+					It.From = From;
+					It.To = To;
+					switch (Kinds[From])
+					{
+					case Manifold:
+						break;
+					case Border:
+						if (OpenOut[From] != To && OpenIn[From] != To)
+							continue;
+						break;
+					case Seam:
+					{
+						// The Other Side Moves Along Its Open Edge Into The Same Position
+						if (OpenOut[From] != To && OpenIn[From] != To)
+							continue;
+						It.From2 = Wedge[From];
+						for (uint32_t W = To; ; )
+						{
+							if (OpenOut[It.From2] == W || OpenIn[It.From2] == W)
+							{
+								It.To2 = W;
+								break;
+							}
+							W = Wedge[W];
+							if (W == To)
+								break;
+						}
+						if (It.To2 == None)
+							continue;
+						break;
+					}
+					default:
+						continue;
+					}
+
+					It.Cost = Cost(From, To);
+					if (It.From2 != None && !AttrU.empty() && AttrU[It.From2].Plane.W > 0.)
+						It.Cost += fabs(AttrU[It.From2].eval(P[It.To2], U[It.To2]) +
+							AttrV[It.From2].eval(P[It.To2], V[It.To2])) / AttrU[It.From2].Plane.W;
+					if (It.Cost <= Limit)
+						Collapses.push_back(It);
+				}
+		if (Collapses.empty())
+			break;
+
+		Order.resize(Collapses.size());
+		for (size_t i = 0; i < Order.size(); i++)
+			Order[i] = i;
+		sort(Order.begin(), Order.end(), [&Collapses](size_t A, size_t B) { return Collapses[A].Cost < Collapses[B].Cost; });
+
+		// Every Collapse Removes About Two Triangles; Its Neighbours Don't Move In This Pass
+		size_t Budget = max<size_t>((Result.size() - TargetIndices) / 6, 1), Done = 0;
+		fill(Busy.begin(), Busy.end(), 0);
+		for (uint32_t i = 0; i < (uint32_t)VertexCount; i++)
+			Move[i] = i;
+		for (auto Index: Order)
+		{
+			if (Done >= Budget)
+				break;
+
+			auto &It = Collapses[Index];
+			uint32_t From = Remap[It.From], To = Remap[It.To];
+			if (Busy[From] || Busy[To])
+				continue;
+
+			// Triangles Which Stay Mustn't Turn Over
+			bool Flips = false;
+			for (uint32_t t = First[From]; t < First[From + 1] && !Flips; t++)
+			{
+				const uint32_t *Tri = &Result[Adjacent[t] * 3];
+				uint32_t R[3] = { Remap[Tri[0]], Remap[Tri[1]], Remap[Tri[2]] };
+				if (R[0] == To || R[1] == To || R[2] == To)
+					continue;
+
+				Vec3 Before = Cross(Sub(P[R[1]], P[R[0]]), Sub(P[R[2]], P[R[0]]));
+				Vec3 Q[3] = { P[R[0]], P[R[1]], P[R[2]] };
+				for (int k = 0; k < 3; k++)
+					if (R[k] == From)
+						Q[k] = P[To];
+				Vec3 After = Cross(Sub(Q[1], Q[0]), Sub(Q[2], Q[0]));
+				double Lengths = sqrt(Dot(Before, Before) * Dot(After, After));
+				if (Lengths > 0. && Dot(Before, After) < MinFlipCos * Lengths)
+					Flips = true;
+				if (Dot(Before, Before) > 0. && Dot(After, After) <= 0.)
+					Flips = true;
+			}
+			if (Flips)
+				continue;
+
+			Move[It.From] = It.To;
+			Faces[To].add(Faces[From]);
+			if (!AttrU.empty())
+			{
+				AttrU[It.To].add(AttrU[It.From]);
+				AttrV[It.To].add(AttrV[It.From]);
+			}
+			if (It.From2 != None)
+			{
+				Move[It.From2] = It.To2;
+				if (!AttrU.empty())
+				{
+					AttrU[It.To2].add(AttrU[It.From2]);
+					AttrV[It.To2].add(AttrV[It.From2]);
+				}
+			}
+
+			for (uint32_t t = First[From]; t < First[From + 1]; t++)
+				for (int k = 0; k < 3; k++)
+					Busy[Remap[Result[Adjacent[t] * 3 + k]]] = 1;
+
+			MaxCost = max(MaxCost, It.Cost);
+			Done++;
+		}
+		if (Done == 0)
+			break;
+
+		// Triangles Whose Two Corners Meet Are Dropped
+		size_t Write = 0;
+		for (size_t i = 0; i < Result.size(); i += 3)
+		{
+			uint32_t A = Move[Result[i]], B = Move[Result[i + 1]], C = Move[Result[i + 2]];
+			if (Remap[A] == Remap[B] || Remap[B] == Remap[C] || Remap[A] == Remap[C])
+				continue;
+			Result[Write++] = A;
+			Result[Write++] = B;
+			Result[Write++] = C;
+		}
+		Result.resize(Write);
+	}
+
+	if (ResultError)
+		*ResultError = float(sqrt(MaxCost));
+	return Result;
+}
+
+vector<MeshSimplifier::Level> MeshSimplifier::BuildLods(vector<uint32_t> &Indices, const float *Positions,
+	const float *UVs, size_t Stride, size_t VertexCount, const Settings &Options)
+{
+	vector<Level> Result;
+	Indices.resize(Indices.size() / 3 * 3);
+	Level Full;
+	Full.IndexCount = Indices.size();
+	Result.push_back(Full);
+	if (!Positions || Indices.size() / 3 < Options.MinTriangles)
+		return Result;
+
+	float Scale = getScale(Positions, Stride, VertexCount);
+	vector<uint32_t> Previous = Indices;
+	// Relative Error Of The Previous Level: Every Step Gets What's Left Of MaxError
+	float Spent = 0.f;
+	while (Result.size() < Options.MaxLevels && Spent < Options.MaxError)
+	{
+		size_t Target = size_t((Previous.size() / 3) * Options.Ratio) * 3;
+		float Error = 0.f;
+		auto Next = Simplify(Previous, Positions, UVs, Stride, VertexCount, Target, Options.MaxError - Spent,
+			Options.UVWeight, &Error);
+
+		// The Level Which Saves Little Isn't Worth Its Memory
+		if (Next.empty() || Next.size() * 10 > Previous.size() * 9)
+			break;
+		MeshOptimizer::OptimizeVertexCache(Next, VertexCount);
+
+		// Every Level Is Made From The Previous One, So Their Errors Add Up
+		Level New;
+		New.FirstIndex = Indices.size();
+		New.IndexCount = Next.size();
+		Spent += Error;
+		New.Error = Spent * Scale;
+		Result.push_back(New);
+
+		Indices.insert(Indices.end(), Next.begin(), Next.end());
+		Previous.swap(Next);
+	}
+
+	return Result;
+}
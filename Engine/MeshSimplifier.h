@@ -0,0 +1,111 @@
+/**
+ * \file	MeshSimplifier.h.
+ *
+ * \brief	Declares the mesh simplifier (Levels Of Detail Made By Quadric Error Metrics)
+ */
+
+#pragma once
+#if !defined(__MESHSIMPLIFIER_H__)
+#define __MESHSIMPLIFIER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Number And Size Of Levels Which MeshSimplifier::BuildLods Makes
+struct LodSettings
+{
+	// Levels With The Full Mesh
+	size_t MaxLevels = 5;
+	// Triangles Of The Level Relative To The Previous One
+	float Ratio = 0.5f;
+	// Relative Error Of The Coarsest Level: Errors Of Levels Add Up, Each Step Gets What's Left
+	float MaxError = 0.05f;
+	// How Much UV Difference Costs Relative To Distance
+	float UVWeight = 0.5f;
+	// Smaller Meshes Have Only The Full Level
+	size_t MinTriangles = 64;
+};
+
+/**
+ * \class	MeshSimplifier
+ *
+ * \brief	Collapses edges of the mesh in the order of their quadric error (Garland And Heckbert
+ * 			"Surface Simplification Using Quadric Error Metrics", Attributes As Hoppe "New Quadric
+ * 			Metric"): the vertex moves into its neighbour, so vertices aren't changed and every
+ * 			level uses the vertex buffer of the full mesh with its own indices.
+ * 			Borders move only along themselves, UV seams move with both sides at once, other
+ * 			vertices which have open edges (Complex Ones) don't move.
+ * 			Errors are distances relative to the size of the mesh (Biggest Side Of Its Box).
+ * 			Used by the engine and by tools, so it doesn't need pch.h.
+ */
+
+class MeshSimplifier
+{
+public:
+	// Indices Of The Level Follow Indices Of The Previous One
+	struct Level
+	{
+		size_t FirstIndex = 0, IndexCount = 0;
+		// Distance In Units Of The Mesh Which Is Lost (Upper Bound, 0 For The Full Mesh)
+		float Error = 0.f;
+	};
+	typedef LodSettings Settings;
+
+	/**
+	 * \fn	static std::vector<uint32_t> MeshSimplifier::Simplify(const std::vector<uint32_t> &Indices,
+	 * 		const float *Positions, const float *UVs, size_t Stride, size_t VertexCount, size_t TargetIndices,
+	 * 		float TargetError, float UVWeight = 0.5f, float *ResultError = nullptr);
+	 *
+	 * \brief	Collapse edges while there are more indices than TargetIndices and the error of the
+	 * 			cheapest collapse is at most TargetError
+	 *
+	 * \param 		  	Indices		 	Triangle list.
+	 * \param 		  	Positions	 	The first vertex position (X, Y, Z).
+	 * \param 		  	UVs			 	The first texture coordinates (U, V) or nullptr.
+	 * \param 		  	Stride		 	Bytes between vertices.
+	 * \param 		  	VertexCount  	Number of vertices.
+	 * \param 		  	TargetIndices	Wanted size of the list.
+	 * \param 		  	TargetError  	Relative error which mustn't be exceeded.
+	 * \param 		  	UVWeight	 	(Optional) How much UV difference costs relative to distance.
+	 * \param [out]   	ResultError  	(Optional) Relative error of the result.
+	 *
+	 * \returns	Triangle list of the same vertices (The Input If It Has Broken Indices).
+	 */
+
+	static std::vector<uint32_t> Simplify(const std::vector<uint32_t> &Indices, const float *Positions,
+		const float *UVs, size_t Stride, size_t VertexCount, size_t TargetIndices, float TargetError,
+		float UVWeight = 0.5f, float *ResultError = nullptr);
+
+	// Biggest Side Of The Box Of Vertices: Relative Errors Are Multiplied By It
+	static float getScale(const float *Positions, size_t Stride, size_t VertexCount);
+
+	/**
+	 * \fn	static std::vector<Level> MeshSimplifier::BuildLods(std::vector<uint32_t> &Indices,
+	 * 		const float *Positions, const float *UVs, size_t Stride, size_t VertexCount,
+	 * 		const Settings &Options = Settings());
+	 *
+	 * \brief	Simplify every level from the previous one (Each Is Optimized For Vertex Cache)
+	 *
+	 * \param [in,out]	Indices	   	The full mesh, indices of other levels are added.
+	 * \param 		  	Positions  	The first vertex position (X, Y, Z).
+	 * \param 		  	UVs		   	The first texture coordinates (U, V) or nullptr.
+	 * \param 		  	Stride	   	Bytes between vertices.
+	 * \param 		  	VertexCount	Number of vertices.
+	 * \param 		  	Options	   	(Optional) Number and size of levels.
+	 *
+	 * \returns	Levels from the full mesh, their errors grow.
+	 */
+
+	static std::vector<Level> BuildLods(std::vector<uint32_t> &Indices, const float *Positions, const float *UVs,
+		size_t Stride, size_t VertexCount, const Settings &Options = Settings());
+
+	// Vertex Starts With The Position And Texture Coordinates (Five Floats)
+	template<class Vertex> static std::vector<Level> BuildLods(const std::vector<Vertex> &Vertices,
+		std::vector<uint32_t> &Indices, const Settings &Options = Settings())
+	{
+		const float *Positions = reinterpret_cast<const float *>(Vertices.data());
+		return BuildLods(Indices, Positions, Positions + 3, sizeof(Vertex), Vertices.size(), Options);
+	}
+};
+#endif // !__MESHSIMPLIFIER_H__
@@ -0,0 +1,135 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+
+#include "ModelBatch.h"
+#include "Console.h"
+
+ModelBatch::ModelBatch(vector<string> Files)
+{
+	unordered_map<string, size_t> Indices;
+	for (auto &File: Files)
+	{
+		string Lower = path(File).generic_string();
+		to_lower(Lower);
+
+		auto Found = Indices.find(Lower);
+		if (Found != Indices.end())
+		{
+			Items.push_back(Found->second);
+			continue;
+		}
+
+		Indices[Lower] = Unique.size();
+		Items.push_back(Unique.size());
+		Unique.push_back(Models::BeginPrepare(File));
+	}
+
+	Jobs->Left = Unique.size();
+	for (auto &It: Unique)
+	{
+		auto Data = It;
+		auto State = Jobs;
+		Run([Data, State]()
+		{
+			Models::PrepareMeshes(*Data);
+			State->Left--;
+		});
+	}
+}
+
+void ModelBatch::Run(function<void()> Job)
+{
+	if (Application.operator bool() && Application->getWorkers().operator bool())
+		Application->getWorkers()->AddJob(Job);
+	else
+		Job();
+}
+
+bool ModelBatch::Update()
+{
+	if (Now == Ready)
+		return true;
+	if (Jobs->Left.load() > 0)
+		return false;
+
+	if (Now == Meshes)
+	{
+		// The File System Is Used Only By The Frame Thread
+		for (auto &Data: Unique)
+		{
+			Models::PrepareTextures(*Data, Known);
+			for (auto &Part: Data->Parts)
+				for (auto &Name: Part.Textures)
+				{
+					auto &It = Data->Textures[Name];
+					if (It.operator bool() && !It->Resident.operator bool() &&
+						find(Decoded.begin(), Decoded.end(), It) == Decoded.end())
+						Decoded.push_back(It);
+				}
+		}
+
+		Now = Textures;
+		Jobs->Left = Decoded.size();
+		for (auto &It: Decoded)
+		{
+			auto Texture = It;
+			auto State = Jobs;
+			Run([Texture, State]()
+			{
+				Models::DecodeTexture(*Texture);
+				State->Left--;
+			});
+		}
+
+		if (Jobs->Left.load() > 0)
+			return false;
+	}
+
+	Now = Ready;
+	PrepareMs = chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+	return true;
+}
+
+void ModelBatch::Wait()
+{
+	while (!Update())
+		this_thread::sleep_for(chrono::milliseconds(1));
+}
+
+shared_ptr<Models> ModelBatch::Make(size_t Index)
+{
+	if (Now != Ready || Index >= Items.size())
+		return nullptr;
+
+	auto Model = make_shared<Models>();
+	if (!Model->LoadPrepared(*Unique.at(Items.at(Index))))
+		return nullptr;
+
+	return Model;
+}
+
+void ModelBatch::LogTimings(string Title)
+{
+	double MeshMs = 0., DecodeMs = 0., DeviceMs = 0.;
+	for (auto &It: Unique)
+	{
+		Console::LogInfo((boost::format("%s: Model %s (%s): Mesh %.2f ms, Device %.2f ms") % Title
+			% path(It->File).filename().string() % (It->From.empty() ? "failed" : It->From)
+			% It->MeshMs % It->DeviceMs).str());
+		MeshMs += It->MeshMs;
+		DeviceMs += It->DeviceMs;
+	}
+	for (auto &It: Decoded)
+	{
+		Console::LogInfo((boost::format("%s: Texture %s: Decode %.2f ms") % Title % It->Name % It->DecodeMs).str());
+		DecodeMs += It->DecodeMs;
+	}
+
+	// Work Of Workers Is Summed, The Wall Time Shows How Much Of It Was Parallel
+	Console::LogInfo((boost::format("%s: %d Models (%d Files, %d Textures) Are Prepared In %.2f ms "
+		"(Meshes %.2f ms, Textures %.2f ms On Workers), Device Objects Took %.2f ms") % Title % Items.size()
+		% Unique.size() % Decoded.size() % PrepareMs % MeshMs % DecodeMs % DeviceMs).str());
+}
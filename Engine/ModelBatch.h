@@ -0,0 +1,88 @@
+/**
+ * \file	ModelBatch.h.
+ *
+ * \brief	Declares the model batch (Many Models Are Loaded By Workers At Once)
+ */
+
+#pragma once
+#if !defined(__MODELBATCH_H__)
+#define __MODELBATCH_H__
+#include "pch.h"
+
+#include <atomic>
+#include "Models.h"
+
+/**
+ * \class	ModelBatch
+ *
+ * \brief	Loads models of the level in three steps: workers read cooked meshes or import models,
+ * 			then the frame thread finds their textures and workers decode them (Every File Once),
+ * 			then the frame thread makes device objects in the order of files, so the result
+ * 			doesn't depend on which worker was faster. Every step is timed for every asset.
+ * 			The same file given many times is prepared once, its models share meshes.
+ * 			Decoded textures aren't made then: models show the placeholder until
+ * 			Models::UploadTextures uploads them within the budget of next frames.
+ */
+
+class ModelBatch
+{
+public:
+	ModelBatch(vector<string> Files);
+
+	/**
+	 * \fn	bool ModelBatch::Update();
+	 *
+	 * \brief	Start the next step if workers are done (Called By The Frame Thread)
+	 *
+	 * \returns	True when every model is prepared and Make() can be called.
+	 */
+
+	bool Update();
+	// Update Until Everything Is Prepared
+	void Wait();
+
+	/**
+	 * \fn	shared_ptr<Models> ModelBatch::Make(size_t Index);
+	 *
+	 * \brief	Make device objects of the model (Frame Thread, After Update() Returned True)
+	 *
+	 * \param 	Index	Number of the file which was given to the constructor.
+	 *
+	 * \returns	The model or nullptr if it can't be loaded.
+	 */
+
+	shared_ptr<Models> Make(size_t Index);
+	Models::Prepared *getPrepared(size_t Index) { return Unique.at(Items.at(Index)).get(); }
+	size_t size() { return Items.size(); }
+
+	// Time Of Every Model And Texture And Of The Whole Batch
+	void LogTimings(string Title);
+private:
+	enum Step
+	{
+		Meshes = 0,
+		Textures,
+		Ready
+	};
+	// Jobs Keep It, So The Batch Can Be Dropped Before They're Done
+	struct Work
+	{
+		atomic<size_t> Left{ 0 };
+	};
+
+	void Run(function<void()> Job);
+
+	Step Now = Meshes;
+	shared_ptr<Work> Jobs = make_shared<Work>();
+
+	vector<shared_ptr<Models::Prepared>> Unique;
+	// Index In Unique For Every File
+	vector<size_t> Items;
+	// Every Texture File Of The Batch In The Order Of Models
+	unordered_map<string, shared_ptr<Models::PreparedTexture>> Known;
+	vector<shared_ptr<Models::PreparedTexture>> Decoded;
+
+	chrono::steady_clock::time_point Start = chrono::steady_clock::now();
+	double PrepareMs = 0.;
+};
+#endif // !__MODELBATCH_H__
@@ -0,0 +1,375 @@
+#include "ModelDeps.h"
+
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+
+using namespace std;
+
+namespace
+{
+	const unsigned MaxDepth = 64;
+
+	string Lower(string_view Text)
+	{
+		string Result(Text);
+		for (auto &C: Result)
+			if (C >= 'A' && C <= 'Z')
+				C = char(C - 'A' + 'a');
+		return Result;
+	}
+
+	string_view Trim(string_view Text)
+	{
+		while (!Text.empty() && (Text.front() == ' ' || Text.front() == '\t' || Text.front() == '\r'))
+			Text.remove_prefix(1);
+		while (!Text.empty() && (Text.back() == ' ' || Text.back() == '\t' || Text.back() == '\r' || Text.back() == '\0'))
+			Text.remove_suffix(1);
+		return Text;
+	}
+
+	// Calls F For Every Line (Without \n)
+	template<class Function> void ForEachLine(string_view Data, Function F)
+	{
+		size_t Pos = 0;
+		while (Pos < Data.size())
+		{
+			size_t End = Data.find('\n', Pos);
+			if (End == string_view::npos)
+				End = Data.size();
+			F(Data.substr(Pos, End - Pos));
+			Pos = End + 1;
+		}
+	}
+
+	vector<string_view> Tokens(string_view Line)
+	{
+		vector<string_view> Result;
+		size_t Pos = 0;
+		while (Pos < Line.size())
+		{
+			while (Pos < Line.size() && (Line[Pos] == ' ' || Line[Pos] == '\t'))
+				Pos++;
+			size_t Start = Pos;
+			while (Pos < Line.size() && Line[Pos] != ' ' && Line[Pos] != '\t')
+				Pos++;
+			if (Pos > Start)
+				Result.push_back(Line.substr(Start, Pos - Start));
+		}
+		return Result;
+	}
+
+	template<class T> bool Get(string_view Data, size_t Pos, T &Value)
+	{
+		if (Pos > Data.size() || Data.size() - Pos < sizeof(T))
+			return false;
+		memcpy(&Value, Data.data() + Pos, sizeof(T));
+		return true;
+	}
+
+	// Sign Only Counts With a Digit Or Dot After It: -clamp Is An Option, -0.5 Is a Number
+	bool IsNumber(string_view Token)
+	{
+		if (!Token.empty() && (Token.front() == '-' || Token.front() == '+'))
+			Token.remove_prefix(1);
+		if (Token.empty())
+			return false;
+		char C = Token.front();
+		return (C >= '0' && C <= '9') || C == '.';
+	}
+}
+
+bool ModelDeps::ReadFile(const string &File, string &Data)
+{
+	ifstream Stream(File, ios::binary);
+	if (!Stream.is_open())
+		return false;
+
+	Stream.seekg(0, ios::end);
+	auto Size = Stream.tellg();
+	if (Size < 0)
+		return false;
+	Stream.seekg(0, ios::beg);
+
+	Data.resize((size_t)Size);
+	if (!Data.empty())
+		Stream.read(&Data[0], Data.size());
+	return Stream.good() || Stream.eof();
+}
+
+bool ModelDeps::IsSupported(const string &File)
+{
+	size_t Dot = File.find_last_of('.');
+	if (Dot == string::npos)
+		return false;
+
+	string Ext = Lower(string_view(File).substr(Dot));
+	return Ext == ".obj" || Ext == ".3ds" || Ext == ".fbx";
+}
+
+void ModelDeps::AddTexture(string Name, Result &Out)
+{
+	string_view View = Trim(Name);
+	if (View.size() >= 2 && View.front() == '"' && View.back() == '"')
+		View = View.substr(1, View.size() - 2);
+	if (View.empty())
+		return;
+
+	string Key = Lower(View);
+	for (auto &It: Out.Textures)
+		if (Lower(It) == Key)
+			return;
+
+	Out.Textures.push_back(string(View));
+}
+
+bool ModelDeps::Scan(const string &File, Result &Out, Reader Read)
+{
+	string Data;
+	if (!(Read ? Read(File, Data) : ReadFile(File, Data)))
+		return false;
+
+	return Scan(File, Data, Out, Read);
+}
+
+bool ModelDeps::Scan(const string &File, string_view Data, Result &Out, Reader Read)
+{
+	if (!IsSupported(File))
+		return false;
+
+	string Ext = Lower(string_view(File).substr(File.find_last_of('.')));
+	if (Ext == ".3ds")
+		return Scan3DS(Data, Out);
+	if (Ext == ".fbx")
+		return ScanFBX(Data, Out);
+
+	// .mtl Is Near The .obj
+	size_t Slash = File.find_last_of("/\\");
+	string Folder = Slash == string::npos ? string() : File.substr(0, Slash + 1);
+	if (!Read)
+		Read = ReadFile;
+	return ScanOBJ(Data, Folder, Out, Read);
+}
+
+bool ModelDeps::ScanOBJ(string_view Data, const string &Folder, Result &Out, const Reader &Read)
+{
+	ForEachLine(Data, [&](string_view Line)
+	{
+		Line = Trim(Line);
+		if (Line.size() < 7 || Line.compare(0, 6, "mtllib") != 0 || (Line[6] != ' ' && Line[6] != '\t'))
+			return;
+
+		// As Assimp Does: The Rest Of The Line Is The Name (It May Have Spaces)
+		string Name(Trim(Line.substr(7)));
+		if (Name.empty())
+			return;
+
+		string Text;
+		if (!Read || !Read(Folder + Name, Text))
+			return;
+
+		Out.Materials.push_back(Name);
+		ScanMTL(Text, Out);
+	});
+
+	return true;
+}
+
+void ModelDeps::ScanMTL(string_view Data, Result &Out)
+{
+	ForEachLine(Data, [&](string_view Line)
+	{
+		auto List = Tokens(Trim(Line));
+		if (List.size() < 2)
+			return;
+
+		string Key = Lower(List.front());
+		if (Key.compare(0, 4, "map_") != 0 && Key != "bump" && Key != "disp" && Key != "decal" &&
+			Key != "refl" && Key != "norm")
+			return;
+
+		// Options Go Before The Name: -o 1 1 1, -mm 0 1, -clamp on, -type sphere...
+		size_t i = 1;
+		while (i < List.size() && List.at(i).size() > 1 && List.at(i).front() == '-' && !IsNumber(List.at(i).substr(1)))
+		{
+			string Option = Lower(List.at(i++).substr(1));
+			size_t Args = 1;
+			if (Option == "mm")
+				Args = 2;
+			else if (Option == "o" || Option == "s" || Option == "t")
+				Args = 3;
+
+			// Only Numbers Are Optional (-o u [v [w]])
+			for (size_t Taken = 0; Taken < Args && i < List.size() - 1; Taken++)
+			{
+				if (Args == 3 && Taken > 0 && !IsNumber(List.at(i)))
+					break;
+				i++;
+			}
+		}
+		if (i >= List.size())
+			return;
+
+		// The Name May Have Spaces
+		string Name(List.at(i));
+		for (size_t j = i + 1; j < List.size(); j++)
+			Name += " " + string(List.at(j));
+		AddTexture(Name, Out);
+	});
+}
+
+bool ModelDeps::Scan3DS(string_view Data, Result &Out)
+{
+	uint16_t ID = 0;
+	if (!Get(Data, 0, ID) || ID != 0x4D4D)
+		return false;
+
+	return Walk3DS(Data, 0, Data.size(), 0, Out);
+}
+
+bool ModelDeps::Walk3DS(string_view Data, size_t Begin, size_t End, unsigned Depth, Result &Out)
+{
+	if (Depth > MaxDepth)
+		return false;
+
+	size_t Pos = Begin;
+	while (Pos + 6 <= End)
+	{
+		uint16_t ID = 0;
+		uint32_t Length = 0;
+		Get(Data, Pos, ID);
+		Get(Data, Pos + 2, Length);
+		if (Length < 6 || Length > End - Pos)
+			return false;
+
+		switch (ID)
+		{
+		// Main, Editor, Material
+		case 0x4D4D:
+		case 0x3D3D:
+		case 0xAFFF:
+		// Maps: Texture 1 And 2, Opacity, Bump, Specular, Shininess, Reflection, Self-Illumination
+		case 0xA200:
+		case 0xA33A:
+		case 0xA210:
+		case 0xA230:
+		case 0xA204:
+		case 0xA33C:
+		case 0xA220:
+		case 0xA33D:
+			if (!Walk3DS(Data, Pos + 6, Pos + Length, Depth + 1, Out))
+				return false;
+			break;
+		// Name Of Map File (Zero-Terminated)
+		case 0xA300:
+		{
+			string_view Name = Data.substr(Pos + 6, Length - 6);
+			size_t Zero = Name.find('\0');
+			if (Zero != string_view::npos)
+				Name = Name.substr(0, Zero);
+			AddTexture(string(Name), Out);
+			break;
+		}
+		default:
+			break;
+		}
+
+		Pos += Length;
+	}
+
+	return true;
+}
+
+bool ModelDeps::ScanFBX(string_view Data, Result &Out)
+{
+	static const char Magic[] = "Kaydara FBX Binary  ";
+	if (Data.size() >= 27 && Data.compare(0, sizeof(Magic) - 1, Magic) == 0)
+	{
+		uint32_t Version = 0;
+		Get(Data, 23, Version);
+		// Offsets Are 64-Bit Since 7.5
+		return WalkFBX(Data, 27, Data.size(), Version >= 7500, 0, Out);
+	}
+
+	// ASCII: RelativeFilename: "textures\wood.png"
+	ForEachLine(Data, [&](string_view Line)
+	{
+		Line = Trim(Line);
+		for (string_view Key: { "RelativeFilename:", "FileName:", "Filename:" })
+		{
+			if (Line.compare(0, Key.size(), Key) != 0)
+				continue;
+
+			string_view Value = Trim(Line.substr(Key.size()));
+			if (Value.size() >= 2 && Value.front() == '"')
+			{
+				size_t Close = Value.find('"', 1);
+				if (Close != string_view::npos)
+					AddTexture(string(Value.substr(1, Close - 1)), Out);
+			}
+			break;
+		}
+	});
+
+	return true;
+}
+
+bool ModelDeps::WalkFBX(string_view Data, size_t Begin, size_t End, bool Wide, unsigned Depth, Result &Out)
+{
+	if (Depth > MaxDepth)
+		return false;
+
+	const size_t Header = Wide ? 25 : 13;
+	size_t Pos = Begin;
+	while (Pos + Header <= End)
+	{
+		uint64_t EndOffset = 0, Properties = 0, PropertiesLength = 0;
+		if (Wide)
+		{
+			Get(Data, Pos, EndOffset);
+			Get(Data, Pos + 8, Properties);
+			Get(Data, Pos + 16, PropertiesLength);
+		}
+		else
+		{
+			uint32_t Value = 0;
+			Get(Data, Pos, Value);
+			EndOffset = Value;
+			Get(Data, Pos + 4, Value);
+			Properties = Value;
+			Get(Data, Pos + 8, Value);
+			PropertiesLength = Value;
+		}
+
+		// Null Record Ends The List
+		if (EndOffset == 0)
+			break;
+		if (EndOffset <= Pos || EndOffset > End)
+			return false;
+
+		uint8_t NameLength = (uint8_t)Data[Pos + Header - 1];
+		size_t PropertiesStart = Pos + Header + NameLength;
+		if (PropertiesStart > EndOffset || PropertiesLength > EndOffset - PropertiesStart)
+			return false;
+
+		// The Type Byte Is Read Only If The Record Has Properties (It May End The Data)
+		string_view Name = Data.substr(Pos + Header, NameLength);
+		if (Properties > 0 && PropertiesLength > 0 &&
+			(Name == "FileName" || Name == "Filename" || Name == "RelativeFilename") && Data[PropertiesStart] == 'S')
+		{
+			uint32_t Length = 0;
+			if (PropertiesLength >= 5 && Get(Data, PropertiesStart + 1, Length) && Length <= PropertiesLength - 5)
+				AddTexture(string(Data.substr(PropertiesStart + 5, Length)), Out);
+		}
+
+		// Properties (Even Big Arrays Of Vertices) Are Skipped By Their Length
+		size_t Children = PropertiesStart + (size_t)PropertiesLength;
+		if (Children < EndOffset && !WalkFBX(Data, Children, (size_t)EndOffset, Wide, Depth + 1, Out))
+			return false;
+
+		Pos = (size_t)EndOffset;
+	}
+
+	return true;
+}
@@ -0,0 +1,71 @@
+/**
+ * \file	ModelDeps.h.
+ *
+ * \brief	Declares the extractor of texture references from model files
+ */
+
+#pragma once
+#if !defined(__MODELDEPS_H__)
+#define __MODELDEPS_H__
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+
+/**
+ * \class	ModelDeps
+ *
+ * \brief	Finds which textures (And Material Libraries) a model needs without importing it:
+ * 			.obj (mtllib -> map_* Of The .mtl), .3ds (Map Chunks Of Materials) and .fbx
+ * 			(FileName And RelativeFilename Of Binary Or ASCII Nodes). Nothing is built: only
+ * 			records with names are looked at and the rest is skipped by its length, so it's
+ * 			cheap and can be called from any thread.
+ * 			Used by the engine (File_system) and by tools, so it doesn't need pch.h.
+ */
+
+class ModelDeps
+{
+public:
+	// Read Whole File (False If There's No Such File)
+	using Reader = std::function<bool(const std::string &File, std::string &Data)>;
+
+	struct Result
+	{
+		// Textures As They Are Written In The Model (Or In Its .mtl), Without Duplicates
+		std::vector<std::string> Textures;
+		// Material Libraries (.mtl) Which Were Read
+		std::vector<std::string> Materials;
+	};
+
+	/**
+	 * \fn	static bool ModelDeps::Scan(const std::string &File, Result &Out, Reader Read = nullptr);
+	 *
+	 * \brief	Find references of the model file
+	 *
+	 * \param 		  	File	The model.
+	 * \param [in,out]	Out 	The references.
+	 * \param 		  	Read	(Optional) How files are read (Disk If It's Empty).
+	 *
+	 * \returns	False if the file can't be read or its format isn't known or it's broken.
+	 */
+
+	static bool Scan(const std::string &File, Result &Out, Reader Read = nullptr);
+	// Data Of The Model Is Already Read (Or Mapped)
+	static bool Scan(const std::string &File, std::string_view Data, Result &Out, Reader Read = nullptr);
+
+	// Data Is The Whole File. Folder Is Where .mtl Files Are Looked For (With Slash At End)
+	static bool ScanOBJ(std::string_view Data, const std::string &Folder, Result &Out, const Reader &Read);
+	static void ScanMTL(std::string_view Data, Result &Out);
+	static bool Scan3DS(std::string_view Data, Result &Out);
+	static bool ScanFBX(std::string_view Data, Result &Out);
+
+	// .obj, .3ds, .fbx (Case-Insensitive)
+	static bool IsSupported(const std::string &File);
+	static bool ReadFile(const std::string &File, std::string &Data);
+private:
+	static void AddTexture(std::string Name, Result &Out);
+	static bool Walk3DS(std::string_view Data, size_t Begin, size_t End, unsigned Depth, Result &Out);
+	static bool WalkFBX(std::string_view Data, size_t Begin, size_t End, bool Wide, unsigned Depth, Result &Out);
+};
+#endif // !__MODELDEPS_H__
@@ -8,25 +8,550 @@ extern shared_ptr<Engine> Application;
 #include "Console.h"
 #include "Shaders.h"
 #include "File_system.h"
+#include "MappedFile.h"
+#include "CookedMesh.h"
+#include "ResidentCache.h"
+#include "ModelBatch.h"
+#include "Camera.h"
 
-bool Models::LoadFromFile(string Filename)
-{	
-	importer = new Assimp::Importer;
-	pScene = importer->ReadFile(Filename.c_str(),
-		aiProcess_Triangulate | aiProcess_ConvertToLeftHanded
-		| aiProcess_OptimizeMeshes | aiProcess_SortByPType | aiProcess_FindInvalidData
-		| aiProcess_GenUVCoords | aiProcess_TransformUVCoords | aiProcess_OptimizeGraph);
-	if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode || !pScene->HasMeshes())
-	{
-		Engine::LogError(string("Model: Scene return nullptr with text: ") + (!importer->GetErrorString()
-			? "flag: " + to_string(pScene->mFlags) : string("text: ") + importer->GetErrorString()),
-			string(__FILE__) + ": " + to_string(__LINE__),
-			string("Model: Scene return nullptr with text: ") + (!importer->GetErrorString()
-				? "flag: " + to_string(pScene->mFlags) : string("text: ") + importer->GetErrorString()));
+#include <wincodec.h>
+
+static_assert(sizeof(Things) == sizeof(CookedMesh::Vertex), "Cooked Vertices Are Copied As Things");
+
+// Meshes Which The Engine Cooked When It Imported Them: cache/meshes/<Source Hash>.mesh
+static string getMeshCache(uint64_t Source)
+{
+	char Name[17] = {};
+	snprintf(Name, sizeof(Name), "%016llx", (unsigned long long)Source);
+	return File_system::GetCurrentPath() + "cache/meshes/" + Name + CookedMesh::Ext;
+}
+
+// Hash Of The Model And Its .mtl (Loose Or In The Archive), 0 If It Can't Be Read
+static uint64_t getSourceHash(const string &Filename)
+{
+	MappedFile Model(Filename, MappedFile::Sequential);
+	if (!Model.IsOpen())
+		return 0;
+
+	return CookedMesh::SourceHash(Filename, Model.View(), [](const string &File, string &Text)
+	{
+		MappedFile Library(File, MappedFile::Sequential);
+		if (!Library.IsOpen())
+			return false;
+		Text.assign(Library.View());
+		return true;
+	});
+}
+
+// RGBA Pixels Of The Image (WIC Is Free-Threaded, So Any Worker Decodes)
+static bool decodeWIC(const uint8_t *Data, size_t Size, vector<uint8_t> &Pixels, UINT &Width, UINT &Height)
+{
+	// Workers Haven't Joined COM Themselves
+	HRESULT Com = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	IWICImagingFactory *Factory = nullptr;
+	IWICStream *Stream = nullptr;
+	IWICBitmapDecoder *Decoder = nullptr;
+	IWICBitmapFrameDecode *Frame = nullptr;
+	IWICFormatConverter *Converter = nullptr;
+
+	bool Result = SUCCEEDED(CoCreateInstance(CLSID_WICImagingFactory, nullptr, CLSCTX_INPROC_SERVER,
+			IID_PPV_ARGS(&Factory))) &&
+		SUCCEEDED(Factory->CreateStream(&Stream)) &&
+		SUCCEEDED(Stream->InitializeFromMemory(const_cast<BYTE *>(Data), (DWORD)Size)) &&
+		SUCCEEDED(Factory->CreateDecoderFromStream(Stream, nullptr, WICDecodeMetadataCacheOnDemand, &Decoder)) &&
+		SUCCEEDED(Decoder->GetFrame(0, &Frame)) &&
+		SUCCEEDED(Frame->GetSize(&Width, &Height)) &&
+		// Bigger Images Are Resized By The Device Loader
+		Width > 0 && Height > 0 &&
+		Width <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION && Height <= D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION &&
+		SUCCEEDED(Factory->CreateFormatConverter(&Converter)) &&
+		SUCCEEDED(Converter->Initialize(Frame, GUID_WICPixelFormat32bppRGBA, WICBitmapDitherTypeNone, nullptr, 0.,
+			WICBitmapPaletteTypeCustom));
+	if (Result)
+	{
+		Pixels.resize(size_t(Width) * Height * 4);
+		Result = SUCCEEDED(Converter->CopyPixels(nullptr, Width * 4, (UINT)Pixels.size(), Pixels.data()));
+	}
+	if (!Result)
+		Pixels = vector<uint8_t>();
+
+	SAFE_RELEASE(Converter);
+	SAFE_RELEASE(Frame);
+	SAFE_RELEASE(Decoder);
+	SAFE_RELEASE(Stream);
+	SAFE_RELEASE(Factory);
+	if (SUCCEEDED(Com))
+		CoUninitialize();
+
+	return Result;
+}
+
+// Immutable Texture Of RGBA Pixels Without Mip Levels
+static HRESULT createRGBA(const void *Pixels, UINT Width, UINT Height, ResidentTexture &Target)
+{
+	D3D11_TEXTURE2D_DESC Desc = {};
+	Desc.Width = Width;
+	Desc.Height = Height;
+	Desc.MipLevels = 1;
+	Desc.ArraySize = 1;
+	Desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+	Desc.SampleDesc.Count = 1;
+	Desc.Usage = D3D11_USAGE_IMMUTABLE;
+	Desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+	D3D11_SUBRESOURCE_DATA Init = {};
+	Init.pSysMem = Pixels;
+	Init.SysMemPitch = Width * 4;
+
+	ID3D11Texture2D *Texture2D = nullptr;
+	HRESULT Result = Application->getDevice()->CreateTexture2D(&Desc, &Init, &Texture2D);
+	if (FAILED(Result))
+		return Result;
+
+	Target.TextureRes = Texture2D;
+	return Application->getDevice()->CreateShaderResourceView(Texture2D, nullptr, &Target.TextureSHRes);
+}
+
+// Errors And Spheres Of Meshes Grow With The Biggest Scale Of The Transform
+static float getMaxScale(const Matrix &Mrx)
+{
+	return max(Vector3(Mrx._11, Mrx._12, Mrx._13).Length(), max(Vector3(Mrx._21, Mrx._22, Mrx._23).Length(),
+		Vector3(Mrx._31, Mrx._32, Mrx._33).Length()));
+}
+
+static double getMs(chrono::steady_clock::time_point Start)
+{
+	return chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+}
+
+bool Models::LoadCooked(string File, uint64_t Source, Prepared &Data)
+{
+	auto Mapped = make_shared<MappedFile>(File, MappedFile::Sequential);
+	if (!Mapped->IsOpen())
+		return false;
+
+	// Nothing Is Copied Until Meshes Are Made: Parts Point Into The Mapping
+	CookedMesh::View Cooked;
+	if (!CookedMesh::Parse(Mapped->View(), Cooked) || Cooked.Head.Flags != CookedMesh::ImportFlags ||
+		Cooked.Head.Source != Source)
+	{
+		Data.Log.push_back("Model: Cooked Mesh " + File + " Is Broken Or Outdated");
+		return false;
+	}
+
+	Data.Parts.clear();
+	for (uint32_t i = 0; i < Cooked.Head.Parts; i++)
+	{
+		auto &It = Cooked.Parts[i];
+		PreparedPart Part;
+		Part.Vertices = reinterpret_cast<const Things *>(Cooked.Vertices + It.FirstVertex);
+		Part.VertexCount = It.VertexCount;
+		Part.Indices = Cooked.Indices + It.FirstIndex;
+		Part.IndexCount = It.IndexCount;
+		for (uint32_t j = It.FirstLod; j < It.FirstLod + It.LodCount; j++)
+			Part.Lods.push_back({ Cooked.Lods[j].FirstIndex, Cooked.Lods[j].IndexCount, Cooked.Lods[j].Error });
+		Part.Textures = Cooked.getTextures(i);
+		Data.Parts.push_back(move(Part));
+	}
+	Data.Storage = Mapped;
+
+	return true;
+}
+
+bool Models::Import(string Filename, uint64_t Source, Prepared &Data)
+{
+	auto Importer = make_shared<Assimp::Importer>();
+
+	// Parse Right From Mapped File (Loose Or In The Archive)
+	Importer->SetIOHandler(new MappedIOSystem);
+	auto Scene = Importer->ReadFile(Filename.c_str(), CookedMesh::ImportFlags);
+	if (!Scene || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !Scene->mRootNode || !Scene->HasMeshes())
+	{
+		Data.Error = string("Model: Scene return nullptr with text: ") + (Scene && !*Importer->GetErrorString()
+			? "flag: " + to_string(Scene->mFlags) : string("text: ") + Importer->GetErrorString());
 		return false;
 	}
 
-	processNode(pScene->mRootNode, pScene);
+	// Embedded Textures Are Taken From The Scene, So The Frame Thread Makes Such Model From It
+	if (Scene->HasTextures())
+	{
+		Data.From = "embedded";
+		Data.Scene = Importer;
+		return true;
+	}
+
+	auto Cooking = make_shared<CookedMesh>();
+	Cooking->AddNode(Scene->mRootNode, Scene);
+	// Everything Is Copied, The Scene Isn't Needed Anymore
+	Importer->FreeScene();
+
+	char Stats[128];
+	snprintf(Stats, sizeof(Stats), "ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", Cooking->Before.ACMR(),
+		Cooking->After.ACMR(), Cooking->Before.ATVR(), Cooking->After.ATVR());
+	Data.Log.push_back("Model: " + Filename + " Is Optimized For Vertex Cache: " + Stats);
+
+	// Next Time It Isn't Imported
+	if (Source)
+	{
+		Cooking->Source = Source;
+		Cooking->Flags = CookedMesh::ImportFlags;
+
+		string Cache = getMeshCache(Source);
+		boost::system::error_code EC;
+		create_directories(path(Cache).parent_path(), EC);
+		if (!Cooking->Save(Cache))
+			Data.Log.push_back("Model: Cannot Write Cooked Mesh " + Cache);
+	}
+
+	Data.Parts.clear();
+	for (size_t i = 0; i < Cooking->Parts.size(); i++)
+	{
+		auto &It = Cooking->Parts.at(i);
+		PreparedPart Part;
+		Part.Vertices = reinterpret_cast<const Things *>(Cooking->Vertices.data() + It.FirstVertex);
+		Part.VertexCount = It.VertexCount;
+		Part.Indices = Cooking->Indices.data() + It.FirstIndex;
+		Part.IndexCount = It.IndexCount;
+		for (uint32_t j = It.FirstLod; j < It.FirstLod + It.LodCount; j++)
+			Part.Lods.push_back({ Cooking->Lods[j].FirstIndex, Cooking->Lods[j].IndexCount, Cooking->Lods[j].Error });
+		Part.Textures = Cooking->Textures.at(i);
+		Data.Parts.push_back(move(Part));
+	}
+	Data.From = "import";
+	Data.Storage = Cooking;
+
+	return true;
+}
+
+shared_ptr<Models::Prepared> Models::BeginPrepare(string Filename)
+{
+	auto Data = make_shared<Prepared>();
+	Data->File = Filename;
+
+	auto Cache = Application->getCache();
+	if (Cache.operator bool())
+		Data->Resident = Cache->Find<ResidentModel>(ResidentCache::Models, StringID::Path(Filename));
+	if (Data->Resident.operator bool())
+		Data->From = "resident";
+
+	return Data;
+}
+
+void Models::PrepareMeshes(Prepared &Data)
+{
+	if (Data.Resident.operator bool())
+		return;
+
+	auto Start = chrono::steady_clock::now();
+
+	// Cooked By Tools/Cook (Mounted Next To The Model), Then Cooked By The Engine When It Imported It
+	Data.Source = getSourceHash(Data.File);
+	if (Data.Source && LoadCooked(Data.File + CookedMesh::Ext, Data.Source, Data))
+		Data.From = "cooked";
+	else if (Data.Source && LoadCooked(getMeshCache(Data.Source), Data.Source, Data))
+		Data.From = "cache";
+	else if (!Import(Data.File, Data.Source, Data))
+		Data.Failed = true;
+
+	Data.MeshMs = getMs(Start);
+}
+
+shared_ptr<Models::PreparedTexture> Models::findTexture(const string &Name,
+	unordered_map<string, shared_ptr<PreparedTexture>> &Known)
+{
+	string TName = path(Name).filename().string();
+	to_lower(TName);
+	auto File = Application->getFS()->GetFile(TName);
+	if (!File.operator bool())
+		return nullptr;
+
+	// Alias Has PathA Of The Stored File, So It Gets The Same Texture
+	string Path = path(File->PathA).generic_string();
+	to_lower(Path);
+
+	auto &It = Known[Path];
+	if (It.operator bool())
+		return It;
+
+	It = make_shared<PreparedTexture>();
+	It->Path = Path;
+	It->File = File->PathA;
+	It->Name = File->FileA;
+	It->Ext = File->ExtA;
+
+	auto Cache = Application->getCache();
+	if (Cache.operator bool())
+		It->Resident = Cache->Find<ResidentTexture>(ResidentCache::Textures, StringID::Path(Path));
+
+	return It;
+}
+
+void Models::PrepareTextures(Prepared &Data, unordered_map<string, shared_ptr<PreparedTexture>> &Known)
+{
+	for (auto &Part: Data.Parts)
+		for (auto &Name: Part.Textures)
+			if (Data.Textures.find(Name) == Data.Textures.end())
+				Data.Textures[Name] = findTexture(Name, Known);
+}
+
+void Models::DecodeTexture(PreparedTexture &It)
+{
+	if (It.Resident.operator bool() || !It.Pixels.empty() || It.Encoded.operator bool())
+		return;
+
+	auto Start = chrono::steady_clock::now();
+
+	// DDS Is Made By The Device Loader As It Is, Other Formats Are Decoded Here
+	auto Mapped = make_shared<MappedFile>(It.File, MappedFile::WillNeed);
+	if (Mapped->IsOpen() && (FindSubStr(It.Ext, ".dds") ||
+		!decodeWIC(Mapped->data(), Mapped->size(), It.Pixels, It.Width, It.Height)))
+		It.Encoded = Mapped;
+
+	It.DecodeMs = getMs(Start);
+}
+
+shared_ptr<ResidentTexture> Models::createTexture(const shared_ptr<PreparedTexture> &It)
+{
+	if (It->Resident.operator bool() || It->Failed)
+		return It->Resident;
+
+	// The Device Texture Has These Pixels, DDS Has The Same Size As Its File (Other Files Are Estimated So)
+	size_t Bytes = !It->Pixels.empty() ? It->Pixels.size() :
+		It->Encoded.operator bool() ? static_pointer_cast<MappedFile>(It->Encoded)->size() : 0;
+	if (!Bytes)
+	{
+		Console::LogInfo(string("Something is wrong with this texture: ") + It->Name);
+		It->Failed = true;
+		return nullptr;
+	}
+
+	auto New = make_shared<ResidentTexture>();
+	New->Placeholder = getPlaceholder();
+
+	// Models Of Other Levels Find It In The Cache While It Waits, So It's Decoded Once
+	auto Cache = Application->getCache();
+	if (Cache.operator bool())
+		It->Resident = Cache->Add(ResidentCache::Textures, StringID::Path(It->Path), New, Bytes);
+	else
+		It->Resident = New;
+
+	Uploads.Add(It, Bytes);
+	return It->Resident;
+}
+
+shared_ptr<ResidentTexture> Models::getPlaceholder()
+{
+	auto Result = Blank.lock();
+	if (Result.operator bool())
+		return Result;
+
+	Result = make_shared<ResidentTexture>();
+	Blank = Result;
+
+	// Opaque Grey (R, G, B, A Bytes)
+	const uint32_t Grey = 0xff808080;
+	createRGBA(&Grey, 1, 1, *Result);
+
+	return Result;
+}
+
+bool Models::addMeshes(Prepared &Data)
+{
+	for (auto &It: Data.Log)
+		Console::LogInfo(It);
+	Data.Log.clear();
+
+	if (Data.Failed)
+	{
+		Engine::LogError(Data.Error, string(__FILE__) + ": " + to_string(__LINE__), Data.Error);
+		return false;
+	}
+
+	if (Data.Scene.operator bool())
+	{
+		auto Scene = Data.Scene->GetScene();
+		processNode(Scene->mRootNode, Scene);
+		return true;
+	}
+
+	for (auto &Part: Data.Parts)
+		meshes.push_back(make_shared<Mesh>(Part.Vertices, Part.VertexCount, Part.Indices, Part.IndexCount,
+			loadTextures(Part.Textures, "texture_diffuse", nullptr, &Data), Part.Lods));
+
+	return true;
+}
+
+bool Models::LoadPrepared(Prepared &Data)
+{
+	auto Start = chrono::steady_clock::now();
+
+	// Other Object Has This Model: Only The Handle Is Taken
+	if (!Data.Resident.operator bool())
+	{
+		if (!addMeshes(Data))
+			return false;
+
+		auto New = make_shared<ResidentModel>();
+		New->Meshes.swap(meshes);
+		New->Textures.swap(Textures_loaded);
+
+		// Embedded Textures Aren't In The Textures Category, So The Model Counts Them
+		size_t Bytes = 0;
+		for (auto &It: New->Meshes)
+			Bytes += It->getBytes();
+		for (auto &It: New->Textures)
+			if (!It.Resident.operator bool() && It.TextureSHRes)
+			{
+				ID3D11Resource *Res = nullptr;
+				It.TextureSHRes->GetResource(&Res);
+				Bytes += getTextureBytes(Res);
+				SAFE_RELEASE(Res);
+			}
+
+		auto Cache = Application->getCache();
+		if (Cache.operator bool() && !New->Meshes.empty())
+			Data.Resident = Cache->Add(ResidentCache::Models, StringID::Path(Data.File), New, Bytes);
+		else
+			Data.Resident = New;
+
+		// Next Models Of This File (e.g. Of The Same Level) Share It, Prepared Data Isn't Needed
+		Data.Parts.clear();
+		Data.Storage.reset();
+		Data.Scene.reset();
+	}
+
+	Resident = Data.Resident;
+	Shared = getPipeline();
+
+	Data.DeviceMs += getMs(Start);
+	return true;
+}
+
+bool Models::LoadFromFile(string Filename)
+{
+	// The Same Steps Which ModelBatch Does With Workers
+	auto Data = BeginPrepare(Filename);
+	PrepareMeshes(*Data);
+
+	unordered_map<string, shared_ptr<PreparedTexture>> Known;
+	PrepareTextures(*Data, Known);
+	for (auto &It: Known)
+		DecodeTexture(*It.second);
+
+	return LoadPrepared(*Data);
+}
+
+weak_ptr<Models::Pipeline> Models::Current;
+bool Models::CompactMeshes = true;
+bool Models::Instancing = true;
+InstanceQueue Models::Queue;
+InstanceQueue::Stats Models::LastFrame;
+UploadQueue Models::Uploads;
+UploadQueue::Stats Models::LastUploads;
+size_t Models::UploadBudget = 16 * 1024 * 1024;
+weak_ptr<ResidentTexture> Models::Blank;
+
+class Models::DeviceTextures: public UploadQueue::Backend
+{
+public:
+	bool Upload(void *Item) override
+	{
+		// The Handle Is Kept Until It's Uploaded: Models Of Next Levels Can Find It In The Cache
+		auto &It = *static_cast<PreparedTexture *>(Item);
+		auto Target = It.Resident;
+		if (!Target.operator bool())
+			return false;
+
+		HRESULT Result = E_FAIL;
+		if (!It.Pixels.empty())
+			Result = createRGBA(It.Pixels.data(), It.Width, It.Height, *Target);
+		else if (It.Encoded.operator bool())
+		{
+			auto Mapped = static_pointer_cast<MappedFile>(It.Encoded);
+			Result = FindSubStr(It.Ext, ".dds")
+				? CreateDDSTextureFromMemory(Application->getDevice(), Mapped->data(), Mapped->size(),
+					&Target->TextureRes, &Target->TextureSHRes)
+				: CreateWICTextureFromMemory(Application->getDevice(), Mapped->data(), Mapped->size(),
+					&Target->TextureRes, &Target->TextureSHRes);
+		}
+
+		// Decoded Data Isn't Needed Anymore
+		It.Pixels = vector<uint8_t>();
+		It.Encoded.reset();
+
+		if (FAILED(Result))
+		{
+			// Models Which Have It Keep The Placeholder, The Next Load Of The Texture Tries Again
+			SAFE_RELEASE(Target->TextureSHRes);
+			SAFE_RELEASE(Target->TextureRes);
+			Console::LogInfo(string("Something is wrong with this texture: ") + It.Name);
+			if (Application->getCache().operator bool())
+				Application->getCache()->Forget(ResidentCache::Textures, StringID::Path(It.Path));
+			It.Resident.reset();
+			It.Failed = true;
+			return false;
+		}
+
+		Target->Placeholder.reset();
+		return true;
+	}
+};
+
+void Models::UploadTextures()
+{
+	if (!Uploads.size())
+	{
+		LastUploads = UploadQueue::Stats();
+		return;
+	}
+
+	DeviceTextures Device;
+	LastUploads = Uploads.Update(Device, UploadBudget);
+}
+
+void Models::ForgetUploads()
+{
+	Uploads.Clear();
+	LastUploads = UploadQueue::Stats();
+}
+
+class Models::DeviceInstances: public InstanceQueue::Backend
+{
+public:
+	DeviceInstances(Pipeline &Shared): Shared(Shared) {}
+
+	size_t getCapacity() override { return Pipeline::MaxInstances; }
+	void Write(const float *Worlds, size_t Count) override
+	{
+		// Draws Of The Previous Write Keep Its Data
+		D3D11_MAPPED_SUBRESOURCE Mapped;
+		if (FAILED(Application->getDeviceContext()->Map(Shared.InstanceBuffer, 0, D3D11_MAP_WRITE_DISCARD, 0, &Mapped)))
+			return;
+		memcpy(Mapped.pData, Worlds, Count * sizeof(Matrix));
+		Application->getDeviceContext()->Unmap(Shared.InstanceBuffer, 0);
+	}
+	void Draw(const void *It, size_t Level, size_t First, size_t Count) override
+	{
+		auto Source = static_cast<Mesh *>(const_cast<void *>(It));
+		Application->getDeviceContext()->IASetInputLayout(Source->isPacked() ? Shared.pPackedInstancedLayout :
+			Shared.pInstancedLayout);
+		Source->Draw(Level, Shared.InstanceBuffer, (UINT)First, (UINT)Count);
+	}
+
+private:
+	Pipeline &Shared;
+};
+
+shared_ptr<Models::Pipeline> Models::getPipeline()
+{
+	// Every Model Has The Same Shaders, So They're Compiled Once
+	auto Result = Current.lock();
+	if (Result.operator bool())
+		return Result;
+
+	Result = make_shared<Pipeline>();
+	Current = Result;
 
 	D3D11_SAMPLER_DESC sampDesc;
 	ZeroMemory(&sampDesc, sizeof(sampDesc));
@@ -37,7 +562,7 @@ bool Models::LoadFromFile(string Filename)
 	sampDesc.ComparisonFunc = D3D11_COMPARISON_NOT_EQUAL;
 	sampDesc.MaxLOD = D3D11_FLOAT32_MAX;
 
-	Application->getDevice()->CreateSamplerState(&sampDesc, &TexSamplerState);
+	Application->getDevice()->CreateSamplerState(&sampDesc, &Result->TexSamplerState);
 
 	vector<ID3DBlob *> Buffer_blob;
 	vector<string> FileShaders =
@@ -57,13 +582,13 @@ bool Models::LoadFromFile(string Filename)
 	};
 	vector<void *> Buffers = Shaders::CompileShaderFromFile(Buffer_blob =
 		Shaders::CreateShaderFromFile(FileShaders, Functions, Version));
-	VS = (ID3D11VertexShader *)Buffers[0]; // VS
-	PS = (ID3D11PixelShader *)Buffers[1]; // PS
+	Result->VS = (ID3D11VertexShader *)Buffers[0]; // VS
+	Result->PS = (ID3D11PixelShader *)Buffers[1]; // PS
 
 	Application->getDevice()->CreateVertexShader(Buffer_blob.at(0)->GetBufferPointer(), Buffer_blob.at(0)->GetBufferSize(),
-		NULL, &VS);
+		NULL, &Result->VS);
 	Application->getDevice()->CreatePixelShader(Buffer_blob.at(1)->GetBufferPointer(), Buffer_blob.at(1)->GetBufferSize(),
-		NULL, &PS);
+		NULL, &Result->PS);
 
 	D3D11_INPUT_ELEMENT_DESC ied[] =
 	{
@@ -72,66 +597,267 @@ bool Models::LoadFromFile(string Filename)
 	};
 
 	Application->getDevice()->CreateInputLayout(ied, 2, Buffer_blob.at(0)->GetBufferPointer(),
-		Buffer_blob.at(0)->GetBufferSize(), &pLayout);
+		Buffer_blob.at(0)->GetBufferSize(), &Result->pLayout);
 
-	pConstantBuffer = Render_Buffer::CreateConstBuff(D3D11_USAGE::D3D11_USAGE_DEFAULT, 0, sizeof(cb));
-	
-	//	TM->EndTime();
-	//Console::LogInfo((string("\nCreate Buffers And Shaders For Model Take:" + to_string(TM->GetResultTime().count())
-	//	+ string(" Seconds")).c_str()));
+	// The Same Shader Reads Packed Vertices: The Device Turns Them Into Floats (Position In 0..1 Of The Bounds)
+	D3D11_INPUT_ELEMENT_DESC Packed[] =
+	{
+		{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+		{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 }
+	};
 
-	return true;
+	Application->getDevice()->CreateInputLayout(Packed, 2, Buffer_blob.at(0)->GetBufferPointer(),
+		Buffer_blob.at(0)->GetBufferSize(), &Result->pPackedLayout);
+
+	// Variant For Instancing: Vertex Shader Files Which Don't Have It Keep Drawing Every Model By Itself
+	// (It's Compiled Quietly, So Its Absence Isn't Logged As An Error)
+	const string Instanced = "Vertex_model_Instanced_VS";
+	ID3DBlob *Blob = nullptr;
+	if (SUCCEEDED(Shaders::TryCompileShaderFromFile(FileShaders.at(0), Instanced, Version.at(0), &Blob)))
+	{
+		Application->getDevice()->CreateVertexShader(Blob->GetBufferPointer(), Blob->GetBufferSize(), NULL,
+			&Result->InstancedVS);
+
+		D3D11_INPUT_ELEMENT_DESC Instances[] =
+		{
+			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+			{ "WORLD", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 1, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 16, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 32, D3D11_INPUT_PER_INSTANCE_DATA, 1 },
+			{ "WORLD", 3, DXGI_FORMAT_R32G32B32A32_FLOAT, 1, 48, D3D11_INPUT_PER_INSTANCE_DATA, 1 }
+		};
+		Application->getDevice()->CreateInputLayout(Instances, 6, Blob->GetBufferPointer(), Blob->GetBufferSize(),
+			&Result->pInstancedLayout);
+		Instances[0].Format = DXGI_FORMAT_R16G16B16A16_UNORM;
+		Instances[1].Format = DXGI_FORMAT_R16G16_FLOAT;
+		Application->getDevice()->CreateInputLayout(Instances, 6, Blob->GetBufferPointer(), Blob->GetBufferSize(),
+			&Result->pPackedInstancedLayout);
+		SAFE_RELEASE(Blob);
+
+		D3D11_BUFFER_DESC Desc = {};
+		Desc.Usage = D3D11_USAGE_DYNAMIC;
+		Desc.ByteWidth = sizeof(Matrix) * Pipeline::MaxInstances;
+		Desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
+		Desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+		Application->getDevice()->CreateBuffer(&Desc, nullptr, &Result->InstanceBuffer);
+
+		if (!Result->InstancedVS || !Result->pInstancedLayout || !Result->pPackedInstancedLayout || !Result->InstanceBuffer)
+			SAFE_RELEASE(Result->InstancedVS);
+	}
+	else
+		Console::LogInfo("Models: " + Instanced + " Isn't Found, Every Model Is Drawn By Itself");
+
+	Result->pConstantBuffer = Render_Buffer::CreateConstBuff(D3D11_USAGE::D3D11_USAGE_DEFAULT, 0, sizeof(ConstantBuffer));
+
+	return Result;
 }
 
 bool Models::LoadFromAllModels()
 {
-	auto Files = Application->getFS()->GetFileByType(_TypeOfFile::MODELS);
-	for (size_t i = 0; i < Files.size(); i++)
-	{
-		importer = new Assimp::Importer;
+	vector<string> Files;
+	for (auto &It: Application->getFS()->GetFileByType(_TypeOfFile::MODELS))
+		Files.push_back(It.first->PathA);
+
+	// Every Model Is Read Or Imported By Workers, Then Meshes Are Made In The Order Of Files
+	ModelBatch Batch(Files);
+	Batch.Wait();
 
-		pScene = importer->ReadFile(Files.at(i).first->PathA.c_str(),
-		aiProcess_Triangulate | aiProcess_ConvertToLeftHanded 
-		| aiProcess_OptimizeMeshes | aiProcess_SortByPType | aiProcess_FindInvalidData
-		| aiProcess_GenUVCoords | aiProcess_TransformUVCoords | aiProcess_OptimizeGraph);
-		if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode || !pScene->HasMeshes())
+	// Models Which Other Objects Have Are Kept By Parts, So Their Textures Are Freed Only By Them
+	auto All = make_shared<ResidentModel>();
+	for (size_t i = 0; i < Batch.size(); i++)
+	{
+		auto Data = Batch.getPrepared(i);
+		if (Data->Resident.operator bool())
 		{
-			Engine::LogError(string("Model: Scene return nullptr with text: ") + importer->GetErrorString(),
-				string(__FILE__) + ": " + to_string(__LINE__),
-				string("Model: Scene return nullptr with text: ") + importer->GetErrorString());
-			return false;
+			meshes.insert(meshes.end(), Data->Resident->Meshes.begin(), Data->Resident->Meshes.end());
+			All->Parts.push_back(Data->Resident);
 		}
-
-		processNode(pScene->mRootNode, pScene);
-
-		SAFE_DELETE(importer);
+		else if (!addMeshes(*Data))
+			return false;
 	}
 
+	All->Meshes.swap(meshes);
+	All->Textures.swap(Textures_loaded);
+	Resident = All;
+	Shared = getPipeline();
+
 	return true;
 }
 
 void Models::Render(Matrix View, Matrix Proj)
 {
-	if (!Application->getDeviceContext()) return;
+	if (!Application->getDeviceContext() || !Shared.operator bool()) return;
 
 	//ConstantBuffer cb;
 	auto Mrx = scale * position * rotate;
+	auto &Meshes = getMeshes();
+
+	// Copies Of Meshes Are Drawn By FlushInstances (Rows Of Matrices Aren't Transposed: The Shader Builds Them)
+	if (Instancing && Shared->InstancedVS)
+	{
+		for (size_t i = 0; i < Meshes.size(); i++)
+		{
+			auto &It = Meshes.at(i);
+			if (i < Culled.size() && Culled.at(i))
+				continue;
+
+			Matrix World = It->isPacked() ? It->getDecode() * Mrx : Mrx;
+			Queue.Add(It.get(), i < Lods.size() ? Lods.at(i) : 0, &World._11);
+		}
+		return;
+	}
+
 	cb.World = XMMatrixTranspose(Mrx);
 	cb.View = XMMatrixTranspose(View);
 	cb.Proj = XMMatrixTranspose(Proj);
 
-	Application->getDeviceContext()->UpdateSubresource(pConstantBuffer, 0, nullptr, &cb, 0, 0);
-	Application->getDeviceContext()->VSSetConstantBuffers(0, 1, &pConstantBuffer);
-	Application->getDeviceContext()->PSSetSamplers(0, 1, &TexSamplerState);
+	// The Buffer Is Shared, So The Transform Of This Model Is Written Right Before Its Meshes Are Drawn
+	Application->getDeviceContext()->UpdateSubresource(Shared->pConstantBuffer, 0, nullptr, &cb, 0, 0);
+	Application->getDeviceContext()->VSSetConstantBuffers(0, 1, &Shared->pConstantBuffer);
+	Application->getDeviceContext()->PSSetSamplers(0, 1, &Shared->TexSamplerState);
 	Application->getDeviceContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	Application->getDeviceContext()->IASetInputLayout(pLayout);
-	Application->getDeviceContext()->VSSetShader(VS, 0, 0);
-	Application->getDeviceContext()->PSSetShader(PS, 0, 0);
+	Application->getDeviceContext()->VSSetShader(Shared->VS, 0, 0);
+	Application->getDeviceContext()->PSSetShader(Shared->PS, 0, 0);
+
+	// Packed Mesh Has Its Own Decode: It's Multiplied By The World, The Next Mesh Writes The World Again
+	bool Decoded = false;
+	for (size_t i = 0; i < Meshes.size(); i++)
+	{
+		auto &It = Meshes.at(i);
+		if (i < Culled.size() && Culled.at(i))
+			continue;
+		if (It->isPacked() || Decoded)
+		{
+			cb.World = XMMatrixTranspose(It->isPacked() ? It->getDecode() * Mrx : Mrx);
+			Application->getDeviceContext()->UpdateSubresource(Shared->pConstantBuffer, 0, nullptr, &cb, 0, 0);
+			Decoded = It->isPacked();
+		}
+		Application->getDeviceContext()->IASetInputLayout(It->isPacked() ? Shared->pPackedLayout : Shared->pLayout);
+		It->Draw(i < Lods.size() ? Lods.at(i) : 0);
+	}
+}
+
+void Models::SelectLod(Vector3 Eye, Matrix Proj, float ScreenHeight, float PixelError)
+{
+	auto &Meshes = getMeshes();
+	Lods.assign(Meshes.size(), 0);
+
+	// The Same Transform As Render Has
+	auto Mrx = scale * position * rotate;
+	float Scale = getMaxScale(Mrx);
+	// Pixels Of One Unit At Distance 1
+	float PixelsPerUnit = Proj._22 * ScreenHeight * 0.5f;
+
+	for (size_t i = 0; i < Meshes.size(); i++)
+	{
+		auto &Chain = Meshes.at(i)->getLods();
+		if (Chain.size() < 2)
+			continue;
+
+		Vector3 Centre = Vector3::Transform(Meshes.at(i)->getCentre(), Mrx);
+		float Distance = (Centre - Eye).Length() - Meshes.at(i)->getRadius() * Scale;
+		if (Distance <= 0.f)
+			continue;
+
+		for (size_t Level = Chain.size() - 1; Level > 0; Level--)
+			if (Chain.at(Level).Error * Scale * PixelsPerUnit / Distance <= PixelError)
+			{
+				Lods.at(i) = Level;
+				break;
+			}
+	}
+}
+
+void Models::Cull(Frustum &View)
+{
+	auto &Meshes = getMeshes();
+	Culled.assign(Meshes.size(), false);
+
+	auto Mrx = scale * position * rotate;
+	float Scale = getMaxScale(Mrx);
+	for (size_t i = 0; i < Meshes.size(); i++)
+	{
+		Vector3 Centre = Vector3::Transform(Meshes.at(i)->getCentre(), Mrx);
+		Culled.at(i) = !View.CheckSphere(Centre.x, Centre.y, Centre.z, Meshes.at(i)->getRadius() * Scale);
+	}
+}
+
+shared_ptr<Models> Models::MakeStatic(const vector<shared_ptr<Models>> &Objects, const StaticBatcher::Settings &Options)
+{
+	static_assert(sizeof(Things) == sizeof(StaticBatcher::Vertex), "Things Are Merged As Vertices Of The Batcher");
 
-	for (size_t i = 0; i < meshes.size(); i++)
+	// Models Of Clusters Keep The Merged Ones: Their Embedded Textures Are Freed With Them
+	auto All = make_shared<ResidentModel>();
+	vector<StaticBatcher::Instance> Instances;
+	vector<shared_ptr<Mesh>> Sources;
+	for (auto &Object: Objects)
 	{
-		meshes.at(i)->Draw();
+		// Only Made Models (Meshes Of Others Belong To Them)
+		if (!Object.operator bool() || !Object->Resident.operator bool())
+			continue;
+		All->Parts.push_back(Object->Resident);
+
+		auto Mrx = Object->getWorld();
+		for (auto &It: Object->getMeshes())
+		{
+			auto &Chain = It->getLods();
+			if (Chain.empty() || It->getVertexData().empty())
+				continue;
+
+			StaticBatcher::Instance New;
+			New.Vertices = reinterpret_cast<const StaticBatcher::Vertex *>(It->getVertexData().data());
+			New.VertexCount = It->getVertexData().size();
+			New.Indices = It->getIndexData().data() + Chain.front().FirstIndex;
+			New.IndexCount = Chain.front().IndexCount;
+			memcpy(New.World, &Mrx, sizeof(New.World));
+			// The Handle Is The Material: Textures Which Wait For Upload Have The Same View (The Placeholder)
+			auto &Material = It->getTextures();
+			New.Material = Material.empty() ? 0 : Material.front().Resident.operator bool() ?
+				(uint64_t)(uintptr_t)Material.front().Resident.get() : (uint64_t)(uintptr_t)Material.front().TextureSHRes;
+			Instances.push_back(New);
+			Sources.push_back(It);
+		}
 	}
+
+	for (auto &It: StaticBatcher::Build(Instances, Options))
+		All->Meshes.push_back(make_shared<Mesh>(reinterpret_cast<const Things *>(It.Vertices.data()), It.Vertices.size(),
+			It.Indices.data(), It.Indices.size(), Sources.at(It.Instances.front())->getTextures()));
+	if (All->Meshes.empty())
+		return nullptr;
+
+	Console::LogInfo((boost::format("Static Batch: %d Meshes Of %d Models Are Merged Into %d Clusters")
+		% Instances.size() % Objects.size() % All->Meshes.size()).str());
+
+	auto Result = make_shared<Models>();
+	Result->Resident = All;
+	Result->Shared = getPipeline();
+	return Result;
+}
+
+void Models::FlushInstances(Matrix View, Matrix Proj)
+{
+	auto Shared = Current.lock();
+	if (!Application->getDeviceContext() || !Shared.operator bool() || !Shared->InstancedVS)
+	{
+		Queue.Clear();
+		return;
+	}
+
+	// World Of Every Copy Is In The Instance Buffer
+	ConstantBuffer Frame;
+	Frame.View = XMMatrixTranspose(View);
+	Frame.Proj = XMMatrixTranspose(Proj);
+
+	Application->getDeviceContext()->UpdateSubresource(Shared->pConstantBuffer, 0, nullptr, &Frame, 0, 0);
+	Application->getDeviceContext()->VSSetConstantBuffers(0, 1, &Shared->pConstantBuffer);
+	Application->getDeviceContext()->PSSetSamplers(0, 1, &Shared->TexSamplerState);
+	Application->getDeviceContext()->IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	Application->getDeviceContext()->VSSetShader(Shared->InstancedVS, 0, 0);
+	Application->getDeviceContext()->PSSetShader(Shared->PS, 0, 0);
+
+	DeviceInstances Device(*Shared);
+	LastFrame = Queue.Flush(Device);
 }
 
 Models::Models(string Filename)
@@ -148,33 +874,170 @@ Models::Models(string Filename)
 
 void Models::Release()
 {
-	while (!Textures_loaded.empty())
+	for (auto &It: Textures_loaded)
+		ReleaseTexture(It);
+	Textures_loaded.clear();
+	meshes.clear();
+	Lods.clear();
+	Culled.clear();
+
+	// Meshes And Shaders Stay While Other Models Use Them (Meshes Stay In The Cache Until They're Evicted)
+	Resident.reset();
+	Shared.reset();
+	mesh = nullptr;
+}
+
+bool Models::Reload(string Filename)
+{
+	auto New = make_shared<Models>();
+	if (!New->LoadFromFile(Filename) || New->getMeshes().empty())
 	{
-		SAFE_DELETE(Textures_loaded.front().TextureRes);
-		SAFE_DELETE(Textures_loaded.front().TextureSHRes);
-		Textures_loaded.erase(Textures_loaded.begin());
+		Engine::LogError((boost::format("Model File: %s Can't Be Reloaded!") % Filename).str(),
+			string(__FILE__) + ": " + to_string(__LINE__),
+			(boost::format("Model File: %s Can't Be Reloaded!") % Filename).str());
+		return false;
 	}
 
-	if (importer)
+	// The Old Handles Are Dropped With New
+	Resident.swap(New->Resident);
+	Shared.swap(New->Shared);
+
+	return true;
+}
+
+void Models::ReleaseTexture(Texture &It)
+{
+	// The Cache Frees It When Nobody Uses It And It's Evicted
+	if (It.Resident.operator bool())
 	{
-		importer->FreeScene();
-		SAFE_DELETE(importer);
+		It.Resident.reset();
+		It.TextureSHRes = nullptr;
+		It.TextureRes = nullptr;
+		return;
 	}
-	SAFE_DELETE(pScene);
-	SAFE_DELETE(mesh);
+
+	SAFE_RELEASE(It.TextureSHRes);
+	SAFE_RELEASE(It.TextureRes);
 }
 
+size_t Models::getTextureBytes(ID3D11Resource *Resource)
+{
+	ID3D11Texture2D *Texture2D = nullptr;
+	if (!Resource || FAILED(Resource->QueryInterface(__uuidof(ID3D11Texture2D), (void **)&Texture2D)))
+		return 0;
+
+	D3D11_TEXTURE2D_DESC Desc;
+	Texture2D->GetDesc(&Desc);
+	SAFE_RELEASE(Texture2D);
+
+	// Bits Per Pixel (Block-Compressed Formats Are Counted By 4x4 Blocks)
+	size_t Bits = 32;
+	bool Blocks = false;
+	switch (Desc.Format)
+	{
+	case DXGI_FORMAT_BC1_UNORM: case DXGI_FORMAT_BC1_UNORM_SRGB:
+	case DXGI_FORMAT_BC4_UNORM: case DXGI_FORMAT_BC4_SNORM:
+		Bits = 4;
+		Blocks = true;
+		break;
+	case DXGI_FORMAT_BC2_UNORM: case DXGI_FORMAT_BC2_UNORM_SRGB:
+	case DXGI_FORMAT_BC3_UNORM: case DXGI_FORMAT_BC3_UNORM_SRGB:
+	case DXGI_FORMAT_BC5_UNORM: case DXGI_FORMAT_BC5_SNORM:
+	case DXGI_FORMAT_BC6H_UF16: case DXGI_FORMAT_BC6H_SF16:
+	case DXGI_FORMAT_BC7_UNORM: case DXGI_FORMAT_BC7_UNORM_SRGB:
+		Bits = 8;
+		Blocks = true;
+		break;
+	case DXGI_FORMAT_R8_UNORM: case DXGI_FORMAT_A8_UNORM:
+		Bits = 8;
+		break;
+	case DXGI_FORMAT_R8G8_UNORM: case DXGI_FORMAT_R16_FLOAT: case DXGI_FORMAT_R16_UNORM:
+	case DXGI_FORMAT_B5G6R5_UNORM: case DXGI_FORMAT_B5G5R5A1_UNORM:
+		Bits = 16;
+		break;
+	case DXGI_FORMAT_R16G16B16A16_FLOAT: case DXGI_FORMAT_R16G16B16A16_UNORM:
+		Bits = 64;
+		break;
+	case DXGI_FORMAT_R32G32B32A32_FLOAT:
+		Bits = 128;
+		break;
+	default:
+		break;
+	}
+
+	size_t Bytes = 0;
+	for (UINT Mip = 0; Mip < max(Desc.MipLevels, 1u); Mip++)
+	{
+		size_t Width = max(Desc.Width >> Mip, 1u), Height = max(Desc.Height >> Mip, 1u);
+		if (Blocks)
+		{
+			Width = (Width + 3) / 4 * 4;
+			Height = (Height + 3) / 4 * 4;
+		}
+		Bytes += Width * Height * Bits / 8;
+	}
+
+	return Bytes * max(Desc.ArraySize, 1u);
+}
+
+void Models::ForgetTexture(string File)
+{
+	if (!Application->getCache().operator bool())
+		return;
+
+	Application->getCache()->Forget(ResidentCache::Textures, StringID::Path(File));
+	// Kept Models Still Have The Old Texture
+	Application->getCache()->Forget(ResidentCache::Models);
+}
+
+void Models::ForgetModel(string File)
+{
+	if (Application->getCache().operator bool())
+		Application->getCache()->Forget(ResidentCache::Models, StringID::Path(File));
+}
+
+bool Models::UsesTexture(string FileName)
+{
+	// Paths Of Textures Keep The Case Of The Model, So Both Names Are Compared In Lower Case
+	to_lower(FileName);
+	for (auto &It: getTextures())
+	{
+		if (It.path.empty())
+			continue;
+
+		string Name = path(It.path).filename().string();
+		to_lower(Name);
+		if (Name == FileName)
+			return true;
+	}
+
+	return false;
+}
 
 vector<Texture> Models::loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName,
 	const aiScene *Scene)
 {
-	vector<Texture> textures;
-	string PathTexture;
-
+	vector<string> Names;
 	for (UINT i = 0; i < mat->GetTextureCount(type); i++)
 	{
 		aiString str;
 		mat->GetTexture(type, i, &str);
+		Names.push_back(str.C_Str());
+	}
+
+	return loadTextures(Names, typeName, Scene);
+}
+
+vector<Texture> Models::loadTextures(const vector<string> &Names, string typeName, const aiScene *Scene,
+	const Prepared *Data)
+{
+	vector<Texture> textures;
+	string PathTexture;
+	unordered_map<string, shared_ptr<PreparedTexture>> Known;
+
+	for (auto &Name: Names)
+	{
+		aiString str(Name);
 		bool skip = false;
 		for (size_t j = 0; j < Textures_loaded.size(); j++)
 		{
@@ -188,29 +1051,23 @@ vector<Texture> Models::loadMaterialTextures(aiMaterial *mat, aiTextureType type
 		if (!skip)
 		{
 			Texture texture;
-			if (Textype == "embedded compressed texture")
+			if (Scene && Textype == "embedded compressed texture")
 				texture.TextureSHRes = getTextureFromModel(Scene, getTextureIndex(&str));
 			else
 			{
-				string TName = path(str.C_Str()).filename().string();
-				to_lower(TName);
-				auto textr = Application->getFS()->GetFile(TName);
-				if (textr.operator bool())
+				// Decoded By Workers, Or Here If It Isn't Prepared (e.g. Textures On Disk Of Embedded Scene)
+				shared_ptr<PreparedTexture> Ready;
+				auto Found = Data ? Data->Textures.find(Name) : Known.end();
+				if (Data && Found != Data->Textures.end())
+					Ready = Found->second;
+				else if ((Ready = findTexture(Name, Known)).operator bool())
+					DecodeTexture(*Ready);
+
+				// The Device Texture Is Made Later (UploadTextures), The Mesh Draws The View Of The Handle
+				if (Ready.operator bool())
 				{
-					PathTexture = textr->PathA;
-					to_lower(PathTexture);
-					if (FindSubStr(textr->ExtA, ".dds"))
-					{
-						if (FAILED(CreateDDSTextureFromFile(Application->getDevice(), textr->PathW.c_str(),
-							&texture.TextureRes, &texture.TextureSHRes)))
-							Console::LogInfo(string("Something is wrong with this texture: ") + textr->FileA);
-					}
-					else
-					{
-						if (FAILED(CreateWICTextureFromFile(Application->getDevice(), textr->PathW.c_str(),
-							&texture.TextureRes, &texture.TextureSHRes)))
-							Console::LogInfo(string("Something is wrong with Create the texture: ") + textr->FileA);
-					}
+					PathTexture = Ready->Path;
+					texture.Resident = createTexture(Ready);
 				}
 			}
 			texture.type = typeName;
@@ -243,6 +1100,8 @@ void Models::processNode(aiNode *node, const aiScene *Scene)
 				Textype = determineTextureType(Scene, name, mat);
 		}
 
+		vertices.reserve(mesh->mNumVertices);
+		indices.reserve(mesh->mNumFaces * 3);
 		for (UINT i = 0; i < mesh->mNumVertices; i++)
 		{
 			Things vertex;
@@ -263,6 +1122,8 @@ void Models::processNode(aiNode *node, const aiScene *Scene)
 			for (UINT j = 0; j < face.mNumIndices; j++)
 				indices.push_back(face.mIndices[j]);
 		}
+		// The Same Order, Parts And Levels Of Detail As Cooked Meshes Have
+		MeshOptimizer::Optimize(vertices, indices);
 		if (mesh->mMaterialIndex >= 0)
 		{
 			aiMaterial *material = Scene->mMaterials[mesh->mMaterialIndex];
@@ -291,7 +1152,13 @@ void Models::processNode(aiNode *node, const aiScene *Scene)
 			*/
 		}
 
-		meshes.push_back(make_shared<Mesh>(vertices, indices, textures));
+		for (auto &Chunk: MeshQuantizer::Split(move(vertices), move(indices)))
+		{
+			vector<Mesh::Lod> MeshLods;
+			for (auto &It: MeshSimplifier::BuildLods(Chunk.Vertices, Chunk.Indices))
+				MeshLods.push_back({ (UINT)It.FirstIndex, (UINT)It.IndexCount, It.Error });
+			meshes.push_back(make_shared<Mesh>(move(Chunk.Vertices), move(Chunk.Indices), textures, move(MeshLods)));
+		}
 	}
 
 	for (UINT i = 0; i < node->mNumChildren; i++)
@@ -365,51 +1232,97 @@ void Models::setPosition(Vector3 Pos)
 	position = Matrix::CreateTranslation(Pos);
 }
 
-void Models::Mesh::Init(vector<Things> Vertices, vector<UINT> Indices, vector<Texture> Textures)
+void Models::Mesh::Init(vector<Things> Vertices, vector<UINT> Indices, vector<Texture> Textures, vector<Lod> Lods)
 {
-	this->vertices = Vertices;
-	this->indices = Indices;
+	this->vertices = move(Vertices);
+	this->indices = move(Indices);
 	this->textures = Textures;
+	this->lods = move(Lods);
+	if (lods.empty())
+		lods.push_back({ 0, (UINT)indices.size(), 0.f });
+	if (vertices.empty() || indices.empty())
+		return;
+
+	Vector3 Min = vertices.front().Pos, Max = Min;
+	for (auto &It: vertices)
+	{
+		Min = Vector3::Min(Min, It.Pos);
+		Max = Vector3::Max(Max, It.Pos);
+	}
+	Centre = (Min + Max) * 0.5f;
+	for (auto &It: vertices)
+		Radius = max(Radius, (It.Pos - Centre).Length());
+
+	// Compact Formats For The Device, Vertices And Indices In Memory Stay Floats (Physics Uses Them)
+	const float *Positions = &vertices[0].Pos.x, *UVs = &vertices[0].Tex.x;
+	vector<MeshQuantizer::PackedVertex> PackedVertices;
+	Packed = CompactMeshes && MeshQuantizer::FitsHalf(UVs, sizeof(Things), vertices.size());
+	if (Packed)
+	{
+		auto Bounds = MeshQuantizer::getDecode(Positions, sizeof(Things), vertices.size());
+		MeshQuantizer::Pack(Positions, UVs, sizeof(Things), vertices.size(), Bounds, PackedVertices);
+		Decode = Matrix::CreateScale(Bounds.Scale[0], Bounds.Scale[1], Bounds.Scale[2]) *
+			Matrix::CreateTranslation(Bounds.Offset[0], Bounds.Offset[1], Bounds.Offset[2]);
+	}
+	vector<uint16_t> ShortIndices;
+	if (CompactMeshes && vertices.size() <= MeshQuantizer::MaxVertices16)
+	{
+		ShortIndices = MeshQuantizer::Narrow(indices.data(), indices.size());
+		IndexFormat = DXGI_FORMAT_R16_UINT;
+	}
 
 	D3D11_BUFFER_DESC vbd;
 	vbd.Usage = D3D11_USAGE_IMMUTABLE;
-	vbd.ByteWidth = sizeof(Things) * vertices.size();
+	vbd.ByteWidth = UINT(Packed ? sizeof(MeshQuantizer::PackedVertex) * vertices.size() : sizeof(Things) * vertices.size());
 	vbd.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 	vbd.CPUAccessFlags = 0;
 	vbd.MiscFlags = 0;
 
 	D3D11_SUBRESOURCE_DATA initData;
-	initData.pSysMem = &vertices[0];
+	initData.pSysMem = Packed ? (const void *)PackedVertices.data() : (const void *)&vertices[0];
 
 	Application->getDevice()->CreateBuffer(&vbd, &initData, &VertexBuffer);
 
 	D3D11_BUFFER_DESC ibd;
 	ibd.Usage = D3D11_USAGE_IMMUTABLE;
-	ibd.ByteWidth = sizeof(UINT) * indices.size();
+	ibd.ByteWidth = UINT(ShortIndices.empty() ? sizeof(UINT) * indices.size() : sizeof(uint16_t) * indices.size());
 	ibd.BindFlags = D3D11_BIND_INDEX_BUFFER;
 	ibd.CPUAccessFlags = 0;
 	ibd.MiscFlags = 0;
 
-	initData.pSysMem = &indices[0];
+	initData.pSysMem = ShortIndices.empty() ? (const void *)&indices[0] : (const void *)ShortIndices.data();
 
 	Application->getDevice()->CreateBuffer(&ibd, &initData, &IndexBuffer);
+	DeviceBytes = vbd.ByteWidth + ibd.ByteWidth;
 }
 
-void Models::Mesh::Draw()
+void Models::Mesh::Draw(size_t Level, ID3D11Buffer *Instances, UINT FirstInstance, UINT InstanceCount)
 {
-	UINT stride = sizeof(Things);
+	if (lods.empty())
+		return;
+	auto &It = lods.at(min(Level, lods.size() - 1));
+
+	UINT stride = Packed ? sizeof(MeshQuantizer::PackedVertex) : sizeof(Things);
 	UINT offset = 0;
 
 	Application->getDeviceContext()->IASetVertexBuffers(0, 1, &VertexBuffer, &stride, &offset);
-	Application->getDeviceContext()->IASetIndexBuffer(IndexBuffer, DXGI_FORMAT_R32_UINT, 0);
+	Application->getDeviceContext()->IASetIndexBuffer(IndexBuffer, IndexFormat, 0);
 
-	if (!textures.empty() && textures[0].TextureSHRes)
-		Application->getDeviceContext()->PSSetShaderResources(0, 1, &textures[0].TextureSHRes);
+	ID3D11ShaderResourceView *View = textures.empty() ? nullptr : textures[0].getView();
+	if (View)
+		Application->getDeviceContext()->PSSetShaderResources(0, 1, &View);
 
 	if (Application->IsWireFrame())
 		Application->getDeviceContext()->RSSetState(Application->GetWireFrame());
 	else
 		Application->getDeviceContext()->RSSetState(Application->GetNormalFrame());
 
-	Application->getDeviceContext()->DrawIndexed(indices.size(), 0, 0);
+	if (Instances)
+	{
+		UINT InstanceStride = sizeof(Matrix);
+		Application->getDeviceContext()->IASetVertexBuffers(1, 1, &Instances, &InstanceStride, &offset);
+		Application->getDeviceContext()->DrawIndexedInstanced(It.IndexCount, InstanceCount, It.FirstIndex, 0, FirstInstance);
+	}
+	else
+		Application->getDeviceContext()->DrawIndexed(It.IndexCount, It.FirstIndex, 0);
 }
@@ -8,6 +8,11 @@
 #include "assimp\postprocess.h"
 
 #include "Render_Buffer.h"
+#include "MeshQuantizer.h"
+#include "StaticBatcher.h"
+#include "InstanceQueue.h"
+#include "UploadQueue.h"
+#include <unordered_map>
 
 #include <Inc/WICTextureLoader.h>
 #include <Inc/DDSTextureLoader.h>
@@ -17,12 +22,35 @@
 
 using namespace Assimp;
 
+// Texture Which Is Kept By ResidentCache (Freed When It's Unused And Evicted)
+struct ResidentTexture
+{
+	ID3D11ShaderResourceView *TextureSHRes = nullptr;
+	ID3D11Resource *TextureRes = nullptr;
+	// Shown Until The Texture Is Uploaded (Models::UploadTextures), Then It's Dropped
+	shared_ptr<ResidentTexture> Placeholder;
+
+	ID3D11ShaderResourceView *getView() { return TextureSHRes ? TextureSHRes :
+		Placeholder.operator bool() ? Placeholder->TextureSHRes : nullptr; }
+
+	~ResidentTexture()
+	{
+		SAFE_RELEASE(TextureSHRes);
+		SAFE_RELEASE(TextureRes);
+	}
+};
 struct Texture
 {
 	string type, path;
 	ID3D11ShaderResourceView *TextureSHRes = nullptr;
 	ID3D11Resource *TextureRes = nullptr;
+	// Handle Of The Cache (Empty For Embedded Textures Which The Model Owns): Its View Is Drawn, It
+	// Can Be The Placeholder Until The Texture Is Uploaded
+	shared_ptr<ResidentTexture> Resident;
+
+	ID3D11ShaderResourceView *getView() const { return Resident.operator bool() ? Resident->getView() : TextureSHRes; }
 };
+class Frustum;
 #pragma pack(push, 1)
 struct Things
 {
@@ -37,58 +65,310 @@ private:
 	class Mesh
 	{
 	public:
-		Mesh(vector<Things> vertices, vector<UINT> indices, vector<Texture> textures)
+		// Level Of Detail: Range Of The Index Buffer (Every Level Uses The Same Vertices)
+		struct Lod
 		{
-			Init(vertices, indices, textures);
+			UINT FirstIndex = 0, IndexCount = 0;
+			// Distance Which Is Lost (In Units Of The Model)
+			float Error = 0.f;
+		};
+
+		// Indices Of Every Level Follow Each Other (One Level Of Every Index If Lods Is Empty)
+		Mesh(vector<Things> vertices, vector<UINT> indices, vector<Texture> textures, vector<Lod> Lods = {})
+		{
+			Init(move(vertices), move(indices), textures, move(Lods));
+		}
+		// Data Is Copied Once (e.g. From Mapped Cooked Mesh)
+		Mesh(const Things *Vertices, size_t VertexCount, const UINT *Indices, size_t IndexCount, vector<Texture> textures,
+			vector<Lod> Lods = {})
+		{
+			Init(vector<Things>(Vertices, Vertices + VertexCount), vector<UINT>(Indices, Indices + IndexCount), textures,
+				move(Lods));
 		}
 		Mesh() {}
-		~Mesh() {}
+		~Mesh()
+		{
+			SAFE_RELEASE(VertexBuffer);
+			SAFE_RELEASE(IndexBuffer);
+		}
 
-		void Init(vector<Things> vertices, vector<UINT> indices, vector<Texture> textures);
-		void Draw();
+		void Init(vector<Things> vertices, vector<UINT> indices, vector<Texture> textures, vector<Lod> Lods = {});
+		// Instances Of The Buffer (Their World Matrices) Are Drawn By One Call If It's Given
+		void Draw(size_t Level = 0, ID3D11Buffer *Instances = nullptr, UINT FirstInstance = 0, UINT InstanceCount = 0);
 
 		vector<Things> getVertices() { return vertices; }
-		vector<UINT> getIndices() { return indices; }
+		// The Full Mesh
+		vector<UINT> getIndices()
+		{
+			return lods.empty() ? indices : vector<UINT>(indices.begin() + lods[0].FirstIndex,
+				indices.begin() + lods[0].FirstIndex + lods[0].IndexCount);
+		}
+		const vector<Lod> &getLods() { return lods; }
+		// Without Copying (Static Batches Are Made From Them)
+		const vector<Things> &getVertexData() { return vertices; }
+		const vector<UINT> &getIndexData() { return indices; }
+		const vector<Texture> &getTextures() { return textures; }
+		// Sphere Around Vertices (In Units Of The Model)
+		Vector3 getCentre() { return Centre; }
+		float getRadius() { return Radius; }
+		// Vertices And Indices Are Kept Twice: In Memory And In Device Buffers (Which Can Be Compact)
+		size_t getBytes() { return vertices.size() * sizeof(Things) + indices.size() * sizeof(UINT) + DeviceBytes; }
+		// Vertex Buffer Has MeshQuantizer::PackedVertex, Decode Turns Them Into Units Of The Model
+		bool isPacked() { return Packed; }
+		Matrix getDecode() { return Decode; }
 	private:
 		vector<Things> vertices;
 		vector<UINT> indices;
 		vector<Texture> textures;
+		vector<Lod> lods;
+		Vector3 Centre = Vector3::Zero;
+		float Radius = 0.f;
 
 		ID3D11Buffer *VertexBuffer = nullptr, *IndexBuffer = nullptr;
+		DXGI_FORMAT IndexFormat = DXGI_FORMAT_R32_UINT;
+		bool Packed = false;
+		Matrix Decode = Matrix::Identity;
+		size_t DeviceBytes = 0;
 	};
+	// Meshes While The Model Is Made (Then They're Moved Into Resident)
 	vector<shared_ptr<Mesh>> meshes;
 
+	// Meshes And Textures Of The Model File: Made Once And Shared By Every Model Of The File
+	// (Kept By ResidentCache). Embedded Textures Belong To It, So They're Freed With It.
+	struct ResidentModel
+	{
+		vector<shared_ptr<Mesh>> Meshes;
+		vector<Texture> Textures;
+		// Other Files Whose Meshes It Has (LoadFromAllModels)
+		vector<shared_ptr<ResidentModel>> Parts;
+
+		~ResidentModel()
+		{
+			for (auto &It: Textures)
+				ReleaseTexture(It);
+		}
+	};
+	shared_ptr<ResidentModel> Resident;
+
+	// Shaders, Input Layout, Sampler And Constant Buffer Of Every Model (Each Model Writes Its
+	// Transform Into The Buffer Before It's Drawn). Made Once, Freed With The Last Model.
+	struct Pipeline
+	{
+		ID3D11Buffer *pConstantBuffer = nullptr;
+
+		ID3D11InputLayout *pLayout = nullptr;
+		// Layout Of MeshQuantizer::PackedVertex
+		ID3D11InputLayout *pPackedLayout = nullptr;
+		ID3D11SamplerState *TexSamplerState = nullptr;
+
+		ID3D11VertexShader *VS = nullptr;
+		ID3D11PixelShader *PS = nullptr;
+
+		// Vertex_model_Instanced_VS Of VertexShader.hlsl (Instancing Is Off Without It): The World Is
+		// Taken From Rows WORLD0..WORLD3 Of The Instance Buffer (Slot 1), View And Proj Are In The Constant Buffer
+		ID3D11VertexShader *InstancedVS = nullptr;
+		ID3D11InputLayout *pInstancedLayout = nullptr, *pPackedInstancedLayout = nullptr;
+		ID3D11Buffer *InstanceBuffer = nullptr;
+		static const UINT MaxInstances = 1024;
+
+		~Pipeline()
+		{
+			SAFE_RELEASE(pConstantBuffer);
+			SAFE_RELEASE(pLayout);
+			SAFE_RELEASE(pPackedLayout);
+			SAFE_RELEASE(TexSamplerState);
+			SAFE_RELEASE(VS);
+			SAFE_RELEASE(PS);
+			SAFE_RELEASE(InstancedVS);
+			SAFE_RELEASE(pInstancedLayout);
+			SAFE_RELEASE(pPackedInstancedLayout);
+			SAFE_RELEASE(InstanceBuffer);
+		}
+	};
+	shared_ptr<Pipeline> Shared;
+	static weak_ptr<Pipeline> Current;
+	static shared_ptr<Pipeline> getPipeline();
+
+	// Copies Of Meshes Which Models Of The Frame Render, Drawn By FlushInstances
+	static InstanceQueue Queue;
+	static InstanceQueue::Stats LastFrame;
+	// Backend Of The Queue: The Instance Buffer And Meshes Of The Pipeline
+	class DeviceInstances;
+
+	// Decoded Textures Which Wait For The Device (PreparedTexture), Uploaded By UploadTextures
+	static UploadQueue Uploads;
+	static UploadQueue::Stats LastUploads;
+	// Backend Of Uploads: Makes Device Textures Of Prepared Ones
+	class DeviceTextures;
+	// 1x1 Grey Texture Which Models Show While Their Textures Wait (Freed With The Last User)
+	static weak_ptr<ResidentTexture> Blank;
+	static shared_ptr<ResidentTexture> getPlaceholder();
+
 public:
+	// Texture Of Prepared Models: Found By The Frame Thread (File System), Decoded By Any Thread
+	struct PreparedTexture
+	{
+		// Stored File (Lower Case, It's The Key Of The Cache), Path To Read It, Its Name And Extension
+		string Path, File, Name, Ext;
+		// Kept By ResidentCache Already: Nothing Is Decoded
+		shared_ptr<ResidentTexture> Resident;
+		// RGBA Pixels Decoded By WIC, Or Whole File Which The Device Loader Reads (DDS Or Failed Decoding)
+		vector<uint8_t> Pixels;
+		UINT Width = 0, Height = 0;
+		shared_ptr<void> Encoded;
+		// The Device Couldn't Make It (It's Logged Once)
+		bool Failed = false;
+		double DecodeMs = 0.;
+	};
+	// Mesh Of Prepared Model: It Points Into Mapped Cooked Mesh Or Imported Data
+	struct PreparedPart
+	{
+		const Things *Vertices = nullptr;
+		size_t VertexCount = 0;
+		// Indices Of Every Level Of Detail
+		const UINT *Indices = nullptr;
+		size_t IndexCount = 0;
+		vector<Mesh::Lod> Lods;
+		vector<string> Textures;
+	};
+	// CPU Part Of Loading The Model: Everything Except Device Objects
+	struct Prepared
+	{
+		string File;
+		uint64_t Source = 0;
+		// Where Meshes Are From: "resident", "cooked", "cache", "import" Or "embedded" (The Scene Is Kept,
+		// Its Textures Are Made By The Frame Thread)
+		string From;
+		bool Failed = false;
+		// Workers Don't Write Into The Console: It's Done By LoadPrepared
+		string Error;
+		vector<string> Log;
+
+		shared_ptr<ResidentModel> Resident;
+		vector<PreparedPart> Parts;
+		// Keeps Data Of Parts (Mapped File Or Cooked Mesh) Or The Importer Of Embedded Scene
+		shared_ptr<void> Storage;
+		shared_ptr<Assimp::Importer> Scene;
+		// Textures By Name In The Model
+		unordered_map<string, shared_ptr<PreparedTexture>> Textures;
+
+		double MeshMs = 0., DeviceMs = 0.;
+	};
+
+	// Frame Thread: The Model Which ResidentCache Has Isn't Prepared Again
+	static shared_ptr<Prepared> BeginPrepare(string Filename);
+	// Any Thread: Read Cooked Mesh Or Import The Model
+	static void PrepareMeshes(Prepared &Data);
+	// Frame Thread: Find Files Of Textures (Known Has Textures Of Other Models, So Every File Is Decoded Once)
+	static void PrepareTextures(Prepared &Data, unordered_map<string, shared_ptr<PreparedTexture>> &Known);
+	// Any Thread: Decode The Texture
+	static void DecodeTexture(PreparedTexture &It);
+	// Frame Thread: Make Meshes, Textures And Shaders
+	bool LoadPrepared(Prepared &Data);
+
 	bool LoadFromFile(string Filename);
+	// Read Cooked Mesh Instead Of Importing The Model (False If There's No Such File Or It's Made From Other Source)
+	static bool LoadCooked(string File, uint64_t Source, Prepared &Data);
 	bool LoadFromAllModels();
 
 	void Render(Matrix View, Matrix Proj);
 
+	/**
+	 * \fn	void Models::SelectLod(Vector3 Eye, Matrix Proj, float ScreenHeight, float PixelError = 1.f);
+	 *
+	 * \brief	Choose for every mesh the coarsest level of detail whose error is at most PixelError
+	 * 			pixels on the screen (Distance Is Taken To The Sphere Around The Mesh). Render draws it.
+	 *
+	 * \param 	Eye		   	Position of the camera.
+	 * \param 	Proj	   	Projection of the camera.
+	 * \param 	ScreenHeight	Height of the screen in pixels.
+	 * \param 	PixelError  	(Optional) How far on the screen the mesh can move.
+	 */
+
+	void SelectLod(Vector3 Eye, Matrix Proj, float ScreenHeight, float PixelError = 1.f);
+
+	// Meshes Which Are Made Next Get 16-Bit Indices (At Most 65535 Vertices) And Packed Vertices (UVs Which
+	// Half Floats Keep), Others Keep 32-Bit Formats
+	static bool CompactMeshes;
+
+	/**
+	 * \fn	static shared_ptr<Models> Models::MakeStatic(const vector<shared_ptr<Models>> &Objects,
+	 * 		const StaticBatcher::Settings &Options = StaticBatcher::Settings());
+	 *
+	 * \brief	Merge the full meshes of models which don't move by their textures (StaticBatcher) with
+	 * 			their current transforms. Meshes of the result are clusters in the world: it's drawn
+	 * 			without transform and Cull hides clusters. Models keep their own meshes.
+	 *
+	 * \param 	Objects	Models which are placed.
+	 * \param 	Options	(Optional) Size of clusters.
+	 *
+	 * \returns	Model of clusters (nullptr if nothing is merged).
+	 */
+
+	static shared_ptr<Models> MakeStatic(const vector<shared_ptr<Models>> &Objects,
+		const StaticBatcher::Settings &Options = StaticBatcher::Settings());
+	// Meshes Whose Spheres Are Outside Of The Frustum Aren't Drawn (Until The Next Cull)
+	void Cull(Frustum &View);
+
+	// Render Only Adds Copies Of Meshes, FlushInstances Draws Each Mesh And Level Once For Every Copy
+	// (If The Pipeline Has The Instanced Shader)
+	static bool Instancing;
+
+	/**
+	 * \fn	static void Models::FlushInstances(Matrix View, Matrix Proj);
+	 *
+	 * \brief	Draw copies which models rendered since the last flush (It's Done Once Per Frame,
+	 * 			Meshes Must Live Until Then)
+	 *
+	 * \param 	View	View of the camera.
+	 * \param 	Proj	Projection of the camera.
+	 */
+
+	static void FlushInstances(Matrix View, Matrix Proj);
+	// Copies, Groups And Draw Calls Of The Last Flush
+	static InstanceQueue::Stats getInstanceStats() { return LastFrame; }
+
+	/**
+	 * \fn	static void Models::UploadTextures();
+	 *
+	 * \brief	Make device textures of decoded ones which models are waiting for, until UploadBudget
+	 * 			bytes are uploaded (Frame Thread, Once Per Frame). Models show the placeholder until then.
+	 */
+
+	static void UploadTextures();
+	// Bytes Of Textures Which Each Frame Uploads (0: Every Waiting Texture At Once)
+	static size_t UploadBudget;
+	// Uploads Of The Last Frame And Textures Which Still Wait
+	static UploadQueue::Stats getUploadStats() { return LastUploads; }
+	// Waiting Textures Aren't Uploaded (They Keep The Placeholder), e.g. Before The Device Is Released
+	static void ForgetUploads();
+
 	Models() {}
 	Models(string Filename);
 
 	void Release();
 
+	// Load The File Again And Keep Transform Of The Model (Used By Hot Reload)
+	bool Reload(string Filename);
+	bool UsesTexture(string FileName);
+	// Next Model Creates The Texture Again (The File Is Changed)
+	static void ForgetTexture(string File);
+	// Next Model Of This File Is Loaded Again
+	static void ForgetModel(string File);
+
 	void setRotation(Vector3 rotaxis);
 	void setScale(Vector3 Scale);
 	void setPosition(Vector3 Pos);
 
-	Matrix getWorld() { return World; }
+	// The Transform Which Render Uses
+	Matrix getWorld() { return scale * position * rotate; }
 
-	vector<shared_ptr<Mesh>> getMeshes() { return meshes; }
+	const vector<shared_ptr<Mesh>> &getMeshes() { return Resident.operator bool() ? Resident->Meshes : meshes; }
 
 	~Models() {}
 protected:
 	Matrix World = Matrix(), position = Matrix(),
 		scale = Matrix(), rotate = Matrix();
-	ID3D11Buffer *pConstantBuffer = nullptr;
-
-	ID3D11InputLayout *pLayout = nullptr;
-	ID3D11SamplerState *TexSamplerState = nullptr;
-
-	ID3D11VertexShader *VS = nullptr;
-	ID3D11PixelShader *PS = nullptr;
-
 #pragma pack(push, 1)
 	struct ConstantBuffer
 	{
@@ -98,17 +378,41 @@ protected:
 
 	HRESULT hr = S_OK;
 
-	Assimp::Importer *importer = nullptr;
-	const aiScene *pScene = nullptr;
+	// Level Of Detail Of Every Mesh Which Is Drawn (SelectLod)
+	vector<size_t> Lods;
+	// Meshes Which Aren't Drawn (Cull)
+	vector<bool> Culled;
 
+	// Textures While The Model Is Made
 	vector<Texture> Textures_loaded;
 	string Textype = "";
 
+	// Textures Are Shared Between Models By ResidentCache: Aliases Of The Same File Get One Texture
+	static void ReleaseTexture(Texture &It);
+	// Memory Of The Texture With Its Mip Levels
+	static size_t getTextureBytes(ID3D11Resource *Resource);
+
 	aiMesh *mesh = nullptr;
 
+	// Meshes Of Prepared Model Are Added To This One
+	bool addMeshes(Prepared &Data);
+	const vector<Texture> &getTextures() { return Resident.operator bool() ? Resident->Textures : Textures_loaded; }
+
+	// Import With Assimp And Save Cooked Mesh Into The Cache (Source Is Its Hash)
+	static bool Import(string Filename, uint64_t Source, Prepared &Data);
+	// Meshes Of Embedded Scene (Its Textures Are Made From The Scene)
 	void processNode(aiNode *node, const aiScene *Scene);
 
 	vector<Texture> loadMaterialTextures(aiMaterial *mat, aiTextureType type, string typeName, const aiScene *Scene);
+	// Scene Is Needed Only For Embedded Textures, Others Are Prepared
+	vector<Texture> loadTextures(const vector<string> &Names, string typeName, const aiScene *Scene,
+		const Prepared *Data = nullptr);
+	// Frame Thread: The Texture Of This Name (Known Has The Textures Which Were Found Before)
+	static shared_ptr<PreparedTexture> findTexture(const string &Name,
+		unordered_map<string, shared_ptr<PreparedTexture>> &Known);
+	// Handle Of The Texture In The Cache (Other Model Could Make It First): The New One Shows The Placeholder
+	// And Its Decoded Data Waits In Uploads
+	static shared_ptr<ResidentTexture> createTexture(const shared_ptr<PreparedTexture> &It);
 	string determineTextureType(const aiScene *Scene, string TypeName, aiMaterial *mat);
 	int getTextureIndex(aiString *str);
 
@@ -0,0 +1,259 @@
+#include "Pak.h"
+
+#include <algorithm>
+#include <fstream>
+#include <zlib.h>
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+static string ToLower(string Str)
+{
+	transform(Str.begin(), Str.end(), Str.begin(), [](char C) { return (char)tolower((unsigned char)C); });
+	return Str;
+}
+
+bool Pak::Open(fs::path File)
+{
+	Close();
+
+	boost::system::error_code EC;
+	if (!fs::exists(File, EC))
+		return false;
+
+	try
+	{
+		Map.open(File.string());
+	}
+	catch (const std::exception &)
+	{
+		return false;
+	}
+
+	if (!Map.is_open() || Map.size() < sizeof(Header))
+	{
+		Close();
+		return false;
+	}
+
+	auto Tmp = reinterpret_cast<const Header *>(Map.data());
+	if (memcmp(Tmp->Magic, "DPAK", 4) != 0 || Tmp->Version != Version ||
+		Tmp->TocOffset + Tmp->TocSize != Map.size() ||
+		(uint64_t)Tmp->Count * sizeof(Entry) > Tmp->TocSize)
+	{
+		Close();
+		return false;
+	}
+	Head = Tmp;
+
+	auto First = reinterpret_cast<const Entry *>(Map.data() + Head->TocOffset);
+	Names = reinterpret_cast<const char *>(First + Head->Count);
+	uint64_t NamesSize = Head->TocSize - (uint64_t)Head->Count * sizeof(Entry);
+
+	Entries.reserve(Head->Count);
+	for (uint32_t i = 0; i < Head->Count; i++)
+	{
+		auto It = &First[i];
+		if ((uint64_t)It->Name + It->NameLen > NamesSize || It->Offset + It->PackedSize > Head->TocOffset)
+		{
+			Close();
+			return false;
+		}
+
+		Entries.push_back(It);
+		ByName.emplace(GetName(It), It);
+	}
+
+	return true;
+}
+
+void Pak::Close()
+{
+	Entries.clear();
+	ByName.clear();
+	Head = nullptr;
+	Names = nullptr;
+
+	if (Map.is_open())
+		Map.close();
+}
+
+const Pak::Entry *Pak::Find(string Path) const
+{
+	if (!Head) return nullptr;
+
+	auto It = ByName.find(ToLower(Path));
+	return It != ByName.end() ? It->second : nullptr;
+}
+
+string Pak::GetName(const Entry *It) const
+{
+	return string(Names + It->Name, It->NameLen);
+}
+
+const uint8_t *Pak::GetData(const Entry *It) const
+{
+	if (!Head || !It || It->Compressed) return nullptr;
+	return reinterpret_cast<const uint8_t *>(Map.data() + It->Offset);
+}
+
+bool Pak::Read(const Entry *It, vector<uint8_t> &Data) const
+{
+	if (!Head || !It) return false;
+
+	auto Src = reinterpret_cast<const uint8_t *>(Map.data() + It->Offset);
+	size_t Start = Data.size();
+	Data.resize(Start + (size_t)It->Size);
+
+	if (!It->Compressed)
+	{
+		if (It->Size)
+			memcpy(Data.data() + Start, Src, (size_t)It->Size);
+	}
+	else
+	{
+		uLongf Size = (uLongf)It->Size;
+		if (uncompress(Data.data() + Start, &Size, Src, (uLong)It->PackedSize) != Z_OK || Size != It->Size)
+		{
+			Data.resize(Start);
+			return false;
+		}
+	}
+
+	// Build Wrote CRC Of The Original File, So Damaged Archive Isn't Served
+	if ((uint32_t)crc32(0L, Data.data() + Start, (uInt)It->Size) != It->Crc)
+	{
+		Data.resize(Start);
+		return false;
+	}
+
+	return true;
+}
+
+bool Pak::Build(fs::path Folder, fs::path Out, bool Compress, uint32_t Alignment, BuildInfo &Info,
+	function<void(string)> Log)
+{
+	if (!Log)
+		Log = [](string) {};
+	if (Alignment == 0 || (Alignment & (Alignment - 1)) != 0)
+	{
+		Log("Alignment Must Be Power Of Two");
+		return false;
+	}
+
+	boost::system::error_code EC;
+	if (!fs::is_directory(Folder, EC))
+	{
+		Log("Folder " + Folder.string() + " Doesn't Exist");
+		return false;
+	}
+
+	string Root = Folder.generic_string();
+	if (Root.back() != '/')
+		Root += "/";
+
+	vector<pair<string, fs::path>> Files;
+	for (fs::recursive_directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+		if (fs::is_regular_file(It->status()))
+			Files.push_back(make_pair(ToLower(It->path().generic_string().substr(Root.size())), It->path()));
+
+	// Files Of One Folder Go Together
+	sort(Files.begin(), Files.end(), [](const pair<string, fs::path> &A, const pair<string, fs::path> &B)
+	{
+		return A.first < B.first;
+	});
+
+	std::ofstream Stream(Out.string(), ios::binary | ios::trunc);
+	if (!Stream.is_open())
+	{
+		Log("Cannot Create " + Out.string());
+		return false;
+	}
+
+	Header Head = {};
+	memcpy(Head.Magic, "DPAK", 4);
+	Head.Version = Version;
+	Head.Alignment = Alignment;
+	Stream.write(reinterpret_cast<const char *>(&Head), sizeof(Head));
+
+	// Formats Which Are Already Compressed
+	const vector<string> Packed = { ".png", ".jpg", ".jpeg", ".ogg", ".mp3", ".zip", ".pak" };
+
+	vector<Entry> Toc;
+	string NamesBlob;
+	vector<uint8_t> Data, Compressed;
+	uint64_t Offset = sizeof(Head);
+	for (auto &It: Files)
+	{
+		Data.clear();
+		std::ifstream In(It.second.string(), ios::binary);
+		if (!In.is_open())
+		{
+			Log("Cannot Open " + It.second.string());
+			return false;
+		}
+		In.seekg(0, ios::end);
+		Data.resize((size_t)In.tellg());
+		In.seekg(0, ios::beg);
+		if (!Data.empty())
+			In.read(reinterpret_cast<char *>(Data.data()), Data.size());
+
+		Entry Rec = {};
+		Rec.Name = (uint32_t)NamesBlob.size();
+		Rec.NameLen = (uint32_t)It.first.size();
+		NamesBlob += It.first;
+		Rec.Size = Data.size();
+		Rec.Crc = (uint32_t)crc32(0L, Data.data(), (uInt)Data.size());
+
+		const uint8_t *Write = Data.data();
+		Rec.PackedSize = Data.size();
+		string Ext = fs::path(It.first).extension().string();
+		if (Compress && Data.size() > 256 && find(Packed.begin(), Packed.end(), Ext) == Packed.end())
+		{
+			uLongf Size = compressBound((uLong)Data.size());
+			Compressed.resize(Size);
+			// Keep It Only If It Saves At Least 1/8
+			if (compress2(Compressed.data(), &Size, Data.data(), (uLong)Data.size(), Z_BEST_COMPRESSION) == Z_OK &&
+				Size < Data.size() - Data.size() / 8)
+			{
+				Rec.Compressed = 1;
+				Rec.PackedSize = Size;
+				Write = Compressed.data();
+				Info.Compressed++;
+			}
+		}
+
+		uint64_t Aligned = (Offset + Alignment - 1) & ~(uint64_t)(Alignment - 1);
+		if (Aligned != Offset)
+		{
+			string Pad((size_t)(Aligned - Offset), '\0');
+			Stream.write(Pad.data(), Pad.size());
+		}
+		Rec.Offset = Aligned;
+		if (Rec.PackedSize)
+			Stream.write(reinterpret_cast<const char *>(Write), (streamsize)Rec.PackedSize);
+		Offset = Aligned + Rec.PackedSize;
+
+		Toc.push_back(Rec);
+		Info.Files++;
+		Info.Size += Rec.Size;
+		Info.PackedSize += Rec.PackedSize;
+	}
+
+	Head.Count = (uint32_t)Toc.size();
+	Head.TocOffset = Offset;
+	Head.TocSize = Toc.size() * sizeof(Entry) + NamesBlob.size();
+	Stream.write(reinterpret_cast<const char *>(Toc.data()), Toc.size() * sizeof(Entry));
+	Stream.write(NamesBlob.data(), NamesBlob.size());
+
+	Stream.seekp(0, ios::beg);
+	Stream.write(reinterpret_cast<const char *>(&Head), sizeof(Head));
+
+	if (!Stream.good())
+	{
+		Log("Cannot Write " + Out.string());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,122 @@
+/**
+ * \file	Pak.h.
+ *
+ * \brief	Declares the resource archive (.pak) format, reader and builder
+ */
+
+#pragma once
+#if !defined(__PAK_H__)
+#define __PAK_H__
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <cstdint>
+
+#include <Boost/filesystem.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+
+/**
+ * \class	Pak
+ *
+ * \brief	One file with every resource. Layout is: header, data of entries (each one is
+ * 			aligned, so stored entries can be used right from the mapped memory), table
+ * 			of contents and names. Entries are sorted by path, so files of one folder
+ * 			(e.g. model and its textures) lie together.
+ * 			Used by the engine (File_system) and by PakBuilder tool, so it doesn't need pch.h.
+ */
+
+class Pak
+{
+public:
+#pragma pack(push, 1)
+	struct Header
+	{
+		char Magic[4];
+		uint32_t Version;
+		uint32_t Count, Alignment;
+		uint64_t TocOffset, TocSize;
+	};
+	struct Entry
+	{
+		uint64_t Offset, Size, PackedSize;
+		uint32_t Name, NameLen; // In Names Blob (Relative Path In Lower Case)
+		uint32_t Crc;
+		uint8_t Compressed;
+		uint8_t Reserved[3];
+	};
+#pragma pack(pop)
+
+	Pak() {}
+	~Pak() { Close(); }
+
+	/**
+	 * \fn	bool Pak::Open(boost::filesystem::path File);
+	 *
+	 * \brief	Map archive and read its table of contents
+	 *
+	 * \param 	File	The archive.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	bool Open(boost::filesystem::path File);
+	void Close();
+	bool IsOpen() const { return Head != nullptr; }
+
+	// Relative Path (e.g. "models/box/box.obj"), Case-Insensitive
+	const Entry *Find(std::string Path) const;
+	std::string GetName(const Entry *It) const;
+	const std::vector<const Entry *> &GetEntries() const { return Entries; }
+
+	// Pointer Right Into The Mapped Archive (nullptr If Entry Is Compressed). CRC Isn't Checked: It's Done By Read
+	const uint8_t *GetData(const Entry *It) const;
+
+	/**
+	 * \fn	bool Pak::Read(const Entry *It, std::vector<uint8_t> &Data) const;
+	 *
+	 * \brief	Copy (And Decompress) Entry, Then Check Its CRC (Nothing Is Appended If It's Corrupt)
+	 *
+	 * \param 		  	It  	The entry.
+	 * \param [in,out]	Data	Data of the file (it's appended).
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	bool Read(const Entry *It, std::vector<uint8_t> &Data) const;
+
+	struct BuildInfo
+	{
+		size_t Files = 0, Compressed = 0;
+		uint64_t Size = 0, PackedSize = 0;
+	};
+
+	/**
+	 * \fn	static bool Pak::Build(boost::filesystem::path Folder, boost::filesystem::path Out,
+	 * 		bool Compress, uint32_t Alignment, BuildInfo &Info, std::function<void(std::string)> Log);
+	 *
+	 * \brief	Pack every file of the folder into the archive
+	 *
+	 * \param 		  	Folder   	Resource folder.
+	 * \param 		  	Out		 	The archive.
+	 * \param 		  	Compress 	Compress entries with zlib (If It Makes Them Smaller).
+	 * \param 		  	Alignment	Alignment of entries (Power Of Two).
+	 * \param [in,out]	Info	 	Statistic.
+	 * \param 		  	Log		 	Get error text and progress.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Build(boost::filesystem::path Folder, boost::filesystem::path Out, bool Compress,
+		uint32_t Alignment, BuildInfo &Info, std::function<void(std::string)> Log);
+
+	static const uint32_t Version = 1;
+private:
+	boost::iostreams::mapped_file_source Map;
+	const Header *Head = nullptr;
+	const char *Names = nullptr;
+	std::vector<const Entry *> Entries;
+	std::unordered_map<std::string, const Entry *> ByName;
+};
+#endif // !__PAK_H__
@@ -0,0 +1,208 @@
+#include "pch.h"
+
+#include "ResidentCache.h"
+
+ResidentCache::ResidentCache()
+{
+	for (size_t i = 0; i < Categories; i++)
+		Cache->Info[i].Budget = getDefaultBudget((Category)i);
+}
+
+shared_ptr<void> ResidentCache::Lease(const shared_ptr<State> &Cache, const shared_ptr<Entry> &It)
+{
+	if (It->Users++ == 0 && It->Kept)
+	{
+		auto &Info = Cache->Info[It->Type];
+		Cache->Unused[It->Type].erase(It->Place);
+		Info.UnusedBytes -= It->Bytes;
+		Info.Unused--;
+	}
+
+	// Every Copy Of The Handle Shares This Lease, The Entry Keeps The Asset Alive
+	weak_ptr<State> Owner = Cache;
+	return shared_ptr<void>(It->Asset.get(), [Owner, It](void *) { Release(Owner, It); });
+}
+
+void ResidentCache::Release(const weak_ptr<State> &Cache, const shared_ptr<Entry> &It)
+{
+	auto Owner = Cache.lock();
+	if (!Owner.operator bool())
+		return;
+
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Owner->Lock);
+	if (--It->Users > 0 || !It->Kept)
+		return;
+
+	auto &Info = Owner->Info[It->Type];
+	auto &Unused = Owner->Unused[It->Type];
+	It->Place = Unused.insert(Unused.begin(), It);
+	Info.UnusedBytes += It->Bytes;
+	Info.Unused++;
+
+	Trim(*Owner, It->Type, Freed);
+}
+
+void ResidentCache::Remove(State &Cache, const shared_ptr<Entry> &It, vector<shared_ptr<void>> &Freed)
+{
+	// It Can Be The Element Of Unused Which Is Erased Below
+	auto Keep = It;
+	if (!Keep->Kept)
+		return;
+
+	auto &Info = Cache.Info[Keep->Type];
+	auto &Entries = Cache.Entries[Keep->Type];
+	auto Found = Entries.find(Keep->Key);
+	if (Found != Entries.end() && Found->second == Keep)
+		Entries.erase(Found);
+
+	Keep->Kept = false;
+	Info.Bytes -= Keep->Bytes;
+	Info.Entries--;
+
+	// Handles Still Use It, It's Freed By The Last One
+	if (Keep->Users > 0)
+		return;
+
+	Cache.Unused[Keep->Type].erase(Keep->Place);
+	Info.UnusedBytes -= Keep->Bytes;
+	Info.Unused--;
+	Freed.push_back(move(Keep->Asset));
+}
+
+void ResidentCache::Trim(State &Cache, Category Type, vector<shared_ptr<void>> &Freed)
+{
+	auto &Info = Cache.Info[Type];
+	auto &Unused = Cache.Unused[Type];
+	if (Info.Budget == 0)
+		return;
+
+	while (Info.Bytes > Info.Budget && !Unused.empty())
+	{
+		Info.Evictions++;
+		Info.EvictedBytes += Unused.back()->Bytes;
+		Remove(Cache, Unused.back(), Freed);
+	}
+}
+
+shared_ptr<void> ResidentCache::Acquire(Category Type, StringID Key)
+{
+	lock_guard<mutex> Lock(Cache->Lock);
+	auto &Entries = Cache->Entries[Type];
+	auto Found = Entries.find(Key);
+	if (Found == Entries.end())
+	{
+		Cache->Info[Type].Misses++;
+		return nullptr;
+	}
+
+	Cache->Info[Type].Hits++;
+	return Lease(Cache, Found->second);
+}
+
+shared_ptr<void> ResidentCache::Insert(Category Type, StringID Key, shared_ptr<void> Asset, size_t Bytes)
+{
+	if (!Asset.operator bool())
+		return nullptr;
+
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Cache->Lock);
+	auto &Entries = Cache->Entries[Type];
+	auto Found = Entries.find(Key);
+	if (Found != Entries.end())
+		Remove(*Cache, Found->second, Freed);
+
+	auto New = make_shared<Entry>();
+	New->Type = Type;
+	New->Key = Key;
+	New->Asset = Asset;
+	New->Bytes = Bytes;
+	Entries[Key] = New;
+
+	// It's Unused Until The Handle Is Made, So It's Counted As Every Other Asset
+	auto &Info = Cache->Info[Type];
+	New->Place = Cache->Unused[Type].insert(Cache->Unused[Type].begin(), New);
+	Info.Bytes += Bytes;
+	Info.UnusedBytes += Bytes;
+	Info.Entries++;
+	Info.Unused++;
+
+	// The New Asset Is Referenced, So Only Older Ones Can Be Evicted
+	auto Handle = Lease(Cache, New);
+	Trim(*Cache, Type, Freed);
+	return Handle;
+}
+
+void ResidentCache::Forget(Category Type, StringID Key)
+{
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Cache->Lock);
+	auto &Entries = Cache->Entries[Type];
+	auto Found = Entries.find(Key);
+	if (Found != Entries.end())
+		Remove(*Cache, Found->second, Freed);
+}
+
+void ResidentCache::Forget(Category Type)
+{
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Cache->Lock);
+	vector<shared_ptr<Entry>> All;
+	for (auto &It: Cache->Entries[Type])
+		All.push_back(It.second);
+	for (auto &It: All)
+		Remove(*Cache, It, Freed);
+}
+
+void ResidentCache::Clear()
+{
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Cache->Lock);
+	for (size_t i = 0; i < Categories; i++)
+		while (!Cache->Unused[i].empty())
+			Remove(*Cache, Cache->Unused[i].back(), Freed);
+}
+
+void ResidentCache::SetBudget(Category Type, size_t Bytes)
+{
+	vector<shared_ptr<void>> Freed;
+	lock_guard<mutex> Lock(Cache->Lock);
+	Cache->Info[Type].Budget = Bytes;
+	Trim(*Cache, Type, Freed);
+}
+
+ResidentCache::Stats ResidentCache::getStats(Category Type)
+{
+	lock_guard<mutex> Lock(Cache->Lock);
+	return Cache->Info[Type];
+}
+
+string ResidentCache::getName(Category Type)
+{
+	switch (Type)
+	{
+	case Models:
+		return "Models";
+	case Textures:
+		return "Textures";
+	case Sounds:
+		return "Sounds";
+	default:
+		return "Unknown";
+	}
+}
+
+size_t ResidentCache::getDefaultBudget(Category Type)
+{
+	switch (Type)
+	{
+	case Models:
+		return size_t(256) << 20;
+	case Textures:
+		return size_t(512) << 20;
+	case Sounds:
+		return size_t(128) << 20;
+	default:
+		return 0;
+	}
+}
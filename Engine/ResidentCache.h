@@ -0,0 +1,140 @@
+/**
+ * \file	ResidentCache.h.
+ *
+ * \brief	Declares the resident asset cache (Byte Budgets And LRU Eviction)
+ */
+
+#pragma once
+#if !defined(__RESIDENTCACHE_H__)
+#define __RESIDENTCACHE_H__
+#include "pch.h"
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include "StringID.h"
+
+/**
+ * \class	ResidentCache
+ *
+ * \brief	Keeps loaded assets (Models, Textures, Sound Buffers) by category and name, and counts
+ * 			how many bytes every category uses. Find() and Add() give a handle: shared_ptr to
+ * 			the asset, while any copy of it is alive the asset is referenced and is never evicted.
+ * 			When the last copy is gone the asset isn't freed but becomes unused, so the next level
+ * 			which needs it gets it without loading. Unused assets are evicted (The Least Recently
+ * 			Used First) when the category is over its budget.
+ * 			Referenced assets can make the category go over the budget: it's shown by stats.
+ * 			The asset is freed by its own destructor, it's called by the thread which drops it
+ * 			(For Device Objects It's The Frame Thread).
+ */
+
+class ResidentCache
+{
+public:
+	enum Category
+	{
+		Models = 0,
+		Textures,
+		Sounds,
+		Categories
+	};
+
+	struct Stats
+	{
+		// 0 Means Without Limit
+		size_t Budget = 0;
+		size_t Bytes = 0, Entries = 0;
+		// Assets Which Nobody Uses (They Can Be Evicted)
+		size_t UnusedBytes = 0, Unused = 0;
+		uint64_t Hits = 0, Misses = 0, Evictions = 0, EvictedBytes = 0;
+	};
+
+	ResidentCache();
+	~ResidentCache() { Clear(); }
+
+	/**
+	 * \fn	template<class T> shared_ptr<T> ResidentCache::Find(Category Type, StringID Key);
+	 *
+	 * \brief	Get the asset and mark it as used right now (It's a Hit Or a Miss Of Stats)
+	 *
+	 * \param 	Type	The category.
+	 * \param 	Key 	Name of the asset (e.g. StringID::Path Of The File).
+	 *
+	 * \returns	Handle of the asset or nullptr if it isn't loaded.
+	 */
+
+	template<class T> shared_ptr<T> Find(Category Type, StringID Key)
+	{
+		return static_pointer_cast<T>(Acquire(Type, Key));
+	}
+
+	/**
+	 * \fn	template<class T> shared_ptr<T> ResidentCache::Add(Category Type, StringID Key, shared_ptr<T> Asset,
+	 * 		size_t Bytes);
+	 *
+	 * \brief	Keep the loaded asset. If other asset with this name is kept it's replaced (Its
+	 * 			Handles Still Work, But It's Freed When They Are Gone).
+	 *
+	 * \param 	Type 	The category.
+	 * \param 	Key  	Name of the asset.
+	 * \param 	Asset	The asset.
+	 * \param 	Bytes	Memory which the asset uses.
+	 *
+	 * \returns	Handle of the asset.
+	 */
+
+	template<class T> shared_ptr<T> Add(Category Type, StringID Key, shared_ptr<T> Asset, size_t Bytes)
+	{
+		return static_pointer_cast<T>(Insert(Type, Key, static_pointer_cast<void>(Asset), Bytes));
+	}
+
+	// Next Find() Of The Asset Is a Miss (e.g. The File Is Changed)
+	void Forget(Category Type, StringID Key);
+	void Forget(Category Type);
+	// Evict Every Unused Asset
+	void Clear();
+
+	// Evict Unused Assets Of The Category Until It Fits
+	void SetBudget(Category Type, size_t Bytes);
+	Stats getStats(Category Type);
+
+	static string getName(Category Type);
+	// Models: 256 MB, Textures: 512 MB, Sounds: 128 MB (Overridden By "[cache]" Of settings.cfg)
+	static size_t getDefaultBudget(Category Type);
+private:
+	struct Entry
+	{
+		Category Type = Models;
+		StringID Key;
+		shared_ptr<void> Asset;
+		size_t Bytes = 0;
+
+		// Alive Handles
+		size_t Users = 0;
+		// False When It's Replaced Or Forgotten
+		bool Kept = true;
+		// Place In Unused If Users Is 0
+		list<shared_ptr<Entry>>::iterator Place;
+	};
+	struct State
+	{
+		mutex Lock;
+		unordered_map<StringID, shared_ptr<Entry>> Entries[Categories];
+		// The Most Recently Used Is At The Front
+		list<shared_ptr<Entry>> Unused[Categories];
+		Stats Info[Categories];
+	};
+
+	shared_ptr<void> Acquire(Category Type, StringID Key);
+	shared_ptr<void> Insert(Category Type, StringID Key, shared_ptr<void> Asset, size_t Bytes);
+
+	// Called With Locked State. Removed Assets Are Moved To Freed, They're Dropped Without The Lock
+	static shared_ptr<void> Lease(const shared_ptr<State> &Cache, const shared_ptr<Entry> &It);
+	static void Release(const weak_ptr<State> &Cache, const shared_ptr<Entry> &It);
+	static void Remove(State &Cache, const shared_ptr<Entry> &It, vector<shared_ptr<void>> &Freed);
+	static void Trim(State &Cache, Category Type, vector<shared_ptr<void>> &Freed);
+
+	// Handles Can Live Longer Than The Cache
+	shared_ptr<State> Cache = make_shared<State>();
+};
+#endif // !__RESIDENTCACHE_H__
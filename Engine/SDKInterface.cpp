@@ -13,6 +13,7 @@ extern shared_ptr<Engine> Application;
 #include "DebugDraw.h"
 #include "Models.h"
 #include "Actor.h"
+#include "ResidentCache.h"
 
 //pair<float, bool> DragFloat(string ID, float Thing)
 //{
@@ -355,6 +356,7 @@ void SDKInterface::Render()
 	else if (Application->getMessage().message == WM_DROPFILES || Application->getMessage().wParam > 0)
 	{
 		WCHAR buffer[512];
+		vector<path> Dropped;
 		HDROP fDrop = (HDROP)Application->getMessage().wParam;
 		for (int i = DragQueryFileW(fDrop, 0xFFFFFFFF, 0, 0); 0 <= i; i--)
 		{
@@ -394,30 +396,38 @@ void SDKInterface::Render()
 					continue;
 				}
 				else
-					Application->getFS()->AddFile(File, ListTextures);
+					Dropped.push_back(File);
 			}
 		}
 		DragFinish(fDrop);
 		Application->setMessage(MSG{});
 
-		if (!ListTextures.second.empty())
-			SelectMissingFiles();
-		else
+		// Textures Of Dropped Models Are Found On Worker Threads, So The Editor Isn't Frozen
+		// And AddFile Only Takes Them From The Cache
+		Application->getFS()->ScanDependencies(Dropped, [this, Dropped]()
 		{
-			if (!ListTextures.first.empty())
+			for (auto &File: Dropped)
+				Application->getFS()->AddFile(File, ListTextures);
+
+			if (!ListTextures.second.empty())
+				SelectMissingFiles();
+			else
 			{
-				auto newNode = Application->getLevel()->Add(ListTextures.first);
-				if (newNode)
+				if (!ListTextures.first.empty())
 				{
-					// Need To Save It As New Object (or mark it)
-					newNode->SaveInfo->T = newNode->GM->GetType();
-					newNode->IsItChanged = true;
-					newNode->SaveInfo->IsVisible = newNode->GM->RenderIt;
-					newNode->SaveInfo->Pos = newNode->SaveInfo->Rot =
-						newNode->SaveInfo->Scale = true;
+					auto newNode = Application->getLevel()->Add(ListTextures.first);
+					if (newNode)
+					{
+						// Need To Save It As New Object (or mark it)
+						newNode->SaveInfo->T = newNode->GM->GetType();
+						newNode->IsItChanged = true;
+						newNode->SaveInfo->IsVisible = newNode->GM->RenderIt;
+						newNode->SaveInfo->Pos = newNode->SaveInfo->Rot =
+							newNode->SaveInfo->Scale = true;
+					}
 				}
 			}
-		}
+		});
 	}
 
 	for (auto It = notifications.begin(); It != notifications.end(); It++)
@@ -741,7 +751,7 @@ void SDKInterface::Render()
 									"cube_with_diffuse_texture.3ds");
 								if (OurNode)
 								{
-									OurNode->ID = path(It).filename().string();
+									OurNode->SetID(path(It).filename().string());
 									OurNode->GM->SetScaleCoords(Vector3(0.01f, 0.01f, 0.01f));
 									OurNode->GM->SetPositionCoords(Application->getCamera()->GetEyePt());
 									OurNode->GM->SetType(OurNode->SaveInfo->T = GameObjects::TYPE::Sound_Obj);
@@ -783,8 +793,8 @@ void SDKInterface::Render()
 			bool Snd = ImGui::TreeNode("Sounds");
 			if (Snd)
 			{
-				auto SndFiles = FS->GetFileByType(_TypeOfFile::SOUNDS);
-				for (auto it: SndFiles)
+				auto &SndFiles = FS->GetFileByType(_TypeOfFile::SOUNDS);
+				for (auto &it: SndFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -797,8 +807,8 @@ void SDKInterface::Render()
 			bool Mdl = ImGui::TreeNode("Models");
 			if (Mdl)
 			{
-				auto MldFiles = FS->GetFileByType(_TypeOfFile::MODELS);
-				for (auto it: MldFiles)
+				auto &MldFiles = FS->GetFileByType(_TypeOfFile::MODELS);
+				for (auto &it: MldFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -811,8 +821,8 @@ void SDKInterface::Render()
 			bool Txtrs = ImGui::TreeNode("Textures");
 			if (Txtrs)
 			{
-				auto TxtrFiles = FS->GetFileByType(_TypeOfFile::TEXTURES);
-				for (auto it: TxtrFiles)
+				auto &TxtrFiles = FS->GetFileByType(_TypeOfFile::TEXTURES);
+				for (auto &it: TxtrFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -825,8 +835,8 @@ void SDKInterface::Render()
 			bool Lvls = ImGui::TreeNode("Levels");
 			if (Lvls)
 			{
-				auto LvlFiles = FS->GetFileByType(_TypeOfFile::LEVELS);
-				for (auto it: LvlFiles)
+				auto &LvlFiles = FS->GetFileByType(_TypeOfFile::LEVELS);
+				for (auto &it: LvlFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -839,8 +849,8 @@ void SDKInterface::Render()
 			bool Shdrs = ImGui::TreeNode("Shaders");
 			if (Shdrs)
 			{
-				auto ShdrFiles = FS->GetFileByType(_TypeOfFile::SHADERS);
-				for (auto it: ShdrFiles)
+				auto &ShdrFiles = FS->GetFileByType(_TypeOfFile::SHADERS);
+				for (auto &it: ShdrFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -853,8 +863,8 @@ void SDKInterface::Render()
 			bool Scrpts = ImGui::TreeNode("Scripts");
 			if (Scrpts)
 			{
-				auto ScrFiles = FS->GetFileByType(_TypeOfFile::SCRIPTS);
-				for (auto it: ScrFiles)
+				auto &ScrFiles = FS->GetFileByType(_TypeOfFile::SCRIPTS);
+				for (auto &it: ScrFiles)
 				{
 					if (filter.PassFilter(it.first->FileA.c_str()))
 						ImGui::TreeNodeEx(("File#" + it.first->FileA).c_str(), ImGuiTreeNodeFlags_Leaf |
@@ -1226,7 +1236,7 @@ void SDKInterface::Render()
 			for (size_t i = 0; i < snd->getAllSources().size(); i++)
 			{
 				bool Clicked = ImGui::Button(("[" + to_string(i) + ("] FileName:") + 
-					snd->getAllSources().at(i).second).c_str());
+					snd->getAllSources().at(i).second.original()).c_str());
 				if (Clicked && snd->getAllSources().at(i).first->IsStop())
 				{
 					snd->getAllSources().at(i).first->Play();
@@ -1562,6 +1572,20 @@ void SDKInterface::LoadSettings(boost::property_tree::ptree fData)
 			CamBtnRight = true;
 		Application->getCamera()->SetCameraControlButtons(CamBtnLeft, CamBtnRight);
 	}
+
+	// Budgets Of Resident Assets (MB, 0 Means Without Limit)
+	if (Application->getCache())
+		for (int i = 0; i < ResidentCache::Categories; i++)
+		{
+			auto Type = (ResidentCache::Category)i;
+			string Name = ResidentCache::getName(Type);
+			to_lower(Name);
+			Application->getCache()->SetBudget(Type,
+				fData.get<size_t>("cache." + Name + "_mb", ResidentCache::getDefaultBudget(Type) >> 20) << 20);
+		}
+
+	// The Longest Side Of Clusters Of The Static Batch (0 Means Without Limit)
+	Levels::Batching.MaxExtent = fData.get<float>("static.max_extent", Levels::Batching.MaxExtent);
 }
 void SDKInterface::SaveSettings()
 {
@@ -1596,6 +1620,17 @@ void SDKInterface::SaveSettings()
 		make_pair("application.look", getLook),
 	};
 
+	if (Application->getCache())
+		for (int i = 0; i < ResidentCache::Categories; i++)
+		{
+			auto Type = (ResidentCache::Category)i;
+			string Name = ResidentCache::getName(Type);
+			to_lower(Name);
+			Settings.push_back(make_pair("cache." + Name + "_mb",
+				to_string(Application->getCache()->getStats(Type).Budget >> 20)));
+		}
+	Settings.push_back(make_pair("static.max_extent", to_string(Levels::Batching.MaxExtent)));
+
 	Application->getFS()->SaveSettings(Settings);
 }
 
@@ -1886,6 +1921,20 @@ void SDKInterface::Information()
 			ImGui::Text("FrameTime : %f", Application->getframeTime());
 			ImGui::Separator();
 
+			// Resident Assets: Used Of Budget, Unused Which Can Be Evicted And Stats
+			if (Application->getCache())
+			{
+				for (int i = 0; i < ResidentCache::Categories; i++)
+				{
+					auto Type = (ResidentCache::Category)i;
+					auto Stats = Application->getCache()->getStats(Type);
+					ImGui::Text((boost::format(string("%s : %.1f / %.0f MB (Unused: %.1f MB), Hits: %d, Misses: %d, Evictions: %d"))
+						% ResidentCache::getName(Type) % (Stats.Bytes / 1048576.0) % (Stats.Budget / 1048576.0)
+						% (Stats.UnusedBytes / 1048576.0) % Stats.Hits % Stats.Misses % Stats.Evictions).str().c_str());
+				}
+				ImGui::Separator();
+			}
+
 			ImGui::Separator();
 			if (ImGui::IsMousePosValid())
 				ImGui::Text("Mouse Position: <%.1f,%.1f>", io.MousePos.x, io.MousePos.y);
@@ -8,6 +8,8 @@ extern shared_ptr<Engine> Application;
 #include "File_system.h"
 #include "Console.h"
 
+#pragma comment(lib, "d3dcompiler.lib")
+
 HRESULT Shaders::result = S_OK;
 ID3DBlob *Shaders::pErrorBlob = nullptr;
 
@@ -40,6 +42,32 @@ HRESULT Shaders::CompileShaderFromFile(string FileName, string FunctionName,
 	return S_OK;
 }
 
+HRESULT Shaders::TryCompileShaderFromFile(string FileName, string FunctionName,
+	string VersionShader, ID3DBlob **ppBlobOut)
+{
+	*ppBlobOut = nullptr;
+	size_t Size = 0;
+	vector<BYTE> Source;
+	if (!File_system::ReadFileMemory(FileName.c_str(), Size, Source))
+		return E_FAIL;
+
+	DWORD dwShaderFlags = D3DCOMPILE_ENABLE_STRICTNESS;
+
+#if defined (_DEBUG)
+	dwShaderFlags |= D3DCOMPILE_DEBUG;
+#endif
+
+	// Errors Of The Compiler Are Dropped: The Caller Decides What The Failure Means
+	ID3DBlob *Errors = nullptr;
+	HRESULT Result = D3DCompile(Source.data(), Size, FileName.c_str(), NULL, D3D_COMPILE_STANDARD_FILE_INCLUDE,
+		FunctionName.c_str(), VersionShader.c_str(), dwShaderFlags, 0, ppBlobOut, &Errors);
+	SAFE_RELEASE(Errors);
+	if (FAILED(Result))
+		SAFE_RELEASE(*ppBlobOut);
+
+	return Result;
+}
+
 vector<void *> Shaders::CompileShaderFromFile(vector<ID3DBlob *> Things)
 {
 	vector<void *> ppBlobOut;
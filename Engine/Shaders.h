@@ -8,6 +8,9 @@ class Shaders
 public:
 	static HRESULT CompileShaderFromFile(string FileName, string FunctionName, string VersionShader,
 		ID3DBlob **ppBlobOut);
+	// Nothing Is Logged: Failure (E_FAIL If The File Has No Such Function) Means The Variant Isn't There
+	static HRESULT TryCompileShaderFromFile(string FileName, string FunctionName, string VersionShader,
+		ID3DBlob **ppBlobOut);
 	static vector<void *> CompileShaderFromFile(vector<ID3DBlob *> Things);
 	static vector<ID3DBlob *> CreateShaderFromFile(vector<string> FileName, vector<string> FunctionName,
 		vector<string> VersionShader, DWORD ShaderFlags = 0);
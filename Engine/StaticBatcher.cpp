@@ -0,0 +1,141 @@
+#include "StaticBatcher.h"
+
+#include <algorithm>
+#include <map>
+
+using namespace std;
+
+namespace
+{
+	void Transform(const float *World, const float *Pos, float *Result)
+	{
+		for (int k = 0; k < 3; k++)
+			Result[k] = Pos[0] * World[k] + Pos[1] * World[4 + k] + Pos[2] * World[8 + k] + World[12 + k];
+	}
+
+	// Mirrored Transform Turns Triangles Over
+	bool isMirrored(const float *World)
+	{
+		float Det = World[0] * (World[5] * World[10] - World[6] * World[9]) -
+			World[1] * (World[4] * World[10] - World[6] * World[8]) +
+			World[2] * (World[4] * World[9] - World[5] * World[8]);
+		return Det < 0.f;
+	}
+
+	struct Placed
+	{
+		size_t Index = 0;
+		float Centre[3] = { 0.f, 0.f, 0.f };
+	};
+
+	void Emit(const vector<StaticBatcher::Instance> &Instances, vector<Placed>::iterator Begin,
+		vector<Placed>::iterator End, uint64_t Material, vector<StaticBatcher::Cluster> &Result)
+	{
+		StaticBatcher::Cluster New;
+		New.Material = Material;
+		for (auto It = Begin; It != End; ++It)
+		{
+			auto &Mesh = Instances[It->Index];
+			uint32_t Base = (uint32_t)New.Vertices.size();
+			for (size_t i = 0; i < Mesh.VertexCount; i++)
+			{
+				StaticBatcher::Vertex V = Mesh.Vertices[i];
+				Transform(Mesh.World, Mesh.Vertices[i].Pos, V.Pos);
+				for (int k = 0; k < 3; k++)
+				{
+					New.Min[k] = New.Vertices.empty() ? V.Pos[k] : min(New.Min[k], V.Pos[k]);
+					New.Max[k] = New.Vertices.empty() ? V.Pos[k] : max(New.Max[k], V.Pos[k]);
+				}
+				New.Vertices.push_back(V);
+			}
+
+			bool Flip = isMirrored(Mesh.World);
+			for (size_t i = 0; i + 2 < Mesh.IndexCount; i += 3)
+			{
+				const uint32_t *Tri = &Mesh.Indices[i];
+				if (Tri[0] >= Mesh.VertexCount || Tri[1] >= Mesh.VertexCount || Tri[2] >= Mesh.VertexCount)
+					continue;
+				New.Indices.push_back(Base + Tri[0]);
+				New.Indices.push_back(Base + Tri[Flip ? 2 : 1]);
+				New.Indices.push_back(Base + Tri[Flip ? 1 : 2]);
+			}
+			New.Instances.push_back(It->Index);
+		}
+
+		if (!New.Indices.empty())
+			Result.push_back(move(New));
+	}
+
+	void Split(const vector<StaticBatcher::Instance> &Instances, vector<Placed>::iterator Begin,
+		vector<Placed>::iterator End, uint64_t Material, const StaticBatcher::Settings &Options,
+		vector<StaticBatcher::Cluster> &Result)
+	{
+		size_t Vertices = 0;
+		float Min[3] = { Begin->Centre[0], Begin->Centre[1], Begin->Centre[2] }, Max[3] = { Min[0], Min[1], Min[2] };
+		for (auto It = Begin; It != End; ++It)
+		{
+			Vertices += Instances[It->Index].VertexCount;
+			for (int k = 0; k < 3; k++)
+			{
+				Min[k] = min(Min[k], It->Centre[k]);
+				Max[k] = max(Max[k], It->Centre[k]);
+			}
+		}
+
+		int Axis = 0;
+		for (int k = 1; k < 3; k++)
+			if (Max[k] - Min[k] > Max[Axis] - Min[Axis])
+				Axis = k;
+
+		bool Small = Vertices <= Options.MaxVertices && (Options.MaxExtent <= 0.f || Max[Axis] - Min[Axis] <= Options.MaxExtent);
+		if (Small || End - Begin < 2)
+		{
+			Emit(Instances, Begin, End, Material, Result);
+			return;
+		}
+
+		// Halves Of Objects Along The Longest Side (Ties Keep The Order Of The Level)
+		auto Middle = Begin + (End - Begin) / 2;
+		nth_element(Begin, Middle, End, [Axis] (const Placed &A, const Placed &B)
+		{
+			return A.Centre[Axis] < B.Centre[Axis] || (A.Centre[Axis] == B.Centre[Axis] && A.Index < B.Index);
+		});
+		sort(Begin, Middle, [] (const Placed &A, const Placed &B) { return A.Index < B.Index; });
+		sort(Middle, End, [] (const Placed &A, const Placed &B) { return A.Index < B.Index; });
+
+		Split(Instances, Begin, Middle, Material, Options, Result);
+		Split(Instances, Middle, End, Material, Options, Result);
+	}
+}
+
+vector<StaticBatcher::Cluster> StaticBatcher::Build(const vector<Instance> &Instances, const Settings &Options)
+{
+	map<uint64_t, vector<Placed>> Materials;
+	for (size_t i = 0; i < Instances.size(); i++)
+	{
+		auto &It = Instances[i];
+		if (!It.Vertices || !It.Indices || It.VertexCount == 0 || It.IndexCount < 3)
+			continue;
+
+		// Centre Of The Box Of The Mesh In The World
+		float Min[3], Max[3];
+		for (size_t v = 0; v < It.VertexCount; v++)
+			for (int k = 0; k < 3; k++)
+			{
+				Min[k] = v ? min(Min[k], It.Vertices[v].Pos[k]) : It.Vertices[v].Pos[k];
+				Max[k] = v ? max(Max[k], It.Vertices[v].Pos[k]) : It.Vertices[v].Pos[k];
+			}
+
+		Placed New;
+		New.Index = i;
+		float Centre[3] = { (Min[0] + Max[0]) * 0.5f, (Min[1] + Max[1]) * 0.5f, (Min[2] + Max[2]) * 0.5f };
+		Transform(It.World, Centre, New.Centre);
+		Materials[It.Material].push_back(New);
+	}
+
+	vector<Cluster> Result;
+	for (auto &It: Materials)
+		Split(Instances, It.second.begin(), It.second.end(), It.first, Options, Result);
+
+	return Result;
+}
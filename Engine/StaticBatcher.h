@@ -0,0 +1,85 @@
+/**
+ * \file	StaticBatcher.h.
+ *
+ * \brief	Declares the static batcher (Meshes Of Objects Which Don't Move Merged By Material)
+ */
+
+#pragma once
+#if !defined(__STATICBATCHER_H__)
+#define __STATICBATCHER_H__
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Size Of Clusters Which StaticBatcher::Build Makes
+struct BatchSettings
+{
+	// Vertices Of The Cluster (16-Bit Indices), a Bigger Mesh Is Its Own Cluster
+	size_t MaxVertices = 65535;
+	// The Longest Side Of The Box Of Centres Of The Cluster (0: No Limit)
+	float MaxExtent = 0.f;
+};
+
+/**
+ * \class	StaticBatcher
+ *
+ * \brief	Merges meshes of placed objects which have the same material into clusters: vertices
+ * 			are transformed into the world, so the cluster is one draw call without its own
+ * 			transform. Objects of the material are split in halves along the longest side of
+ * 			their box while the cluster is too big, so clusters are close objects and their
+ * 			bounds cull them. Used by the engine and by tests, so it doesn't need pch.h.
+ */
+
+class StaticBatcher
+{
+public:
+#pragma pack(push, 1)
+	// The Same Layout As Things Of Models
+	struct Vertex
+	{
+		float Pos[3];
+		float Tex[2];
+	};
+#pragma pack(pop)
+	// Mesh Of The Placed Object
+	struct Instance
+	{
+		const Vertex *Vertices = nullptr;
+		size_t VertexCount = 0;
+		const uint32_t *Indices = nullptr;
+		size_t IndexCount = 0;
+		// Row Vectors Are Multiplied By It (As SimpleMath Does): Translation Is In The Last Row
+		float World[16] = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+		// Only Meshes Of The Same Material Are Merged (e.g. Their Texture)
+		uint64_t Material = 0;
+	};
+	struct Cluster
+	{
+		uint64_t Material = 0;
+		std::vector<Vertex> Vertices;
+		std::vector<uint32_t> Indices;
+		// Box Of Vertices In The World
+		float Min[3] = { 0.f, 0.f, 0.f }, Max[3] = { 0.f, 0.f, 0.f };
+		// Numbers Of Merged Instances
+		std::vector<size_t> Instances;
+	};
+	typedef BatchSettings Settings;
+
+	/**
+	 * \fn	static std::vector<Cluster> StaticBatcher::Build(const std::vector<Instance> &Instances,
+	 * 		const Settings &Options = Settings());
+	 *
+	 * \brief	Merge instances into clusters. Triangles of each instance keep their order (It's
+	 * 			Optimized For Vertex Cache), mirrored instances get the opposite winding, so they
+	 * 			face the same side. Triangles with broken indices are skipped.
+	 *
+	 * \param 	Instances	Meshes of objects.
+	 * \param 	Options  	(Optional) Size of clusters.
+	 *
+	 * \returns	Clusters in the order of materials.
+	 */
+
+	static std::vector<Cluster> Build(const std::vector<Instance> &Instances, const Settings &Options = Settings());
+};
+#endif // !__STATICBATCHER_H__
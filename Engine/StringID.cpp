@@ -0,0 +1,236 @@
+#include "StringID.h"
+
+#include <atomic>
+#include <cassert>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+using namespace std;
+
+namespace
+{
+	struct Entry
+	{
+		string Lower, Original;
+		uint32_t Hash = 0;
+	};
+
+	// Entries Are Never Moved: Chunks Are Only Added, So Reading By ID Needs No Lock
+	const uint32_t ChunkBits = 12, ChunkSize = 1u << ChunkBits, MaxChunks = 4096;
+	// The Last ID Is Given To Every Text Which Doesn't Fit (It Isn't The Empty String)
+	const uint32_t FullID = MaxChunks * ChunkSize - 1;
+
+	struct Table
+	{
+		atomic<Entry *> Chunks[MaxChunks] = {};
+		atomic<uint32_t> Count{ 0 };
+		atomic<size_t> Memory{ 0 };
+
+		// Keys Point To Entry::Lower
+		unordered_map<string_view, uint32_t> ByText;
+		shared_mutex Lock;
+
+		function<void(string)> Log;
+		bool IsFull = false;
+
+		Table()
+		{
+			// ID 0 Is The Empty String
+			Chunks[0].store(new Entry[ChunkSize]);
+			ByText.emplace(string_view(), 0);
+			Count.store(1);
+		}
+	};
+
+	Table &getTable()
+	{
+		// Isn't Destroyed: IDs Can Be Used By Static Objects Until The Very End
+		static Table *It = new Table;
+		return *It;
+	}
+
+	const Entry &getEntry(uint32_t ID)
+	{
+		return getTable().Chunks[ID >> ChunkBits].load(memory_order_acquire)[ID & (ChunkSize - 1)];
+	}
+
+	// FNV-1a
+	uint32_t HashOf(string_view Text)
+	{
+		uint32_t Hash = 2166136261u;
+		for (unsigned char C : Text)
+		{
+			Hash ^= C;
+			Hash *= 16777619u;
+		}
+		return Hash;
+	}
+
+	// Lowercase Bytes: ASCII And Cyrillic Of Windows-1251 (Paths And Names Are In The ANSI Code Page)
+	struct FoldTable
+	{
+		unsigned char Lower[256];
+
+		FoldTable()
+		{
+			for (int i = 0; i < 256; i++)
+				Lower[i] = (unsigned char)i;
+			for (int i = 'A'; i <= 'Z'; i++)
+				Lower[i] = (unsigned char)(i - 'A' + 'a');
+			// Capital Cyrillic Letters (0xC0..0xDF) Are 0x20 Before Small Ones
+			for (int i = 0xC0; i <= 0xDF; i++)
+				Lower[i] = (unsigned char)(i + 0x20);
+
+			// Letters Out Of The Main Block (Yo, Serbian, Macedonian, Belarusian And Ukrainian Ones)
+			const unsigned char Pairs[][2] = {
+				{ 0xA8, 0xB8 }, { 0x80, 0x90 }, { 0x81, 0x83 }, { 0x8A, 0x9A }, { 0x8C, 0x9C },
+				{ 0x8D, 0x9D }, { 0x8E, 0x9E }, { 0x8F, 0x9F }, { 0xA1, 0xA2 }, { 0xA3, 0xBC },
+				{ 0xA5, 0xB4 }, { 0xAA, 0xBA }, { 0xAF, 0xBF }, { 0xB2, 0xB3 }, { 0xBD, 0xBE }
+			};
+			for (auto &It : Pairs)
+				Lower[It[0]] = It[1];
+		}
+	};
+
+	void Fold(string_view Text, bool IsPath, string &Out)
+	{
+		static const FoldTable Table;
+
+		Out.resize(Text.size());
+		for (size_t i = 0; i < Text.size(); i++)
+		{
+			char C = (char)Table.Lower[(unsigned char)Text[i]];
+			if (IsPath && C == '\\')
+				C = '/';
+			Out[i] = C;
+		}
+	}
+}
+
+uint32_t StringID::Intern(string_view Text, bool IsPath)
+{
+	if (Text.empty())
+		return 0;
+
+	thread_local string Lower;
+	Fold(Text, IsPath, Lower);
+
+	auto &T = getTable();
+	{
+		shared_lock<shared_mutex> Read(T.Lock);
+		auto It = T.ByText.find(Lower);
+		if (It != T.ByText.end())
+			return It->second;
+	}
+
+	unique_lock<shared_mutex> Write(T.Lock);
+	auto It = T.ByText.find(Lower);
+	if (It != T.ByText.end())
+		return It->second;
+
+	uint32_t ID = T.Count.load(memory_order_relaxed);
+	uint32_t Chunk = ID >> ChunkBits;
+	Entry *Data = T.Chunks[Chunk].load(memory_order_relaxed);
+	if (ID == FullID)
+	{
+		// Said Once: The Chunk Of The Last ID Is There Already
+		if (!T.IsFull)
+		{
+			T.IsFull = true;
+			Entry &Last = Data[ID & (ChunkSize - 1)];
+			Last.Lower = Last.Original = "<StringID Table Is Full>";
+			Last.Hash = HashOf(Last.Lower);
+
+			string Error = "StringID::Intern() The table is full, \"" + string(Text) +
+				"\" and every next new text gets ID " + to_string(FullID) + "!";
+			// The Log Can Intern Texts Too
+			auto Log = T.Log;
+			Write.unlock();
+			if (Log)
+				Log(Error);
+			else
+				cerr << Error << "\n";
+			assert(!"StringID::Intern() The table is full!");
+		}
+		return FullID;
+	}
+
+	if (!Data)
+	{
+		Data = new Entry[ChunkSize];
+		T.Chunks[Chunk].store(Data, memory_order_release);
+		T.Memory.fetch_add(sizeof(Entry) * ChunkSize, memory_order_relaxed);
+	}
+
+	Entry &New = Data[ID & (ChunkSize - 1)];
+	New.Lower = Lower;
+	New.Original.assign(Text.data(), Text.size());
+	New.Hash = HashOf(Lower);
+	T.ByText.emplace(string_view(New.Lower), ID);
+
+	T.Memory.fetch_add(New.Lower.capacity() + New.Original.capacity() + sizeof(string_view) + sizeof(uint32_t),
+		memory_order_relaxed);
+	T.Count.store(ID + 1, memory_order_release);
+	return ID;
+}
+
+StringID::StringID(string_view Text): ID(Intern(Text, false)) {}
+
+StringID StringID::Path(string_view Text)
+{
+	StringID Result;
+	Result.ID = Intern(Text, true);
+	return Result;
+}
+
+StringID StringID::Find(string_view Text)
+{
+	StringID Result;
+	if (Text.empty())
+		return Result;
+
+	thread_local string Lower;
+	Fold(Text, false, Lower);
+
+	auto &T = getTable();
+	shared_lock<shared_mutex> Read(T.Lock);
+	auto It = T.ByText.find(Lower);
+	if (It != T.ByText.end())
+		Result.ID = It->second;
+	return Result;
+}
+
+const string &StringID::str() const
+{
+	return getEntry(ID).Lower;
+}
+
+const string &StringID::original() const
+{
+	return getEntry(ID).Original;
+}
+
+uint32_t StringID::hash() const
+{
+	return getEntry(ID).Hash;
+}
+
+size_t StringID::getCount()
+{
+	return getTable().Count.load(memory_order_acquire);
+}
+
+size_t StringID::getMemory()
+{
+	return getTable().Memory.load(memory_order_relaxed) + sizeof(Entry) * ChunkSize;
+}
+
+void StringID::setLog(function<void(string)> Log)
+{
+	auto &T = getTable();
+	unique_lock<shared_mutex> Write(T.Lock);
+	T.Log = move(Log);
+}
@@ -0,0 +1,98 @@
+/**
+ * \file	StringID.h.
+ *
+ * \brief	Declares the interned lowercase identifiers
+ */
+
+#pragma once
+#if !defined(__STRINGID_H__)
+#define __STRINGID_H__
+
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <functional>
+
+/**
+ * \class	StringID
+ *
+ * \brief	A string which is kept once in the global table and is known by a 32-bit number.
+ * 			The text is lowercased when it's interned, so "Textures/A.DDS" and "textures/a.dds"
+ * 			have the same ID and comparing (or hashing) them is comparing two integers.
+ * 			Cyrillic letters are lowercased as Windows-1251 (The ANSI Code Page Of Paths).
+ * 			The number is stable while the engine works (Entries Are Never Removed).
+ * 			Strings are turned into IDs at API boundaries, inside the engine only IDs are compared.
+ * 			Used by the engine and by tools, so it doesn't need pch.h.
+ */
+
+class StringID
+{
+public:
+	StringID() = default;
+	explicit StringID(std::string_view Text);
+
+	/**
+	 * \fn	static StringID StringID::Path(std::string_view Text);
+	 *
+	 * \brief	Intern a path: '\' is the same as '/'
+	 *
+	 * \param 	Text	The path.
+	 *
+	 * \returns	The ID.
+	 */
+
+	static StringID Path(std::string_view Text);
+
+	/**
+	 * \fn	static StringID StringID::Find(std::string_view Text);
+	 *
+	 * \brief	The ID of the text if it was interned, else the empty ID (Nothing Is Added)
+	 *
+	 * \param 	Text	The text.
+	 *
+	 * \returns	The ID.
+	 */
+
+	static StringID Find(std::string_view Text);
+
+	uint32_t getID() const { return ID; }
+	bool IsEmpty() const { return ID == 0; }
+
+	// Lowercase Text
+	const std::string &str() const;
+	// Text As It Was When It Was Interned First Time
+	const std::string &original() const;
+	// Hash Of The Lowercase Text (Computed Once)
+	uint32_t hash() const;
+
+	bool operator==(const StringID &Other) const { return ID == Other.ID; }
+	bool operator!=(const StringID &Other) const { return ID != Other.ID; }
+	bool operator<(const StringID &Other) const { return ID < Other.ID; }
+
+	// Statistics Of The Table
+	static size_t getCount();
+	static size_t getMemory();
+
+	/**
+	 * \fn	static void StringID::setLog(std::function<void(std::string)> Log);
+	 *
+	 * \brief	Where errors of the table go (The Engine Gives Its LogError, Else It's std::cerr)
+	 *
+	 * \param 	Log	The log.
+	 */
+
+	static void setLog(std::function<void(std::string)> Log);
+private:
+	static uint32_t Intern(std::string_view Text, bool IsPath);
+
+	uint32_t ID = 0;
+};
+
+namespace std
+{
+	template<> struct hash<StringID>
+	{
+		size_t operator()(const StringID &It) const noexcept { return It.hash(); }
+	};
+}
+#endif // !__STRINGID_H__
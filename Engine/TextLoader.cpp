@@ -0,0 +1,187 @@
+#include "TextLoader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+const TextLoader::Syntax &TextLoader::XML()
+{
+	static const Syntax S;
+	return S;
+}
+
+const TextLoader::Syntax &TextLoader::Code()
+{
+	static const Syntax S = { "/*", "*/", "//", true, true };
+	return S;
+}
+
+const TextLoader::Syntax &TextLoader::Plain()
+{
+	static const Syntax S = { "", "", "", false, true };
+	return S;
+}
+
+static bool Starts(const char *P, const char *End, const string &What)
+{
+	return !What.empty() && size_t(End - P) >= What.size() && memcmp(P, What.data(), What.size()) == 0;
+}
+
+size_t TextLoader::Strip(const char *Data, size_t Size, const Syntax &S, char *Out)
+{
+	const char *P = Data, *End = Data + Size;
+	char *W = Out;
+
+	// Only These Chars Can Start Something, The Rest Is Copied As Is
+	bool Special[256] = {};
+	if (!S.BlockStart.empty())
+		Special[uint8_t(S.BlockStart.front())] = true;
+	if (!S.Line.empty())
+		Special[uint8_t(S.Line.front())] = true;
+	if (S.Quotes)
+		Special[uint8_t('"')] = Special[uint8_t('\'')] = true;
+	if (S.TextMode)
+		Special[uint8_t('\r')] = true;
+
+	while (P < End)
+	{
+		const char C = *P;
+		if (!Special[uint8_t(C)])
+		{
+			*W++ = *P++;
+			continue;
+		}
+
+		if (C == '\r' && S.TextMode && P + 1 < End && P[1] == '\n')
+		{
+			P++;
+			continue;
+		}
+
+		// Block Is Checked First: e.g. Lua Has --[[ And --
+		if (Starts(P, End, S.BlockStart))
+		{
+			const char *Close = search(P + S.BlockStart.size(), End, S.BlockEnd.begin(), S.BlockEnd.end());
+			if (S.BlockEnd.empty() || Close == End)
+			{
+				// Not Closed: Keep The Rest (As deleteWord Did)
+				size_t Rest = size_t(End - P);
+				memmove(W, P, Rest);
+				W += Rest;
+				break;
+			}
+			P = Close + S.BlockEnd.size();
+			continue;
+		}
+
+		if (Starts(P, End, S.Line))
+		{
+			// The End Of Line Is Kept, So Lines Are Still Where They Were
+			P = find(P, End, '\n');
+			if (!S.TextMode && P < End && P[-1] == '\r')
+				P--;
+			continue;
+		}
+
+		if (S.Quotes && (C == '"' || C == '\''))
+		{
+			// Copy The String Until The Same Quote (Or End Of Line)
+			*W++ = *P++;
+			while (P < End && *P != C && *P != '\n')
+			{
+				if (*P == '\\' && P + 1 < End)
+					*W++ = *P++;
+				*W++ = *P++;
+			}
+			if (P < End && *P == C)
+				*W++ = *P++;
+			continue;
+		}
+
+		*W++ = *P++;
+	}
+
+	return size_t(W - Out);
+}
+
+void TextLoader::Strip(string &Text, const Syntax &S)
+{
+	Text.resize(Strip(Text.data(), Text.size(), S, &Text[0]));
+}
+
+bool TextLoader::Load(string File, const Syntax &S, string &Out)
+{
+	ifstream Stream(File, ios::binary | ios::ate);
+	if (!Stream.is_open())
+		return false;
+
+	auto Size = Stream.tellg();
+	if (Size < 0)
+		return false;
+
+	Out.resize(size_t(Size));
+	Stream.seekg(0);
+	if (!Stream.read(&Out[0], Size))
+		return false;
+
+	Strip(Out, S);
+	return true;
+}
+
+string_view TextLoader::Load(const char *Data, size_t Size, const Syntax &S, Arena &Into)
+{
+	char *Out = Into.Allocate(Size + 1);
+	size_t Length = Strip(Data, Size, S, Out);
+	Out[Length] = '\0';
+	Into.Shrink(Out, Size + 1, Length + 1);
+
+	return string_view(Out, Length);
+}
+
+char *TextLoader::Arena::Allocate(size_t Size)
+{
+	for (; Current < Blocks.size(); Current++)
+	{
+		auto &It = Blocks.at(Current);
+		if (It.Size - It.Used >= Size)
+		{
+			char *Data = It.Data.get() + It.Used;
+			It.Used += Size;
+			Used += Size;
+			return Data;
+		}
+	}
+
+	Block New;
+	New.Size = max(Size, BlockSize);
+	New.Data.reset(new char[New.Size]);
+	New.Used = Size;
+	Blocks.push_back(move(New));
+	Current = Blocks.size() - 1;
+	Used += Size;
+
+	return Blocks.back().Data.get();
+}
+
+void TextLoader::Arena::Shrink(char *Data, size_t Size, size_t NewSize)
+{
+	if (Current >= Blocks.size() || NewSize > Size)
+		return;
+
+	auto &It = Blocks.at(Current);
+	if (Data + Size == It.Data.get() + It.Used)
+	{
+		It.Used -= Size - NewSize;
+		Used -= Size - NewSize;
+	}
+}
+
+void TextLoader::Arena::Reset()
+{
+	for (auto &It: Blocks)
+		It.Used = 0;
+	Current = 0;
+	Used = 0;
+}
@@ -0,0 +1,106 @@
+/**
+ * \file	TextLoader.h.
+ *
+ * \brief	Declares the text loader which strips comments in one pass
+ */
+
+#pragma once
+#if !defined(__TEXTLOADER_H__)
+#define __TEXTLOADER_H__
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+/**
+ * \class	TextLoader
+ *
+ * \brief	Text is read in one piece and comments are cut while it's copied once from start
+ * 			to end (Nothing Is Erased And Moved, So It's Linear Even For Big Files).
+ * 			Comments in quotes aren't comments if Syntax has Quotes.
+ * 			Used by the engine (File_system) and by tests, so it doesn't need pch.h.
+ */
+
+class TextLoader
+{
+public:
+	struct Syntax
+	{
+		// Empty String: There's No Such Comment
+		std::string BlockStart = "<!--", BlockEnd = "-->", Line = "";
+		// Skip Text In "" And '' (With \ Escapes)
+		bool Quotes = false;
+		// \r\n -> \n (As Text Mode Of Streams Does)
+		bool TextMode = true;
+	};
+
+	// <!-- --> (XML: UI, Levels, Dialogs)
+	static const Syntax &XML();
+	// // And /* */ Outside Of Strings
+	static const Syntax &Code();
+	// Nothing Is Cut, Only \r\n
+	static const Syntax &Plain();
+
+	/**
+	 * \class	Arena
+	 *
+	 * \brief	Memory for many texts which are freed at once (e.g. Texts Of One Level)
+	 */
+
+	class Arena
+	{
+	public:
+		Arena(size_t Size = 1024 * 1024): BlockSize(Size) {}
+
+		char *Allocate(size_t Size);
+		// Give Back The End Of The Last Allocation (Text Is Shorter Without Comments)
+		void Shrink(char *Data, size_t Size, size_t NewSize);
+		// Everything Which Was Given Is Free Again (Blocks Are Kept)
+		void Reset();
+
+		size_t getUsed() const { return Used; }
+	private:
+		struct Block
+		{
+			std::unique_ptr<char[]> Data;
+			size_t Size = 0, Used = 0;
+		};
+
+		std::vector<Block> Blocks;
+		size_t BlockSize = 0, Current = 0, Used = 0;
+	};
+
+	/**
+	 * \fn	static size_t TextLoader::Strip(const char *Data, size_t Size, const Syntax &S, char *Out);
+	 *
+	 * \brief	Copy text without comments (Out Can Be Data Itself)
+	 *
+	 * \param 	Data	The text.
+	 * \param 	Size	Size of the text.
+	 * \param 	S   	What is comment.
+	 * \param 	Out 	At least Size bytes.
+	 *
+	 * \returns	Size of the result.
+	 */
+
+	static size_t Strip(const char *Data, size_t Size, const Syntax &S, char *Out);
+	static void Strip(std::string &Text, const Syntax &S);
+
+	/**
+	 * \fn	static bool TextLoader::Load(std::string File, const Syntax &S, std::string &Out);
+	 *
+	 * \brief	Read whole file in one request and strip it
+	 *
+	 * \param 		  	File	The file.
+	 * \param 		  	S   	What is comment.
+	 * \param [in,out]	Out 	The text.
+	 *
+	 * \returns	True if it succeeds, false if it fails.
+	 */
+
+	static bool Load(std::string File, const Syntax &S, std::string &Out);
+	static std::string_view Load(const char *Data, size_t Size, const Syntax &S, Arena &Into);
+};
+#endif // !__TEXTLOADER_H__
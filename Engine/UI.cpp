@@ -8,6 +8,7 @@ extern shared_ptr<Engine> Application;
 #include "UI.h"
 #include "Console.h"
 #include "File_system.h"
+#include "MappedFile.h"
 
 #include "examples/imgui_impl_win32.h"
 #include "examples/imgui_impl_dx11.h"
@@ -82,28 +83,24 @@ void UI::Destroy()
 
 HRESULT UI::LoadFileUI(string File)
 {
+	FileUI = File;
 	doc = make_shared<tinyxml2::XMLDocument>();
 
-	doc->LoadFile(File.c_str());
-	if (doc->ErrorID() != XML_SUCCESS)
+	MappedFile Mapped(File, MappedFile::Sequential);
+	if (!Mapped.IsOpen())
 	{
-		Engine::LogError((boost::format("UI::LoatXmlUI() ErrorID > 0!\nReturn Error ID: %s") %
-			to_string(doc->ErrorID())).str(),
+		Engine::LogError("UI::LoadFileUI() Failed!",
 			string(__FILE__) + ": " + to_string(__LINE__),
-			(boost::format("UI: Something is wrong with load XML File!\nReturn Error Text: %s"\
-				"\nErrorID(see tinyXml doc): %s") % doc->ErrorStr() % to_string(doc->ErrorID())).str());
-#if defined (_DEBUG)
-		Engine::StackTrace(doc->ErrorStr());
-#endif
+			"UI: Cannot Open XML File " + File);
 		return E_FAIL;
 	}
-	if (doc->Parse(Application->getFS()->getDataFromFile(File).c_str()) > 0)
+	if (doc->Parse(reinterpret_cast<const char *>(Mapped.data()), Mapped.size()) != XML_SUCCESS)
 	{
-		Engine::LogError((boost::format("UI::LoatXmlUI() Parse File ErrorID > 0!\nReturn Error ID: %s")
-			% to_string(doc->ErrorID())).str(),
+		Engine::LogError((boost::format("UI::LoatXmlUI() ErrorID > 0!\nReturn Error ID: %s") %
+			to_string(doc->ErrorID())).str(),
 			string(__FILE__) + ": " + to_string(__LINE__),
-			(boost::format("UI: Something is wrong with Parse XML File!\nReturn Error Text: %s"
-				"\nErrorID (see tinyXml doc): %s") % doc->ErrorStr() % to_string(doc->ErrorID())).str());
+			(boost::format("UI: Something is wrong with load XML File!\nReturn Error Text: %s"\
+				"\nErrorID(see tinyXml doc): %s") % doc->ErrorStr() % to_string(doc->ErrorID())).str());
 #if defined (_DEBUG)
 		Engine::StackTrace(doc->ErrorStr());
 #endif
@@ -2110,17 +2107,19 @@ void UI::ReloadXML(string File)
 
 void UI::DisableDialog(string IDDialog)
 {
-	for (size_t i = 0; i < Dialogs.size(); i++)
+	StringID Key = StringID::Find(IDDialog);
+	for (size_t i = 0; i < Dialogs.size() && !Key.IsEmpty(); i++)
 	{
-		if (Dialogs.at(i)->GetTitle()== IDDialog)
+		if (Dialogs.at(i)->GetTitleKey() == Key)
 			Dialogs.at(i)->setVisible(false);
 	}
 }
 void UI::EnableDialog(string IDDialog)
 {
-	for (size_t i = 0; i < Dialogs.size(); i++)
+	StringID Key = StringID::Find(IDDialog);
+	for (size_t i = 0; i < Dialogs.size() && !Key.IsEmpty(); i++)
 	{
-		if (Dialogs.at(i)->GetTitle() == IDDialog)
+		if (Dialogs.at(i)->GetTitleKey() == Key)
 			Dialogs.at(i)->setVisible(true);
 	}
 }
@@ -2130,9 +2129,11 @@ shared_ptr<dialogs> UI::getDialog(string IDDialog)
 	if (Dialogs.empty() || IDDialog.empty())
 		return make_shared<dialogs>();
 
-	for (size_t i = 0; i < Dialogs.size(); i++)
+	// Titles Were Interned When They Were Set: If There's No Such String, There's No Such Dialog
+	StringID Key = StringID::Find(IDDialog);
+	for (size_t i = 0; i < Dialogs.size() && !Key.IsEmpty(); i++)
 	{
-		if (Dialogs.at(i)->GetTitle() == IDDialog)
+		if (Dialogs.at(i)->GetTitleKey() == Key)
 			return Dialogs.at(i);
 	}
 
@@ -6,6 +6,7 @@
 #include "tinyxml2.h"
 #include "imgui.h"
 #include "Timer.h"
+#include "StringID.h"
 
 using namespace tinyxml2;
 
@@ -583,7 +584,7 @@ public:
 class dialogs
 {
 public:
-	void ChangeTitle(string Title) { IDTitle = Title; }
+	void ChangeTitle(string Title) { IDTitle = Title; TitleKey = StringID(Title); }
 	void ChangeOrder(int num) { OrderlyRender = num; }
 	void ChangeSize(float W, float H) { SizeW = W; SizeH = H; }
 	void ChangePosition(float X, float Y, ImVec2 _Pivot = { 0.f, 0.f })
@@ -597,6 +598,8 @@ public:
 	void setVisible(bool Visible) { IsVisible = Visible; }
 
 	string GetTitle() { return IDTitle; }
+	// Interned Lower Case Title To Find The Dialog
+	StringID GetTitleKey() const { return TitleKey; }
 
 	bool getVisible() { return IsVisible; }
 	bool getIsFullScreen() { return IsFullScreen; }
@@ -615,10 +618,10 @@ public:
 	auto GetCurrentWindow() { return ImGui::GetCurrentWindow(); }
 
 	dialogs() {}
-	dialogs(string IDTitle): IDTitle(IDTitle) {}
+	dialogs(string IDTitle): IDTitle(IDTitle), TitleKey(IDTitle) {}
 	dialogs(string IDTitle, bool IsVisible, bool ShowTitle, bool IsMoveble, bool IsKeyboardSupport, bool IsResizeble,
 		bool IsCollapsible, bool IsNeedBringToFont, bool IsFullScreen, float SizeW = 0.f, float SizeH = 0.f):
-		IDTitle(IDTitle), IsVisible(IsVisible), IsKeyboardSupport(IsKeyboardSupport), IsMoveble(IsMoveble),
+		IDTitle(IDTitle), TitleKey(IDTitle), IsVisible(IsVisible), IsKeyboardSupport(IsKeyboardSupport), IsMoveble(IsMoveble),
 		IsResizeble(IsResizeble), IsCollapsible(IsCollapsible), ShowTitle(ShowTitle), IsNeedBringToFont(IsNeedBringToFont),
 		IsFullScreen(IsFullScreen), SizeW(SizeW), SizeH(SizeH)
 	{
@@ -628,6 +631,7 @@ public:
 	void Render();
 private:
 	string IDTitle;
+	StringID TitleKey;
 	bool IsKeyboardSupport = false,
 		ShowTitle = false,
 		IsMoveble = false,
@@ -668,6 +672,8 @@ public:
 	void ProcessXML();
 
 	void ReloadXML(string File);
+	// Full Path Of The Last Loaded XML File
+	string getFileUI() { return FileUI; }
 
 	void DisableDialog(string IDDialog);
 	void EnableDialog(string IDDialog);
@@ -726,6 +732,7 @@ protected:
 
 	// **********
 	shared_ptr<tinyxml2::XMLDocument> doc;
+	string FileUI;
 
 	vector<shared_ptr<XMLDial>> XMLDialogs;
 
@@ -0,0 +1,45 @@
+#include "UploadQueue.h"
+
+using namespace std;
+
+void UploadQueue::Add(shared_ptr<void> Item, size_t Size)
+{
+	if (!Item)
+		return;
+
+	Items.push_back({ move(Item), Size });
+	Bytes += Size;
+}
+
+UploadQueue::Stats UploadQueue::Update(Backend &Device, size_t Budget)
+{
+	Stats Result;
+	while (!Items.empty())
+	{
+		// The Next One Waits If It Doesn't Fit (Smaller Ones Behind It Don't Overtake It)
+		auto &It = Items.front();
+		if (Budget && (Result.Uploads + Result.Failed) > 0 && Result.Bytes + It.Bytes > Budget)
+			break;
+
+		// The Item Is Taken Out First: Upload Can Add New Ones
+		auto Next = move(It);
+		Items.pop_front();
+		Bytes -= Next.Bytes;
+
+		if (Device.Upload(Next.Item.get()))
+			Result.Uploads++;
+		else
+			Result.Failed++;
+		Result.Bytes += Next.Bytes;
+	}
+
+	Result.Left = Items.size();
+	Result.LeftBytes = Bytes;
+	return Result;
+}
+
+void UploadQueue::Clear()
+{
+	Items.clear();
+	Bytes = 0;
+}
@@ -0,0 +1,75 @@
+/**
+ * \file	UploadQueue.h.
+ *
+ * \brief	Declares the upload queue (Decoded Assets Are Given To The Device Within a Budget Of Frames)
+ */
+
+#pragma once
+#if !defined(__UPLOADQUEUE_H__)
+#define __UPLOADQUEUE_H__
+
+#include <deque>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * \class	UploadQueue
+ *
+ * \brief	Decoded assets (e.g. Pixels Of Textures) wait here until the frame thread uploads
+ * 			them. Every Update uploads them in the order they were added until the budget of
+ * 			bytes is spent, so loading the level is spread over frames instead of stalling one.
+ * 			The first asset of the frame is always uploaded, even if it's bigger than the budget.
+ * 			Device calls go through Backend, so tests record them instead of uploading.
+ * 			Used by the engine and by tests, so it doesn't need pch.h.
+ */
+
+class UploadQueue
+{
+public:
+	// Calls Which Upload Assets: Direct3D 11 In The Engine, Recorded By Tests
+	class Backend
+	{
+	public:
+		virtual ~Backend() {}
+		// False If The Device Couldn't Make It (It's Dropped Anyway)
+		virtual bool Upload(void *Item) = 0;
+	};
+	struct Stats
+	{
+		size_t Uploads = 0, Failed = 0, Bytes = 0;
+		// Still Waiting For Next Frames
+		size_t Left = 0, LeftBytes = 0;
+	};
+
+	// The Queue Keeps Item Until It's Uploaded, Size Is What It Costs The Budget (Bytes)
+	void Add(std::shared_ptr<void> Item, size_t Size);
+
+	/**
+	 * \fn	Stats UploadQueue::Update(Backend &Device, size_t Budget);
+	 *
+	 * \brief	Upload assets of this frame
+	 *
+	 * \param 	Device	Makes device objects.
+	 * \param 	Budget	Bytes of the frame (0: Everything Is Uploaded).
+	 *
+	 * \returns	What was uploaded and what is left.
+	 */
+
+	Stats Update(Backend &Device, size_t Budget);
+	void Clear();
+
+	size_t size() const { return Items.size(); }
+	size_t getBytes() const { return Bytes; }
+
+private:
+	struct Pending
+	{
+		std::shared_ptr<void> Item;
+		size_t Bytes = 0;
+	};
+
+	std::deque<Pending> Items;
+	size_t Bytes = 0;
+};
+#endif // !__UPLOADQUEUE_H__
@@ -0,0 +1,335 @@
+#include "pch.h"
+
+class Engine;
+extern shared_ptr<Engine> Application;
+#include "Engine.h"
+#include "VFS.h"
+
+#include <Boost/filesystem.hpp>
+
+string VFS::Normalize(string Path)
+{
+	replace(Path.begin(), Path.end(), '\\', '/');
+	while (!Path.empty() && Path.front() == '/')
+		Path.erase(0, 1);
+	return Path;
+}
+
+uint32_t VFS::Attach(shared_ptr<Mount> New)
+{
+	unique_lock<shared_mutex> Write(Lock);
+	New->Info.ID = ++Counter;
+	Mounts.push_back(New);
+
+	// Higher Priority First, The Last Mounted First If Priority Is The Same
+	stable_sort(Mounts.begin(), Mounts.end(), [](const shared_ptr<Mount> &A, const shared_ptr<Mount> &B)
+	{
+		if (A->Info.Priority != B->Info.Priority)
+			return A->Info.Priority > B->Info.Priority;
+		return A->Info.ID > B->Info.ID;
+	});
+	Cache.clear();
+
+	return New->Info.ID;
+}
+
+VFS::Mount *VFS::Get(uint32_t ID)
+{
+	for (auto &It: Mounts)
+		if (It->Info.ID == ID)
+			return It.get();
+	return nullptr;
+}
+
+uint32_t VFS::MountDirectory(string Name, string Folder, int Priority)
+{
+	Folder = boost::filesystem::path(Folder).generic_string();
+	if (Folder.empty())
+		return 0;
+	if (Folder.back() != '/')
+		Folder += "/";
+
+	auto New = make_shared<Mount>();
+	New->Info.Name = Name;
+	New->Info.Root = Folder;
+	New->Info.Type = Directory;
+	New->Info.Priority = Priority;
+	return Attach(New);
+}
+
+uint32_t VFS::MountArchive(string Name, shared_ptr<Pak> Pack, int Priority)
+{
+	if (!Pack || !Pack->IsOpen())
+		return 0;
+
+	auto New = make_shared<Mount>();
+	New->Info.Name = Name;
+	New->Info.Type = Archive;
+	New->Info.Priority = Priority;
+	New->Pack = Pack;
+	for (auto It: Pack->GetEntries())
+	{
+		Entry File;
+		File.Path = Pack->GetName(It);
+		File.Size = It->Size;
+		File.Packed = It;
+		New->Files.emplace(StringID::Path(File.Path), File);
+	}
+	New->Info.Files = New->Files.size();
+
+	return Attach(New);
+}
+
+uint32_t VFS::MountMemory(string Name, int Priority)
+{
+	auto New = make_shared<Mount>();
+	New->Info.Name = Name;
+	New->Info.Type = Memory;
+	New->Info.Priority = Priority;
+	return Attach(New);
+}
+
+bool VFS::Unmount(uint32_t ID)
+{
+	unique_lock<shared_mutex> Write(Lock);
+	auto It = find_if(Mounts.begin(), Mounts.end(), [ID](const shared_ptr<Mount> &M) { return M->Info.ID == ID; });
+	if (It == Mounts.end())
+		return false;
+
+	Mounts.erase(It);
+	Cache.clear();
+	return true;
+}
+
+void VFS::Clear()
+{
+	unique_lock<shared_mutex> Write(Lock);
+	Mounts.clear();
+	Cache.clear();
+}
+
+size_t VFS::Scan(uint32_t ID)
+{
+	string Root;
+	{
+		shared_lock<shared_mutex> Read(Lock);
+		auto M = Get(ID);
+		if (!M || M->Info.Type != Directory)
+			return 0;
+		Root = M->Info.Root;
+	}
+
+	// The Folder Is Walked Without Lock
+	vector<Entry> Found;
+	boost::system::error_code EC;
+	for (boost::filesystem::recursive_directory_iterator It(Root, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (!boost::filesystem::is_regular_file(It->status()))
+			continue;
+
+		Entry File;
+		File.Path = It->path().generic_string().substr(Root.size());
+		boost::system::error_code SizeEC;
+		File.Size = boost::filesystem::file_size(It->path(), SizeEC);
+		Found.push_back(File);
+	}
+
+	unique_lock<shared_mutex> Write(Lock);
+	auto M = Get(ID);
+	if (!M)
+		return 0;
+
+	for (auto &File: Found)
+	{
+		StringID Key = StringID::Path(File.Path);
+		M->Files[Key] = File;
+		Invalidate(Key);
+	}
+	M->Info.Files = M->Files.size();
+
+	return Found.size();
+}
+
+bool VFS::Add(uint32_t ID, Entry File)
+{
+	File.Path = Normalize(File.Path);
+	if (File.Path.empty())
+		return false;
+
+	StringID Key = StringID::Path(File.Path);
+
+	unique_lock<shared_mutex> Write(Lock);
+	auto M = Get(ID);
+	if (!M)
+		return false;
+
+	M->Files[Key] = File;
+	M->Info.Files = M->Files.size();
+	Invalidate(Key);
+	return true;
+}
+
+bool VFS::Remove(uint32_t ID, string Path)
+{
+	StringID Key = StringID::Find(Normalize(Path));
+	if (Key.IsEmpty())
+		return false;
+
+	unique_lock<shared_mutex> Write(Lock);
+	auto M = Get(ID);
+	if (!M || M->Files.erase(Key) == 0)
+		return false;
+
+	M->Info.Files = M->Files.size();
+	Invalidate(Key);
+	return true;
+}
+
+bool VFS::AddMemoryFile(uint32_t ID, string Path, vector<uint8_t> Data)
+{
+	{
+		shared_lock<shared_mutex> Read(Lock);
+		auto M = Get(ID);
+		if (!M || M->Info.Type != Memory)
+			return false;
+	}
+
+	Entry File;
+	File.Path = Path;
+	File.Size = Data.size();
+	File.Data = make_shared<const vector<uint8_t>>(move(Data));
+	return Add(ID, File);
+}
+
+void VFS::Invalidate(StringID Key)
+{
+	Cache.erase(Key);
+}
+
+VFS::Source VFS::Make(const Mount &From, const Entry &File)
+{
+	Source Result;
+	Result.Mount = From.Info.ID;
+	Result.Type = From.Info.Type;
+	Result.File = File;
+	Result.Archive = From.Pack;
+	if (From.Info.Type == Directory)
+		Result.Real = From.Info.Root + File.Path;
+	return Result;
+}
+
+VFS::Source VFS::Resolve(string Path)
+{
+	// Nothing Is Interned For A Path Which No Mount Has
+	return Resolve(StringID::Find(Normalize(Path)));
+}
+
+VFS::Source VFS::Resolve(StringID Key)
+{
+	if (Key.IsEmpty())
+		return Source();
+
+	{
+		shared_lock<shared_mutex> Read(Lock);
+		auto It = Cache.find(Key);
+		if (It != Cache.end())
+		{
+			Hits++;
+			if (It->second < 0)
+				return Source();
+
+			auto &M = *Mounts.at(It->second);
+			return Make(M, M.Files.at(Key));
+		}
+	}
+
+	Misses++;
+	unique_lock<shared_mutex> Write(Lock);
+	for (size_t i = 0; i < Mounts.size(); i++)
+	{
+		auto File = Mounts.at(i)->Files.find(Key);
+		if (File != Mounts.at(i)->Files.end())
+		{
+			Cache[Key] = (int)i;
+			return Make(*Mounts.at(i), File->second);
+		}
+	}
+
+	Cache[Key] = -1;
+	return Source();
+}
+
+uint32_t VFS::Locate(string Full, string &Relative)
+{
+	Full = boost::filesystem::path(Full).generic_string();
+	string Lower = Full;
+	to_lower(Lower);
+
+	shared_lock<shared_mutex> Read(Lock);
+	for (auto &M: Mounts)
+	{
+		if (M->Info.Type != Directory || Lower.size() <= M->Info.Root.size())
+			continue;
+
+		string Root = M->Info.Root;
+		to_lower(Root);
+		if (Lower.compare(0, Root.size(), Root) == 0)
+		{
+			Relative = Full.substr(Root.size());
+			return M->Info.ID;
+		}
+	}
+
+	return 0;
+}
+
+vector<StringID> VFS::GetAll(uint32_t ID)
+{
+	shared_lock<shared_mutex> Read(Lock);
+
+	size_t Count = 0;
+	for (auto &M: Mounts)
+		Count += M->Files.size();
+
+	vector<StringID> Result;
+	Result.reserve(Count);
+	for (auto &M: Mounts)
+	{
+		if (ID != 0 && M->Info.ID != ID)
+			continue;
+		for (auto &It: M->Files)
+			Result.push_back(It.first);
+	}
+
+	// The Same File In Several Mounts Is Returned Once
+	sort(Result.begin(), Result.end());
+	Result.erase(unique(Result.begin(), Result.end()), Result.end());
+	return Result;
+}
+
+vector<VFS::MountInfo> VFS::GetMounts()
+{
+	shared_lock<shared_mutex> Read(Lock);
+
+	vector<MountInfo> Result;
+	for (auto &M: Mounts)
+		Result.push_back(M->Info);
+	return Result;
+}
+
+vector<VFS::Shadow> VFS::GetShadows()
+{
+	shared_lock<shared_mutex> Read(Lock);
+
+	vector<Shadow> Result;
+	for (size_t i = 1; i < Mounts.size(); i++)
+		for (auto &It: Mounts.at(i)->Files)
+			for (size_t j = 0; j < i; j++)
+				if (Mounts.at(j)->Files.count(It.first))
+				{
+					Result.push_back({ It.second.Path, Mounts.at(j)->Info.Name, Mounts.at(i)->Info.Name });
+					break;
+				}
+
+	return Result;
+}
@@ -0,0 +1,186 @@
+/**
+ * \file	VFS.h.
+ *
+ * \brief	Declares the virtual file system (Ordered Mounts Under The Resource Catalog)
+ */
+
+#pragma once
+#if !defined(__VFS_H__)
+#define __VFS_H__
+#include "pch.h"
+
+#include <unordered_map>
+#include <shared_mutex>
+#include <atomic>
+#include "Pak.h"
+#include "StringID.h"
+
+/**
+ * \class	VFS
+ *
+ * \brief	Relative resource paths (e.g. "models/box/box.obj") are mapped to the mount which
+ * 			has the file and has the highest priority: a patch or a mod folder is mounted over
+ * 			the resource folder and the archive, so nothing has to be copied or scanned again.
+ * 			Mounts with the same priority: the last mounted wins.
+ * 			Results are cached by interned path until mounts or their files are changed.
+ * 			Resolve can be called from any thread.
+ */
+
+class VFS
+{
+public:
+	enum Kind { Directory = 0, Archive, Memory };
+
+	/**
+	 * \struct	Entry
+	 *
+	 * \brief	File which the mount has
+	 */
+
+	struct Entry
+	{
+		// Relative Path As It Is In The Mount
+		string Path;
+		uint64_t Size = 0;
+		// _TypeOfFile (0 If It Wasn't Known When The File Was Listed)
+		int Type = 0;
+		bool HasTextures = false;
+
+		// Archive: Entry Of The Pak
+		const Pak::Entry *Packed = nullptr;
+		// Memory: Content
+		shared_ptr<const vector<uint8_t>> Data;
+	};
+
+	/**
+	 * \struct	Source
+	 *
+	 * \brief	Where the file is really taken from
+	 */
+
+	struct Source
+	{
+		// 0: There's No Such File
+		uint32_t Mount = 0;
+		Kind Type = Directory;
+		// Full Path On Disk (Directory)
+		string Real;
+		Entry File;
+		shared_ptr<Pak> Archive;
+
+		bool IsFound() const { return Mount != 0; }
+	};
+
+	struct MountInfo
+	{
+		uint32_t ID = 0;
+		string Name, Root;
+		Kind Type = Directory;
+		int Priority = 0;
+		size_t Files = 0;
+	};
+
+	/**
+	 * \struct	Shadow
+	 *
+	 * \brief	The file is in several mounts, only Winner is used
+	 */
+
+	struct Shadow
+	{
+		string Path, Winner, Hidden;
+	};
+
+	/**
+	 * \fn	uint32_t VFS::MountDirectory(string Name, string Folder, int Priority);
+	 *
+	 * \brief	Mount folder (Its Files Are Added By Add Or Scan)
+	 *
+	 * \param 	Name		Name for diagnostics.
+	 * \param 	Folder  	Full path to the folder.
+	 * \param 	Priority	Higher priority wins.
+	 *
+	 * \returns	ID of the mount (0 If It Failed).
+	 */
+
+	uint32_t MountDirectory(string Name, string Folder, int Priority);
+	uint32_t MountArchive(string Name, shared_ptr<Pak> Pack, int Priority);
+	uint32_t MountMemory(string Name, int Priority);
+	bool Unmount(uint32_t ID);
+	void Clear();
+
+	/**
+	 * \fn	size_t VFS::Scan(uint32_t ID);
+	 *
+	 * \brief	Walk the folder of the directory mount and list every file of it
+	 *
+	 * \param 	ID	The mount.
+	 *
+	 * \returns	Count of files.
+	 */
+
+	size_t Scan(uint32_t ID);
+
+	bool Add(uint32_t ID, Entry File);
+	bool Remove(uint32_t ID, string Path);
+	bool AddMemoryFile(uint32_t ID, string Path, vector<uint8_t> Data);
+
+	/**
+	 * \fn	Source VFS::Resolve(string Path);
+	 *
+	 * \brief	Find the mount which gives this file
+	 *
+	 * \param 	Path	Relative path (Case-Insensitive, '\' Is The Same As '/').
+	 *
+	 * \returns	The source (Not Found If No Mount Has It).
+	 */
+
+	Source Resolve(string Path);
+	Source Resolve(StringID Key);
+
+	/**
+	 * \fn	uint32_t VFS::Locate(string Full, string &Relative);
+	 *
+	 * \brief	Which directory mount has this full path on disk
+	 *
+	 * \param 		  	Full		Full path.
+	 * \param [in,out]	Relative	Path relative to the mount.
+	 *
+	 * \returns	ID of the mount (0 If It's Outside Of Every Mounted Folder).
+	 */
+
+	uint32_t Locate(string Full, string &Relative);
+
+	// Interned Relative Paths Of Every File Of Every Mount (Or Of One Mount)
+	vector<StringID> GetAll(uint32_t ID = 0);
+	vector<MountInfo> GetMounts();
+	vector<Shadow> GetShadows();
+
+	size_t getHits() const { return Hits.load(); }
+	size_t getMisses() const { return Misses.load(); }
+private:
+	struct Mount
+	{
+		MountInfo Info;
+		shared_ptr<Pak> Pack;
+		unordered_map<StringID, Entry> Files;
+	};
+
+	uint32_t Attach(shared_ptr<Mount> New);
+	Mount *Get(uint32_t ID);
+	Source Make(const Mount &From, const Entry &File);
+	// Under Lock: Forget Cached Result Of The Path
+	void Invalidate(StringID Key);
+
+	static string Normalize(string Path);
+
+	// Sorted: The First Wins
+	vector<shared_ptr<Mount>> Mounts;
+	// Path -> Index In Mounts (-1 If There's No Such File)
+	unordered_map<StringID, int> Cache;
+	shared_mutex Lock;
+	uint32_t Counter = 0;
+
+	atomic<size_t> Hits{ 0 }, Misses{ 0 };
+};
+#endif // !__VFS_H__
@@ -0,0 +1,37 @@
+/**
+ * \file	Check.h.
+ *
+ * \brief	Checks of tests of engine modules (Every Test Is a Console Program)
+ */
+
+#pragma once
+#if !defined(__CHECK_H__)
+#define __CHECK_H__
+
+#include <iostream>
+#include <string>
+
+// Checks Which Failed In This Program
+inline int &getFailed()
+{
+	static int Count = 0;
+	return Count;
+}
+
+// Failed Check Is Printed And Counted, The Test Goes On
+inline void Check(bool Condition, const std::string &What)
+{
+	if (!Condition)
+	{
+		std::cout << "FAILED: " << What << "\n";
+		getFailed()++;
+	}
+}
+
+// The Last Line Of The Test: Its Result Is The Exit Code Of main
+inline int Report()
+{
+	std::cout << (getFailed() ? "Some Tests Failed\n" : "All Tests Passed\n");
+	return getFailed() ? 1 : 0;
+}
+#endif // !__CHECK_H__
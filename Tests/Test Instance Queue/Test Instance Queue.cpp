@@ -0,0 +1,130 @@
+// Tests Of InstanceQueue (Engine/InstanceQueue.h) Against a Backend Which Records Calls: Groups By Mesh And
+// Level, Matrices In The Buffer, Buffer Which Is Smaller Than The Frame
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../../Engine/InstanceQueue.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+// Keeps Every Write And Draw, Draws Read Matrices Of The Last Write (As The Device Does)
+class Recorder: public InstanceQueue::Backend
+{
+public:
+	struct DrawCall
+	{
+		const void *Mesh;
+		size_t Level;
+		// Instances Which The Draw Reads (The First Float Of Each Matrix)
+		vector<float> Ids;
+	};
+
+	size_t Capacity = 1024;
+	vector<float> Buffer;
+	vector<DrawCall> Draws;
+	size_t Writes = 0;
+	bool Valid = true;
+
+	size_t getCapacity() override { return Capacity; }
+	void Write(const float *Worlds, size_t Count) override
+	{
+		Valid = Valid && Count <= Capacity;
+		Buffer.assign(Worlds, Worlds + Count * 16);
+		Writes++;
+	}
+	void Draw(const void *Mesh, size_t Level, size_t First, size_t Count) override
+	{
+		Valid = Valid && Count > 0 && (First + Count) * 16 <= Buffer.size();
+		DrawCall New = { Mesh, Level, {} };
+		for (size_t i = First; i < First + Count && (i + 1) * 16 <= Buffer.size(); i++)
+			New.Ids.push_back(Buffer[i * 16]);
+		Draws.push_back(New);
+	}
+};
+
+// Matrix Whose First Float Names The Instance
+static vector<float> World(float Id)
+{
+	vector<float> Result(16, 0.f);
+	Result[0] = Id;
+	Result[5] = Result[10] = Result[15] = 1.f;
+	return Result;
+}
+
+int main()
+{
+	int MeshA = 0, MeshB = 0, MeshC = 0;
+
+	// 300 Copies Of Two Meshes, One Of Them With Two Levels, And One Single Mesh
+	{
+		InstanceQueue Queue;
+		float Id = 0.f;
+		for (int i = 0; i < 300; i++)
+		{
+			Queue.Add(&MeshA, i % 2, World(Id++).data());
+			Queue.Add(&MeshB, 0, World(Id++).data());
+		}
+		Queue.Add(&MeshC, 3, World(Id++).data());
+		Queue.Add(nullptr, 0, World(Id).data());
+		Check(Queue.size() == 601, "Queue: Every Copy Is Added");
+
+		Recorder Device;
+		auto Stats = Queue.Flush(Device);
+		cout << "Draw Calls: " << Stats.Instances << " -> " << Stats.Draws << " (Writes: " << Stats.Writes << ")\n";
+		Check(Stats.Instances == 601 && Stats.Groups == 4 && Stats.Draws == 4 && Stats.Writes == 1, "Stats");
+		Check(Device.Valid, "Calls Are Valid");
+		Check(Device.Writes == 1 && Device.Draws.size() == 4, "One Write, Draw Per Group");
+
+		// Groups In The Order Of The First Copy, Copies In The Order Of Adding
+		bool Order = Device.Draws.size() == 4 && Device.Draws[0].Mesh == &MeshA && Device.Draws[0].Level == 0 &&
+			Device.Draws[1].Mesh == &MeshB && Device.Draws[2].Mesh == &MeshA && Device.Draws[2].Level == 1 &&
+			Device.Draws[3].Mesh == &MeshC && Device.Draws[3].Level == 3;
+		Check(Order, "Groups By Mesh And Level");
+		if (Order)
+		{
+			bool Copies = Device.Draws[0].Ids.size() == 150 && Device.Draws[1].Ids.size() == 300 &&
+				Device.Draws[2].Ids.size() == 150 && Device.Draws[3].Ids == vector<float>{ 600.f };
+			for (size_t i = 0; Copies && i < 150; i++)
+				Copies = Device.Draws[0].Ids[i] == i * 4.f && Device.Draws[2].Ids[i] == i * 4.f + 2.f;
+			for (size_t i = 0; Copies && i < 300; i++)
+				Copies = Device.Draws[1].Ids[i] == i * 2.f + 1.f;
+			Check(Copies, "Matrices Of Every Copy");
+		}
+
+		Check(Queue.size() == 0, "Flush Forgets Copies");
+		Recorder Empty;
+		auto None = Queue.Flush(Empty);
+		Check(None.Draws == 0 && Empty.Writes == 0 && Empty.Draws.empty(), "Empty Frame Calls Nothing");
+	}
+
+	// Buffer For 64 Copies: Groups Go On From The Start Of The Next Write
+	{
+		InstanceQueue Queue;
+		for (int i = 0; i < 100; i++)
+			Queue.Add(&MeshA, 0, World(float(i)).data());
+		for (int i = 0; i < 40; i++)
+			Queue.Add(&MeshB, 0, World(float(100 + i)).data());
+
+		Recorder Device;
+		Device.Capacity = 64;
+		auto Stats = Queue.Flush(Device);
+		Check(Device.Valid, "Small Buffer: Calls Are Valid");
+		Check(Stats.Writes == 3 && Device.Writes == 3, "Small Buffer: Three Writes");
+
+		vector<float> A, B;
+		for (auto &It: Device.Draws)
+			(It.Mesh == &MeshA ? A : B).insert((It.Mesh == &MeshA ? A : B).end(), It.Ids.begin(), It.Ids.end());
+		bool Copies = A.size() == 100 && B.size() == 40;
+		for (size_t i = 0; Copies && i < A.size(); i++)
+			Copies = A[i] == float(i);
+		for (size_t i = 0; Copies && i < B.size(); i++)
+			Copies = B[i] == float(100 + i);
+		Check(Copies, "Small Buffer: Every Copy Is Drawn Once");
+		Check(Stats.Draws == Device.Draws.size() && Stats.Draws == 4, "Small Buffer: Groups Are Split Where The Buffer Ends");
+	}
+
+	return Report();
+}
@@ -0,0 +1,259 @@
+// Tests Of MeshOptimizer (Engine/MeshOptimizer.h): The Same Triangles After Every Pass,
+// Better ACMR/ATVR For Shuffled Grid And Sphere, Vertices In The Order Of The First Use,
+// Far Sides Of a Box Drawn First
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <array>
+#include <string>
+
+#include "../../Engine/MeshOptimizer.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+struct Vertex
+{
+	float Pos[3];
+	float Tex[2];
+};
+
+// Quads Of N x N Grid In Random Order
+static void MakeGrid(size_t N, vector<Vertex> &Vertices, vector<uint32_t> &Indices)
+{
+	Vertices.clear();
+	Indices.clear();
+	for (size_t y = 0; y <= N; y++)
+		for (size_t x = 0; x <= N; x++)
+			Vertices.push_back({ { float(x), float(y), 0.f }, { float(x) / N, float(y) / N } });
+
+	vector<array<uint32_t, 3>> Triangles;
+	for (size_t y = 0; y < N; y++)
+		for (size_t x = 0; x < N; x++)
+		{
+			uint32_t A = uint32_t(y * (N + 1) + x), B = A + 1, C = A + uint32_t(N + 1), D = C + 1;
+			Triangles.push_back({ A, C, B });
+			Triangles.push_back({ B, C, D });
+		}
+
+	shuffle(Triangles.begin(), Triangles.end(), mt19937(42));
+	for (auto &It: Triangles)
+		Indices.insert(Indices.end(), It.begin(), It.end());
+}
+
+// UV Sphere (Its Vertices Are Shuffled Too)
+static void MakeSphere(size_t Rings, size_t Segments, vector<Vertex> &Vertices, vector<uint32_t> &Indices)
+{
+	Vertices.clear();
+	Indices.clear();
+	for (size_t r = 0; r <= Rings; r++)
+		for (size_t s = 0; s <= Segments; s++)
+		{
+			float Theta = 3.14159265f * r / Rings, Phi = 2.f * 3.14159265f * s / Segments;
+			Vertices.push_back({ { sin(Theta) * cos(Phi), cos(Theta), sin(Theta) * sin(Phi) },
+				{ float(s) / Segments, float(r) / Rings } });
+		}
+
+	vector<uint32_t> Order(Vertices.size());
+	for (size_t i = 0; i < Order.size(); i++)
+		Order[i] = uint32_t(i);
+	shuffle(Order.begin(), Order.end(), mt19937(7));
+	vector<Vertex> Shuffled(Vertices.size());
+	for (size_t i = 0; i < Order.size(); i++)
+		Shuffled[Order[i]] = Vertices[i];
+	Vertices.swap(Shuffled);
+
+	for (size_t r = 0; r < Rings; r++)
+		for (size_t s = 0; s < Segments; s++)
+		{
+			uint32_t A = uint32_t(r * (Segments + 1) + s), B = A + 1, C = A + uint32_t(Segments + 1), D = C + 1;
+			Indices.insert(Indices.end(), { Order[A], Order[B], Order[C], Order[B], Order[D], Order[C] });
+		}
+}
+
+// Distance From The Centre (At 0) To The Plane Of The Triangle Along Its Normal
+static float PlaneDistance(const vector<Vertex> &Vertices, const uint32_t *Tri)
+{
+	const float *A = Vertices.at(Tri[0]).Pos, *B = Vertices.at(Tri[1]).Pos, *C = Vertices.at(Tri[2]).Pos;
+	float E1[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] }, E2[3] = { C[0] - A[0], C[1] - A[1], C[2] - A[2] };
+	float N[3] = { E1[1] * E2[2] - E1[2] * E2[1], E1[2] * E2[0] - E1[0] * E2[2], E1[0] * E2[1] - E1[1] * E2[0] };
+	float Length = sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]);
+	return (N[0] * A[0] + N[1] * A[1] + N[2] * A[2]) / Length;
+}
+
+// Box Of 1 x 2 x 4 Around 0: Every Side Is a Grid Of N x N Quads With Its Own Vertices (Flat Shading),
+// Sides Which Are Near The Centre Are Listed First
+static void MakeBox(size_t N, vector<Vertex> &Vertices, vector<uint32_t> &Indices)
+{
+	Vertices.clear();
+	Indices.clear();
+	const float Half[3] = { 0.5f, 1.f, 2.f };
+	for (int Axis = 0; Axis < 3; Axis++)
+		for (float Sign: { 1.f, -1.f })
+		{
+			// U x V Is The Outward Normal
+			int U = (Axis + 1) % 3, V = (Axis + 2) % 3;
+			if (Sign < 0.f)
+				swap(U, V);
+
+			uint32_t First = uint32_t(Vertices.size());
+			for (size_t y = 0; y <= N; y++)
+				for (size_t x = 0; x <= N; x++)
+				{
+					Vertex It = {};
+					It.Pos[Axis] = Sign * Half[Axis];
+					It.Pos[U] = (2.f * x / N - 1.f) * Half[U];
+					It.Pos[V] = (2.f * y / N - 1.f) * Half[V];
+					It.Tex[0] = float(x) / N;
+					It.Tex[1] = float(y) / N;
+					Vertices.push_back(It);
+				}
+
+			for (size_t y = 0; y < N; y++)
+				for (size_t x = 0; x < N; x++)
+				{
+					uint32_t A = First + uint32_t(y * (N + 1) + x), B = A + 1, C = A + uint32_t(N + 1), D = C + 1;
+					Indices.insert(Indices.end(), { A, B, C, B, D, C });
+				}
+		}
+}
+
+// Triangles By Positions And UVs Of Their Vertices (Rotated So The Smallest Is First, Winding Is Kept)
+static vector<array<float, 15>> Triangles(const vector<Vertex> &Vertices, const vector<uint32_t> &Indices)
+{
+	vector<array<float, 15>> Result;
+	for (size_t i = 0; i + 2 < Indices.size(); i += 3)
+	{
+		array<array<float, 5>, 3> Tri;
+		for (int k = 0; k < 3; k++)
+		{
+			auto &V = Vertices.at(Indices[i + k]);
+			Tri[k] = { V.Pos[0], V.Pos[1], V.Pos[2], V.Tex[0], V.Tex[1] };
+		}
+		rotate(Tri.begin(), min_element(Tri.begin(), Tri.end()), Tri.end());
+
+		array<float, 15> Flat;
+		for (int k = 0; k < 3; k++)
+			copy(Tri[k].begin(), Tri[k].end(), Flat.begin() + k * 5);
+		Result.push_back(Flat);
+	}
+	sort(Result.begin(), Result.end());
+	return Result;
+}
+
+static bool FirstUseOrder(const vector<uint32_t> &Indices)
+{
+	uint32_t Next = 0;
+	for (auto V: Indices)
+	{
+		if (V > Next)
+			return false;
+		if (V == Next)
+			Next++;
+	}
+	return true;
+}
+
+static void Print(const string &Name, const MeshOptimizer::Report &It, double Ms)
+{
+	cout << left << setw(20) << Name << right << fixed << setprecision(3)
+		<< "ACMR " << It.Before.ACMR() << " -> " << It.After.ACMR()
+		<< ", ATVR " << It.Before.ATVR() << " -> " << It.After.ATVR()
+		<< " (" << It.After.Triangles << " Triangles, " << setprecision(2) << Ms << " ms)\n";
+}
+
+static void TestMesh(const string &Name, vector<Vertex> Vertices, vector<uint32_t> Indices, bool Overdraw,
+	double MaxACMR)
+{
+	auto Before = Triangles(Vertices, Indices);
+
+	auto Start = chrono::steady_clock::now();
+	auto Report = MeshOptimizer::Optimize(Vertices, Indices, Overdraw);
+	double Ms = chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+	Print(Name, Report, Ms);
+
+	Check(Triangles(Vertices, Indices) == Before, Name + ": Triangles Are The Same");
+	Check(FirstUseOrder(Indices), Name + ": Vertices Are In The Order Of The First Use");
+	Check(Report.After.Misses < Report.Before.Misses, Name + ": Less Vertices Are Transformed");
+	Check(Report.After.ACMR() <= MaxACMR, Name + ": ACMR Is At Most " + to_string(MaxACMR));
+	Check(Report.After.ATVR() >= 1., Name + ": Every Vertex Is Transformed At Least Once");
+}
+
+int main()
+{
+	// Known Cases Of The Simulated Cache
+	{
+		auto One = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2 }, 3);
+		Check(One.Misses == 3 && One.ACMR() == 3. && One.ATVR() == 1., "One Triangle: 3 Misses");
+
+		auto Quad = MeshOptimizer::AnalyzeVertexCache({ 0, 1, 2, 2, 1, 3 }, 4);
+		Check(Quad.Misses == 4 && Quad.ACMR() == 2., "Quad: Shared Edge Hits The Cache");
+
+		// The First Vertex Is Pushed Out By 16 Others
+		vector<uint32_t> Fan;
+		for (uint32_t i = 1; i <= 17; i++)
+			Fan.insert(Fan.end(), { i, i, i });
+		Fan.insert(Fan.end(), { 1, 1, 1 });
+		Check(MeshOptimizer::AnalyzeVertexCache(Fan, 18).Misses == 18, "FIFO Of 16 Entries");
+	}
+
+	// Nothing To Do Or Broken Input Isn't Changed
+	{
+		vector<Vertex> Vertices(3);
+		vector<uint32_t> Empty, Broken = { 0, 1, 7 };
+		MeshOptimizer::Optimize(Vertices, Empty);
+		Check(Empty.empty() && Vertices.size() == 3, "Empty Mesh");
+
+		MeshOptimizer::OptimizeVertexCache(Broken, 3);
+		vector<uint32_t> Remap;
+		Check(MeshOptimizer::OptimizeVertexFetch(Broken, Remap, 3) == 3 && Broken == vector<uint32_t>({ 0, 1, 7 }),
+			"Index Out Of Range");
+	}
+
+	// Unused Vertices Are Dropped
+	{
+		vector<Vertex> Vertices = { { { 0, 0, 0 }, {} }, { { 9, 9, 9 }, {} }, { { 1, 0, 0 }, {} }, { { 0, 1, 0 }, {} } };
+		vector<uint32_t> Indices = { 3, 0, 2 };
+		MeshOptimizer::Optimize(Vertices, Indices);
+		Check(Vertices.size() == 3 && Indices == vector<uint32_t>({ 0, 1, 2 }), "Unused Vertex");
+	}
+
+	vector<Vertex> Vertices;
+	vector<uint32_t> Indices;
+	MakeGrid(100, Vertices, Indices);
+	TestMesh("Shuffled Grid", Vertices, Indices, false, 0.8);
+	TestMesh("Grid + Overdraw", Vertices, Indices, true, 0.8 * 1.05);
+
+	MakeSphere(64, 128, Vertices, Indices);
+	TestMesh("Sphere", Vertices, Indices, false, 0.8);
+	TestMesh("Sphere + Overdraw", Vertices, Indices, true, 0.8 * 1.05);
+
+	// Overdraw: Sides Of The Box Are Clusters, The Far Ones Go First, The Cache Stays Within The Threshold
+	{
+		MakeBox(16, Vertices, Indices);
+		MeshOptimizer::OptimizeVertexCache(Indices, Vertices.size());
+		auto Cached = Indices;
+		MeshOptimizer::Report Box;
+		Box.Before = MeshOptimizer::AnalyzeVertexCache(Indices, Vertices.size());
+
+		auto Start = chrono::steady_clock::now();
+		MeshOptimizer::OptimizeOverdraw(Indices, Vertices.front().Pos, sizeof(Vertex), Vertices.size(), 1.05f);
+		Box.After = MeshOptimizer::AnalyzeVertexCache(Indices, Vertices.size());
+		Print("Box + Overdraw", Box, chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count());
+		auto &Before = Box.Before, &After = Box.After;
+
+		Check(Indices != Cached, "Box: Order Of Clusters Is Changed");
+		Check(Triangles(Vertices, Indices) == Triangles(Vertices, Cached), "Box: Triangles Are The Same");
+		Check(After.ACMR() <= Before.ACMR() * 1.05, "Box: ACMR Is Within The Threshold");
+
+		bool FarFirst = PlaneDistance(Vertices, &Indices[0]) > 1.9f;
+		for (size_t i = 3; i < Indices.size(); i += 3)
+			FarFirst &= PlaneDistance(Vertices, &Indices[i]) <= PlaneDistance(Vertices, &Indices[i - 3]) + 1e-4f;
+		Check(FarFirst, "Box: Sides Are Drawn From The Farthest To The Nearest");
+	}
+
+	return Report();
+}
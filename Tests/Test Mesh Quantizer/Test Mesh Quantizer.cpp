@@ -0,0 +1,177 @@
+// Tests Of MeshQuantizer (Engine/MeshQuantizer.h): Half Floats, Precision Of Packed Vertices After The Round
+// Trip, Big Meshes Which Are Split Into Parts With 16-Bit Indices
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <cmath>
+#include <array>
+#include <string>
+#include <sstream>
+
+#include "../../Engine/MeshQuantizer.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+struct Vertex
+{
+	float Pos[3];
+	float Tex[2];
+};
+
+static void RoundTrip(const string &Name, const vector<Vertex> &Vertices)
+{
+	const float *Positions = Vertices.data()->Pos, *UVs = Vertices.data()->Tex;
+	auto Bounds = MeshQuantizer::getDecode(Positions, sizeof(Vertex), Vertices.size());
+	vector<MeshQuantizer::PackedVertex> Packed;
+	MeshQuantizer::Pack(Positions, UVs, sizeof(Vertex), Vertices.size(), Bounds, Packed);
+
+	// Half Of The Step Of 16-Bit Grid (And Rounding Of Floats), Half Of Ulp Of Half Float
+	double PosError = 0., TexError = 0., PosBound = 0.;
+	for (int k = 0; k < 3; k++)
+		PosBound = max(PosBound, Bounds.Scale[k] / 65535. * 0.5 * 1.001 + fabs(Bounds.Offset[k]) * 1e-6);
+	bool TexOk = true;
+	for (size_t i = 0; i < Vertices.size(); i++)
+	{
+		float Pos[3], Tex[2];
+		MeshQuantizer::Unpack(Packed[i], Bounds, Pos, Tex);
+		for (int k = 0; k < 3; k++)
+			PosError = max(PosError, (double)fabs(Pos[k] - Vertices[i].Pos[k]));
+		for (int k = 0; k < 2; k++)
+		{
+			double Error = fabs(Tex[k] - Vertices[i].Tex[k]);
+			TexError = max(TexError, Error);
+			TexOk = TexOk && Error <= max(fabs(Vertices[i].Tex[k]) * ldexp(1., -11), ldexp(1., -25));
+		}
+		Check(Packed[i].Pos[3] == 65535, Name + ": W Is 1");
+	}
+
+	cout << left << setw(20) << Name + ": " << right << "Position Error " << PosError << " (Bound " << PosBound
+		<< "), UV Error " << TexError << ", " << Vertices.size() * sizeof(Vertex) << " -> "
+		<< Packed.size() * sizeof(MeshQuantizer::PackedVertex) << " Bytes\n";
+	Check(PosError <= PosBound, Name + ": Position Is Within Half Of The Step");
+	Check(TexOk, Name + ": UV Is Within Half Of Ulp");
+}
+
+int main()
+{
+	static_assert(sizeof(MeshQuantizer::PackedVertex) == 12, "Packed Vertex Is 12 Bytes");
+
+	// Half Floats
+	{
+		Check(MeshQuantizer::ToHalf(0.f) == 0x0000 && MeshQuantizer::ToHalf(-0.f) == 0x8000, "Half: Zero");
+		Check(MeshQuantizer::ToHalf(1.f) == 0x3C00 && MeshQuantizer::ToHalf(-2.f) == 0xC000, "Half: 1 And -2");
+		Check(MeshQuantizer::ToHalf(65504.f) == 0x7BFF && MeshQuantizer::ToHalf(1e6f) == 0x7C00, "Half: Max And Overflow");
+		Check(MeshQuantizer::ToHalf(ldexp(1.f, -24)) == 0x0001 && MeshQuantizer::ToHalf(ldexp(1.f, -26)) == 0, "Half: Subnormal");
+		Check(MeshQuantizer::ToHalf(INFINITY) == 0x7C00 && (MeshQuantizer::ToHalf(NAN) & 0x3FF) != 0, "Half: Infinity And NaN");
+		// 1 + 2^-11 Is Half Way: Rounded To Even (1), 1 + 3 * 2^-11 Is Rounded Up
+		Check(MeshQuantizer::ToHalf(1.f + ldexp(1.f, -11)) == 0x3C00 && MeshQuantizer::ToHalf(1.f + 3 * ldexp(1.f, -11)) == 0x3C02,
+			"Half: Rounding To Even");
+
+		bool Every = true;
+		for (uint32_t i = 0; i < 0x10000; i++)
+		{
+			uint16_t H = (uint16_t)i;
+			if (((H >> 10) & 0x1F) == 31 && (H & 0x3FF))
+				continue;
+			Every = Every && MeshQuantizer::ToHalf(MeshQuantizer::FromHalf(H)) == H;
+		}
+		Check(Every, "Half: Every Value Survives The Round Trip");
+	}
+
+	// Random Props Of Different Size And Place
+	mt19937 Random(5);
+	for (float Size: { 0.01f, 1.f, 250.f })
+	{
+		uniform_real_distribution<float> Pos(-Size, Size), Tex(-1.f, 2.f);
+		vector<Vertex> Vertices(5000);
+		for (auto &It: Vertices)
+			It = { { Pos(Random) + Size * 3, Pos(Random), Pos(Random) * 0.5f }, { Tex(Random), Tex(Random) } };
+		ostringstream Name;
+		Name << "Prop Of Size " << Size;
+		RoundTrip(Name.str(), Vertices);
+	}
+	{
+		// Flat Mesh: The Axis Without Size Is Kept Exactly
+		vector<Vertex> Vertices = { { { 0, 5, 0 }, { 0, 0 } }, { { 1, 5, 0 }, { 1, 0 } }, { { 0, 5, 1 }, { 0, 1 } } };
+		RoundTrip("Flat Mesh", Vertices);
+	}
+
+	// UVs Which Half Floats Can't Keep
+	{
+		vector<Vertex> Tiled = { { { 0, 0, 0 }, { 0.25f, 0.5f } }, { { 1, 0, 0 }, { 300.3f, 0.5f } } };
+		Check(MeshQuantizer::FitsHalf(Tiled.data()->Tex, sizeof(Vertex), 1), "FitsHalf: Usual UVs");
+		Check(!MeshQuantizer::FitsHalf(Tiled.data()->Tex, sizeof(Vertex), 2), "FitsHalf: Tiled Far UVs");
+	}
+
+	// Grid Of 300 x 300 Quads: Parts With At Most 65535 Vertices, The Same Triangles In The Same Order
+	{
+		const size_t N = 300;
+		vector<Vertex> Vertices;
+		vector<uint32_t> Indices;
+		for (size_t y = 0; y <= N; y++)
+			for (size_t x = 0; x <= N; x++)
+				Vertices.push_back({ { float(x), float(y), 0.f }, { 0.f, 0.f } });
+		for (size_t y = 0; y < N; y++)
+			for (size_t x = 0; x < N; x++)
+			{
+				uint32_t A = uint32_t(y * (N + 1) + x), B = A + 1, C = A + uint32_t(N + 1), D = C + 1;
+				Indices.insert(Indices.end(), { A, B, C, B, D, C });
+			}
+
+		auto Parts = MeshQuantizer::Split(Vertices, Indices);
+		cout << "Split: " << Vertices.size() << " Vertices Into " << Parts.size() << " Parts\n";
+		Check(Parts.size() == 2, "Split: Two Parts");
+
+		vector<array<float, 9>> Before, After;
+		for (size_t i = 0; i < Indices.size(); i += 3)
+		{
+			array<float, 9> Tri;
+			for (int k = 0; k < 3; k++)
+				copy(Vertices[Indices[i + k]].Pos, Vertices[Indices[i + k]].Pos + 3, Tri.begin() + k * 3);
+			Before.push_back(Tri);
+		}
+		bool Small = true, Valid = true, Compact = true;
+		for (auto &Part: Parts)
+		{
+			Small = Small && Part.Vertices.size() <= MeshQuantizer::MaxVertices16;
+			vector<bool> Seen(Part.Vertices.size(), false);
+			for (size_t i = 0; i < Part.Indices.size(); i += 3)
+			{
+				array<float, 9> Tri;
+				for (int k = 0; k < 3; k++)
+				{
+					uint32_t V = Part.Indices[i + k];
+					Valid = Valid && V < Part.Vertices.size();
+					if (V < Part.Vertices.size())
+					{
+						copy(Part.Vertices[V].Pos, Part.Vertices[V].Pos + 3, Tri.begin() + k * 3);
+						Seen[V] = true;
+					}
+				}
+				After.push_back(Tri);
+			}
+			Compact = Compact && count(Seen.begin(), Seen.end(), false) == 0;
+
+			auto Short = MeshQuantizer::Narrow(Part.Indices.data(), Part.Indices.size());
+			Valid = Valid && equal(Short.begin(), Short.end(), Part.Indices.begin());
+		}
+		Check(Small, "Split: Every Part Has 16-Bit Indices");
+		Check(Valid, "Split: Indices Are Valid");
+		Check(Compact, "Split: Every Vertex Of The Part Is Used");
+		Check(Before == After, "Split: The Same Triangles");
+
+		auto One = MeshQuantizer::Split(vector<Vertex>(Vertices.begin(), Vertices.begin() + 100), vector<uint32_t>{ 0, 1, 2 });
+		Check(One.size() == 1 && One[0].Vertices.size() == 100, "Split: Small Mesh Isn't Changed");
+
+		// Bytes Of Vertices And Indices For The Device
+		size_t Full = Vertices.size() * sizeof(Vertex) + Indices.size() * 4, Packed = 0;
+		for (auto &Part: Parts)
+			Packed += Part.Vertices.size() * sizeof(MeshQuantizer::PackedVertex) + Part.Indices.size() * 2;
+		cout << "Device Memory Of The Grid: " << Full << " -> " << Packed << " Bytes\n";
+		Check(Packed * 10 <= Full * 6, "Packed Mesh Takes At Most 60%");
+	}
+
+	return Report();
+}
@@ -0,0 +1,273 @@
+// Tests Of MeshSimplifier (Engine/MeshSimplifier.h): Triangle Budgets And Error Bounds Of Simplify,
+// Borders And UV Seams Which Stay In Place, Levels Of Detail Of Grid And Sphere
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "../../Engine/MeshSimplifier.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+struct Vertex
+{
+	float Pos[3];
+	float Tex[2];
+};
+
+// N x N Quads In XY Plane (Height Is Z), Vertices Of Columns From Seam Are Doubled When Seam Is Set
+static void MakeGrid(size_t N, vector<Vertex> &Vertices, vector<uint32_t> &Indices, float Bumps = 0.f,
+	size_t Seam = 0)
+{
+	Vertices.clear();
+	Indices.clear();
+	vector<uint32_t> Left((N + 1) * (N + 1)), Right((N + 1) * (N + 1));
+	for (size_t y = 0; y <= N; y++)
+		for (size_t x = 0; x <= N; x++)
+		{
+			float Z = Bumps * sin(x * 0.7f) * cos(y * 0.5f);
+			size_t i = y * (N + 1) + x;
+			Left[i] = Right[i] = (uint32_t)Vertices.size();
+			// The Right Chart Has Its Own UVs
+			Vertices.push_back({ { float(x), float(y), Z }, { float(x) / N, float(y) / N } });
+			if (Seam && x == Seam)
+			{
+				Right[i] = (uint32_t)Vertices.size();
+				Vertices.push_back({ { float(x), float(y), Z }, { 0.5f + float(x) / N, float(y) / N } });
+			}
+		}
+
+	for (size_t y = 0; y < N; y++)
+		for (size_t x = 0; x < N; x++)
+		{
+			auto &Map = Seam && x >= Seam ? Right : Left;
+			uint32_t A = Map[y * (N + 1) + x], B = Map[y * (N + 1) + x + 1], C = Map[(y + 1) * (N + 1) + x],
+				D = Map[(y + 1) * (N + 1) + x + 1];
+			Indices.insert(Indices.end(), { A, B, C, B, D, C });
+		}
+}
+
+static void MakeSphere(size_t Rings, size_t Segments, vector<Vertex> &Vertices, vector<uint32_t> &Indices)
+{
+	Vertices.clear();
+	Indices.clear();
+	for (size_t r = 0; r <= Rings; r++)
+		for (size_t s = 0; s <= Segments; s++)
+		{
+			float Theta = 3.14159265f * r / Rings, Phi = 2.f * 3.14159265f * s / Segments;
+			Vertices.push_back({ { sin(Theta) * cos(Phi), cos(Theta), sin(Theta) * sin(Phi) },
+				{ float(s) / Segments, float(r) / Rings } });
+		}
+	for (size_t r = 0; r < Rings; r++)
+		for (size_t s = 0; s < Segments; s++)
+		{
+			uint32_t A = uint32_t(r * (Segments + 1) + s), B = A + 1, C = A + uint32_t(Segments + 1), D = C + 1;
+			if (r > 0)
+				Indices.insert(Indices.end(), { A, B, C });
+			if (r + 1 < Rings)
+				Indices.insert(Indices.end(), { B, D, C });
+		}
+}
+
+static vector<uint32_t> Simplify(const vector<Vertex> &Vertices, const vector<uint32_t> &Indices, size_t Target,
+	float Error, float *Result)
+{
+	return MeshSimplifier::Simplify(Indices, Vertices.data()->Pos, Vertices.data()->Tex, sizeof(Vertex),
+		Vertices.size(), Target, Error, 0.5f, Result);
+}
+
+static double Area(const vector<Vertex> &Vertices, const vector<uint32_t> &Indices, double *MinNormalZ = nullptr)
+{
+	double Sum = 0.;
+	if (MinNormalZ)
+		*MinNormalZ = 1.;
+	for (size_t i = 0; i < Indices.size(); i += 3)
+	{
+		auto &A = Vertices[Indices[i]].Pos, &B = Vertices[Indices[i + 1]].Pos, &C = Vertices[Indices[i + 2]].Pos;
+		double E1[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] }, E2[3] = { C[0] - A[0], C[1] - A[1], C[2] - A[2] };
+		double N[3] = { E1[1] * E2[2] - E1[2] * E2[1], E1[2] * E2[0] - E1[0] * E2[2], E1[0] * E2[1] - E1[1] * E2[0] };
+		double Length = sqrt(N[0] * N[0] + N[1] * N[1] + N[2] * N[2]);
+		Sum += Length * 0.5;
+		if (MinNormalZ && Length > 0.)
+			*MinNormalZ = min(*MinNormalZ, N[2] / Length);
+	}
+	return Sum;
+}
+
+// Edges Which Have One Triangle (By Positions)
+static vector<pair<int, int>> OpenEdges(const vector<Vertex> &Vertices, const vector<uint32_t> &Indices)
+{
+	map<pair<int, int>, int> Count;
+	auto Key = [&Vertices](uint32_t V) { return int(Vertices[V].Pos[1] * 1000 + Vertices[V].Pos[0]); };
+	for (size_t i = 0; i < Indices.size(); i += 3)
+		for (int k = 0; k < 3; k++)
+		{
+			int A = Key(Indices[i + k]), B = Key(Indices[i + (k + 1) % 3]);
+			Count[{ min(A, B), max(A, B) }]++;
+		}
+
+	vector<pair<int, int>> Result;
+	for (auto &It: Count)
+		if (It.second == 1)
+			Result.push_back(It.first);
+	return Result;
+}
+
+int main()
+{
+	vector<Vertex> Vertices;
+	vector<uint32_t> Indices;
+
+	// Flat Grid: Nothing Is Lost, So It Goes Down To The Budget; Borders Stay Where They Were
+	{
+		MakeGrid(64, Vertices, Indices);
+		float Error = 1.f;
+		auto Start = chrono::steady_clock::now();
+		auto Result = Simplify(Vertices, Indices, Indices.size() / 20, 1e-3f, &Error);
+		double Ms = chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+		cout << "Flat Grid: " << Indices.size() / 3 << " -> " << Result.size() / 3 << " Triangles, Error " << Error
+			<< " (" << fixed << setprecision(2) << Ms << " ms)\n" << defaultfloat;
+
+		double MinNormalZ = 0.;
+		Check(Result.size() <= Indices.size() / 20, "Flat Grid: Budget Is Reached");
+		Check(Error < 1e-5f, "Flat Grid: No Error");
+		Check(fabs(Area(Vertices, Result, &MinNormalZ) - 64. * 64.) < 1e-3, "Flat Grid: Area Is The Same");
+		Check(MinNormalZ > 0.99, "Flat Grid: No Triangle Is Turned Over");
+
+		bool OnBorder = true;
+		for (auto &It: OpenEdges(Vertices, Result))
+			for (int Key: { It.first, It.second })
+			{
+				int X = Key % 1000, Y = Key / 1000;
+				OnBorder = OnBorder && (X == 0 || Y == 0 || X == 64 || Y == 64);
+			}
+		Check(OnBorder, "Flat Grid: Open Edges Are On Its Border");
+	}
+
+	// UV Seam In The Middle: Triangles Don't Cross It, It Stays Straight
+	{
+		MakeGrid(64, Vertices, Indices, 0.f, 32);
+		float Error = 1.f;
+		auto Result = Simplify(Vertices, Indices, Indices.size() / 10, 1e-3f, &Error);
+		cout << "Grid With Seam: " << Indices.size() / 3 << " -> " << Result.size() / 3 << " Triangles\n";
+
+		bool Sides = true;
+		for (size_t i = 0; i < Result.size(); i += 3)
+		{
+			bool Right = false, Left = false;
+			for (int k = 0; k < 3; k++)
+			{
+				auto &V = Vertices[Result[i + k]];
+				// UV Of The Right Chart Starts From 0.5 + 32 / 64
+				bool RightChart = V.Tex[0] > 0.5f + 31.5f / 64;
+				Right = Right || RightChart || V.Pos[0] > 32.f;
+				Left = Left || (!RightChart && V.Pos[0] < 32.f) || (!RightChart && V.Pos[0] == 32.f && V.Tex[0] <= 0.5f);
+			}
+			Sides = Sides && !(Right && Left);
+		}
+		Check(Sides, "Seam: Every Triangle Is On One Side");
+		Check(Result.size() <= Indices.size() / 10, "Seam: Budget Is Reached");
+		Check(fabs(Area(Vertices, Result) - 64. * 64.) < 1e-3, "Seam: Area Is The Same");
+	}
+
+	// Sphere: Error Of The Result Is At Most The Target, Triangles At Most The Budget
+	MakeSphere(64, 128, Vertices, Indices);
+	for (float Target: { 1e-3f, 5e-3f, 2e-2f })
+	{
+		float Error = 1.f;
+		auto Result = Simplify(Vertices, Indices, Indices.size() / 10, Target, &Error);
+		cout << "Sphere, Error " << Target << ": " << Indices.size() / 3 << " -> " << Result.size() / 3
+			<< " Triangles, Error " << Error << "\n";
+		Check(Error <= Target, "Sphere: Error Is At Most " + to_string(Target));
+		Check(Result.size() < Indices.size(), "Sphere: Something Is Collapsed With Error " + to_string(Target));
+
+		// Vertices Are Kept On The Sphere, Centres Of Triangles Are Inside It By Less Than The Error
+		double Deepest = 0.;
+		for (size_t i = 0; i < Result.size(); i += 3)
+		{
+			double C[3] = {};
+			for (int k = 0; k < 3; k++)
+				for (int j = 0; j < 3; j++)
+					C[j] += Vertices[Result[i + k]].Pos[j] / 3.;
+			Deepest = max(Deepest, 1. - sqrt(C[0] * C[0] + C[1] * C[1] + C[2] * C[2]));
+		}
+		// Size Of The Sphere Is 2; Quadrics Average Squared Distances To Planes Of Old Triangles, So The Deepest
+		// Point Of The Curved Surface Is Further Than The Error, But Not Much
+		Check(Deepest / 2. <= 3. * Target, "Sphere: Surface Is Within Error " + to_string(Target));
+	}
+	{
+		float Error = 1.f;
+		auto Result = Simplify(Vertices, Indices, 0, 1e-7f, &Error);
+		Check(Result.size() == Indices.size(), "Sphere: Nothing Is Collapsed Under Tiny Error");
+	}
+	{
+		float Error = 1.f;
+		auto Result = Simplify(Vertices, Indices, Indices.size() / 4, 1.f, &Error);
+		Check(Result.size() <= Indices.size() / 4 && Result.size() > Indices.size() / 8, "Sphere: Budget Without Error Limit");
+	}
+
+	// Levels Of Detail: 3 To 5 Levels, Each Has At Most Half Of The Previous, Errors Grow Within MaxError
+	for (int Mesh = 0; Mesh < 2; Mesh++)
+	{
+		if (Mesh)
+			MakeGrid(96, Vertices, Indices, 2.f);
+		else
+			MakeSphere(64, 128, Vertices, Indices);
+		size_t Full = Indices.size();
+
+		auto Start = chrono::steady_clock::now();
+		auto Levels = MeshSimplifier::BuildLods(Vertices, Indices);
+		double Ms = chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+
+		string Name = Mesh ? "Bumpy Grid" : "Sphere";
+		cout << Name << " Levels:";
+		for (auto &It: Levels)
+			cout << " " << It.IndexCount / 3 << " (" << It.Error << ")";
+		cout << ", " << fixed << setprecision(2) << Ms << " ms\n" << defaultfloat;
+
+		Check(Levels.size() >= 3 && Levels.size() <= 5, Name + ": 3 To 5 Levels");
+		Check(Levels.front().IndexCount == Full && Levels.front().Error == 0.f, Name + ": The First Level Is Full");
+		float Scale = MeshSimplifier::getScale(Vertices.front().Pos, sizeof(Vertex), Vertices.size()),
+			Budget = LodSettings().MaxError * Scale;
+		for (size_t i = 1; i < Levels.size(); i++)
+		{
+			// Only The Last Level Can Have More: MaxError Was Spent Before The Ratio Was Reached
+			bool Spent = i + 1 == Levels.size() && Levels[i].Error >= Budget * 0.99f;
+			Check(Levels[i].IndexCount * 2 <= Levels[i - 1].IndexCount || Spent, Name + ": Half Of The Previous Level");
+			Check(Levels[i].Error >= Levels[i - 1].Error, Name + ": Errors Grow");
+			Check(Levels[i].FirstIndex == Levels[i - 1].FirstIndex + Levels[i - 1].IndexCount, Name + ": Levels Follow");
+		}
+		Check(Levels.back().FirstIndex + Levels.back().IndexCount == Indices.size(), Name + ": Every Index Is In a Level");
+		Check(Levels.back().Error <= Budget * 1.0001f, Name + ": The Coarsest Level Is Within MaxError");
+		bool Valid = true;
+		for (auto V: Indices)
+			Valid = Valid && V < Vertices.size();
+		Check(Valid, Name + ": Indices Are Valid");
+	}
+
+	// Errors Of Levels Add Up: The Coarsest One Stays Within MaxError, Even If a Single Step Could Spend It All
+	{
+		MakeGrid(96, Vertices, Indices, 2.f);
+		LodSettings Tight;
+		Tight.MaxError = 0.01f;
+		auto Levels = MeshSimplifier::BuildLods(Vertices, Indices, Tight);
+		float Scale = MeshSimplifier::getScale(Vertices.front().Pos, sizeof(Vertex), Vertices.size());
+		Check(Levels.size() >= 2, "Tight Budget: Some Level Is Made");
+		Check(Levels.back().Error <= Tight.MaxError * Scale * 1.0001f, "Tight Budget: The Coarsest Level Is Within MaxError");
+	}
+
+	// Small And Broken Meshes Aren't Changed
+	{
+		vector<Vertex> Quad = { { { 0, 0, 0 }, {} }, { { 1, 0, 0 }, {} }, { { 0, 1, 0 }, {} }, { { 1, 1, 0 }, {} } };
+		vector<uint32_t> Two = { 0, 1, 2, 1, 3, 2 }, Broken = { 0, 1, 9 };
+		auto Levels = MeshSimplifier::BuildLods(Quad, Two);
+		Check(Levels.size() == 1 && Two.size() == 6, "Small Mesh Has One Level");
+		Check(Simplify(Quad, Broken, 0, 1.f, nullptr) == Broken, "Index Out Of Range");
+	}
+
+	return Report();
+}
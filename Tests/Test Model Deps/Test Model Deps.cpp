@@ -0,0 +1,171 @@
+/**
+ * \file	Test Model Deps.cpp.
+ *
+ * \brief	Tests of texture references of models: .obj/.mtl, .3ds, binary and ASCII .fbx, broken files
+ */
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Engine/ModelDeps.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+template<class T> static void Put(string &Data, T Value)
+{
+	Data.append((const char *)&Value, sizeof(T));
+}
+
+// Binary FBX 7.4 (32-Bit Offsets): Record Is Written At Offset Base Of The File
+static string Record(size_t Base, const string &Name, const string &Properties, uint32_t Count,
+	const vector<string> &Children = {})
+{
+	string Body = Properties;
+	for (auto &It: Children)
+		Body += It;
+	if (!Children.empty())
+		Body += string(13, '\0');
+
+	string Result;
+	Put<uint32_t>(Result, uint32_t(Base + 13 + Name.size() + Body.size()));
+	Put<uint32_t>(Result, Count);
+	Put<uint32_t>(Result, (uint32_t)Properties.size());
+	Result += char(Name.size());
+	Result += Name;
+	return Result + Body;
+}
+
+static string StringProperty(const string &Text)
+{
+	string Result = "S";
+	Put<uint32_t>(Result, (uint32_t)Text.size());
+	return Result + Text;
+}
+
+static string FBXHeader()
+{
+	string Result = "Kaydara FBX Binary  ";
+	Result += '\0';
+	Result += '\x1a';
+	Result += '\0';
+	Put<uint32_t>(Result, 7400);
+	return Result;
+}
+
+// 3DS Chunk: ID, Length With The Header, Data
+static string Chunk(uint16_t ID, const string &Data)
+{
+	string Result;
+	Put<uint16_t>(Result, ID);
+	Put<uint32_t>(Result, uint32_t(Data.size() + 6));
+	return Result + Data;
+}
+
+// Data Is Copied To a Buffer Of Its Exact Size, So Reading Past The End Is Caught By Sanitizers
+static bool ScanExact(const string &File, const string &Data, ModelDeps::Result &Out)
+{
+	unique_ptr<char[]> Buffer(new char[Data.size()]);
+	memcpy(Buffer.get(), Data.data(), Data.size());
+	return ModelDeps::Scan(File, string_view(Buffer.get(), Data.size()), Out);
+}
+
+int main()
+{
+	// .obj -> .mtl
+	{
+		map<string, string> Files = {
+			{ "models/house.mtl",
+				"newmtl Wall\n"
+				"map_Kd -o 0.5 0.5 -clamp on Textures/Wall.dds\r\n"
+				"map_bump -bm 0.3 wall normal.png\n"
+				"bump textures/wall.DDS\n"
+				"Kd 1 1 1\n" }
+		};
+		auto Read = [&Files](const string &File, string &Data)
+		{
+			auto It = Files.find(File);
+			if (It == Files.end())
+				return false;
+			Data = It->second;
+			return true;
+		};
+
+		ModelDeps::Result Out;
+		Check(ModelDeps::Scan("models/house.obj", string_view("v 0 0 0\nmtllib house.mtl\nmtllib missing.mtl\nf 1 1 1\n"),
+			Out, Read), "OBJ Is Scanned");
+		Check(Out.Materials == vector<string>{ "house.mtl" }, "Only Found .mtl Is Listed");
+		Check(Out.Textures == (vector<string>{ "Textures/Wall.dds", "wall normal.png" }),
+			"Options Are Skipped, Names With Spaces Kept, Duplicates Folded");
+	}
+
+	// .3ds
+	{
+		string Map = Chunk(0xA200, Chunk(0xA300, string("Brick.JPG") + '\0') + Chunk(0xA351, string(2, '\0')));
+		string Data = Chunk(0x4D4D, Chunk(0x3D3D, Chunk(0xAFFF, Chunk(0xA000, string("Mat\0", 4)) + Map)));
+
+		ModelDeps::Result Out;
+		Check(ScanExact("box.3DS", Data, Out), "3DS Is Scanned");
+		Check(Out.Textures == vector<string>{ "Brick.JPG" }, "3DS Map Name");
+
+		string Broken = Data;
+		Broken[2] = char(0x7F);
+		ModelDeps::Result Skip;
+		Check(!ScanExact("box.3ds", Broken, Skip), "3DS With Too Long Chunk Is Broken");
+		Check(!ScanExact("box.3ds", "3DS?", Skip), "Not 3DS");
+	}
+
+	// Binary .fbx
+	{
+		string Data = FBXHeader();
+		// Objects { Texture { FileName: "C:\\wood.png", RelativeFilename: "wood.png" } }
+		size_t Objects = Data.size(), Inner = Objects + 13 + 7;
+		string File = Record(Inner + 13 + 7, "FileName", StringProperty("C:\\wood.png"), 1);
+		string Relative = Record(Inner + 13 + 7 + File.size(), "RelativeFilename", StringProperty("wood.png"), 1);
+		string Texture = Record(Inner, "Texture", "", 0, { File, Relative });
+		Data += Record(Objects, "Objects", "", 0, { Texture });
+		Data += string(13, '\0');
+
+		ModelDeps::Result Out;
+		Check(ScanExact("tree.fbx", Data, Out), "FBX Is Scanned");
+		Check(Out.Textures == (vector<string>{ "C:\\wood.png", "wood.png" }), "FBX File Names");
+	}
+
+	// Binary .fbx: The Last Record Says It Has a Property But Its Properties Are Empty
+	{
+		string Data = FBXHeader();
+		Data += Record(Data.size(), "FileName", "", 1);
+
+		ModelDeps::Result Out;
+		Check(ScanExact("cut.fbx", Data, Out), "Record Without Properties Is Skipped");
+		Check(Out.Textures.empty(), "Nothing Is Read Past The End");
+
+		string Short = FBXHeader();
+		Short += Record(Short.size(), "FileName", StringProperty("a.png"), 1).substr(0, 20);
+		Check(!ScanExact("cut.fbx", Short, Out), "Cut Record Is Broken");
+	}
+
+	// ASCII .fbx
+	{
+		ModelDeps::Result Out;
+		Check(ModelDeps::Scan("a.fbx", string_view("; FBX 7.3.0 project file\n\tTexture: {\n"
+			"\t\tFileName: \"D:\\Art\\bark.tga\"\r\n\t\tRelativeFilename: \"bark.tga\"\n\t}\n"), Out), "ASCII FBX");
+		Check(Out.Textures == (vector<string>{ "D:\\Art\\bark.tga", "bark.tga" }), "ASCII FBX File Names");
+	}
+
+	// Formats
+	{
+		Check(ModelDeps::IsSupported("A.OBJ") && ModelDeps::IsSupported("b.Fbx") && ModelDeps::IsSupported("c.3ds"),
+			"Known Formats");
+		Check(!ModelDeps::IsSupported("d.dae") && !ModelDeps::IsSupported("obj"), "Unknown Formats");
+
+		ModelDeps::Result Out;
+		Check(!ModelDeps::Scan("d.dae", string_view("<COLLADA/>"), Out), "Unknown Format Isn't Scanned");
+	}
+
+	return Report();
+}
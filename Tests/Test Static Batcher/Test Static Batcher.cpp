@@ -0,0 +1,167 @@
+// Tests Of StaticBatcher (Engine/StaticBatcher.h): Props Of a Level Merged By Material Into Clusters,
+// Vertices In The World, Mirrored Props, Size And Place Of Clusters
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <set>
+#include <string>
+
+#include "../../Engine/StaticBatcher.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+typedef StaticBatcher::Vertex Vertex;
+
+// Unit Box Around 0: 24 Vertices, 12 Triangles Which Face Outside (Counter-Clockwise From Outside)
+static void MakeBox(vector<Vertex> &Vertices, vector<uint32_t> &Indices)
+{
+	for (int Axis = 0; Axis < 3; Axis++)
+		for (float Side: { -0.5f, 0.5f })
+		{
+			uint32_t Base = (uint32_t)Vertices.size();
+			int U = (Axis + 1) % 3, V = (Axis + 2) % 3;
+			for (int i = 0; i < 4; i++)
+			{
+				Vertex New = {};
+				New.Pos[Axis] = Side;
+				New.Pos[U] = (i == 1 || i == 2) ? 0.5f : -0.5f;
+				New.Pos[V] = (i >= 2) ? 0.5f : -0.5f;
+				New.Tex[0] = New.Pos[U] + 0.5f;
+				New.Tex[1] = New.Pos[V] + 0.5f;
+				Vertices.push_back(New);
+			}
+			if (Side > 0.f)
+				Indices.insert(Indices.end(), { Base, Base + 1, Base + 2, Base, Base + 2, Base + 3 });
+			else
+				Indices.insert(Indices.end(), { Base, Base + 2, Base + 1, Base, Base + 3, Base + 2 });
+		}
+}
+
+// Normal Of The Triangle Looks Away From The Centre
+static bool FacesOutside(const Vertex &A, const Vertex &B, const Vertex &C, const float *Centre)
+{
+	float E1[3], E2[3], N[3], Mid[3];
+	for (int k = 0; k < 3; k++)
+	{
+		E1[k] = B.Pos[k] - A.Pos[k];
+		E2[k] = C.Pos[k] - A.Pos[k];
+		Mid[k] = (A.Pos[k] + B.Pos[k] + C.Pos[k]) / 3.f - Centre[k];
+	}
+	N[0] = E1[1] * E2[2] - E1[2] * E2[1];
+	N[1] = E1[2] * E2[0] - E1[0] * E2[2];
+	N[2] = E1[0] * E2[1] - E1[1] * E2[0];
+	return N[0] * Mid[0] + N[1] * Mid[1] + N[2] * Mid[2] > 0.f;
+}
+
+int main()
+{
+	vector<Vertex> Box;
+	vector<uint32_t> BoxIndices;
+	MakeBox(Box, BoxIndices);
+
+	// 40 x 40 Props On a Field, Three Materials, Every Seventh Is Mirrored And Scaled
+	const int N = 40;
+	vector<StaticBatcher::Instance> Instances;
+	for (int z = 0; z < N; z++)
+		for (int x = 0; x < N; x++)
+		{
+			StaticBatcher::Instance It;
+			It.Vertices = Box.data();
+			It.VertexCount = Box.size();
+			It.Indices = BoxIndices.data();
+			It.IndexCount = BoxIndices.size();
+			It.Material = (x + z) % 3;
+			float Scale = (Instances.size() % 7 == 0) ? -2.f : 1.f;
+			It.World[0] = Scale;
+			It.World[12] = x * 10.f;
+			It.World[13] = 1.f;
+			It.World[14] = z * 10.f;
+			Instances.push_back(It);
+		}
+
+	StaticBatcher::Settings Options;
+	Options.MaxVertices = 2000;
+	Options.MaxExtent = 100.f;
+	auto Clusters = StaticBatcher::Build(Instances, Options);
+	cout << "Draw Calls: " << Instances.size() << " -> " << Clusters.size() << "\n";
+	Check(Clusters.size() * 20 <= Instances.size(), "Clusters Are Much Fewer Than Props");
+
+	set<size_t> Merged;
+	size_t Triangles = 0;
+	bool Small = true, OneMaterial = true, Placed = true, Outside = true, Bounds = true, Near = true;
+	for (auto &It: Clusters)
+	{
+		Small = Small && It.Vertices.size() <= Options.MaxVertices;
+		Triangles += It.Indices.size() / 3;
+
+		// Every Vertex Is In The Box, The Box Is Small (Centres Within MaxExtent Plus The Prop)
+		for (auto &V: It.Vertices)
+			for (int k = 0; k < 3; k++)
+				Bounds = Bounds && V.Pos[k] >= It.Min[k] && V.Pos[k] <= It.Max[k];
+		for (int k = 0; k < 3; k++)
+			Near = Near && It.Max[k] - It.Min[k] <= Options.MaxExtent + 2.f;
+
+		size_t Offset = 0;
+		for (auto Index: It.Instances)
+		{
+			auto &Source = Instances[Index];
+			OneMaterial = OneMaterial && Source.Material == It.Material;
+			Merged.insert(Index);
+
+			// Vertices Are Moved Into The World And Triangles Still Face Outside
+			for (size_t v = 0; v < Source.VertexCount; v++)
+			{
+				auto &V = It.Vertices[Offset + v];
+				float Want[3] = { Box[v].Pos[0] * Source.World[0] + Source.World[12], Box[v].Pos[1] + Source.World[13],
+					Box[v].Pos[2] + Source.World[14] };
+				for (int k = 0; k < 3; k++)
+					Placed = Placed && fabs(V.Pos[k] - Want[k]) < 1e-4f;
+				Placed = Placed && V.Tex[0] == Box[v].Tex[0] && V.Tex[1] == Box[v].Tex[1];
+			}
+			Offset += Source.VertexCount;
+		}
+		for (size_t i = 0; i < It.Indices.size(); i += 3)
+		{
+			auto &A = It.Vertices[It.Indices[i]];
+			float Centre[3] = { floor(A.Pos[0] / 10.f + 0.5f) * 10.f, 1.f, floor(A.Pos[2] / 10.f + 0.5f) * 10.f };
+			Outside = Outside && FacesOutside(A, It.Vertices[It.Indices[i + 1]], It.Vertices[It.Indices[i + 2]], Centre);
+		}
+	}
+	Check(Small, "Clusters Have At Most MaxVertices");
+	Check(OneMaterial, "Cluster Has One Material");
+	Check(Merged.size() == Instances.size(), "Every Prop Is Merged Once");
+	Check(Triangles == Instances.size() * BoxIndices.size() / 3, "Every Triangle Is Kept");
+	Check(Placed, "Vertices Are In The World");
+	Check(Outside, "Mirrored Props Face Outside");
+	Check(Bounds, "Bounds Of Clusters");
+	Check(Near, "Clusters Are Close Props");
+
+	// Without Limits Every Material Is One Cluster, a Too Big Mesh Is Its Own One
+	{
+		auto All = StaticBatcher::Build(Instances, StaticBatcher::Settings());
+		Check(All.size() == 3, "One Cluster Per Material");
+
+		StaticBatcher::Settings Tiny;
+		Tiny.MaxVertices = 10;
+		auto Alone = StaticBatcher::Build(vector<StaticBatcher::Instance>(Instances.begin(), Instances.begin() + 4), Tiny);
+		Check(Alone.size() == 4, "Too Big Meshes Aren't Merged");
+	}
+
+	// Broken Meshes
+	{
+		vector<uint32_t> Broken = { 0, 1, 99, 0, 1, 2 };
+		StaticBatcher::Instance It;
+		It.Vertices = Box.data();
+		It.VertexCount = Box.size();
+		It.Indices = Broken.data();
+		It.IndexCount = Broken.size();
+		StaticBatcher::Instance Empty;
+		auto Result = StaticBatcher::Build({ It, Empty });
+		Check(Result.size() == 1 && Result[0].Indices.size() == 3, "Broken Triangles And Empty Meshes Are Skipped");
+		Check(StaticBatcher::Build({}).empty(), "Nothing To Merge");
+	}
+
+	return Report();
+}
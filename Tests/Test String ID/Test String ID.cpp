@@ -0,0 +1,96 @@
+/**
+ * \file	Test String ID.cpp.
+ *
+ * \brief	Tests of interned identifiers: case folding (ASCII And Windows-1251), paths, lookups
+ */
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../Engine/StringID.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+int main()
+{
+	// ASCII
+	{
+		StringID A("Textures/A.DDS"), B("textures/a.dds");
+		Check(A == B, "Same ID For Both Cases");
+		Check(A.str() == "textures/a.dds", "Lowercase Text");
+		Check(A.original() == "Textures/A.DDS", "Original Text Of The First One");
+		Check(A.hash() == B.hash(), "Same Hash");
+		Check(StringID("Textures/B.dds") != A, "Other Text Has Other ID");
+	}
+
+	// Paths
+	{
+		Check(StringID::Path("Models\\Tree.OBJ") == StringID::Path("models/tree.obj"), "Backslash Is Slash In Paths");
+		Check(StringID("Models\\Tree.OBJ") != StringID("models/tree.obj"), "Backslash Stays In Names");
+	}
+
+	// Windows-1251: "\xCF\xD0\xC8\xC2\xC5\xD2" Is The Capital Cyrillic "Privet"
+	{
+		StringID Upper("\xCF\xD0\xC8\xC2\xC5\xD2.xml"), Lower("\xEF\xF0\xE8\xE2\xE5\xF2.xml");
+		Check(Upper == Lower, "Cyrillic Capitals");
+		Check(Upper.str() == "\xEF\xF0\xE8\xE2\xE5\xF2.xml", "Cyrillic Lowercase Text");
+
+		// Whole Block: 0xC0..0xDF -> 0xE0..0xFF
+		string AllUpper, AllLower;
+		for (int i = 0; i < 32; i++)
+		{
+			AllUpper += char(0xC0 + i);
+			AllLower += char(0xE0 + i);
+		}
+		Check(StringID(AllUpper).str() == AllLower, "Whole Cyrillic Alphabet");
+
+		// Yo, Ukrainian And Belarusian Letters
+		Check(StringID("\xA8").str() == "\xB8", "Capital Yo");
+		Check(StringID("\xAA\xAF\xB2\xA1\xA5").str() == "\xBA\xBF\xB3\xA2\xB4", "Ukrainian And Belarusian Letters");
+
+		// Small Letters And Signs Don't Change
+		Check(StringID("\xB8\xFF\xAB\xBB\x96").str() == "\xB8\xFF\xAB\xBB\x96", "Small Letters And Signs Stay");
+
+		Check(StringID::Path("\xD3\xD0\xCE\xC2\xCD\xC8\\1.XML") == StringID::Path("\xF3\xF0\xEE\xE2\xED\xE8/1.xml"),
+			"Cyrillic Paths");
+	}
+
+	// Find Doesn't Add
+	{
+		size_t Count = StringID::getCount();
+		Check(StringID::Find("Never Interned").IsEmpty(), "Unknown Text");
+		Check(StringID::getCount() == Count, "Find Added Nothing");
+		Check(StringID::Find("TEXTURES/A.DDS") == StringID("textures/a.dds"), "Find Folds Case");
+		Check(StringID::Find("\xCF\xD0\xC8\xC2\xC5\xD2.XML") == StringID("\xEF\xF0\xE8\xE2\xE5\xF2.xml"), "Find Folds Cyrillic");
+	}
+
+	// Empty
+	{
+		Check(StringID("").IsEmpty() && StringID().getID() == 0, "Empty Text Is ID 0");
+	}
+
+	// Threads Intern The Same Names
+	{
+		vector<uint32_t> IDs(4);
+		vector<thread> Threads;
+		for (size_t t = 0; t < IDs.size(); t++)
+			Threads.emplace_back([&IDs, t]()
+			{
+				for (int i = 0; i < 1000; i++)
+					StringID("Name " + to_string(i));
+				IDs[t] = StringID(t % 2 ? "NAME 999" : "name 999").getID();
+			});
+		for (auto &It : Threads)
+			It.join();
+
+		bool Same = true;
+		for (auto ID : IDs)
+			Same &= ID == IDs[0] && ID != 0;
+		Check(Same, "Same ID From Every Thread");
+	}
+
+	return Report();
+}
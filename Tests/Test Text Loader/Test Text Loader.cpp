@@ -0,0 +1,154 @@
+// Benchmark Of TextLoader (Engine/TextLoader.h) Against The Old getDataFromFile:
+// Copy Through istream_iterator And Erase Comments With deleteWord
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdio>
+
+#include "../../Engine/TextLoader.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+// The Same As deleteWord(string &, string const, string const) Of Engine/pch.cpp
+static void deleteWord(string &context, string const start, string const end)
+{
+	size_t pos1 = 0, pos2 = string::npos;
+	for (;;)
+	{
+		if ((pos1 = context.find(start, pos1)) != string::npos)
+		{
+			if ((pos2 = context.find(end, pos1)) != string::npos)
+			{
+				pos2 += end.length();
+				context.erase(pos1, pos2 - pos1);
+			}
+			else break;
+		}
+		else break;
+	}
+}
+
+static string OldLoad(const string &File)
+{
+	string Returned_val;
+	ifstream streamObj(File.c_str(), ios::binary);
+	streamObj >> noskipws;
+	copy(istream_iterator<char>(streamObj), istream_iterator<char>(), back_inserter(Returned_val));
+	deleteWord(Returned_val, "<!--", "-->");
+	return Returned_val;
+}
+
+// UI-Like XML With Many Comments
+static string MakeXML(size_t Size)
+{
+	mt19937 Random(42);
+	string Text = "<?xml version=\"1.0\"?>\n<ui>\n";
+	for (size_t i = 0; Text.size() < Size; i++)
+	{
+		if (Random() % 3 == 0)
+			Text += "\t<!-- Comment " + to_string(i) + ": Button Is Here Because Of Something -->\n";
+		Text += "\t<button id=\"##Button" + to_string(i) + "\" text=\"Text " + to_string(i) +
+			"\" pos=\"10, 20\" size=\"100, 30\"/>\n";
+	}
+	return Text + "</ui>\n";
+}
+
+static string MakeCode(size_t Size)
+{
+	mt19937 Random(7);
+	string Text;
+	for (size_t i = 0; Text.size() < Size; i++)
+	{
+		if (Random() % 4 == 0)
+			Text += "/* Block " + to_string(i) + "\n   Still Comment */\n";
+		Text += "Value" + to_string(i) + " = \"http://site/" + to_string(i) + "\"; // Line Comment\n";
+	}
+	return Text;
+}
+
+template<class Function> static double Measure(Function F, int Times = 5)
+{
+	double Best = 1e30;
+	for (int i = 0; i < Times; i++)
+	{
+		auto Start = chrono::steady_clock::now();
+		F();
+		Best = min(Best, chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count());
+	}
+	return Best;
+}
+
+int main()
+{
+	{
+		string Text = "a<!-- x -->b<!-- y\n -->c<!-- not closed";
+		TextLoader::Strip(Text, TextLoader::XML());
+		Check(Text == "abc<!-- not closed", "XML Comments, The Last Isn't Closed");
+
+		Text = "x = \"// not comment\"; // comment\r\ny = '/*'; /* block\r\n */ z";
+		TextLoader::Strip(Text, TextLoader::Code());
+		Check(Text == "x = \"// not comment\"; \ny = '/*';  z", "Code Comments Outside Of Strings");
+
+		Text = "x = \"a\\\"//b\"; // c";
+		TextLoader::Strip(Text, TextLoader::Code());
+		Check(Text == "x = \"a\\\"//b\"; ", "Escaped Quote Doesn't End The String");
+
+		// The String Ends With Its Line
+		Text = "s = \"open // not comment\nt = 1; // comment";
+		TextLoader::Strip(Text, TextLoader::Code());
+		Check(Text == "s = \"open // not comment\nt = 1; ", "Unterminated String");
+
+		TextLoader::Syntax Binary = TextLoader::Code();
+		Binary.TextMode = false;
+		Text = "a; // c\r\nb\r\n/* d */";
+		TextLoader::Strip(Text, Binary);
+		Check(Text == "a; \r\nb\r\n", "\\r\\n Is Kept Without TextMode");
+
+		TextLoader::Arena Arena(64);
+		auto A = TextLoader::Load("1<!--2-->3", 10, TextLoader::XML(), Arena);
+		auto B = TextLoader::Load("4<!--5-->6", 10, TextLoader::XML(), Arena);
+		Check(A == "13" && B == "46" && A.data()[2] == '\0' && Arena.getUsed() == 6, "Texts In Arena");
+	}
+
+	for (size_t MiB : { 1, 2, 4, 8 })
+	{
+		string File = "text_loader_bench.xml";
+		{
+			ofstream Out(File, ios::binary);
+			Out << MakeXML(MiB * 1024 * 1024);
+		}
+
+		string Old, New;
+		double OldMs = Measure([&]() { Old = OldLoad(File); }, MiB > 4 ? 1 : 3);
+		double NewMs = Measure([&]() { TextLoader::Load(File, TextLoader::XML(), New); });
+
+		// Old Loader Doesn't Touch \r\n, The File Has Only \n
+		bool Same = Old == New;
+		Check(Same, "XML " + to_string(MiB) + " MiB Is The Same As Old Loader");
+		cout << "XML " << MiB << " MiB: Old " << OldMs << " ms, New " << NewMs << " ms ("
+			<< (NewMs > 0. ? OldMs / NewMs : 0.) << "x, " << (MiB / (NewMs / 1000.)) << " MiB/s)"
+			<< (Same ? "" : " DIFFERENT RESULT!") << "\n";
+		remove(File.c_str());
+	}
+
+	{
+		string Code = MakeCode(16 * 1024 * 1024), Out;
+		double Ms = Measure([&]() { Out = Code; TextLoader::Strip(Out, TextLoader::Code()); });
+		cout << "Code 16 MiB (In Memory): " << Ms << " ms (" << (16. / (Ms / 1000.)) << " MiB/s)\n";
+
+		TextLoader::Arena Arena;
+		Ms = Measure([&]()
+		{
+			Arena.Reset();
+			for (size_t i = 0; i < Code.size(); i += 64 * 1024)
+				TextLoader::Load(Code.data() + i, min<size_t>(64 * 1024, Code.size() - i), TextLoader::Code(), Arena);
+		});
+		cout << "Code 16 MiB (Arena, 64 KiB Texts): " << Ms << " ms\n";
+	}
+
+	return Report();
+}
@@ -0,0 +1,105 @@
+// Tests Of UploadQueue (Engine/UploadQueue.h) Against a Backend Which Records Uploads: Budget Of Frames,
+// Order Of Assets, Assets Bigger Than The Budget, Failed Uploads
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Engine/UploadQueue.h"
+#include "../Common/Check.h"
+
+using namespace std;
+
+// Asset Is Its Number, Negative Ones Fail
+class Recorder: public UploadQueue::Backend
+{
+public:
+	vector<int> Uploaded;
+
+	bool Upload(void *Item) override
+	{
+		int Id = *static_cast<int *>(Item);
+		Uploaded.push_back(Id);
+		return Id >= 0;
+	}
+};
+
+static shared_ptr<void> Asset(int Id)
+{
+	return make_shared<int>(Id);
+}
+
+int main()
+{
+	const size_t MB = 1024 * 1024;
+
+	// 40 Textures Of 1 MB With The Budget Of 4 MB: Ten Frames, Every Texture Once In The Order Of Adding
+	{
+		UploadQueue Queue;
+		for (int i = 0; i < 40; i++)
+			Queue.Add(Asset(i), MB);
+		Queue.Add(nullptr, MB);
+		Check(Queue.size() == 40 && Queue.getBytes() == 40 * MB, "Queue: Every Asset Is Added");
+
+		Recorder Device;
+		size_t Frames = 0;
+		bool Budget = true;
+		while (Queue.size() && Frames < 100)
+		{
+			auto Stats = Queue.Update(Device, 4 * MB);
+			Budget = Budget && Stats.Bytes <= 4 * MB && Stats.Uploads == 4 && Stats.Left == Queue.size() &&
+				Stats.LeftBytes == Queue.getBytes();
+			Frames++;
+		}
+		cout << "Frames: " << Frames << " For " << Device.Uploaded.size() << " Uploads\n";
+		Check(Frames == 10, "Ten Frames");
+		Check(Budget, "Every Frame Keeps The Budget");
+
+		bool Order = Device.Uploaded.size() == 40;
+		for (size_t i = 0; Order && i < 40; i++)
+			Order = Device.Uploaded[i] == int(i);
+		Check(Order, "Every Asset Once In The Order Of Adding");
+		Check(Queue.getBytes() == 0, "Nothing Is Left");
+
+		auto None = Queue.Update(Device, 4 * MB);
+		Check(None.Uploads == 0 && None.Bytes == 0 && Device.Uploaded.size() == 40, "Empty Frame Uploads Nothing");
+	}
+
+	// Bigger Asset Than The Budget Is Uploaded Alone, Small Ones Behind It Wait For It
+	{
+		UploadQueue Queue;
+		Queue.Add(Asset(0), MB);
+		Queue.Add(Asset(1), 16 * MB);
+		Queue.Add(Asset(2), MB);
+		Queue.Add(Asset(3), MB);
+
+		Recorder Device;
+		auto First = Queue.Update(Device, 4 * MB);
+		Check(First.Uploads == 1 && Device.Uploaded == vector<int>{ 0 }, "Big Asset Waits For The Next Frame");
+		auto Second = Queue.Update(Device, 4 * MB);
+		Check(Second.Uploads == 1 && Second.Bytes == 16 * MB && Device.Uploaded == vector<int>({ 0, 1 }),
+			"Big Asset Is Uploaded Alone");
+		auto Third = Queue.Update(Device, 4 * MB);
+		Check(Third.Uploads == 2 && Third.Left == 0 && Device.Uploaded == vector<int>({ 0, 1, 2, 3 }),
+			"Small Assets Go After It");
+	}
+
+	// Failed Uploads Are Dropped And Counted, Budget 0 Uploads Everything
+	{
+		UploadQueue Queue;
+		for (int i = 0; i < 10; i++)
+			Queue.Add(Asset(i % 3 ? i : -i - 1), MB);
+
+		Recorder Device;
+		auto Stats = Queue.Update(Device, 0);
+		Check(Stats.Uploads == 6 && Stats.Failed == 4 && Stats.Bytes == 10 * MB && Stats.Left == 0,
+			"Without Budget: Everything, Failures Are Counted");
+		Check(Queue.size() == 0 && Device.Uploaded.size() == 10, "Failed Assets Aren't Tried Again");
+
+		Queue.Add(Asset(1), MB);
+		Queue.Clear();
+		Check(Queue.size() == 0 && Queue.getBytes() == 0, "Clear Forgets Assets");
+	}
+
+	return Report();
+}
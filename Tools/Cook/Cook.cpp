@@ -0,0 +1,492 @@
+// Cook Resource Folder Into Data Which The Engine Reads As It Is (Nothing Is Converted At Runtime)
+//	Cook <resource folder> <out folder> [-j N] [-force] [-top N] [-bench N]
+// Models (.obj, .3ds, .fbx) -> <model>.mesh (See Engine/CookedMesh.h)
+// XML (Levels, UI, Dialogs) -> The Same XML Which Was Checked, Without Comments And Formatting
+// Only Changed Assets Are Cooked: Hashes Of Sources Are Kept In <out folder>/cook.db (Skipped Models Too)
+// The Engine Takes Cooked Data When The Out Folder Is Mounted Over Resources (resource.mounts: dir 10 <out folder>)
+// Doesn't Use Windows: Build Machines Build It With Assimp, tinyxml2 And Boost.Filesystem (See CMakeLists.txt)
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <tinyxml2.h>
+
+#include "../../Engine/CookedMesh.h"
+#include "../../Engine/ModelDeps.h"
+#include "../../Engine/TextLoader.h"
+
+using namespace std;
+namespace fs = boost::filesystem;
+
+// Change It When Cooked Output Is Changed: Everything Is Cooked Again
+static const uint32_t CookerVersion = 1;
+static const char *DataBase = "cook.db";
+// Models With Embedded Textures Are Kept In cook.db With This After The Hash
+static const char *SkippedMark = ":skipped";
+static const char *EmbeddedTextures = "Embedded Textures";
+
+enum class Kind { Model, XML };
+enum class Status { Cooked, UpToDate, Skipped, Failed };
+
+struct Asset
+{
+	string Rel;
+	fs::path Source;
+	Kind Type = Kind::XML;
+
+	uint64_t Hash = 0;
+	// Models: CookedMesh::SourceHash Which The Engine Checks
+	uint64_t SourceHash = 0;
+	Status Result = Status::Failed;
+	string Error;
+	double Ms = 0.;
+	// Models: Post-Transform Cache Before And After MeshOptimizer
+	MeshOptimizer::Report Cache;
+	// Models: Triangles Of The Full Meshes And Of Their Coarsest Levels Of Detail
+	size_t Triangles = 0, Coarsest = 0;
+};
+
+static string ToLower(string Str)
+{
+	transform(Str.begin(), Str.end(), Str.begin(), [](char C) { return (char)tolower((unsigned char)C); });
+	return Str;
+}
+
+static string Output(const Asset &It)
+{
+	return It.Type == Kind::Model ? It.Rel + CookedMesh::Ext : It.Rel;
+}
+
+static bool WriteFile(const fs::path &File, const char *Data, size_t Size)
+{
+	boost::system::error_code EC;
+	fs::create_directories(File.parent_path(), EC);
+
+	fs::path Temp = File;
+	Temp += ".tmp";
+	{
+		ofstream Out(Temp.string(), ios::binary | ios::trunc);
+		if (!Out.is_open())
+			return false;
+		Out.write(Data, Size);
+		Out.close();
+		if (!Out.good())
+		{
+			fs::remove(Temp, EC);
+			return false;
+		}
+	}
+
+	fs::rename(Temp, File, EC);
+	if (EC)
+	{
+		boost::system::error_code Ignored;
+		fs::remove(Temp, Ignored);
+		return false;
+	}
+	return true;
+}
+
+static Status CookModel(Asset &It, const fs::path &Out, string &Error)
+{
+	Assimp::Importer Importer;
+	auto Scene = Importer.ReadFile(It.Source.string(), CookedMesh::ImportFlags);
+	if (!Scene || Scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !Scene->mRootNode || !Scene->HasMeshes())
+	{
+		Error = Importer.GetErrorString();
+		return Status::Failed;
+	}
+
+	// Embedded Textures Are Taken From The Scene: The Engine Imports Such Model Itself
+	if (Scene->HasTextures())
+	{
+		Error = EmbeddedTextures;
+		return Status::Skipped;
+	}
+
+	CookedMesh Mesh;
+	Mesh.Source = It.SourceHash;
+	Mesh.Flags = CookedMesh::ImportFlags;
+	Mesh.AddNode(Scene->mRootNode, Scene);
+	It.Cache.Before = Mesh.Before;
+	It.Cache.After = Mesh.After;
+	for (auto &Part: Mesh.Parts)
+	{
+		It.Triangles += Mesh.Lods.at(Part.FirstLod).IndexCount / 3;
+		It.Coarsest += Mesh.Lods.at(Part.FirstLod + Part.LodCount - 1).IndexCount / 3;
+	}
+
+	boost::system::error_code EC;
+	fs::create_directories(Out.parent_path(), EC);
+	if (!Mesh.Save(Out.string()))
+	{
+		Error = "Cannot Write " + Out.string();
+		return Status::Failed;
+	}
+
+	return Status::Cooked;
+}
+
+static Status CookXML(const string &Data, const fs::path &Out, string &Error)
+{
+	string Text = Data;
+	TextLoader::Strip(Text, TextLoader::XML());
+
+	tinyxml2::XMLDocument Doc;
+	if (Doc.Parse(Text.c_str(), Text.size()) != tinyxml2::XML_SUCCESS)
+	{
+		Error = Doc.ErrorStr() ? Doc.ErrorStr() : "Parse Error";
+		return Status::Failed;
+	}
+
+	tinyxml2::XMLPrinter Printer(nullptr, true);
+	Doc.Print(&Printer);
+	if (!WriteFile(Out, Printer.CStr(), Printer.CStrSize() - 1))
+	{
+		Error = "Cannot Write " + Out.string();
+		return Status::Failed;
+	}
+
+	return Status::Cooked;
+}
+
+struct Record
+{
+	uint64_t Hash = 0;
+	string Rel;
+	// Model With Embedded Textures: It Isn't Imported Again Until Its Source Is Changed
+	bool Skipped = false;
+};
+
+// Lowercase Relative Path -> Record
+using DataBaseMap = unordered_map<string, Record>;
+
+static void Cook(Asset &It, const fs::path &OutFolder, const DataBaseMap &Cooked, bool Force)
+{
+	auto Start = chrono::steady_clock::now();
+
+	string Data;
+	if (!ModelDeps::ReadFile(It.Source.string(), Data))
+	{
+		It.Error = "Cannot Read";
+		It.Result = Status::Failed;
+		return;
+	}
+
+	// Hash Of The Source And Of Everything Which Changes The Output
+	string Salt = "cook/" + to_string(CookerVersion);
+	if (It.Type == Kind::Model)
+	{
+		// It Has Material Libraries, Version And Import Flags
+		It.SourceHash = CookedMesh::SourceHash(It.Source.string(), Data);
+		It.Hash = CookedMesh::Hash(Salt, It.SourceHash);
+	}
+	else
+		It.Hash = CookedMesh::Hash(Data, CookedMesh::Hash(Salt));
+
+	fs::path Out = OutFolder / Output(It);
+	auto Known = Cooked.find(ToLower(It.Rel));
+	boost::system::error_code EC;
+	if (!Force && Known != Cooked.end() && Known->second.Hash == It.Hash && Known->second.Skipped)
+	{
+		It.Result = Status::Skipped;
+		It.Error = EmbeddedTextures;
+	}
+	else if (!Force && Known != Cooked.end() && Known->second.Hash == It.Hash && !Known->second.Skipped &&
+		fs::exists(Out, EC))
+		It.Result = Status::UpToDate;
+	else
+		It.Result = It.Type == Kind::Model ? CookModel(It, Out, It.Error) : CookXML(Data, Out, It.Error);
+
+	// Engine Mustn't Take Output Of The Old Source
+	if (It.Result == Status::Skipped || It.Result == Status::Failed)
+		fs::remove(Out, EC);
+
+	It.Ms = chrono::duration<double, milli>(chrono::steady_clock::now() - Start).count();
+}
+
+// Import With Assimp Against Load Of The Cooked Mesh (The Best Of Runs, On One Thread)
+static void Bench(const vector<Asset> &Assets, const fs::path &OutFolder, unsigned Runs)
+{
+	using Clock = chrono::steady_clock;
+	auto Ms = [](Clock::time_point Start) { return chrono::duration<double, milli>(Clock::now() - Start).count(); };
+
+	double TotalImport = 0., TotalCached = 0.;
+	size_t Count = 0;
+	cout << "Import ms\tCached ms\tSpeedup\tModel\n";
+	for (auto &It: Assets)
+	{
+		if (It.Type != Kind::Model || (It.Result != Status::Cooked && It.Result != Status::UpToDate))
+			continue;
+
+		double Import = 1e30, Cached = 1e30;
+		size_t Vertices = 0;
+		for (unsigned Run = 0; Run < Runs; Run++)
+		{
+			// What Models::LoadFromFile Does Without The Cache
+			auto Start = Clock::now();
+			{
+				Assimp::Importer Importer;
+				auto Scene = Importer.ReadFile(It.Source.string(), CookedMesh::ImportFlags);
+				if (!Scene || !Scene->mRootNode)
+					break;
+				CookedMesh Mesh;
+				Mesh.AddNode(Scene->mRootNode, Scene);
+				Vertices = Mesh.Vertices.size();
+			}
+			Import = min(Import, Ms(Start));
+
+			// Read, Check And Copy Blobs As The Engine Does Into Its Meshes
+			Start = Clock::now();
+			{
+				string Data;
+				CookedMesh::View Parsed;
+				if (!ModelDeps::ReadFile((OutFolder / Output(It)).string(), Data) || !CookedMesh::Parse(Data, Parsed))
+					break;
+				vector<CookedMesh::Vertex> Copy(Parsed.Vertices, Parsed.Vertices + Parsed.Head.Vertices);
+				vector<uint32_t> CopyIndices(Parsed.Indices, Parsed.Indices + Parsed.Head.Indices);
+			}
+			Cached = min(Cached, Ms(Start));
+		}
+		if (Import == 1e30 || Cached == 1e30)
+		{
+			cout << "-\t\t-\t\t-\t" << It.Rel << "\n";
+			continue;
+		}
+
+		TotalImport += Import;
+		TotalCached += Cached;
+		Count++;
+		cout << fixed << setprecision(3) << Import << "\t\t" << Cached << "\t\t" << setprecision(1)
+			<< Import / max(Cached, 0.001) << "x\t" << It.Rel << " (" << Vertices << " Vertices)\n";
+	}
+
+	if (Count > 0)
+		cout << "Models: " << Count << ", Import: " << fixed << setprecision(2) << TotalImport << " ms, Cached: "
+			<< TotalCached << " ms (" << setprecision(1) << TotalImport / max(TotalCached, 0.001) << "x)\n";
+}
+
+static DataBaseMap LoadDataBase(const fs::path &File)
+{
+	DataBaseMap Result;
+	ifstream In(File.string());
+	string Line;
+	while (getline(In, Line))
+	{
+		// <Hash In Hex>[:skipped] <Relative Path>
+		size_t Space = Line.find(' ');
+		if (Space == string::npos)
+			continue;
+		try
+		{
+			Record New;
+			string Hash = Line.substr(0, Space);
+			size_t Mark = Hash.find(':');
+			if (Mark != string::npos)
+			{
+				if (Hash.compare(Mark, string::npos, SkippedMark) != 0)
+					continue;
+				New.Skipped = true;
+				Hash.erase(Mark);
+			}
+			New.Hash = stoull(Hash, nullptr, 16);
+			New.Rel = Line.substr(Space + 1);
+			Result[ToLower(New.Rel)] = New;
+		}
+		catch (const exception &)
+		{
+		}
+	}
+	return Result;
+}
+
+static bool SaveDataBase(const fs::path &File, const vector<Asset> &Assets)
+{
+	ostringstream Out;
+	for (auto &It: Assets)
+	{
+		bool Embedded = It.Result == Status::Skipped && It.Error == EmbeddedTextures;
+		if (It.Result == Status::Cooked || It.Result == Status::UpToDate || Embedded)
+			Out << hex << setw(16) << setfill('0') << It.Hash << dec << (Embedded ? SkippedMark : "") << " "
+				<< It.Rel << "\n";
+	}
+
+	string Text = Out.str();
+	return WriteFile(File, Text.data(), Text.size());
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		cout << "Usage: Cook <resource folder> <out folder> [-j N] [-force] [-top N] [-bench N]\n"
+			"\t-j\tCount of workers (Count Of Cores By Default)\n"
+			"\t-force\tCook everything, even if it wasn't changed\n"
+			"\t-top\tHow many of the slowest assets are shown (10 By Default)\n"
+			"\t-bench\tAfter cooking compare import and cached load of every model (The Best Of N Runs)\n";
+		return 1;
+	}
+
+	fs::path Folder = argv[1], OutFolder = argv[2];
+	unsigned Workers = max(1u, thread::hardware_concurrency());
+	bool Force = false;
+	size_t Top = 10;
+	unsigned Runs = 0;
+	for (int i = 3; i < argc; i++)
+	{
+		string Arg = argv[i];
+		if (Arg == "-force")
+			Force = true;
+		else if (Arg == "-j" && i + 1 < argc)
+			Workers = max(1u, (unsigned)stoul(argv[++i]));
+		else if (Arg == "-top" && i + 1 < argc)
+			Top = (size_t)stoul(argv[++i]);
+		else if (Arg == "-bench" && i + 1 < argc)
+			Runs = max(1u, (unsigned)stoul(argv[++i]));
+		else
+		{
+			cout << "Unknown Option: " << Arg << "\n";
+			return 1;
+		}
+	}
+
+	boost::system::error_code EC;
+	if (!fs::is_directory(Folder, EC))
+	{
+		cout << "Folder " << Folder.string() << " Doesn't Exist\n";
+		return 1;
+	}
+
+	auto Start = chrono::steady_clock::now();
+
+	string Root = Folder.generic_string();
+	if (Root.back() != '/')
+		Root += "/";
+
+	vector<Asset> Assets;
+	for (fs::recursive_directory_iterator It(Folder, EC), End; !EC && It != End; It.increment(EC))
+	{
+		if (!fs::is_regular_file(It->status()))
+			continue;
+
+		Asset New;
+		New.Source = It->path();
+		New.Rel = It->path().generic_string().substr(Root.size());
+		string Ext = ToLower(It->path().extension().string());
+		if (ModelDeps::IsSupported(New.Rel))
+			New.Type = Kind::Model;
+		else if (Ext == ".xml")
+			New.Type = Kind::XML;
+		else
+			continue;
+
+		Assets.push_back(New);
+	}
+
+	// The Same Order Every Time (Output Doesn't Depend On Workers)
+	sort(Assets.begin(), Assets.end(), [](const Asset &A, const Asset &B) { return A.Rel < B.Rel; });
+
+	auto Cooked = LoadDataBase(OutFolder / DataBase);
+
+	// Workers Take The Next Asset Until Everything Is Cooked
+	atomic<size_t> Next{ 0 };
+	vector<thread> Threads;
+	for (unsigned i = 0; i < min<size_t>(Workers, max<size_t>(Assets.size(), 1)); i++)
+		Threads.emplace_back([&]()
+		{
+			for (size_t Index = Next++; Index < Assets.size(); Index = Next++)
+				Cook(Assets.at(Index), OutFolder, Cooked, Force);
+		});
+	for (auto &It: Threads)
+		It.join();
+
+	// Outputs Of Deleted Sources
+	unordered_set<string> Sources;
+	for (auto &It: Assets)
+		Sources.insert(ToLower(It.Rel));
+
+	size_t Removed = 0;
+	for (auto &It: Cooked)
+	{
+		if (Sources.count(It.first))
+			continue;
+
+		if (It.second.Skipped)
+			continue;
+
+		fs::path Old = OutFolder / It.second.Rel;
+		if (ModelDeps::IsSupported(It.first))
+			Old += CookedMesh::Ext;
+		if (fs::remove(Old, EC))
+			Removed++;
+	}
+
+	SaveDataBase(OutFolder / DataBase, Assets);
+
+	size_t Counts[4] = {};
+	double Busy = 0.;
+	MeshOptimizer::Report Cache;
+	size_t Triangles = 0, Coarsest = 0;
+	for (auto &It: Assets)
+	{
+		Triangles += It.Triangles;
+		Coarsest += It.Coarsest;
+		Counts[(int)It.Result]++;
+		Busy += It.Ms;
+		Cache.Before += It.Cache.Before;
+		Cache.After += It.Cache.After;
+
+		static const char *Names[] = { "Cooked", "Up To Date", "Skipped", "Failed" };
+		if (It.Result != Status::UpToDate)
+		{
+			cout << "[" << Names[(int)It.Result] << "] " << fixed << setprecision(2) << It.Ms << " ms\t" << It.Rel
+				<< (It.Error.empty() ? "" : ": " + It.Error);
+			if (It.Cache.After.Triangles)
+				cout << setprecision(3) << " (ACMR " << It.Cache.Before.ACMR() << " -> " << It.Cache.After.ACMR()
+					<< ", ATVR " << It.Cache.Before.ATVR() << " -> " << It.Cache.After.ATVR() << ")";
+			cout << "\n";
+		}
+	}
+
+	vector<const Asset *> Slowest;
+	for (auto &It: Assets)
+		if (It.Result == Status::Cooked)
+			Slowest.push_back(&It);
+	sort(Slowest.begin(), Slowest.end(), [](const Asset *A, const Asset *B) { return A->Ms > B->Ms; });
+	if (!Slowest.empty() && Top > 0)
+	{
+		cout << "Slowest:\n";
+		for (size_t i = 0; i < min(Top, Slowest.size()); i++)
+			cout << "\t" << fixed << setprecision(2) << Slowest.at(i)->Ms << " ms\t" << Slowest.at(i)->Rel << "\n";
+	}
+
+	double Time = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	cout << "Assets: " << Assets.size() << " (Cooked: " << Counts[(int)Status::Cooked]
+		<< ", Up To Date: " << Counts[(int)Status::UpToDate] << ", Skipped: " << Counts[(int)Status::Skipped]
+		<< ", Failed: " << Counts[(int)Status::Failed] << ", Removed: " << Removed << ")\n"
+		<< "Time: " << fixed << setprecision(2) << Time << " Seconds (" << Threads.size() << " Workers, "
+		<< Busy / 1000. << " Seconds Of Work)\n";
+	if (Cache.After.Triangles)
+		cout << "Vertex Cache Of Cooked Models: ACMR " << setprecision(3) << Cache.Before.ACMR() << " -> "
+			<< Cache.After.ACMR() << ", ATVR " << Cache.Before.ATVR() << " -> " << Cache.After.ATVR() << " ("
+			<< Cache.After.Triangles << " Triangles)\n";
+	if (Triangles)
+		cout << "Levels Of Detail Of Cooked Models: " << Triangles << " Triangles, The Coarsest: " << Coarsest << "\n";
+
+	if (Runs > 0)
+		Bench(Assets, OutFolder, Runs);
+
+	return Counts[(int)Status::Failed] > 0 ? 2 : 0;
+}
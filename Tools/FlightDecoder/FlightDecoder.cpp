@@ -0,0 +1,118 @@
+// Print Records Of Engine.flight (See Engine/FlightRecorder.h)
+//	FlightDecoder <Engine.flight> [-json] [-last N]
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../../Engine/FlightRecorder.h"
+
+using namespace std;
+
+static string Escape(const string &Text)
+{
+	ostringstream Out;
+	for (unsigned char C : Text)
+	{
+		if (C == '"' || C == '\\')
+			Out << '\\' << C;
+		else if (C == '\n')
+			Out << "\\n";
+		else if (C == '\r')
+			Out << "\\r";
+		else if (C == '\t')
+			Out << "\\t";
+		else if (C < 0x20)
+			Out << "\\u" << hex << setw(4) << setfill('0') << int(C) << dec;
+		else
+			Out << C;
+	}
+	return Out.str();
+}
+
+// FILETIME -> Seconds Since 1970
+static double UnixTime(uint64_t FileTime)
+{
+	return double(FileTime) / 1e7 - 11644473600.;
+}
+
+int main(int argc, char *argv[])
+{
+	if (argc < 2)
+	{
+		cout << "Usage: FlightDecoder <Engine.flight> [-json] [-last N]\n"
+			"\t-json\tPrint JSON instead of text\n"
+			"\t-last\tOnly the last N records\n";
+		return 1;
+	}
+
+	bool Json = false;
+	size_t Last = 0;
+	for (int i = 2; i < argc; i++)
+	{
+		string Arg = argv[i];
+		if (Arg == "-json")
+			Json = true;
+		else if (Arg == "-last" && i + 1 < argc)
+			Last = (size_t)stoul(argv[++i]);
+		else
+		{
+			cout << "Unknown Option: " << Arg << "\n";
+			return 1;
+		}
+	}
+
+	ifstream File(argv[1], ios::binary);
+	if (!File)
+	{
+		cout << "Cannot Open " << argv[1] << "\n";
+		return 2;
+	}
+	vector<uint8_t> Data((istreambuf_iterator<char>(File)), istreambuf_iterator<char>());
+
+	FlightRecorder::Dump Dump;
+	if (!FlightRecorder::Decode(Data.data(), Data.size(), Dump))
+	{
+		cout << argv[1] << " Isn't A Flight Recorder File!\n";
+		return 3;
+	}
+
+	size_t First = Last && Last < Dump.Entries.size() ? Dump.Entries.size() - Last : 0;
+	if (Json)
+	{
+		cout << fixed << setprecision(6) << "{\n"
+			<< "\t\"process\": " << Dump.ProcessID << ",\n"
+			<< "\t\"start\": " << UnixTime(Dump.StartTime) << ",\n"
+			<< "\t\"capacity\": " << Dump.Capacity << ",\n"
+			<< "\t\"clean\": " << (Dump.Clean ? "true" : "false") << ",\n"
+			<< "\t\"lost\": " << Dump.Lost << ",\n"
+			<< "\t\"records\": [";
+		for (size_t i = First; i < Dump.Entries.size(); i++)
+		{
+			auto &It = Dump.Entries.at(i);
+			cout << (i == First ? "\n" : ",\n") << "\t\t{ \"seq\": " << It.Sequence << ", \"time\": " << It.Time
+				<< ", \"thread\": " << It.ThreadID << ", \"type\": \"" << FlightRecorder::GetKindName(It.Type)
+				<< "\", \"text\": \"" << Escape(It.Text) << "\" }";
+		}
+		cout << "\n\t]\n}\n";
+		return 0;
+	}
+
+	cout << "Process: " << Dump.ProcessID << (Dump.Clean ? " (Closed)" : " (Crashed Or Still Running)") << "\n"
+		<< "Records: " << Dump.Entries.size() << " (Overwritten: " << Dump.Lost << ")\n";
+	for (size_t i = First; i < Dump.Entries.size(); i++)
+	{
+		auto &It = Dump.Entries.at(i);
+		string Text = It.Text;
+		for (auto &C : Text)
+			if (C == '\n' || C == '\r')
+				C = ' ';
+
+		cout << fixed << setprecision(6) << setw(12) << It.Time << " [" << setw(6) << It.ThreadID << "] "
+			<< setw(6) << left << FlightRecorder::GetKindName(It.Type) << right << " " << Text << "\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,56 @@
+// Pack Resource Folder Into One Archive For The Engine (See Engine/Pak.h)
+//	PakBuilder <resource folder> <out.pak> [-store] [-align N]
+#include <iostream>
+#include <chrono>
+#include <string>
+
+#include "../../Engine/Pak.h"
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+	if (argc < 3)
+	{
+		cout << "Usage: PakBuilder <resource folder> <out.pak> [-store] [-align N]\n"
+			"\t-store\tDon't compress entries\n"
+			"\t-align\tAlignment of entries (4096 by default)\n";
+		return 1;
+	}
+
+	bool Compress = true;
+	uint32_t Alignment = 4096;
+	for (int i = 3; i < argc; i++)
+	{
+		string Arg = argv[i];
+		if (Arg == "-store")
+			Compress = false;
+		else if (Arg == "-align" && i + 1 < argc)
+			Alignment = (uint32_t)stoul(argv[++i]);
+		else
+		{
+			cout << "Unknown Option: " << Arg << "\n";
+			return 1;
+		}
+	}
+
+	auto Start = chrono::steady_clock::now();
+	Pak::BuildInfo Info;
+	if (!Pak::Build(argv[1], argv[2], Compress, Alignment, Info, [](string Text) { cout << Text << "\n"; }))
+		return 2;
+
+	double Time = chrono::duration<double>(chrono::steady_clock::now() - Start).count();
+	cout << "Files: " << Info.Files << " (Compressed: " << Info.Compressed << ")\n"
+		<< "Size: " << Info.Size << " Bytes -> " << Info.PackedSize << " Bytes\n"
+		<< "Time: " << Time << " Seconds\n";
+
+	// Check What Was Written
+	Pak Archive;
+	if (!Archive.Open(argv[2]) || Archive.GetEntries().size() != Info.Files)
+	{
+		cout << "Archive Is Broken!\n";
+		return 3;
+	}
+
+	return 0;
+}